@@ -0,0 +1,73 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTransformWorkerBenchmark.h"
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_filter_strategy.h"
+#include "kis_paint_device.h"
+#include "kis_painter.h"
+#include "kis_transform_worker.h"
+
+const int IMAGE_WIDTH = 4096;
+const int IMAGE_HEIGHT = 3072;
+
+void KisTransformWorkerBenchmark::benchmarkScale_data()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<QString>("filterId");
+    QTest::addColumn<qreal>("scale");
+    QTest::addColumn<qreal>("shear");
+
+    const QStringList depths = {"U8", "U16", "F32"};
+    const QStringList filters = {"Bilinear", "Bicubic", "Lanczos3"};
+
+    Q_FOREACH (const QString &depth, depths) {
+        Q_FOREACH (const QString &filter, filters) {
+            QTest::addRow("%s-%s-down", qPrintable(depth), qPrintable(filter)) << depth << filter << 0.5 << 0.0;
+            QTest::addRow("%s-%s-up", qPrintable(depth), qPrintable(filter)) << depth << filter << 1.5 << 0.0;
+            QTest::addRow("%s-%s-shear", qPrintable(depth), qPrintable(filter)) << depth << filter << 0.8 << 0.3;
+        }
+    }
+}
+
+void KisTransformWorkerBenchmark::benchmarkScale()
+{
+    QFETCH(QString, depthId);
+    QFETCH(QString, filterId);
+    QFETCH(qreal, scale);
+    QFETCH(qreal, shear);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", depthId, "");
+    QVERIFY(cs);
+
+    KisFilterStrategy *filter = KisFilterStrategyRegistry::instance()->value(filterId);
+    QVERIFY(filter);
+
+    KisPaintDeviceSP source = new KisPaintDevice(cs);
+    source->fill(QRect(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT), KoColor(Qt::white, cs));
+
+    // some details, so that the pixels are not all the same
+    KisPainter painter(source);
+    painter.setPaintColor(KoColor(Qt::red, cs));
+    for (int i = 0; i < IMAGE_WIDTH; i += 97) {
+        painter.drawThickLine(QPointF(i, 0), QPointF(IMAGE_WIDTH - i, IMAGE_HEIGHT), 3, 9);
+    }
+
+    QBENCHMARK_ONCE {
+        KisPaintDeviceSP dev = new KisPaintDevice(*source);
+
+        KisTransformWorker worker(dev, scale, scale,
+                                  shear, 0.0, 0.0, 0.0,
+                                  0.0, 0.0, 0.0,
+                                  0, filter);
+        worker.run();
+    }
+}
+
+SIMPLE_TEST_MAIN(KisTransformWorkerBenchmark)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTRANSFORMWORKERBENCHMARK_H
+#define KISTRANSFORMWORKERBENCHMARK_H
+
+#include <simpletest.h>
+
+class KisTransformWorkerBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkScale_data();
+    void benchmarkScale();
+};
+
+#endif // KISTRANSFORMWORKERBENCHMARK_H
@@ -0,0 +1,180 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTransformWorkersThreadingBenchmark.h"
+
+#include <QTransform>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_cage_transform_worker.h"
+#include "kis_image_config.h"
+#include "kis_liquify_transform_worker.h"
+#include "kis_paint_device.h"
+#include "kis_painter.h"
+#include "kis_perspectivetransform_worker.h"
+#include "kis_warptransform_worker.h"
+
+const int IMAGE_WIDTH = 4096;
+const int IMAGE_HEIGHT = 3072;
+
+namespace {
+
+KisPaintDeviceSP createSourceDevice()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->fill(QRect(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT), KoColor(Qt::white, cs));
+
+    // some details, so that the pixels are not all the same
+    KisPainter painter(dev);
+    painter.setPaintColor(KoColor(Qt::red, cs));
+    for (int i = 0; i < IMAGE_WIDTH; i += 97) {
+        painter.drawThickLine(QPointF(i, 0), QPointF(IMAGE_WIDTH - i, IMAGE_HEIGHT), 3, 9);
+    }
+
+    return dev;
+}
+
+QVector<QPointF> rectPoints(const QRectF &rc)
+{
+    return {rc.topLeft(), rc.topRight(), rc.bottomRight(), rc.bottomLeft()};
+}
+
+}
+
+void KisTransformWorkersThreadingBenchmark::init()
+{
+    m_defaultMaxThreadCount = KisImageConfig(true).maxNumberOfThreads();
+}
+
+void KisTransformWorkersThreadingBenchmark::cleanup()
+{
+    KisImageConfig(false).setMaxNumberOfThreads(m_defaultMaxThreadCount);
+}
+
+void KisTransformWorkersThreadingBenchmark::addThreadsColumn()
+{
+    QTest::addColumn<bool>("multithreaded");
+
+    QTest::newRow("single-threaded") << false;
+    QTest::newRow("multithreaded") << true;
+}
+
+void KisTransformWorkersThreadingBenchmark::setupThreads()
+{
+    QFETCH(bool, multithreaded);
+
+    KisImageConfig(false).setMaxNumberOfThreads(
+        multithreaded ? m_defaultMaxThreadCount : 1);
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkPerspective_data()
+{
+    addThreadsColumn();
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkPerspective()
+{
+    setupThreads();
+
+    KisPaintDeviceSP source = createSourceDevice();
+
+    QTransform transform;
+    transform.translate(IMAGE_WIDTH / 2, IMAGE_HEIGHT / 2);
+    transform.rotate(30, Qt::YAxis);
+    transform.rotate(15);
+    transform.translate(-IMAGE_WIDTH / 2, -IMAGE_HEIGHT / 2);
+
+    QBENCHMARK_ONCE {
+        KisPaintDeviceSP dev = new KisPaintDevice(*source);
+        KisPerspectiveTransformWorker worker(dev, transform, false, 0);
+        worker.run();
+    }
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkWarp_data()
+{
+    addThreadsColumn();
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkWarp()
+{
+    setupThreads();
+
+    KisPaintDeviceSP source = createSourceDevice();
+    const QRectF rc(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+
+    QVector<QPointF> origPoints = rectPoints(rc);
+    origPoints << rc.center();
+
+    QVector<QPointF> transfPoints = origPoints;
+    transfPoints[1] += QPointF(300, -200);
+    transfPoints[4] += QPointF(400, 250);
+
+    QBENCHMARK_ONCE {
+        KisPaintDeviceSP dst = new KisPaintDevice(source->colorSpace());
+        KisWarpTransformWorker worker(KisWarpTransformWorker::RIGID_TRANSFORM,
+                                      origPoints, transfPoints, 1.0, 0);
+        worker.run(source, dst);
+    }
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkCage_data()
+{
+    addThreadsColumn();
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkCage()
+{
+    setupThreads();
+
+    KisPaintDeviceSP source = createSourceDevice();
+    const QRectF rc(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+
+    const QVector<QPointF> origCage = rectPoints(rc.adjusted(100, 100, -100, -100));
+
+    QVector<QPointF> transfCage = origCage;
+    transfCage[0] += QPointF(300, 200);
+    transfCage[2] += QPointF(-200, 400);
+
+    KisCageTransformWorker worker(source->exactBounds(), origCage, 0);
+    worker.prepareTransform();
+    worker.setTransformedCage(transfCage);
+
+    QBENCHMARK_ONCE {
+        KisPaintDeviceSP dst = new KisPaintDevice(*source);
+        worker.run(source, dst);
+    }
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkLiquify_data()
+{
+    addThreadsColumn();
+}
+
+void KisTransformWorkersThreadingBenchmark::benchmarkLiquify()
+{
+    setupThreads();
+
+    KisPaintDeviceSP source = createSourceDevice();
+
+    KisLiquifyTransformWorker worker(source->exactBounds(), 0);
+
+    for (int i = 0; i < 10; i++) {
+        worker.translatePoints(QPointF(400 * i, 300 * i), QPointF(150, 50),
+                               500, false, 0.5);
+    }
+
+    QBENCHMARK_ONCE {
+        KisPaintDeviceSP dst = new KisPaintDevice(source->colorSpace());
+        worker.run(source, dst);
+    }
+}
+
+SIMPLE_TEST_MAIN(KisTransformWorkersThreadingBenchmark)
@@ -0,0 +1,44 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTRANSFORMWORKERSTHREADINGBENCHMARK_H
+#define KISTRANSFORMWORKERSTHREADINGBENCHMARK_H
+
+#include <simpletest.h>
+
+/**
+ * Compares the time the perspective, warp, cage and liquify workers
+ * need for the same image when rendering in one thread and in the
+ * number of threads set by KisImageConfig::maxNumberOfThreads()
+ */
+class KisTransformWorkersThreadingBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void benchmarkPerspective_data();
+    void benchmarkPerspective();
+
+    void benchmarkWarp_data();
+    void benchmarkWarp();
+
+    void benchmarkCage_data();
+    void benchmarkCage();
+
+    void benchmarkLiquify_data();
+    void benchmarkLiquify();
+
+private:
+    void addThreadsColumn();
+    void setupThreads();
+
+private:
+    int m_defaultMaxThreadCount = 0;
+};
+
+#endif // KISTRANSFORMWORKERSTHREADINGBENCHMARK_H
@@ -33,7 +33,11 @@ void KisMaskGeneratorBenchmark::benchmarkCircle()
 #include "krita_utils.h"
 
 
-void benchmarkSIMD(qreal fade) {
+#include "kis_curve_circle_mask_generator.h"
+#include "kis_curve_rect_mask_generator.h"
+#include "kis_cubic_curve.h"
+
+void benchmarkApplicator(KisBrushMaskApplicatorBase *applicator) {
     const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
     KisFixedPaintDeviceSP dev = new KisFixedPaintDevice(cs);
     dev->setRect(QRect(0, 0, 1000, 1000));
@@ -43,9 +47,6 @@ void benchmarkSIMD(qreal fade) {
                             0.0, 1.0,
                             500, 500, 0);
 
-    KisCircleMaskGenerator gen(1000, 1.0, fade, fade, 2, false);
-
-    KisBrushMaskApplicatorBase *applicator = gen.applicator();
     applicator->initializeData(&data);
 
     QVector<QRect> rects = KritaUtils::splitRectIntoPatches(dev->bounds(), QSize(63, 63));
@@ -57,6 +58,11 @@ void benchmarkSIMD(qreal fade) {
     }
 }
 
+void benchmarkSIMD(qreal fade) {
+    KisCircleMaskGenerator gen(1000, 1.0, fade, fade, 2, false);
+    benchmarkApplicator(gen.applicator());
+}
+
 void KisMaskGeneratorBenchmark::benchmarkSIMD_SharpBrush()
 {
     benchmarkSIMD(1.0);
@@ -67,6 +73,38 @@ void KisMaskGeneratorBenchmark::benchmarkSIMD_FadedBrush()
     benchmarkSIMD(0.5);
 }
 
+void KisMaskGeneratorBenchmark::benchmarkSIMD_SpikyBrush()
+{
+    KisCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 5, false);
+    benchmarkApplicator(gen.applicator());
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_CurveCircleBrush()
+{
+    KisCurveCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, KisCubicCurve(QString("0,1;1,0")), true);
+    benchmarkApplicator(gen.applicator());
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_CurveRectBrush()
+{
+    KisCurveRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, KisCubicCurve(QString("0,1;1,0")), true);
+    benchmarkApplicator(gen.applicator());
+}
+
+void KisMaskGeneratorBenchmark::benchmarkScalar_CurveCircleBrush()
+{
+    KisCurveCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, KisCubicCurve(QString("0,1;1,0")), true);
+    gen.setMaskScalarApplicator();
+    benchmarkApplicator(gen.applicator());
+}
+
+void KisMaskGeneratorBenchmark::benchmarkScalar_CurveRectBrush()
+{
+    KisCurveRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, KisCubicCurve(QString("0,1;1,0")), true);
+    gen.setMaskScalarApplicator();
+    benchmarkApplicator(gen.applicator());
+}
+
 void KisMaskGeneratorBenchmark::benchmarkSquare()
 {
     KisRectangleMaskGenerator gen(1000, 0.5, 0.5, 0.5, 3, true);
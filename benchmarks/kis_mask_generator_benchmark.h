@@ -16,6 +16,11 @@ private Q_SLOTS:
     void benchmarkCircle();
     void benchmarkSIMD_SharpBrush();
     void benchmarkSIMD_FadedBrush();
+    void benchmarkSIMD_SpikyBrush();
+    void benchmarkSIMD_CurveCircleBrush();
+    void benchmarkSIMD_CurveRectBrush();
+    void benchmarkScalar_CurveCircleBrush();
+    void benchmarkScalar_CurveRectBrush();
     void benchmarkSquare();
 
 };
@@ -16,6 +16,8 @@ inline double drand48()
 #include <simpletest.h>
 
 #include <QImage>
+#include <QThread>
+#include <QtConcurrent>
 #include <kis_debug.h>
 
 #include "kis_painter_benchmark.h"
@@ -449,5 +451,38 @@ void KisPainterBenchmark::benchmarkMassiveBltFixed()
 }
 
 
+/**
+ * Every write to a tile bumps its revision (see KisTile::revision()).
+ * Paint small dabs on several devices in parallel, like the workers of
+ * a multithreaded brush do, to check that the revision counters don't
+ * become a point of contention between the threads.
+ */
+void KisPainterBenchmark::benchmarkParallelDabsOnSeparateDevices()
+{
+    const int numDevices = qMax(2, QThread::idealThreadCount());
+    const int numDabs = 20000;
+    const int dabSize = 16;
+
+    KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(m_colorSpace);
+    dab->setRect(QRect(0, 0, dabSize, dabSize));
+    dab->initialize();
+    dab->fill(0, 0, dabSize, dabSize, m_color.data());
+
+    QVector<KisPaintDeviceSP> devices;
+    for (int i = 0; i < numDevices; i++) {
+        devices << new KisPaintDevice(m_colorSpace);
+    }
+
+    QBENCHMARK {
+        QtConcurrent::blockingMap(devices, [dab, numDabs, dabSize] (KisPaintDeviceSP dev) {
+            KisPainter gc(dev);
+
+            for (int i = 0; i < numDabs; i++) {
+                const QPoint pt((i * 7) % (TEST_IMAGE_WIDTH - dabSize), (i * 13) % (TEST_IMAGE_HEIGHT - dabSize));
+                gc.bltFixed(pt, dab, QRect(0, 0, dabSize, dabSize));
+            }
+        });
+    }
+}
 
 SIMPLE_TEST_MAIN(KisPainterBenchmark)
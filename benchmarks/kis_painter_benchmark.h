@@ -41,6 +41,8 @@ private Q_SLOTS:
     void benchmarkBitBltOldData();
     void benchmarkMassiveBltFixed();
 
+    void benchmarkParallelDabsOnSeparateDevices();
+
     
 };
 
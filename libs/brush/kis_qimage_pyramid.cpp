@@ -8,6 +8,9 @@
 
 #include <limits>
 #include <QPainter>
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
 #include <kis_debug.h>
 
 #define MIPMAP_SIZE_THRESHOLD 512
@@ -15,8 +18,65 @@
 
 #define QPAINTER_WORKAROUND_BORDER 1
 
+/**
+ * The maximum amount of memory the rendered tips of a single
+ * brush are allowed to occupy, in KiB
+ */
+#define RENDERED_CACHE_SIZE_LIMIT (16 * 1024)
+
+namespace {
+struct RenderedImageKey {
+    RenderedImageKey(KisDabShape const& shape, qreal subPixelX, qreal subPixelY)
+        : scaleX(shape.scaleX()),
+          scaleY(shape.scaleY()),
+          rotation(shape.rotation()),
+          subPixelX(subPixelX),
+          subPixelY(subPixelY)
+    {
+    }
+
+    bool operator==(const RenderedImageKey &rhs) const {
+        return scaleX == rhs.scaleX &&
+            scaleY == rhs.scaleY &&
+            rotation == rhs.rotation &&
+            subPixelX == rhs.subPixelX &&
+            subPixelY == rhs.subPixelY;
+    }
+
+    qreal scaleX;
+    qreal scaleY;
+    qreal rotation;
+    qreal subPixelX;
+    qreal subPixelY;
+};
+
+inline uint qHash(const RenderedImageKey &key, uint seed = 0)
+{
+    return ::qHash(key.scaleX, seed) ^
+        ::qHash(key.scaleY, seed + 1) ^
+        ::qHash(key.rotation, seed + 2) ^
+        ::qHash(key.subPixelX, seed + 3) ^
+        ::qHash(key.subPixelY, seed + 4);
+}
+}
+
+/**
+ * Keeps the tips that have already been rendered for a particular
+ * shape. The cache only stores exact matches, so it never changes the
+ * rendered result. To get more hits, the paintop should snap the dab
+ * shape onto a grid (see KisDabCacheBase and the precision option)
+ */
+struct KisQImagePyramid::RenderedCache
+{
+    RenderedCache() : images(RENDERED_CACHE_SIZE_LIMIT) {}
+
+    QMutex mutex;
+    QCache<RenderedImageKey, QImage> images;
+};
+
 
 KisQImagePyramid::KisQImagePyramid(const QImage &baseImage, bool useSmoothingForEnlarging)
+    : m_renderedCache(new RenderedCache())
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(!baseImage.isNull());
 
@@ -262,6 +322,43 @@ QImage KisQImagePyramid::createImage(KisDabShape const& shape,
 {
     if (m_levels.isEmpty()) return QImage();
 
+    if (!m_renderedCache) {
+        return createImageImpl(shape, subPixelX, subPixelY);
+    }
+
+    const RenderedImageKey key(shape, subPixelX, subPixelY);
+
+    {
+        QMutexLocker l(&m_renderedCache->mutex);
+        QImage *cachedImage = m_renderedCache->images.object(key);
+        if (cachedImage) {
+            return *cachedImage;
+        }
+    }
+
+    const QImage image = createImageImpl(shape, subPixelX, subPixelY);
+    const int cost = qMax(1, int(image.sizeInBytes() / 1024));
+
+    {
+        QMutexLocker l(&m_renderedCache->mutex);
+        m_renderedCache->images.insert(key, new QImage(image), cost);
+    }
+
+    return image;
+}
+
+void KisQImagePyramid::clearRenderedCache()
+{
+    if (!m_renderedCache) return;
+
+    QMutexLocker l(&m_renderedCache->mutex);
+    m_renderedCache->images.clear();
+}
+
+QImage KisQImagePyramid::createImageImpl(KisDabShape const& shape,
+                                         qreal subPixelX, qreal subPixelY) const
+{
+
     qreal baseScale = -1.0;
     int level = findNearestLevel(shape.scale(), &baseScale);
 
@@ -9,6 +9,7 @@
 
 #include <QImage>
 #include <QVector>
+#include <QSharedPointer>
 #include <kis_dab_shape.h>
 #include <kritabrush_export.h>
 
@@ -33,8 +34,16 @@ public:
 
     QImage getClosestWithoutWorkaroundBorder(QTransform transform, qreal *scale) const;
 
+    /**
+     * Drops all the tip images that were cached by createImage()
+     */
+    void clearRenderedCache();
+
 private:
     friend class KisGbrBrushTest;
+    QImage createImageImpl(KisDabShape const&,
+                           qreal subPixelX, qreal subPixelY) const;
+
     int findNearestLevel(qreal scale, qreal *baseScale) const;
     void appendPyramidLevel(const QImage &image);
 
@@ -62,6 +71,14 @@ private:
     };
 
     QVector<PyramidLevel> m_levels;
+
+    /**
+     * The pyramid is shared between all the clones of the brush, so
+     * the rendered tips are also reused by all the strokes that paint
+     * with the same brush.
+     */
+    struct RenderedCache;
+    QSharedPointer<RenderedCache> m_renderedCache;
 };
 
 #endif /* __KIS_QIMAGE_PYRAMID_H */
@@ -9,6 +9,7 @@
 #include <simpletest.h>
 #include <QString>
 #include <QDir>
+#include <QPainter>
 #include <KoColor.h>
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
@@ -224,6 +225,36 @@ void KisGbrBrushTest::testPyramidLevelRounding()
     QCOMPARE(baseLevel, 5);
 }
 
+void KisGbrBrushTest::testPyramidRenderedCache()
+{
+    QImage image(QSize(41, 41), QImage::Format_ARGB32);
+    image.fill(0);
+
+    QPainter gc(&image);
+    gc.fillRect(QRect(10, 5, 20, 30), Qt::black);
+    gc.end();
+
+    KisQImagePyramid pyramid(image);
+
+    const KisDabShape shape(0.7, 0.8, M_PI / 5);
+
+    const QImage reference = pyramid.createImageImpl(shape, 0.25, 0.5);
+    const QImage first = pyramid.createImage(shape, 0.25, 0.5);
+    const QImage second = pyramid.createImage(shape, 0.25, 0.5);
+
+    QCOMPARE(first, reference);
+    QCOMPARE(second, reference);
+
+    // the second request should be served from the cache
+    QCOMPARE(second.constBits(), first.constBits());
+
+    pyramid.clearRenderedCache();
+
+    const QImage third = pyramid.createImage(shape, 0.25, 0.5);
+    QCOMPARE(third, reference);
+    QVERIFY(third.constBits() != first.constBits());
+}
+
 static QSize dabTransformHelper(KisDabShape const& shape)
 {
     QSize const testSize(150, 150);
@@ -28,6 +28,7 @@ private Q_SLOTS:
 
     void testPyramidLevelRounding();
     void testPyramidDabTransform();
+    void testPyramidRenderedCache();
 
     void testQPainterTransformationBorder();
 };
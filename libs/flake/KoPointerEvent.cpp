@@ -12,6 +12,7 @@
 #include <QTabletEvent>
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <chrono>
 #include <cmath>
 #include <boost/variant2/variant.hpp>
 
@@ -64,11 +65,14 @@ class Q_DECL_HIDDEN KoPointerEvent::Private
 public:
     template <typename Event>
     Private(Event *event)
-        : eventPtr(event)
+        : eventPtr(event),
+          receivedTimestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch()).count())
     {
     }
 
     boost::variant2::variant<QMouseEvent*, QTabletEvent*, QTouchEvent*> eventPtr;
+    qint64 receivedTimestamp = 0;
 };
 
 KoPointerEvent::KoPointerEvent(QMouseEvent *ev, const QPointF &pnt)
@@ -319,6 +323,11 @@ ulong KoPointerEvent::time() const
     return visit(Visitor(), d->eventPtr);
 }
 
+qint64 KoPointerEvent::receivedTimestamp() const
+{
+    return d->receivedTimestamp;
+}
+
 bool KoPointerEvent::isTabletEvent()
 {
     return d->eventPtr.index() == 1;
@@ -178,6 +178,14 @@ public:
      */
     ulong time() const;
 
+    /**
+     * Returns the moment the event has been wrapped for the tools,
+     * in nanoseconds of std::chrono::steady_clock. In contrast to
+     * time(), it can be compared with the timestamps taken inside
+     * Krita, e.g. for measuring the input latency.
+     */
+    qint64 receivedTimestamp() const;
+
 
     /// The point in document coordinates.
     QPointF point;
@@ -105,13 +105,15 @@ void KisBezierTransformMesh::transformPatch(const KisBezierPatch &patch, KisPain
 
     {
         GridIterationTools::PaintDevicePolygonOp polygonOp(srcDevice, dstDevice);
+        GridIterationTools::ParallelPolygonOp<GridIterationTools::PaintDevicePolygonOp> parallelOp(polygonOp);
 
         GridIterationTools::RegularGridIndexesOp indexesOp(gridSize);
         GridIterationTools::iterateThroughGrid
-                <GridIterationTools::AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
+                <GridIterationTools::AlwaysCompletePolygonPolicy>(parallelOp, indexesOp,
                                                                   gridSize,
                                                                   originalPointsLocal,
                                                                   transformedPointsLocal);
+        parallelOp.finish();
     }
 }
 
@@ -0,0 +1,229 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisIncrementalThumbnail.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+#include <cstring>
+
+#include <KoColor.h>
+#include <KoColorConversionTransformation.h>
+#include <KoColorSpace.h>
+#include <KoMixColorsOp.h>
+
+#include "kis_datamanager.h"
+#include "kis_paint_device.h"
+
+
+namespace {
+
+inline quint64 tileKey(qint32 col, qint32 row)
+{
+    return (quint64(quint32(col)) << 32) | quint32(row);
+}
+
+inline int floorDiv(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+/**
+ * The shadow is oversampled twice relative to the thumbnail, and one
+ * pixel of the shadow covers at most one tile of the device
+ */
+int idealScale(const QSize &boundsSize, const QSize &thumbnailSize)
+{
+    const int maxScale = KisTileData::WIDTH;
+
+    int scale = 1;
+    while (scale * 2 <= maxScale &&
+           boundsSize.width() / (scale * 2) >= 2 * thumbnailSize.width() &&
+           boundsSize.height() / (scale * 2) >= 2 * thumbnailSize.height()) {
+
+        scale *= 2;
+    }
+    return scale;
+}
+
+}
+
+struct KisIncrementalThumbnail::Private
+{
+    QMutex mutex;
+
+    const KoColorSpace *colorSpace = nullptr;
+    KoColor defaultPixel;
+    QPoint offset;
+    int scale = 0;
+
+    /// the pixel (i, j) of the shadow is the average of the block
+    /// of the device pixels starting at offset + (i, j) * scale
+    KisPaintDeviceSP shadow;
+
+    QHash<quint64, quint64> tileRevisions;
+    int numUpdatedTiles = 0;
+
+    void reset() {
+        colorSpace = nullptr;
+        scale = 0;
+        shadow = 0;
+        tileRevisions.clear();
+    }
+
+    QRect shadowRectForTile(qint32 col, qint32 row) const {
+        const int size = KisTileData::WIDTH / scale;
+        return QRect(col * size, row * size, size, size);
+    }
+
+    void downsampleTile(KisPaintDeviceSP device, qint32 col, qint32 row);
+};
+
+void KisIncrementalThumbnail::Private::downsampleTile(KisPaintDeviceSP device, qint32 col, qint32 row)
+{
+    const int tileSize = KisTileData::WIDTH;
+    const int pixelSize = colorSpace->pixelSize();
+    const int shadowSize = tileSize / scale;
+    const KoMixColorsOp *mixOp = colorSpace->mixColorsOp();
+
+    QVector<quint8> tilePixels(tileSize * tileSize * pixelSize);
+    device->readBytes(tilePixels.data(),
+                      offset.x() + col * tileSize, offset.y() + row * tileSize,
+                      tileSize, tileSize);
+
+    QVector<quint8> blockPixels(scale * scale * pixelSize);
+    QVector<quint8> shadowPixels(shadowSize * shadowSize * pixelSize);
+
+    quint8 *dst = shadowPixels.data();
+
+    for (int by = 0; by < shadowSize; by++) {
+        for (int bx = 0; bx < shadowSize; bx++) {
+            const quint8 *src = tilePixels.constData() +
+                ((by * scale) * tileSize + bx * scale) * pixelSize;
+
+            quint8 *block = blockPixels.data();
+            for (int y = 0; y < scale; y++) {
+                memcpy(block, src, scale * pixelSize);
+                block += scale * pixelSize;
+                src += tileSize * pixelSize;
+            }
+
+            mixOp->mixColors(blockPixels.constData(), scale * scale, dst);
+            dst += pixelSize;
+        }
+    }
+
+    shadow->writeBytes(shadowPixels.constData(), shadowRectForTile(col, row));
+}
+
+KisIncrementalThumbnail::KisIncrementalThumbnail()
+    : m_d(new Private)
+{
+}
+
+KisIncrementalThumbnail::~KisIncrementalThumbnail()
+{
+}
+
+QImage KisIncrementalThumbnail::thumbnail(KisPaintDeviceSP device, int maxSize)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->numUpdatedTiles = 0;
+
+    const QRect bounds = device->exactBounds();
+    const QSize thumbnailSize = bounds.size().scaled(maxSize, maxSize, Qt::KeepAspectRatio);
+    const int scale = idealScale(bounds.size(), thumbnailSize);
+
+    // small devices are cheap to scale down directly
+    if (bounds.isEmpty() || thumbnailSize.isEmpty() || scale <= 1) {
+        m_d->reset();
+        return device->createThumbnail(maxSize, maxSize, Qt::KeepAspectRatio, 1,
+                                       KoColorConversionTransformation::internalRenderingIntent(),
+                                       KoColorConversionTransformation::internalConversionFlags());
+    }
+
+    /**
+     * Keep the current scale while the content changes moderately,
+     * otherwise every stroke near the border of the content might cause
+     * a full rebuild
+     */
+    const bool scaleIsUsable = m_d->scale > 1 &&
+        m_d->scale <= 2 * scale && 2 * m_d->scale >= scale;
+
+    if (!scaleIsUsable ||
+        m_d->colorSpace != device->colorSpace() ||
+        m_d->defaultPixel != device->defaultPixel() ||
+        m_d->offset != QPoint(device->x(), device->y())) {
+
+        m_d->reset();
+        m_d->colorSpace = device->colorSpace();
+        m_d->defaultPixel = device->defaultPixel();
+        m_d->offset = QPoint(device->x(), device->y());
+        m_d->scale = scale;
+        m_d->shadow = new KisPaintDevice(m_d->colorSpace);
+        m_d->shadow->setDefaultPixel(m_d->defaultPixel);
+    }
+
+    const QVector<KisTiledDataManager::TileRevision> revisions =
+        device->dataManager()->tileRevisions();
+
+    QHash<quint64, quint64> newTileRevisions;
+    newTileRevisions.reserve(revisions.size());
+
+    Q_FOREACH (const KisTiledDataManager::TileRevision &tile, revisions) {
+        const quint64 key = tileKey(tile.col, tile.row);
+        newTileRevisions.insert(key, tile.revision);
+
+        auto it = m_d->tileRevisions.find(key);
+        const bool tileChanged = it == m_d->tileRevisions.end() || *it != tile.revision;
+
+        if (it != m_d->tileRevisions.end()) {
+            m_d->tileRevisions.erase(it);
+        }
+
+        if (tileChanged) {
+            m_d->downsampleTile(device, tile.col, tile.row);
+            m_d->numUpdatedTiles++;
+        }
+    }
+
+    // the tiles that are left have been removed from the device
+    for (auto it = m_d->tileRevisions.constBegin(); it != m_d->tileRevisions.constEnd(); ++it) {
+        const qint32 col = qint32(it.key() >> 32);
+        const qint32 row = qint32(quint32(it.key()));
+        m_d->shadow->clear(m_d->shadowRectForTile(col, row));
+        m_d->numUpdatedTiles++;
+    }
+
+    m_d->tileRevisions.swap(newTileRevisions);
+
+    const QRect localBounds = bounds.translated(-m_d->offset);
+    const QRect shadowBounds(QPoint(floorDiv(localBounds.left(), m_d->scale),
+                                    floorDiv(localBounds.top(), m_d->scale)),
+                             QPoint(floorDiv(localBounds.right(), m_d->scale),
+                                    floorDiv(localBounds.bottom(), m_d->scale)));
+
+    return m_d->shadow->createThumbnail(thumbnailSize.width(), thumbnailSize.height(),
+                                        shadowBounds, 1,
+                                        KoColorConversionTransformation::internalRenderingIntent(),
+                                        KoColorConversionTransformation::internalConversionFlags());
+}
+
+void KisIncrementalThumbnail::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->reset();
+}
+
+int KisIncrementalThumbnail::numUpdatedTiles() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->numUpdatedTiles;
+}
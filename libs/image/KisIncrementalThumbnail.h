@@ -0,0 +1,66 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISINCREMENTALTHUMBNAIL_H
+#define KISINCREMENTALTHUMBNAIL_H
+
+#include <QImage>
+#include <QScopedPointer>
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+/**
+ * Generates the thumbnails of a paint device incrementally.
+ *
+ * The object keeps a low-resolution "shadow" of the device, where every
+ * pixel is the average of a square block of the device pixels. When the
+ * thumbnail is requested, only the tiles of the device that have changed
+ * since the previous request are downsampled into the shadow again (the
+ * changes are detected by the tile revisions, \see KisTile::revision()).
+ * The thumbnail itself is then sampled from the shadow, which is only
+ * a few times bigger than the thumbnail.
+ *
+ * The shadow is rebuilt from scratch when the color space, the default
+ * pixel or the offset of the device change, or when the content of the
+ * device grows or shrinks so much that the shadow needs another scale.
+ *
+ * The object is supposed to be used for one device (or one node) only.
+ * The calls are serialized with an internal lock.
+ */
+class KRITAIMAGE_EXPORT KisIncrementalThumbnail
+{
+public:
+    KisIncrementalThumbnail();
+    ~KisIncrementalThumbnail();
+
+    KisIncrementalThumbnail(const KisIncrementalThumbnail &) = delete;
+    KisIncrementalThumbnail &operator=(const KisIncrementalThumbnail &) = delete;
+
+    /**
+     * Returns the thumbnail of the exact bounds of \p device fitted into
+     * \p maxSize x \p maxSize with the aspect ratio kept, like
+     * KisLayer::createThumbnail() does
+     */
+    QImage thumbnail(KisPaintDeviceSP device, int maxSize);
+
+    /**
+     * Drops the shadow, the next thumbnail will be generated from scratch
+     */
+    void clear();
+
+    /**
+     * The number of device tiles downsampled into the shadow by the
+     * last call to thumbnail(). Used in unittests.
+     */
+    int numUpdatedTiles() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISINCREMENTALTHUMBNAIL_H
@@ -0,0 +1,320 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisInputLatencyTracker.h"
+
+#include <QFile>
+#include <QGlobalStatic>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtMath>
+
+#include <atomic>
+#include <chrono>
+
+#include "kis_assert.h"
+#include "kis_debug.h"
+
+Q_GLOBAL_STATIC(KisInputLatencyTracker, s_instance)
+
+namespace {
+
+/**
+ * The newest input event that has passed a stage of the pipeline
+ * and the moment it did that
+ */
+struct PendingSample
+{
+    qint64 inputTimestamp = 0;
+    qint64 stageTimestamp = 0;
+
+    /// the event is a drag of a transform handle
+    bool isTransform = false;
+
+    bool isValid() const {
+        return inputTimestamp > 0;
+    }
+};
+
+}
+
+KisInputLatencyTracker::Histogram::Histogram()
+    : buckets(numBuckets, 0)
+{
+}
+
+void KisInputLatencyTracker::Histogram::addSample(qint64 latencyNs)
+{
+    latencyNs = qMax(qint64(0), latencyNs);
+
+    const int bucket = int(qMin(latencyNs / (bucketWidthUs * 1000), qint64(numBuckets - 1)));
+    buckets[bucket]++;
+
+    minNs = count ? qMin(minNs, latencyNs) : latencyNs;
+    maxNs = count ? qMax(maxNs, latencyNs) : latencyNs;
+    sumNs += latencyNs;
+    count++;
+}
+
+qreal KisInputLatencyTracker::Histogram::percentileMs(qreal percent) const
+{
+    if (!count) return 0.0;
+
+    const qint64 threshold = qMax(qint64(1), qint64(qCeil(count * percent / 100.0)));
+
+    qint64 accumulated = 0;
+    for (int i = 0; i < numBuckets - 1; i++) {
+        accumulated += buckets[i];
+        if (accumulated >= threshold) {
+            return qMin(maxMs(), (i + 1) * bucketWidthUs / 1000.0);
+        }
+    }
+
+    return maxMs();
+}
+
+qreal KisInputLatencyTracker::Histogram::meanMs() const
+{
+    return count ? sumNs / 1e6 / count : 0.0;
+}
+
+qreal KisInputLatencyTracker::Histogram::minMs() const
+{
+    return minNs / 1e6;
+}
+
+qreal KisInputLatencyTracker::Histogram::maxMs() const
+{
+    return maxNs / 1e6;
+}
+
+struct Q_DECL_HIDDEN KisInputLatencyTracker::Private
+{
+    std::atomic<bool> isEnabled {false};
+
+    /// the file the report is written into on exit
+    QString reportFileName;
+
+    mutable QMutex mutex;
+    Histogram histograms[NumStages];
+
+    PendingSample painted;
+    PendingSample merged;
+    PendingSample texturesUpdated;
+
+    /**
+     * Moves the pending sample from \p from to \p to and records the
+     * time between the two stages
+     */
+    void promote(PendingSample &from, PendingSample &to, Stage stage, qint64 now) {
+        if (!from.isValid()) return;
+
+        histograms[stage].addSample(now - from.stageTimestamp);
+
+        if (from.inputTimestamp > to.inputTimestamp) {
+            to.inputTimestamp = from.inputTimestamp;
+            to.stageTimestamp = now;
+            to.isTransform = from.isTransform;
+        }
+
+        from = PendingSample();
+    }
+
+    void addFirstStageSample(qint64 inputTimestamp, bool isTransform, qint64 now) {
+        histograms[isTransform ? TransformPreviewRendered : DabPainted].addSample(now - inputTimestamp);
+
+        if (inputTimestamp > painted.inputTimestamp) {
+            painted.inputTimestamp = inputTimestamp;
+            painted.stageTimestamp = now;
+            painted.isTransform = isTransform;
+        }
+    }
+};
+
+KisInputLatencyTracker::KisInputLatencyTracker()
+    : m_d(new Private)
+{
+    m_d->reportFileName = qEnvironmentVariable("KRITA_INPUT_LATENCY_REPORT");
+    m_d->isEnabled = !m_d->reportFileName.isEmpty();
+}
+
+KisInputLatencyTracker::~KisInputLatencyTracker()
+{
+    if (!m_d->reportFileName.isEmpty()) {
+        exportToFile(m_d->reportFileName);
+    }
+}
+
+KisInputLatencyTracker *KisInputLatencyTracker::instance()
+{
+    return s_instance;
+}
+
+qint64 KisInputLatencyTracker::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+QString KisInputLatencyTracker::stageName(Stage stage)
+{
+    switch (stage) {
+    case DabPainted:
+        return "dab-painted";
+    case ProjectionMerged:
+        return "projection-merged";
+    case TexturesUpdated:
+        return "textures-updated";
+    case FramePresented:
+        return "frame-presented";
+    case EndToEnd:
+        return "end-to-end";
+    case TransformPreviewRendered:
+        return "transform-preview-rendered";
+    case TransformEndToEnd:
+        return "transform-end-to-end";
+    case NumStages:
+        break;
+    }
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(0 && "unknown stage");
+    return QString();
+}
+
+void KisInputLatencyTracker::setEnabled(bool value)
+{
+    m_d->isEnabled = value;
+}
+
+bool KisInputLatencyTracker::isEnabled() const
+{
+    return m_d->isEnabled;
+}
+
+void KisInputLatencyTracker::notifyDabPainted(qint64 inputTimestamp)
+{
+    if (!m_d->isEnabled || inputTimestamp <= 0) return;
+
+    const qint64 currentTime = now();
+
+    QMutexLocker l(&m_d->mutex);
+    m_d->addFirstStageSample(inputTimestamp, false, currentTime);
+}
+
+void KisInputLatencyTracker::notifyTransformPreviewRendered(qint64 inputTimestamp)
+{
+    if (!m_d->isEnabled || inputTimestamp <= 0) return;
+
+    const qint64 currentTime = now();
+
+    QMutexLocker l(&m_d->mutex);
+    m_d->addFirstStageSample(inputTimestamp, true, currentTime);
+}
+
+void KisInputLatencyTracker::notifyProjectionMerged()
+{
+    if (!m_d->isEnabled) return;
+
+    const qint64 currentTime = now();
+
+    QMutexLocker l(&m_d->mutex);
+    m_d->promote(m_d->painted, m_d->merged, ProjectionMerged, currentTime);
+}
+
+void KisInputLatencyTracker::notifyTexturesUpdated()
+{
+    if (!m_d->isEnabled) return;
+
+    const qint64 currentTime = now();
+
+    QMutexLocker l(&m_d->mutex);
+    m_d->promote(m_d->merged, m_d->texturesUpdated, TexturesUpdated, currentTime);
+}
+
+void KisInputLatencyTracker::notifyFramePresented()
+{
+    if (!m_d->isEnabled) return;
+
+    const qint64 currentTime = now();
+
+    QMutexLocker l(&m_d->mutex);
+
+    if (!m_d->texturesUpdated.isValid()) return;
+
+    m_d->histograms[FramePresented].addSample(currentTime - m_d->texturesUpdated.stageTimestamp);
+    m_d->histograms[m_d->texturesUpdated.isTransform ? TransformEndToEnd : EndToEnd]
+        .addSample(currentTime - m_d->texturesUpdated.inputTimestamp);
+    m_d->texturesUpdated = PendingSample();
+}
+
+KisInputLatencyTracker::Histogram KisInputLatencyTracker::histogram(Stage stage) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(stage >= 0 && stage < NumStages, Histogram());
+
+    QMutexLocker l(&m_d->mutex);
+    return m_d->histograms[stage];
+}
+
+void KisInputLatencyTracker::reset()
+{
+    QMutexLocker l(&m_d->mutex);
+
+    for (int i = 0; i < NumStages; i++) {
+        m_d->histograms[i] = Histogram();
+    }
+
+    m_d->painted = PendingSample();
+    m_d->merged = PendingSample();
+    m_d->texturesUpdated = PendingSample();
+}
+
+QJsonObject KisInputLatencyTracker::toJson() const
+{
+    QJsonObject stages;
+
+    for (int i = 0; i < NumStages; i++) {
+        const Stage stage = static_cast<Stage>(i);
+        const Histogram h = histogram(stage);
+
+        QJsonArray buckets;
+        for (qint64 value : h.buckets) {
+            buckets.append(double(value));
+        }
+
+        QJsonObject object;
+        object["count"] = double(h.count);
+        object["meanMs"] = h.meanMs();
+        object["minMs"] = h.minMs();
+        object["maxMs"] = h.maxMs();
+        object["p50Ms"] = h.percentileMs(50);
+        object["p95Ms"] = h.percentileMs(95);
+        object["p99Ms"] = h.percentileMs(99);
+        object["buckets"] = buckets;
+
+        stages[stageName(stage)] = object;
+    }
+
+    QJsonObject root;
+    root["bucketWidthUs"] = double(Histogram::bucketWidthUs);
+    root["stages"] = stages;
+
+    return root;
+}
+
+bool KisInputLatencyTracker::exportToFile(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        warnKrita << "Failed to write input latency report into" << fileName;
+        return false;
+    }
+
+    file.write(QJsonDocument(toJson()).toJson());
+    return true;
+}
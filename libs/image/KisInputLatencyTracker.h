@@ -0,0 +1,145 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISINPUTLATENCYTRACKER_H
+#define KISINPUTLATENCYTRACKER_H
+
+#include "kritaimage_export.h"
+
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+
+class QJsonObject;
+
+/**
+ * Measures how long it takes for an input event to reach the screen.
+ *
+ * The moment the tool receives a pointer event is stored in
+ * KoPointerEvent and then carried by KisPaintInformation into the
+ * stroke jobs. The tracker is notified when the stages of the canvas
+ * update pipeline are finished:
+ *
+ * 1) the freehand stroke job has painted the dab, or the transform
+ *    stroke has rendered the preview of the dragged handles,
+ * 2) the update scheduler has merged the projection,
+ * 3) the canvas has updated its textures (or the prescaled projection),
+ * 4) the canvas widget has painted the frame.
+ *
+ * The update pipeline works with dirty rects, not with the events,
+ * so every stage just picks up the newest event that has passed the
+ * previous one. That is, every painted frame produces one end-to-end
+ * sample for the newest input event it contains, and the events
+ * overtaken by the newer ones are not measured after the first stage.
+ *
+ * The transform tool drags have the first and the end-to-end stages
+ * of their own, because the transform preview is recalculated for a
+ * batch of pointer events at once, which is not comparable with
+ * painting a dab. The intermediate stages are shared.
+ *
+ * The tracker is disabled by default and costs one atomic read per
+ * notification then. It is enabled by the Input Latency docker or by
+ * KRITA_INPUT_LATENCY_REPORT environment variable. In the latter case
+ * the histograms are written to the file the variable points to when
+ * Krita exits, which is intended for the benchmarks run headless.
+ *
+ * All the methods are thread-safe.
+ */
+class KRITAIMAGE_EXPORT KisInputLatencyTracker
+{
+public:
+    enum Stage {
+        DabPainted = 0,   ///< input received -> dab painted
+        ProjectionMerged, ///< dab painted -> projection merged
+        TexturesUpdated,  ///< projection merged -> canvas textures updated
+        FramePresented,   ///< canvas textures updated -> frame painted
+        EndToEnd,         ///< input received -> frame painted
+        TransformPreviewRendered, ///< input received -> transform preview rendered
+        TransformEndToEnd,        ///< input received -> frame painted, for the transform drags
+        NumStages
+    };
+
+    /**
+     * A histogram of the latencies with buckets of bucketWidthUs
+     * microseconds. The last bucket collects all the longer samples.
+     */
+    struct KRITAIMAGE_EXPORT Histogram
+    {
+        static constexpr int numBuckets = 201;
+        static constexpr qint64 bucketWidthUs = 500;
+
+        Histogram();
+
+        void addSample(qint64 latencyNs);
+
+        /**
+         * @return an approximate latency in milliseconds which \p percent
+         * of the samples do not exceed, i.e. the upper bound of the bucket
+         * it falls into
+         */
+        qreal percentileMs(qreal percent) const;
+
+        qreal meanMs() const;
+        qreal minMs() const;
+        qreal maxMs() const;
+
+        qint64 count = 0;
+        qint64 sumNs = 0;
+        qint64 minNs = 0;
+        qint64 maxNs = 0;
+        QVector<qint64> buckets;
+    };
+
+public:
+    KisInputLatencyTracker();
+    ~KisInputLatencyTracker();
+
+    static KisInputLatencyTracker* instance();
+
+    /**
+     * The clock used for all the timestamps: nanoseconds of
+     * std::chrono::steady_clock, the same as in
+     * KoPointerEvent::receivedTimestamp()
+     */
+    static qint64 now();
+
+    static QString stageName(Stage stage);
+
+    void setEnabled(bool value);
+    bool isEnabled() const;
+
+    void notifyDabPainted(qint64 inputTimestamp);
+
+    /**
+     * Called when the transform stroke has rendered the preview for the
+     * pointer events up to the one received at \p inputTimestamp.
+     * The stroke passes the oldest event it has not rendered yet,
+     * so the time the event waited in the tool's compressors and in
+     * the stroke's update interval is included.
+     */
+    void notifyTransformPreviewRendered(qint64 inputTimestamp);
+    void notifyProjectionMerged();
+    void notifyTexturesUpdated();
+    void notifyFramePresented();
+
+    Histogram histogram(Stage stage) const;
+
+    void reset();
+
+    QJsonObject toJson() const;
+
+    /**
+     * Writes the histograms of all the stages into \p fileName
+     * in JSON format
+     */
+    bool exportToFile(const QString &fileName) const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISINPUTLATENCYTRACKER_H
@@ -9,7 +9,15 @@ struct KisLodPreferences
     enum PreferenceFlag {
         None = 0x0,
         LodSupported = 0x1,
-        LodPreferred = 0x2
+        LodPreferred = 0x2,
+
+        /**
+         * The canvas cannot show the level of detail planes in general,
+         * but can upscale them for a short preview (QPainter canvas does
+         * that in KisImagePyramid). Only the strokes that explicitly opt
+         * in for such a preview use it, e.g. the transform tool.
+         */
+        LodPreviewSupported = 0x4
     };
     Q_DECLARE_FLAGS(PreferenceFlags, PreferenceFlag)
 
@@ -40,6 +48,10 @@ struct KisLodPreferences
         return m_flags & LodSupported;
     }
 
+    bool lodPreviewSupported() const {
+        return m_flags & LodPreviewSupported;
+    }
+
     int desiredLevelOfDetail() const {
         return m_desiredLevelOfDetail;
     }
@@ -80,6 +80,7 @@ struct KisPaintInformation::Private {
         }
 
         levelOfDetail = rhs.levelOfDetail;
+        inputTimestamp = rhs.inputTimestamp;
     }
 
 
@@ -129,6 +130,7 @@ struct KisPaintInformation::Private {
     boost::optional<DirectionHistoryInfo> directionHistoryInfo;
 
     int levelOfDetail;
+    qint64 inputTimestamp = 0;
 
     void registerDistanceInfo(KisDistanceInformation *di) {
         directionHistoryInfo = DirectionHistoryInfo(di->scalarDistanceApprox(),
@@ -521,6 +523,16 @@ void KisPaintInformation::setPerStrokeRandomSource(KisPerStrokeRandomSourceSP va
     d->perStrokeRandomSource = value;
 }
 
+qint64 KisPaintInformation::inputTimestamp() const
+{
+    return d->inputTimestamp;
+}
+
+void KisPaintInformation::setInputTimestamp(qint64 value)
+{
+    d->inputTimestamp = value;
+}
+
 void KisPaintInformation::setLevelOfDetail(int levelOfDetail)
 {
     d->levelOfDetail = levelOfDetail;
@@ -599,6 +611,7 @@ void KisPaintInformation::mixOtherImpl(const QPointF &p, qreal t, const KisPaint
         this->d->pos = p;
         this->d->isHoveringMode = false;
         this->d->levelOfDetail = 0;
+        this->d->inputTimestamp = qMax(this->d->inputTimestamp, other.d->inputTimestamp);
         return;
     }
     else {
@@ -621,6 +634,8 @@ void KisPaintInformation::mixOtherImpl(const QPointF &p, qreal t, const KisPaint
         qreal time = mixTime ? ((1 - t) * other.currentTime() + t * this->currentTime()) : this->currentTime();
         qreal speed = (1 - t) * other.drawingSpeed() + t * this->drawingSpeed();
 
+        qint64 inputTimestamp = qMax(this->d->inputTimestamp, other.d->inputTimestamp);
+
         KIS_ASSERT_RECOVER_NOOP(other.isHoveringMode() == this->isHoveringMode());
         *(this->d) = Private(p, pressure, xTilt, yTilt, rotation, tangentialPressure, perspective, time, speed, other.isHoveringMode());
         this->d->canvasRotation = other.d->canvasRotation;
@@ -630,6 +645,7 @@ void KisPaintInformation::mixOtherImpl(const QPointF &p, qreal t, const KisPaint
         this->d->perStrokeRandomSource = other.d->perStrokeRandomSource;
         // this->d->isHoveringMode = other.isHoveringMode();
         this->d->levelOfDetail = other.d->levelOfDetail;
+        this->d->inputTimestamp = inputTimestamp;
     }
 }
 
@@ -222,6 +222,16 @@ public:
     // set level of detail which info object has been generated for
     void setLevelOfDetail(int levelOfDetail);
 
+    /**
+     * The moment the input event this information originates from has
+     * been received by the tool, in nanoseconds of the steady clock
+     * (KisInputLatencyTracker::now()). Zero if the information has not
+     * been generated from an input event. When two infos are mixed, the
+     * newer timestamp is kept.
+     */
+    qint64 inputTimestamp() const;
+    void setInputTimestamp(qint64 value);
+
     /**
      * The paint information may be generated not only during real
      * stroke when the actual painting is happening, but also when the
@@ -328,6 +328,14 @@ public:
      */
     virtual int thumbnailSeqNo() const;
 
+    /**
+     * @return the paint device that createThumbnail() scales down or
+     * null if the thumbnail of the node is generated in some other way.
+     * It lets the callers update the thumbnail incrementally, \see
+     * KisIncrementalThumbnail
+     */
+    virtual KisPaintDeviceSP thumbnailSourceDevice() const;
+
     /**
      * @return a thumbnail in requested size for the defined timestamp.
      * The thumbnail is a rgba Image and may have transparent parts.
@@ -13,19 +13,56 @@
 
 #if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) && XSIMD_UNIVERSAL_BUILD_PASS
 
+#include <algorithm>
+
 #include "kis_brush_mask_scalar_applicator.h"
 
 template<class V>
 struct FastRowProcessor {
     FastRowProcessor(V *maskGenerator)
         : d(maskGenerator->d.data())
+        , spikes(maskGenerator->spikes())
+        , spikesAngle(static_cast<float>(M_PI / maskGenerator->spikes()))
     {
     }
 
     template<typename _impl>
     void process(float *buffer, int width, float y, float cosa, float sina, float centerX, float centerY);
 
+    /**
+     * Vectorized version of KisMaskGenerator::fixRotation(). Rotates
+     * every point into the first spike of the mask. Instead of rotating
+     * step by step, the number of steps is calculated directly from
+     * the angle of the point.
+     */
+    template<typename _impl>
+    inline void fixRotation(xsimd::batch<float, _impl> &xr, xsimd::batch<float, _impl> &yr) const
+    {
+        using float_v = xsimd::batch<float, _impl>;
+
+        if (spikes <= 2) return;
+
+        yr = xsimd::abs(yr);
+
+        const float_v vSpikesAngle(spikesAngle);
+        const float_v vSpikesStep(2.0f * spikesAngle);
+
+        const float_v angle = xsimd::atan2(yr, xr);
+        const float_v steps =
+            xsimd::max(float_v(0.0f), xsimd::ceil((angle - vSpikesAngle) / vSpikesStep));
+
+        const auto rotation = xsimd::sincos(-steps * vSpikesStep);
+        const float_v &s = rotation.first;
+        const float_v &c = rotation.second;
+
+        const float_v sx = xr;
+        xr = c * sx - s * yr;
+        yr = s * sx + c * yr;
+    }
+
     typename V::Private *d;
+    int spikes;
+    float spikesAngle;
 };
 
 template<class MaskGenerator, typename _impl>
@@ -95,8 +132,44 @@ void KisBrushMaskVectorApplicator<MaskGenerator, impl>::processVector(const QRec
 
     FastRowProcessor<MaskGenerator> processor(m_maskGenerator);
 
+    int supersample = 1;
+    if (m_maskGenerator->shouldSupersample()) {
+        // strengthen supersampling from 3x3 for very small dabs, to smooth out dashed strokes
+        supersample = (m_maskGenerator->shouldSupersample6x6() ? 6 : 3);
+    }
+    const float invss = 1.0f / supersample;
+    const float_v vInvSampleArea(1.0f / (supersample * supersample));
+
+    float *sampleBuffer = supersample != 1 ? xsimd::vector_aligned_malloc<float>(simdWidth) : nullptr;
+
     for (int y = rect.y(); y < rect.y() + rect.height(); y++) {
-        processor.template process<impl>(buffer, simdWidth, y, m_d->cosa, m_d->sina, m_d->centerX, m_d->centerY);
+        if (supersample == 1) {
+            processor.template process<impl>(buffer, simdWidth, y, m_d->cosa, m_d->sina, m_d->centerX, m_d->centerY);
+        } else {
+            std::fill(buffer, buffer + simdWidth, 0.0f);
+
+            for (int sy = 0; sy < supersample; sy++) {
+                for (int sx = 0; sx < supersample; sx++) {
+                    // the row processor samples at (x - centerX), so the
+                    // subpixel offset is applied by shifting the center
+                    processor.template process<impl>(sampleBuffer, simdWidth,
+                                                     y + sy * invss,
+                                                     m_d->cosa, m_d->sina,
+                                                     m_d->centerX - sx * invss,
+                                                     m_d->centerY);
+
+                    for (size_t i = 0; i < simdWidth; i += float_v::size) {
+                        const float_v acc = float_v::load_aligned(buffer + i) + float_v::load_aligned(sampleBuffer + i);
+                        acc.store_aligned(buffer + i);
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < simdWidth; i += float_v::size) {
+                const float_v value = float_v::load_aligned(buffer + i) * vInvSampleArea;
+                value.store_aligned(buffer + i);
+            }
+        }
 
         if (m_d->randomness != 0.0 || m_d->density != 1.0) {
             for (int x = 0; x < width; x++) {
@@ -136,6 +209,10 @@ void KisBrushMaskVectorApplicator<MaskGenerator, impl>::processVector(const QRec
         dabPointer += offset;
     } // endfor y
     xsimd::vector_aligned_free(buffer);
+
+    if (sampleBuffer) {
+        xsimd::vector_aligned_free(sampleBuffer);
+    }
 }
 
 #endif /* defined HAVE_XSIMD */
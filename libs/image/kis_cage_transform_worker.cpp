@@ -355,12 +355,14 @@ void KisCageTransformWorker::run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP ds
     }
 
     GridIterationTools::PaintDevicePolygonOp polygonOp(srcDevice, tempDevice);
+    GridIterationTools::ParallelPolygonOp<GridIterationTools::PaintDevicePolygonOp> parallelOp(polygonOp);
     Private::MapIndexesOp indexesOp(m_d.data());
     GridIterationTools::iterateThroughGrid
-        <GridIterationTools::IncompletePolygonPolicy>(polygonOp, indexesOp,
+        <GridIterationTools::IncompletePolygonPolicy>(parallelOp, indexesOp,
                                                       m_d->gridSize,
                                                       m_d->validPoints,
                                                       transformedPoints);
+    parallelOp.finish();
 
     QRect rect = tempDevice->extent();
     KisPainter gc(dstDevice);
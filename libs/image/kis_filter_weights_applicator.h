@@ -15,6 +15,8 @@
 #include <KoColorSpace.h>
 #include <KoMixColorsOp.h>
 
+#include <vector>
+
 
 namespace tmp {
     template <class iter> iter createIterator(KisPaintDeviceSP dev, qint32 start, qint32 lineNum, qint32 len);
@@ -234,7 +236,12 @@ public:
         const KoColor defaultPixelObject = m_src->defaultPixel();
         const quint8 *defaultPixel = defaultPixelObject.data();
         const quint8 *borderPixel = defaultPixel;
-        quint8 *srcLineBuf = new quint8[pixelSize * (rightSrcBorder - leftSrcBorder)];
+
+        const size_t srcLineBufSize = size_t(pixelSize) * (rightSrcBorder - leftSrcBorder);
+        if (m_srcLineBuf.size() < srcLineBufSize) {
+            m_srcLineBuf.resize(srcLineBufSize);
+        }
+        quint8 *srcLineBuf = m_srcLineBuf.data();
 
         int i = leftSrcBorder;
         quint8 *bufPtr = srcLineBuf;
@@ -264,32 +271,58 @@ public:
             memcpy(bufPtr, borderPixel, pixelSize);
         }
 
-        const quint8 **colors = new const quint8* [buffer->maxSpan()];
+        const BlendSpan *spans = blendSpans(dstStart, dstEnd, line, buffer);
 
+        /**
+         * The source pixels of every span are stored contiguously in
+         * the line buffer, so they are passed to the mixing op directly,
+         * without collecting an array of pointers to them first.
+         */
         T dstIt = tmp::createIterator<T>(m_dst, dstStart, line, dstEnd - dstStart);
-        for (int i = dstStart; i < dstEnd; i++) {
-            BlendSpan span = calculateBlendSpan(i, line, buffer);
+        for (int i = 0; i < dstEnd - dstStart; i++) {
+            const BlendSpan &span = spans[i];
+            const int bufIndexStart = span.firstBlendPixel - leftSrcBorder;
 
-            int bufIndexStart = span.firstBlendPixel - leftSrcBorder;
-            int bufIndexEnd = bufIndexStart + span.weights->span;
-
-            const quint8 **colorsPtr = colors;
-            for (int j = bufIndexStart; j < bufIndexEnd; j++) {
-                *(colorsPtr++) = srcLineBuf + j * pixelSize;
-            }
-
-            mixOp->mixColors(colors, span.weights->weight, span.weights->span, dstIt->rawData());
+            mixOp->mixColors(srcLineBuf + bufIndexStart * pixelSize,
+                             span.weights->weight, span.weights->span,
+                             dstIt->rawData());
             dstIt->nextPixel();
         }
 
-        delete[] colors;
-        delete[] srcLineBuf;
-
         return LinePos(dstStart, qMax(0, dstEnd - dstStart));
     }
 
 private:
 
+    /**
+     * When there is no shear, the position of the dst pixels relative
+     * to the src pixels doesn't depend on the line, so the spans are
+     * calculated for the first line of the pass only and then reused
+     * by all the other lines.
+     */
+    const BlendSpan* blendSpans(int dstStart, int dstEnd, int line, KisFilterWeightsBuffer *buffer) {
+        const int size = dstEnd - dstStart;
+
+        const bool canReuseSpans =
+            m_shear == 0.0 &&
+            m_spansBuffer == buffer &&
+            m_spansStart == dstStart &&
+            int(m_spans.size()) == size;
+
+        if (!canReuseSpans) {
+            m_spans.resize(size);
+
+            for (int i = 0; i < size; i++) {
+                m_spans[i] = calculateBlendSpan(dstStart + i, line, buffer);
+            }
+
+            m_spansBuffer = buffer;
+            m_spansStart = dstStart;
+        }
+
+        return m_spans.data();
+    }
+
     int findAntialiasedDstStart(int src_l, qreal support, int line) {
         qreal dst = srcToDst(src_l, line);
         return !m_clampToEdge ? qRound(dst - support) : qRound(dst);
@@ -334,6 +367,12 @@ private:
     qreal m_shear;
     qreal m_dx;
     bool m_clampToEdge;
+
+    std::vector<quint8> m_srcLineBuf;
+
+    std::vector<BlendSpan> m_spans;
+    KisFilterWeightsBuffer *m_spansBuffer {nullptr};
+    int m_spansStart {0};
 };
 
 #endif /* __KIS_FILTER_WEIGHTS_APPLICATOR_H */
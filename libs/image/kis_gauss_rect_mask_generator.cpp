@@ -102,7 +102,7 @@ quint8 KisGaussRectangleMaskGenerator::valueAt(qreal x, qreal y) const
 
 bool KisGaussRectangleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return !isEmpty();
 }
 
 KisBrushMaskApplicatorBase *KisGaussRectangleMaskGenerator::applicator() const
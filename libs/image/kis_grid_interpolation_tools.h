@@ -11,8 +11,11 @@
 #include <algorithm>
 
 #include <QImage>
+#include <QVector>
 
 #include "kis_algebra_2d.h"
+#include "kis_assert.h"
+#include "krita_utils.h"
 #include "kis_four_point_interpolator_forward.h"
 #include "kis_four_point_interpolator_backward.h"
 #include "kis_iterator_ng.h"
@@ -172,7 +175,21 @@ struct PaintDevicePolygonOp
     }
 
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon) {
-        QRect boundRect = clipDstPolygon.boundingRect().toAlignedRect();
+        processPolygon(srcPolygon, dstPolygon, clipDstPolygon,
+                       clipDstPolygon.boundingRect().toAlignedRect());
+    }
+
+    /**
+     * Same as above, but touches only the pixels inside \p dstClipRect,
+     * so that several threads could render different parts of the
+     * destination device at the same time
+     */
+    void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon, const QRect &dstClipRect) {
+        processPolygon(srcPolygon, dstPolygon, clipDstPolygon,
+                       clipDstPolygon.boundingRect().toAlignedRect() & dstClipRect);
+    }
+
+    void processPolygon(const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon, const QRect &boundRect) {
         if (boundRect.isEmpty()) return;
 
         KisSequentialIterator dstIt(m_dstDev, boundRect);
@@ -234,6 +251,94 @@ struct PaintDevicePolygonOp
     KisPaintDeviceSP m_dstDev;
 };
 
+/**
+ * A polygon op that renders the polygons of the grid in several threads.
+ *
+ * The polygons are collected into a band and the band is rendered
+ * patch-by-patch with KritaUtils::processPatchesInParallel(), so the
+ * number of threads follows KisImageConfig::maxNumberOfThreads().
+ * Every patch of the destination device is rendered by a single
+ * thread, which passes all the polygons overlapping the patch to a
+ * copy of \p PolygonOp in the order they have been generated.
+ * Therefore the overlapping polygons of a folded grid are painted in
+ * the same order as in the single-threaded case and the result is
+ * exactly the same.
+ *
+ * The band is flushed when it grows too big and when finish() is called,
+ * which must happen before the destination device is used.
+ *
+ * \p PolygonOp must be copyable and accept a destination clip rect as
+ * the fourth argument, like PaintDevicePolygonOp does.
+ */
+template <class PolygonOp>
+struct ParallelPolygonOp
+{
+    ParallelPolygonOp(const PolygonOp &polygonOp,
+                      int maxBandSize = 4096,
+                      const QSize &patchSize = QSize(128, 128))
+        : m_polygonOp(polygonOp),
+          m_maxBandSize(maxBandSize),
+          m_patchSize(patchSize)
+    {
+        m_band.reserve(m_maxBandSize);
+    }
+
+    ~ParallelPolygonOp() {
+        KIS_SAFE_ASSERT_RECOVER_NOOP(m_band.isEmpty() && "finish() has not been called");
+    }
+
+    void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon) {
+        this->operator() (srcPolygon, dstPolygon, dstPolygon);
+    }
+
+    void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon) {
+        const QRect bounds = clipDstPolygon.boundingRect().toAlignedRect();
+        if (bounds.isEmpty()) return;
+
+        m_band.append({srcPolygon, dstPolygon, clipDstPolygon, bounds});
+        m_bandBounds |= bounds;
+
+        if (m_band.size() >= m_maxBandSize) {
+            finish();
+        }
+    }
+
+    void finish() {
+        if (m_band.isEmpty()) return;
+
+        const QVector<QRect> patches =
+            KritaUtils::splitRectIntoPatches(m_bandBounds, m_patchSize);
+
+        KritaUtils::processPatchesInParallel(patches,
+            [this] (const QRect &patch) {
+                PolygonOp polygonOp(m_polygonOp);
+
+                for (auto it = m_band.constBegin(); it != m_band.constEnd(); ++it) {
+                    if (!it->bounds.intersects(patch)) continue;
+                    polygonOp(it->srcPolygon, it->dstPolygon, it->clipDstPolygon, patch);
+                }
+            });
+
+        m_band.clear();
+        m_bandBounds = QRect();
+    }
+
+private:
+    struct Polygon {
+        QPolygonF srcPolygon;
+        QPolygonF dstPolygon;
+        QPolygonF clipDstPolygon;
+        QRect bounds;
+    };
+
+    PolygonOp m_polygonOp;
+    const int m_maxBandSize;
+    const QSize m_patchSize;
+
+    QVector<Polygon> m_band;
+    QRect m_bandBounds;
+};
+
 struct QImagePolygonOp
 {
     QImagePolygonOp(const QImage &srcImage, QImage &dstImage,
@@ -72,6 +72,9 @@ struct KisImageAnimationInterface::Private
     QAtomicInt backgroundFrameGenerationBlocked;
     QMutex frameGenerationLock;
 
+    QAtomicInt projectionTime {-1};
+    QAtomicInt externalProjectionTime {-1};
+
     inline int currentTime() const {
         return m_currentTime;
     }
@@ -334,6 +337,9 @@ void KisImageAnimationInterface::saveAndResetCurrentTime(int frameId, int *saved
 {
     m_d->externalFrameActive = true;
     *savedValue = m_d->currentTime();
+
+    // the external projection is going to be changed by someone else
+    m_d->externalProjectionTime = -1;
     m_d->setCurrentTime(frameId);
 }
 
@@ -427,12 +433,14 @@ void KisImageAnimationInterface::notifyNodeChanged(const KisNode *node,
 void KisImageAnimationInterface::invalidateFrames(const KisTimeSpan &range, const QRect &rect)
 {
     m_d->cachedLastFrameValue = -1;
+    m_d->externalProjectionTime = -1;
     emit sigFramesChanged(range, rect);
 }
 
 void KisImageAnimationInterface::invalidateFrame(const int time, KisNodeSP target)
 {
     m_d->cachedLastFrameValue = -1;
+    m_d->externalProjectionTime = -1;
 
     emit sigFramesChanged(KisLayerUtils::fetchLayerActiveRasterFrameSpan(target, time), m_d->image->bounds());
 
@@ -447,6 +455,26 @@ void KisImageAnimationInterface::blockFrameInvalidation(bool value)
     m_d->frameInvalidationBlocked = value;
 }
 
+int KisImageAnimationInterface::projectionTime() const
+{
+    return m_d->projectionTime;
+}
+
+void KisImageAnimationInterface::setProjectionTime(int time)
+{
+    m_d->projectionTime = time;
+}
+
+int KisImageAnimationInterface::externalProjectionTime() const
+{
+    return m_d->externalProjectionTime;
+}
+
+void KisImageAnimationInterface::setExternalProjectionTime(int time)
+{
+    m_d->externalProjectionTime = time;
+}
+
 int findLastKeyframeTimeRecursive(KisNodeSP node)
 {
     int time = 0;
@@ -263,6 +263,7 @@ private:
     friend class KisAnimationFrameCacheTest;
     friend struct KisLayerUtils::SwitchFrameCommand;
     friend class KisImageTest;
+    friend class KisImageAnimationInterfaceTest;
     void saveAndResetCurrentTime(int frameId, int *savedValue);
     void restoreCurrentTime(int *savedValue);
     void notifyFrameReady();
@@ -274,6 +275,17 @@ private:
 
     void blockFrameInvalidation(bool value);
 
+    /**
+     * The frame the projections of the image were last rendered for, or -1
+     * if they don't represent any single frame (e.g. the rendering has been
+     * cancelled). The main projection and the projection of the external
+     * frames are tracked separately.
+     */
+    int projectionTime() const;
+    void setProjectionTime(int time);
+    int externalProjectionTime() const;
+    void setExternalProjectionTime(int time);
+
     friend class KisSwitchTimeStrokeStrategy;
     friend class TransformStrokeStrategy;
     void explicitlySetCurrentTime(int frameId);
@@ -609,6 +609,16 @@ void KisImageConfig::setUseOnDiskAnimationCacheSwapping(bool value)
     m_config.writeEntry("useOnDiskAnimationCacheSwapping", value);
 }
 
+bool KisImageConfig::useCompressedInMemoryAnimationCache(bool defaultValue) const
+{
+    return defaultValue ? false : m_config.readEntry("useCompressedInMemoryAnimationCache", false);
+}
+
+void KisImageConfig::setUseCompressedInMemoryAnimationCache(bool value)
+{
+    m_config.writeEntry("useCompressedInMemoryAnimationCache", value);
+}
+
 QString KisImageConfig::animationCacheDir(bool defaultValue) const
 {
     return safelyGetWritableTempLocation("animation_cache", "animationCacheDir", defaultValue);
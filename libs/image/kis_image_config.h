@@ -117,6 +117,9 @@ public:
     bool useOnDiskAnimationCacheSwapping(bool defaultValue = false) const;
     void setUseOnDiskAnimationCacheSwapping(bool value);
 
+    bool useCompressedInMemoryAnimationCache(bool defaultValue = false) const;
+    void setUseCompressedInMemoryAnimationCache(bool value);
+
     QString animationCacheDir(bool defaultValue = false) const;
     void setAnimationCacheDir(const QString &value);
 
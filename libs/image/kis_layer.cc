@@ -908,6 +908,11 @@ QImage KisLayer::createThumbnail(qint32 w, qint32 h, Qt::AspectRatioMode aspectR
                                            KoColorConversionTransformation::internalConversionFlags()) : QImage();
 }
 
+KisPaintDeviceSP KisLayer::thumbnailSourceDevice() const
+{
+    return original();
+}
+
 int KisLayer::thumbnailSeqNo() const
 {
     KisPaintDeviceSP originalDevice = original();
@@ -238,6 +238,8 @@ public:
 
     int thumbnailSeqNo() const override;
 
+    KisPaintDeviceSP thumbnailSourceDevice() const override;
+
     QImage createThumbnailForFrame(qint32 w, qint32 h, int time, Qt::AspectRatioMode aspectRatioMode = Qt::IgnoreAspectRatio) override;
 
     /**
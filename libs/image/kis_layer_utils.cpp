@@ -15,6 +15,7 @@
 #include "kis_painter.h"
 #include "kis_image.h"
 #include "kis_node.h"
+#include "kis_node_graph_listener.h"
 #include "kis_layer.h"
 #include "kis_paint_layer.h"
 #include "kis_clone_layer.h"
@@ -2040,14 +2041,72 @@ namespace Private {
         return 0;
     }
 
+    /**
+     * Filters out the indexed nodes which don't belong to the subtree
+     * of \p root, the listener may be shared by several graphs
+     */
+    KisNodeList filterIndexedNodesInSubtree(KisNodeSP root, const KisNodeList &nodes)
+    {
+        KisNodeList result;
+
+        Q_FOREACH (KisNodeSP node, nodes) {
+            KisNodeSP ancestor = node;
+            while (ancestor && ancestor != root) {
+                ancestor = ancestor->parent();
+            }
+
+            if (ancestor) {
+                result << node;
+            }
+        }
+
+        return result;
+    }
+
     KisNodeSP findNodeByUuid(KisNodeSP root, const QUuid &uuid)
     {
+        KisNodeGraphListener *listener = root->graphListener();
+
+        if (listener) {
+            const KisNodeList nodes =
+                filterIndexedNodesInSubtree(root, listener->indexedNodesByUuid(uuid));
+
+            /**
+             * If several nodes have the same uuid, the walk below
+             * decides which of them comes first in the graph
+             */
+            if (nodes.size() <= 1) {
+                return !nodes.isEmpty() ? nodes.first() : KisNodeSP();
+            }
+        }
+
         return recursiveFindNode(root,
             [uuid] (KisNodeSP node) {
                 return node->uuid() == uuid;
         });
     }
 
+    KisNodeSP findNodeByClass(KisNodeSP root, std::function<bool(KisNodeSP)> isOfClass)
+    {
+        KisNodeGraphListener *listener = root->graphListener();
+
+        if (listener) {
+            KisNodeList nodes;
+
+            Q_FOREACH (const KisNodeList &sameClassNodes, listener->indexedNodesByClass()) {
+                if (isOfClass(sameClassNodes.first())) {
+                    nodes += filterIndexedNodesInSubtree(root, sameClassNodes);
+                }
+            }
+
+            if (nodes.size() <= 1) {
+                return !nodes.isEmpty() ? nodes.first() : KisNodeSP();
+            }
+        }
+
+        return recursiveFindNode(root, isOfClass);
+    }
+
     QList<KisNodeSP> findNodesByName(KisNodeSP root, const QString &name, bool recursive, bool partialMatch)
     {
         KisNodeList nodeList;
@@ -2417,4 +2476,72 @@ namespace Private {
         return uniqueFrameTimes;
     }
 
+
+    bool nodeChangedBetweenFrames(const KisNode *node, int timeA, int timeB)
+    {
+        // onion skins are composited relative to the current time
+        if (node->nodeProperties().boolProperty("onionskin", false)) {
+            return true;
+        }
+
+        Q_FOREACH (KisKeyframeChannel *channel, node->keyframeChannels()) {
+            KisRasterKeyframeChannel *rasterChannel = dynamic_cast<KisRasterKeyframeChannel*>(channel);
+
+            if (rasterChannel) {
+                KisRasterKeyframeSP keyA = rasterChannel->activeKeyframeAt<KisRasterKeyframe>(timeA);
+                KisRasterKeyframeSP keyB = rasterChannel->activeKeyframeAt<KisRasterKeyframe>(timeB);
+
+                const int frameA = keyA ? keyA->frameID() : -1;
+                const int frameB = keyB ? keyB->frameID() : -1;
+
+                if (frameA != frameB) {
+                    return true;
+                }
+            } else if (!channel->identicalFrames(timeA).contains(timeB)) {
+                return true;
+            }
+        }
+
+        const KisCloneLayer *cloneLayer = dynamic_cast<const KisCloneLayer*>(node);
+        if (cloneLayer && cloneLayer->copyFrom()) {
+            KisNodeSP source = cloneLayer->copyFrom();
+            return bool(recursiveFindNode(source, [timeA, timeB] (KisNodeSP node) {
+                return nodeChangedBetweenFrames(node.data(), timeA, timeB);
+            }));
+        }
+
+        return false;
+    }
+
+    void findNodesChangedBetweenFramesImpl(KisNodeSP node, int timeA, int timeB, KisNodeList *result)
+    {
+        if (!node->visible()) return;
+
+        if (nodeChangedBetweenFrames(node.data(), timeA, timeB)) {
+            KisNodeSP changedNode = node;
+
+            if (node->inherits("KisMask") && node->parent()) {
+                changedNode = node->parent();
+            }
+
+            if (!result->contains(changedNode)) {
+                result->append(changedNode);
+            }
+            return;
+        }
+
+        for (KisNodeSP child = node->firstChild(); child; child = child->nextSibling()) {
+            findNodesChangedBetweenFramesImpl(child, timeA, timeB, result);
+        }
+    }
+
+    KisNodeList findNodesChangedBetweenFrames(KisNodeSP root, int timeA, int timeB)
+    {
+        KisNodeList result;
+        if (timeA == timeB) return result;
+
+        findNodesChangedBetweenFramesImpl(root, timeA, timeB, &result);
+        return result;
+    }
+
 }
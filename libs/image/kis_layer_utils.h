@@ -226,10 +226,21 @@ namespace KisLayerUtils
     KRITAIMAGE_EXPORT KisNodeSP recursiveFindNode(KisNodeSP node, std::function<bool(KisNodeSP)> func);
 
     /**
-     * Recursively searches for a node with specified Uuid
+     * Recursively searches for a node with specified Uuid. If \p root
+     * is connected to a graph listener, the listener's index is used
+     * instead of walking the graph.
      */
     KRITAIMAGE_EXPORT KisNodeSP findNodeByUuid(KisNodeSP root, const QUuid &uuid);
 
+    /**
+     * Searches for a node in \p root and all its children, for which
+     * \p isOfClass returns true. The result of \p isOfClass should
+     * depend on the class of the node only. If \p root is connected to
+     * a graph listener, \p isOfClass is called once per class of the
+     * indexed nodes instead of once per node.
+     */
+    KRITAIMAGE_EXPORT KisNodeSP findNodeByClass(KisNodeSP root, std::function<bool(KisNodeSP)> isOfClass);
+
     KRITAIMAGE_EXPORT QList<KisNodeSP> findNodesByName(KisNodeSP root, const QString &name, bool recursive, bool partialMatch);
 
     KRITAIMAGE_EXPORT KisNodeSP findNodeByName(KisNodeSP root, const QString &name);
@@ -238,7 +249,7 @@ namespace KisLayerUtils
 
     template <class T>
     T* findNodeByType(KisNodeSP root) {
-        return dynamic_cast<T*>(recursiveFindNode(root, [] (KisNodeSP node) {
+        return dynamic_cast<T*>(findNodeByClass(root, [] (KisNodeSP node) {
             return bool(dynamic_cast<T*>(node.data()));
         }).data());
     }
@@ -253,6 +264,18 @@ namespace KisLayerUtils
 
     /* Returns a set of times associated with every unique frame from a selection. */
     KRITAIMAGE_EXPORT QSet<int> fetchUniqueFrameTimes(KisNodeSP node, QSet<int> selectedTimes, bool filterActiveFrameID);
+
+    /**
+     * Returns the topmost visible nodes under \p root whose content at \p timeA
+     * differs from their content at \p timeB. Keyframes shared by the two times
+     * (including instanced raster frames) are considered identical. The children
+     * of a returned node are not listed separately, and a changed mask is
+     * represented by its parent layer.
+     *
+     * Refreshing the returned subtrees is enough to convert a projection
+     * rendered for \p timeA into a projection for \p timeB.
+     */
+    KRITAIMAGE_EXPORT KisNodeList findNodesChangedBetweenFrames(KisNodeSP root, int timeA, int timeB);
 }
 
 #endif /* __KIS_LAYER_UTILS_H */
@@ -398,11 +398,13 @@ void KisLiquifyTransformWorker::run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP
     using namespace GridIterationTools;
 
     PaintDevicePolygonOp polygonOp(srcDevice, dstDevice);
+    ParallelPolygonOp<PaintDevicePolygonOp> parallelOp(polygonOp);
     RegularGridIndexesOp indexesOp(m_d->gridSize);
-    iterateThroughGrid<AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
+    iterateThroughGrid<AlwaysCompletePolygonPolicy>(parallelOp, indexesOp,
                                                     m_d->gridSize,
                                                     m_d->originalPoints,
                                                     m_d->transformedPoints);
+    parallelOp.finish();
 }
 
 QRect KisLiquifyTransformWorker::approxChangeRect(const QRect &rc)
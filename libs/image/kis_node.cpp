@@ -287,7 +287,17 @@ KisNodeGraphListener *KisNode::graphListener() const
 
 void KisNode::setGraphListener(KisNodeGraphListener *graphListener)
 {
-    m_d->graphListener = graphListener;
+    if (m_d->graphListener != graphListener) {
+        if (m_d->graphListener) {
+            m_d->graphListener->unregisterNode(this);
+        }
+
+        m_d->graphListener = graphListener;
+
+        if (m_d->graphListener) {
+            m_d->graphListener->registerNode(this);
+        }
+    }
 
     QReadLocker l(&m_d->nodeSubgraphLock);
     KisSafeReadNodeList::const_iterator iter;
@@ -8,7 +8,14 @@
 #include "kis_node_graph_listener.h"
 
 #include "kis_time_span.h"
+#include "kis_node.h"
+#include <QHash>
+#include <QMultiHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRect>
+#include <QSet>
+#include <QUuid>
 #include <QtGlobal>
 
 
@@ -16,6 +23,22 @@ struct Q_DECL_HIDDEN KisNodeGraphListener::Private
 {
     Private() : sequenceNumber(0) {}
     int sequenceNumber;
+
+    /**
+     * The index of the connected nodes. The nodes are stored as raw
+     * pointers, because the graph holds them alive while they are
+     * connected to the listener. The nodes may be connected and
+     * disconnected from the stroke threads, hence the lock.
+     */
+    struct IndexEntry {
+        QUuid uuid;
+        const QMetaObject *metaObject;
+    };
+
+    mutable QMutex indexLock;
+    QHash<KisNode*, IndexEntry> indexedNodes;
+    QMultiHash<QUuid, KisNode*> nodesByUuid;
+    QHash<const QMetaObject*, QSet<KisNode*>> nodesByClass;
 };
 
 KisNodeGraphListener::KisNodeGraphListener()
@@ -72,8 +95,20 @@ void KisNodeGraphListener::keyframeChannelAboutToBeRemoved(KisNode */*node*/, Ki
 
 }
 
-void KisNodeGraphListener::nodeChanged(KisNode * /*node*/)
+void KisNodeGraphListener::nodeChanged(KisNode *node)
 {
+    /**
+     * The uuid of a connected node may be changed when loading
+     * a document, so keep the index in sync
+     */
+    QMutexLocker l(&m_d->indexLock);
+
+    auto it = m_d->indexedNodes.find(node);
+    if (it == m_d->indexedNodes.end() || it->uuid == node->uuid()) return;
+
+    m_d->nodesByUuid.remove(it->uuid, node);
+    it->uuid = node->uuid();
+    m_d->nodesByUuid.insert(it->uuid, node);
 }
 
 void KisNodeGraphListener::nodeCollapsedChanged(KisNode * /*node*/)
@@ -107,3 +142,64 @@ KisNode *KisNodeGraphListener::graphOverlayNode() const
 {
     return 0;
 }
+
+KisNodeList KisNodeGraphListener::indexedNodesByUuid(const QUuid &uuid) const
+{
+    QMutexLocker l(&m_d->indexLock);
+
+    KisNodeList result;
+    for (auto it = m_d->nodesByUuid.find(uuid); it != m_d->nodesByUuid.end() && it.key() == uuid; ++it) {
+        result << KisNodeSP(it.value());
+    }
+    return result;
+}
+
+QList<KisNodeList> KisNodeGraphListener::indexedNodesByClass() const
+{
+    QMutexLocker l(&m_d->indexLock);
+
+    QList<KisNodeList> result;
+    for (auto it = m_d->nodesByClass.constBegin(); it != m_d->nodesByClass.constEnd(); ++it) {
+        KisNodeList nodes;
+        Q_FOREACH (KisNode *node, it.value()) {
+            nodes << KisNodeSP(node);
+        }
+        result << nodes;
+    }
+    return result;
+}
+
+void KisNodeGraphListener::registerNode(KisNode *node)
+{
+    QMutexLocker l(&m_d->indexLock);
+
+    if (m_d->indexedNodes.contains(node)) return;
+
+    Private::IndexEntry entry;
+    entry.uuid = node->uuid();
+    entry.metaObject = node->metaObject();
+
+    m_d->indexedNodes.insert(node, entry);
+    m_d->nodesByUuid.insert(entry.uuid, node);
+    m_d->nodesByClass[entry.metaObject].insert(node);
+}
+
+void KisNodeGraphListener::unregisterNode(KisNode *node)
+{
+    QMutexLocker l(&m_d->indexLock);
+
+    auto it = m_d->indexedNodes.find(node);
+    if (it == m_d->indexedNodes.end()) return;
+
+    const Private::IndexEntry entry = *it;
+    m_d->indexedNodes.erase(it);
+    m_d->nodesByUuid.remove(entry.uuid, node);
+
+    auto classIt = m_d->nodesByClass.find(entry.metaObject);
+    if (classIt != m_d->nodesByClass.end()) {
+        classIt->remove(node);
+        if (classIt->isEmpty()) {
+            m_d->nodesByClass.erase(classIt);
+        }
+    }
+}
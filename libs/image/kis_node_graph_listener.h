@@ -10,6 +10,9 @@
 
 #include <QScopedPointer>
 
+#include "kis_types.h"
+
+class QUuid;
 class KisTimeSpan;
 class KisNode;
 class QRect;
@@ -114,6 +117,33 @@ public:
      virtual void keyframeChannelHasBeenAdded(KisNode *node, KisKeyframeChannel *channel);
      virtual void keyframeChannelAboutToBeRemoved(KisNode *node, KisKeyframeChannel *channel);
 
+    /**
+     * Returns the nodes connected to the listener that have \p uuid.
+     * Usually there is at most one such node.
+     *
+     * The listener keeps an index of all the nodes connected to it,
+     * which is updated when the nodes are connected or disconnected,
+     * so the lookup doesn't need to walk the graph.
+     * KisLayerUtils::findNodeByUuid() uses the index automatically.
+     */
+    KisNodeList indexedNodesByUuid(const QUuid &uuid) const;
+
+    /**
+     * Returns the nodes connected to the listener grouped by their
+     * actual class (the most derived one)
+     */
+    QList<KisNodeList> indexedNodesByClass() const;
+
+private:
+    friend class KisNode;
+
+    /**
+     * Called by the node when it is connected to or disconnected
+     * from the listener
+     */
+    void registerNode(KisNode *node);
+    void unregisterNode(KisNode *node);
+
 private:
     struct Private;
     QScopedPointer<Private> m_d;
@@ -9,6 +9,7 @@
 #include <QReadWriteLock>
 #include <QReadLocker>
 #include <QWriteLocker>
+#include <QHash>
 
 
 #include "kis_paint_device.h"
@@ -17,13 +18,36 @@
 #include "kis_time_span.h"
 #include "kis_image.h"
 #include "KoColorSpace.h"
+#include "KoCompositeOpRegistry.h"
+#include "kis_painter.h"
+#include "kis_paint_device_frames_interface.h"
 
 #include "kis_raster_keyframe_channel.h"
 
 
+namespace {
+
+/**
+ * A frame of the layer with the onion skin tint applied. The tinted
+ * frames are kept while they stay in the onion skin range, so moving
+ * to the next frame re-tints only the frames that entered the range.
+ */
+struct TintedFrame
+{
+    KisPaintDeviceSP device;
+    QRect bounds;
+    int frameSequenceNumber = -1;
+    int configSeqNo = -1;
+};
+
+typedef QPair<int, bool> TintedFrameKey; // frameId, isForward
+
+}
+
 struct KisOnionSkinCache::Private
 {
     KisPaintDeviceSP cachedProjection;
+    QHash<TintedFrameKey, TintedFrame> tintedFrames;
 
     int cacheTime = 0;
     int cacheConfigSeqNo = 0;
@@ -52,8 +76,61 @@ struct KisOnionSkinCache::Private
         cacheConfigSeqNo = seqNo;
         framesHash = hash;
     }
+
+    void compositeSkins(KisPaintDeviceSP source, KisPaintDeviceSP target, KisOnionSkinCompositor *compositor);
 };
 
+void KisOnionSkinCache::Private::compositeSkins(KisPaintDeviceSP source, KisPaintDeviceSP target, KisOnionSkinCompositor *compositor)
+{
+    KisRasterKeyframeChannel *channel = source->keyframeChannel();
+    const QVector<KisOnionSkinCompositor::SkinFrame> skins = compositor->visibleSkins(source);
+    const int configSeqNo = compositor->configSeqNo();
+
+    QHash<TintedFrameKey, TintedFrame> usedFrames;
+
+    /**
+     * The target device is empty, so compositing the skins "over" from
+     * the farthest to the nearest one gives the same result as
+     * compositing them "behind" in the opposite order, but the "over"
+     * op is much better optimized.
+     */
+    KisPainter gc(target);
+    gc.setCompositeOpId(source->colorSpace()->compositeOp(COMPOSITE_OVER));
+
+    for (auto it = skins.crbegin(); it != skins.crend(); ++it) {
+        const int frameId = it->keyframe->frameID();
+        const bool isForward = it->offset > 0;
+        const TintedFrameKey key(frameId, isForward);
+
+        const QRect bounds = channel->frameExtents(it->keyframe);
+        const int frameSequenceNumber = source->framesInterface()->frameSequenceNumber(frameId);
+
+        TintedFrame frame = usedFrames.value(key, tintedFrames.value(key));
+
+        if (!frame.device ||
+            frame.bounds != bounds ||
+            frame.frameSequenceNumber != frameSequenceNumber ||
+            frame.configSeqNo != configSeqNo ||
+            *frame.device->colorSpace() != *source->colorSpace()) {
+
+            frame.device = new KisPaintDevice(source->colorSpace());
+            frame.bounds = bounds;
+            frame.frameSequenceNumber = frameSequenceNumber;
+            frame.configSeqNo = configSeqNo;
+
+            compositor->tintFrame(source, it->keyframe, isForward, frame.device, bounds);
+        }
+
+        usedFrames.insert(key, frame);
+
+        gc.setOpacity(it->opacity);
+        gc.bitBlt(bounds.topLeft(), frame.device, bounds);
+    }
+
+    // the frames that left the onion skin range are dropped
+    tintedFrames = usedFrames;
+}
+
 KisOnionSkinCache::KisOnionSkinCache()
     : m_d(new Private)
 {
@@ -94,7 +171,7 @@ KisPaintDeviceSP KisOnionSkinCache::projection(KisPaintDeviceSP source)
             }
 
             const QRect extent = compositor->calculateExtent(source);
-            compositor->composite(source, cachedProjection, extent);
+            m_d->compositeSkins(source, cachedProjection, compositor);
 
             cachedProjection->setDefaultBounds(source->defaultBounds());
 
@@ -122,9 +199,16 @@ void KisOnionSkinCache::reset()
 {
     QWriteLocker writeLocker(&m_d->lock);
     m_d->cachedProjection = 0;
+    m_d->tintedFrames.clear();
 }
 
 KisPaintDeviceSP KisOnionSkinCache::lodCapableDevice() const
 {
     return m_d->cachedProjection;
 }
+
+KisPaintDeviceSP KisOnionSkinCache::testingTintedFrame(int frameId, bool isForward) const
+{
+    QReadLocker readLocker(&m_d->lock);
+    return m_d->tintedFrames.value(TintedFrameKey(frameId, isForward)).device;
+}
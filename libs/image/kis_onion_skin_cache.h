@@ -9,9 +9,10 @@
 
 #include <QScopedPointer>
 #include "kis_types.h"
+#include "kritaimage_export.h"
 
 
-class KisOnionSkinCache
+class KRITAIMAGE_EXPORT KisOnionSkinCache
 {
 public:
     KisOnionSkinCache();
@@ -22,6 +23,12 @@ public:
 
     KisPaintDeviceSP lodCapableDevice() const;
 
+    /**
+     * Returns the tinted copy of the frame \p frameId kept by the
+     * cache, or null if the frame is not a visible skin
+     */
+    KisPaintDeviceSP testingTintedFrame(int frameId, bool isForward) const;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -60,18 +60,6 @@ struct KisOnionSkinCompositor::Private
         return channel->keyframeAt<KisRasterKeyframe>(outFrame);
     }
 
-    void tryCompositeFrame(KisRasterKeyframeSP keyframe, KisPainter &gcFrame, KisPainter &gcDest, KisPaintDeviceSP tintSource, int opacity, const QRect &rect)
-    {
-        if (keyframe.isNull() || opacity == OPACITY_TRANSPARENT_U8) return;
-
-        keyframe->writeFrameToDevice(gcFrame.device());
-
-        gcFrame.bitBlt(rect.topLeft(), tintSource, rect);
-
-        gcDest.setOpacity(opacity);
-        gcDest.bitBlt(rect.topLeft(), gcFrame.device(), rect);
-    }
-
     void refreshConfig()
     {
         KisImageConfig config(true);
@@ -135,44 +123,71 @@ QSet<int> KisOnionSkinCompositor::colorLabelFilter()
 
 void KisOnionSkinCompositor::composite(const KisPaintDeviceSP sourceDevice, KisPaintDeviceSP targetDevice, const QRect& rect)
 {
-    KisRasterKeyframeChannel *keyframes = sourceDevice->keyframeChannel();
+    const QVector<SkinFrame> skins = visibleSkins(sourceDevice);
+    if (skins.isEmpty()) return;
 
     KisPaintDeviceSP frameDevice = new KisPaintDevice(sourceDevice->colorSpace());
-    KisPainter gcFrame(frameDevice);
-    QBitArray channelFlags = sourceDevice->colorSpace()->channelFlags(true, false);
-    gcFrame.setChannelFlags(channelFlags);
-    gcFrame.setOpacity(m_d->tintFactor);
-
-    KisPaintDeviceSP backwardTintDevice = m_d->setUpTintDevice(m_d->backwardTintColor, sourceDevice->colorSpace());
-    KisPaintDeviceSP forwardTintDevice = m_d->setUpTintDevice(m_d->forwardTintColor, sourceDevice->colorSpace());
 
     KisPainter gcDest(targetDevice);
     gcDest.setCompositeOpId(sourceDevice->colorSpace()->compositeOp(COMPOSITE_BEHIND));
 
-    int keyframeTimeBck;
-    int keyframeTimeFwd;
+    Q_FOREACH (const SkinFrame &skin, skins) {
+        tintFrame(sourceDevice, skin.keyframe, skin.offset > 0, frameDevice, rect);
 
-    int time = sourceDevice->defaultBounds()->currentTime();
+        gcDest.setOpacity(skin.opacity);
+        gcDest.bitBlt(rect.topLeft(), frameDevice, rect);
+    }
+}
+
+QVector<KisOnionSkinCompositor::SkinFrame> KisOnionSkinCompositor::visibleSkins(const KisPaintDeviceSP sourceDevice)
+{
+    QVector<SkinFrame> skins;
+
+    KisRasterKeyframeChannel *keyframes = sourceDevice->keyframeChannel();
 
     if (!keyframes) { // it happens when you try to show onion skins on non-animated layer with opacity keyframes
-        return;
+        return skins;
     }
 
+    const int time = sourceDevice->defaultBounds()->currentTime();
+
+    int keyframeTimeBck;
+    int keyframeTimeFwd;
+
     keyframeTimeBck = keyframeTimeFwd = keyframes->activeKeyframeTime(time);
 
-    for (int offset = 1; offset <= m_d->numberOfSkins; offset++) {
-        KisRasterKeyframeSP backKeyframe = m_d->getNextFrameToComposite(keyframes, keyframeTimeBck, true);
-        KisRasterKeyframeSP forwardKeyframe = m_d->getNextFrameToComposite(keyframes, keyframeTimeFwd, false);
+    auto addSkin = [&skins, this] (KisRasterKeyframeSP keyframe, int offset) {
+        const int opacity = m_d->skinOpacity(offset);
+        if (keyframe.isNull() || opacity == OPACITY_TRANSPARENT_U8) return;
 
-        if (!backKeyframe.isNull()) {
-            m_d->tryCompositeFrame(backKeyframe, gcFrame, gcDest, backwardTintDevice, m_d->skinOpacity(-offset), rect);
-        }
+        SkinFrame skin;
+        skin.keyframe = keyframe;
+        skin.offset = offset;
+        skin.opacity = opacity;
+        skins.append(skin);
+    };
 
-        if (!forwardKeyframe.isNull()) {
-            m_d->tryCompositeFrame(forwardKeyframe, gcFrame, gcDest, forwardTintDevice, m_d->skinOpacity(offset), rect);
-        }
+    for (int offset = 1; offset <= m_d->numberOfSkins; offset++) {
+        addSkin(m_d->getNextFrameToComposite(keyframes, keyframeTimeBck, true), -offset);
+        addSkin(m_d->getNextFrameToComposite(keyframes, keyframeTimeFwd, false), offset);
     }
 
+    return skins;
+}
+
+void KisOnionSkinCompositor::tintFrame(const KisPaintDeviceSP sourceDevice, KisRasterKeyframeSP keyframe, bool forward, KisPaintDeviceSP targetDevice, const QRect &rect)
+{
+    const KoColorSpace *colorSpace = sourceDevice->colorSpace();
+
+    KisPaintDeviceSP tintDevice =
+        m_d->setUpTintDevice(forward ? m_d->forwardTintColor : m_d->backwardTintColor, colorSpace);
+
+    keyframe->writeFrameToDevice(targetDevice);
+
+    KisPainter gcFrame(targetDevice);
+    gcFrame.setChannelFlags(colorSpace->channelFlags(true, false));
+    gcFrame.setOpacity(m_d->tintFactor);
+    gcFrame.bitBlt(rect.topLeft(), tintDevice, rect);
 }
 
 QRect KisOnionSkinCompositor::calculateFullExtent(const KisPaintDeviceSP device)
@@ -7,6 +7,8 @@
 #ifndef KIS_ONION_SKIN_COMPOSITOR_H
 #define KIS_ONION_SKIN_COMPOSITOR_H
 
+#include <QVector>
+
 #include "kis_types.h"
 #include "kritaimage_export.h"
 
@@ -19,8 +21,29 @@ public:
     ~KisOnionSkinCompositor() override;
     static KisOnionSkinCompositor *instance();
 
+    struct SkinFrame {
+        KisRasterKeyframeSP keyframe;
+
+        /// distance from the current frame, negative for the backward skins
+        int offset = 0;
+        int opacity = 0;
+    };
+
     void composite(const KisPaintDeviceSP sourceDevice, KisPaintDeviceSP targetDevice, const QRect &rect);
 
+    /**
+     * @return the skins visible at the current time of \p sourceDevice,
+     * ordered from the nearest to the farthest one. The skins with zero
+     * opacity are skipped.
+     */
+    QVector<SkinFrame> visibleSkins(const KisPaintDeviceSP sourceDevice);
+
+    /**
+     * Writes the content of \p keyframe into \p targetDevice and tints
+     * the area \p rect with the forward or backward tint color
+     */
+    void tintFrame(const KisPaintDeviceSP sourceDevice, KisRasterKeyframeSP keyframe, bool forward, KisPaintDeviceSP targetDevice, const QRect &rect);
+
     QRect calculateFullExtent(const KisPaintDeviceSP device);
     QRect calculateExtent(const KisPaintDeviceSP device, int time);
     QRect calculateExtent(const KisPaintDeviceSP device);
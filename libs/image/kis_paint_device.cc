@@ -225,6 +225,12 @@ public:
         return data->cache()->invalidate();
     }
 
+    int frameSequenceNumber(int frameId) const
+    {
+        DataSP data = m_frames.value(frameId);
+        return data ? data->cache()->sequenceNumber() : -1;
+    }
+
 private:
     typedef KisPaintDeviceData Data;
     typedef QSharedPointer<Data> DataSP;
@@ -2312,6 +2318,13 @@ void KisPaintDeviceFramesInterface::invalidateFrameCache(int frameId)
     return q->m_d->invalidateFrameCache(frameId);
 }
 
+int KisPaintDeviceFramesInterface::frameSequenceNumber(int frameId) const
+{
+    KIS_ASSERT_RECOVER_RETURN_VALUE(frameId >= 0, -1);
+
+    return q->m_d->frameSequenceNumber(frameId);
+}
+
 void KisPaintDeviceFramesInterface::setFrameOffset(int frameId, const QPoint &offset)
 {
     KIS_ASSERT_RECOVER_RETURN(frameId >= 0);
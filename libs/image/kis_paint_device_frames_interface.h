@@ -117,6 +117,14 @@ public:
      */
     void invalidateFrameCache(int frameId);
 
+    /**
+     * Returns the sequence number of the cache object of the frame.
+     * The number changes every time the content of the frame changes,
+     * so it can be used for validation of the per-frame caches.
+     * Returns -1 if there is no frame with \p frameId.
+     */
+    int frameSequenceNumber(int frameId) const;
+
     /**
      * Sets the offset for \p frameId.
      * Should be used by Undo framework only!
@@ -12,6 +12,8 @@
 #include "kis_perspectivetransform_worker.h"
 
 #include <QMatrix4x4>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QTransform>
 #include <QVector3D>
 #include <QPolygonF>
@@ -167,26 +169,41 @@ void KisPerspectiveTransformWorker::runImpl()
 
     KIS_ASSERT_RECOVER_NOOP(!m_isIdentity);
 
-    KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, m_dstRegion.rectCount());
+    /**
+     * The destination is split into patches that are rendered in
+     * parallel, in at most KisImageConfig::maxNumberOfThreads()
+     * threads. The patches don't overlap and every thread has its own
+     * accessors, so the threads never write the same pixel.
+     */
+    QVector<QRect> patches;
+    Q_FOREACH (const QRect &rect, m_dstRegion.rects()) {
+        patches += KritaUtils::splitRectIntoPatches(rect, QSize(256, 256));
+    }
 
-    SrcAccessorWrapper srcAcc(cloneDevice);
-    KisRandomAccessorSP accessor = m_dev->createRandomAccessorNG();
+    KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, patches.size());
+    QMutex progressMutex;
 
-    Q_FOREACH (const QRect &rect, m_dstRegion.rects()) {
-        for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
-            for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
+    KritaUtils::processPatchesInParallel(patches,
+        [&] (const QRect &rect) {
+            SrcAccessorWrapper srcAcc(cloneDevice);
+            KisRandomAccessorSP accessor = m_dev->createRandomAccessorNG();
 
-                QPointF dstPoint(x, y);
-                QPointF srcPoint = m_backwardTransform.map(dstPoint);
+            for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
+                for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
 
-                if (m_srcRect.contains(srcPoint)) {
-                    accessor->moveTo(dstPoint.x(), dstPoint.y());
-                    srcAcc.samplePixel(srcPoint, accessor->rawData());
+                    QPointF dstPoint(x, y);
+                    QPointF srcPoint = m_backwardTransform.map(dstPoint);
+
+                    if (m_srcRect.contains(srcPoint)) {
+                        accessor->moveTo(dstPoint.x(), dstPoint.y());
+                        srcAcc.samplePixel(srcPoint, accessor->rawData());
+                    }
                 }
             }
-        }
-        progressHelper.step();
-    }
+
+            QMutexLocker l(&progressMutex);
+            progressHelper.step();
+        });
 }
 
 void KisPerspectiveTransformWorker::run(SampleType sampleType)
@@ -213,25 +230,34 @@ void KisPerspectiveTransformWorker::runPartialDst(KisPaintDeviceSP srcDev,
         gc.setCompositeOpId(COMPOSITE_COPY);
         gc.bitBlt(dstRect.topLeft(), srcDev, m_backwardTransform.mapRect(dstRect));
     } else {
-        KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, dstRect.height());
+        const QVector<QRect> patches =
+            KritaUtils::splitRectIntoPatches(dstRect, QSize(256, 256));
+
+        KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, patches.size());
+        QMutex progressMutex;
 
-        KisRandomSubAccessorSP srcAcc = srcDev->createRandomSubAccessor();
-        KisRandomAccessorSP accessor = dstDev->createRandomAccessorNG();
+        KritaUtils::processPatchesInParallel(patches,
+            [&] (const QRect &rect) {
+                KisRandomSubAccessorSP srcAcc = srcDev->createRandomSubAccessor();
+                KisRandomAccessorSP accessor = dstDev->createRandomAccessorNG();
 
-        for (int y = dstRect.y(); y < dstRect.y() + dstRect.height(); ++y) {
-            for (int x = dstRect.x(); x < dstRect.x() + dstRect.width(); ++x) {
+                for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
+                    for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
 
-                QPointF dstPoint(x, y);
-                QPointF srcPoint = m_backwardTransform.map(dstPoint);
+                        QPointF dstPoint(x, y);
+                        QPointF srcPoint = m_backwardTransform.map(dstPoint);
 
-                if (srcClipRect.contains(srcPoint) || srcDev->defaultBounds()->wrapAroundMode()) {
-                    accessor->moveTo(dstPoint.x(), dstPoint.y());
-                    srcAcc->moveTo(srcPoint.x(), srcPoint.y());
-                    srcAcc->sampledOldRawData(accessor->rawData());
+                        if (srcClipRect.contains(srcPoint) || srcDev->defaultBounds()->wrapAroundMode()) {
+                            accessor->moveTo(dstPoint.x(), dstPoint.y());
+                            srcAcc->moveTo(srcPoint.x(), srcPoint.y());
+                            srcAcc->sampledOldRawData(accessor->rawData());
+                        }
+                    }
                 }
-            }
-            progressHelper.step();
-        }
+
+                QMutexLocker l(&progressMutex);
+                progressHelper.step();
+            });
     }
 }
 
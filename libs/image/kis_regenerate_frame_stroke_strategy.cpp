@@ -11,6 +11,7 @@
 #include "kis_image_animation_interface.h"
 #include "kis_node.h"
 #include "kis_image.h"
+#include "kis_layer_utils.h"
 #include "krita_utils.h"
 
 #include "kis_full_refresh_walker.h"
@@ -28,12 +29,15 @@ struct KisRegenerateFrameStrokeStrategy::Private
     KisImageAnimationInterface *interface;
     QStack<KisProjectionUpdatesFilterSP> prevUpdatesFilters;
     std::optional<KisLockFrameGenerationLock> frameGenerationLock;
+    KisNodeList refreshRoots;
+    bool isLodClone = false;
+    bool wasSuspended = false;
 
     class Data : public KisStrokeJobData {
     public:
-        Data(KisNodeSP _root, const QRect &_rect, const QRect &_cropRect)
+        Data(const QRect &_rect, const QRect &_cropRect)
             : KisStrokeJobData(CONCURRENT),
-              root(_root), rect(_rect), cropRect(_cropRect)
+              rect(_rect), cropRect(_cropRect)
             {}
 
         KisStrokeJobData* createLodClone(int levelOfDetail) override {
@@ -41,11 +45,24 @@ struct KisRegenerateFrameStrokeStrategy::Private
             return new KisStrokeJobData(CONCURRENT);
         }
 
-        KisNodeSP root;
         QRect rect;
         QRect cropRect;
     };
 
+    /**
+     * Returns the subtrees that should be refreshed to convert the projection
+     * rendered for \p baseTime into the projection for \p time. The nodes
+     * that are the same in both frames keep their cached projections.
+     */
+    KisNodeList calculateRefreshRoots(KisNodeSP root, int baseTime, int time) {
+        if (baseTime < 0) {
+            return {root};
+        }
+
+        KisNodeList nodes = KisLayerUtils::findNodesChangedBetweenFrames(root, baseTime, time);
+        return nodes.contains(root) ? KisNodeList({root}) : nodes;
+    }
+
     void saveAndResetUpdatesFilter() {
         KisImageSP image = interface->image().toStrongRef();
         if (!image) {
@@ -132,12 +149,26 @@ void KisRegenerateFrameStrokeStrategy::initStrokeCallback()
         return;
     }
     if (m_d->type == EXTERNAL_FRAME) {
+        m_d->refreshRoots = m_d->calculateRefreshRoots(image->root(),
+                                                       m_d->interface->externalProjectionTime(),
+                                                       m_d->frameId);
         m_d->saveAndResetUpdatesFilter();
         image->disableUIUpdates();
         m_d->interface->saveAndResetCurrentTime(m_d->frameId, &m_d->previousFrameId);
     } else if (m_d->type == CURRENT_FRAME) {
         m_d->interface->blockFrameInvalidation(true);
-        m_d->interface->updatesFacade()->refreshGraphAsync(KisNodeSP());
+
+        /**
+         * LodN planes are not tracked by the projection time, so
+         * they are always regenerated in full
+         */
+        const int baseTime = m_d->isLodClone ? -1 : m_d->interface->projectionTime();
+        m_d->refreshRoots = m_d->calculateRefreshRoots(image->root(), baseTime,
+                                                       m_d->interface->currentTime());
+
+        Q_FOREACH (KisNodeSP node, m_d->refreshRoots) {
+            m_d->interface->updatesFacade()->refreshGraphAsync(node);
+        }
     }
 }
 
@@ -149,12 +180,15 @@ void KisRegenerateFrameStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
     KIS_ASSERT(m_d->type == EXTERNAL_FRAME);
 
     const bool skipNonRenderableNodes = m_d->type == EXTERNAL_FRAME;
-    KisBaseRectsWalkerSP walker = new KisFullRefreshWalker(d->cropRect,
-                                                           skipNonRenderableNodes ? KisFullRefreshWalker::SkipNonRenderableNodes : KisFullRefreshWalker::None);
-    walker->collectRects(d->root, d->rect);
 
-    KisAsyncMerger merger;
-    merger.startMerge(*walker);
+    Q_FOREACH (KisNodeSP root, m_d->refreshRoots) {
+        KisBaseRectsWalkerSP walker = new KisFullRefreshWalker(d->cropRect,
+                                                               skipNonRenderableNodes ? KisFullRefreshWalker::SkipNonRenderableNodes : KisFullRefreshWalker::None);
+        walker->collectRects(root, d->rect);
+
+        KisAsyncMerger merger;
+        merger.startMerge(*walker);
+    }
 }
 
 void KisRegenerateFrameStrokeStrategy::finishStrokeCallback()
@@ -168,9 +202,19 @@ void KisRegenerateFrameStrokeStrategy::finishStrokeCallback()
     if (m_d->type == EXTERNAL_FRAME) {
         m_d->interface->notifyFrameReady();
         m_d->interface->restoreCurrentTime(&m_d->previousFrameId);
+
+        // the image might have changed while the stroke was suspended
+        if (!m_d->wasSuspended) {
+            m_d->interface->setExternalProjectionTime(m_d->frameId);
+        }
+
         image->enableUIUpdates();
         m_d->restoreUpdatesFilter();
     } else if (m_d->type == CURRENT_FRAME) {
+        if (!m_d->isLodClone) {
+            m_d->interface->setProjectionTime(m_d->interface->currentTime());
+        }
+
         m_d->interface->notifyFrameRegenerated();
         m_d->interface->blockFrameInvalidation(false);
     }
@@ -185,9 +229,13 @@ void KisRegenerateFrameStrokeStrategy::cancelStrokeCallback()
     if (m_d->type == EXTERNAL_FRAME) {
         m_d->interface->notifyFrameCancelled();
         m_d->interface->restoreCurrentTime(&m_d->previousFrameId);
+        m_d->interface->setExternalProjectionTime(-1);
         image->enableUIUpdates();
         m_d->restoreUpdatesFilter();
     } else if (m_d->type == CURRENT_FRAME) {
+        if (!m_d->isLodClone) {
+            m_d->interface->setProjectionTime(-1);
+        }
         m_d->interface->blockFrameInvalidation(false);
     }
 }
@@ -200,9 +248,13 @@ KisStrokeStrategy* KisRegenerateFrameStrokeStrategy::createLodClone(int levelOfD
      * We need to regenerate animation frames on LodN level only if
      * we are processing current frame. Return dummy stroke otherwise
      */
-    return m_d->type == CURRENT_FRAME ?
-        new KisRegenerateFrameStrokeStrategy(m_d->interface) :
-        new KisSimpleStrokeStrategy(QLatin1String("dumb-lodn-KisRegenerateFrameStrokeStrategy"));
+    if (m_d->type == CURRENT_FRAME) {
+        KisRegenerateFrameStrokeStrategy *clone = new KisRegenerateFrameStrokeStrategy(m_d->interface);
+        clone->m_d->isLodClone = true;
+        return clone;
+    }
+
+    return new KisSimpleStrokeStrategy(QLatin1String("dumb-lodn-KisRegenerateFrameStrokeStrategy"));
 }
 
 void KisRegenerateFrameStrokeStrategy::suspendStrokeCallback()
@@ -212,6 +264,7 @@ void KisRegenerateFrameStrokeStrategy::suspendStrokeCallback()
         return;
     }
     if (m_d->type == EXTERNAL_FRAME) {
+        m_d->wasSuspended = true;
         m_d->interface->restoreCurrentTime(&m_d->previousFrameId);
         image->enableUIUpdates();
         m_d->restoreUpdatesFilter();
@@ -246,7 +299,7 @@ QList<KisStrokeJobData*> KisRegenerateFrameStrokeStrategy::createJobsData(KisIma
     QList<KisStrokeJobData*> jobsData;
 
     Q_FOREACH (const QRect &rc, rects) {
-        jobsData << new Private::Data(image->root(), rc, cropRect);
+        jobsData << new Private::Data(rc, cropRect);
     }
 
     return jobsData;
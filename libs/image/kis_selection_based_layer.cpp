@@ -374,6 +374,14 @@ QImage KisSelectionBasedLayer::createThumbnail(qint32 w, qint32 h, Qt::AspectRat
            QImage();
 }
 
+KisPaintDeviceSP KisSelectionBasedLayer::thumbnailSourceDevice() const
+{
+    KisSelectionSP originalSelection = internalSelection();
+    KisPaintDeviceSP originalDevice = original();
+
+    return originalDevice && originalSelection ? originalDevice : KisPaintDeviceSP();
+}
+
 int KisSelectionBasedLayer::thumbnailSeqNo() const
 {
     KisSelectionSP originalSelection = internalSelection();
@@ -154,6 +154,8 @@ public:
 
     int thumbnailSeqNo() const override;
 
+    KisPaintDeviceSP thumbnailSourceDevice() const override;
+
 
 protected:
     // override from KisLayer
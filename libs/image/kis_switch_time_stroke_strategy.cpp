@@ -9,6 +9,8 @@
 #include <QMutex>
 
 #include "kis_image_animation_interface.h"
+#include "kis_image.h"
+#include "kis_layer_utils.h"
 #include "kis_post_execution_undo_adapter.h"
 #include "commands_new/kis_switch_current_time_command.h"
 
@@ -54,6 +56,18 @@ void KisSwitchTimeStrokeStrategy::initStrokeCallback()
     if (frameId == m_d->interface->currentTime()) return;
 
     const int oldTime = m_d->interface->currentTime();
+
+    /**
+     * When all the nodes look the same in both frames, no regeneration
+     * is needed and the projection becomes valid for the new frame as well
+     */
+    KisImageSP image = m_d->interface->image().toStrongRef();
+    if (image && m_d->interface->projectionTime() == oldTime &&
+        KisLayerUtils::findNodesChangedBetweenFrames(image->root(), oldTime, frameId).isEmpty()) {
+
+        m_d->interface->setProjectionTime(frameId);
+    }
+
     m_d->interface->explicitlySetCurrentTime(frameId);
 
     if (m_d->undoAdapter) {
@@ -17,6 +17,7 @@
 
 #include "kis_queues_progress_updater.h"
 #include "KisImageConfigNotifier.h"
+#include "KisInputLatencyTracker.h"
 
 #include <QReadWriteLock>
 #include "kis_lazy_wait_condition.h"
@@ -471,6 +472,7 @@ bool KisUpdateScheduler::haveUpdatesRunning()
 void KisUpdateScheduler::continueUpdate(const QRect &rect)
 {
     Q_ASSERT(m_d->projectionUpdateListener);
+    KisInputLatencyTracker::instance()->notifyProjectionMerged();
     m_d->projectionUpdateListener->notifyProjectionUpdated(rect);
 }
 
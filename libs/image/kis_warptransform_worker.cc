@@ -246,8 +246,10 @@ void KisWarpTransformWorker::run(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDe
 
     FunctionTransformOp functionOp(m_warpMathFunction, m_origPoint, m_transfPoint, m_alpha);
     GridIterationTools::PaintDevicePolygonOp polygonOp(srcDev, dstDev);
-    GridIterationTools::processGrid(polygonOp, functionOp,
+    GridIterationTools::ParallelPolygonOp<GridIterationTools::PaintDevicePolygonOp> parallelOp(polygonOp);
+    GridIterationTools::processGrid(parallelOp, functionOp,
                                     srcBounds, pixelPrecision);
+    parallelOp.finish();
 }
 
 #include "krita_utils.h"
@@ -14,6 +14,10 @@
 #include <QPolygonF>
 #include <QPen>
 #include <QPainter>
+#include <QAtomicInt>
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include "kis_algebra_2d.h"
 
@@ -29,6 +33,8 @@
 #include <KisRenderedDab.h>
 
 
+Q_GLOBAL_STATIC(QThreadPool, s_patchesThreadPool)
+
 namespace KritaUtils
 {
 
@@ -412,6 +418,35 @@ namespace KritaUtils
         }
     }
 
+    void processPatchesInParallel(const QVector<QRect> &patches, std::function<void(const QRect&)> func)
+    {
+        const int maxThreads = qMax(1, KisImageConfig(true).maxNumberOfThreads());
+        const int numHelperThreads = qMin(maxThreads, patches.size()) - 1;
+
+        QAtomicInt nextPatch(0);
+
+        auto processPatches = [&] () {
+            int i;
+            while ((i = nextPatch.fetchAndAddOrdered(1)) < patches.size()) {
+                func(patches[i]);
+            }
+        };
+
+        QThreadPool *pool = s_patchesThreadPool;
+        pool->setMaxThreadCount(qMax(1, maxThreads - 1));
+
+        QVector<QFuture<void>> helpers;
+        for (int i = 0; i < numHelperThreads; i++) {
+            helpers << QtConcurrent::run(pool, processPatches);
+        }
+
+        processPatches();
+
+        Q_FOREACH (QFuture<void> helper, helpers) {
+            helper.waitForFinished();
+        }
+    }
+
     qreal estimatePortionOfTransparentPixels(KisPaintDeviceSP dev, const QRect &rect, qreal samplePortion) {
         const KoColorSpace *cs = dev->colorSpace();
 
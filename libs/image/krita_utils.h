@@ -88,6 +88,18 @@ namespace KritaUtils
 
     qreal KRITAIMAGE_EXPORT estimatePortionOfTransparentPixels(KisPaintDeviceSP dev, const QRect &rect, qreal samplePortion);
 
+    /**
+     * Calls \p func for every rect of \p patches in several threads and
+     * waits until all of them are processed. The calling thread processes
+     * the patches as well, so the total number of threads is limited by
+     * KisImageConfig::maxNumberOfThreads(), like the one of the updater
+     * context.
+     *
+     * It is meant for the workers that are run synchronously inside a
+     * stroke job, so their work cannot be split into separate stroke jobs.
+     */
+    void KRITAIMAGE_EXPORT processPatchesInParallel(const QVector<QRect> &patches, std::function<void(const QRect&)> func);
+
     void KRITAIMAGE_EXPORT mirrorDab(Qt::Orientation dir, const QPoint &center, KisRenderedDab *dab, bool skipMirrorPixels = false);
     void KRITAIMAGE_EXPORT mirrorDab(Qt::Orientation dir, const QPointF &center, KisRenderedDab *dab, bool skipMirrorPixels = false);
 
@@ -0,0 +1,65 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisIncrementalThumbnailTest.h"
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "KisIncrementalThumbnail.h"
+#include "kis_paint_device.h"
+
+void KisIncrementalThumbnailTest::testChangedTiles()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    dev->fill(QRect(0, 0, 2048, 1024), KoColor(Qt::blue, cs));
+
+    KisIncrementalThumbnail generator;
+
+    QImage thumb = generator.thumbnail(dev, 64);
+    QCOMPARE(thumb.size(), QSize(64, 32));
+    QCOMPARE(generator.numUpdatedTiles(), 32 * 16);
+
+    // nothing has changed
+    thumb = generator.thumbnail(dev, 64);
+    QCOMPARE(generator.numUpdatedTiles(), 0);
+
+    // the change touches a single tile
+    dev->fill(QRect(100, 100, 20, 20), KoColor(Qt::red, cs));
+
+    thumb = generator.thumbnail(dev, 64);
+    QCOMPARE(generator.numUpdatedTiles(), 1);
+
+    KisIncrementalThumbnail freshGenerator;
+    QCOMPARE(thumb, freshGenerator.thumbnail(dev, 64));
+
+    // the offset of the device invalidates the shadow
+    dev->moveTo(QPoint(10, 10));
+
+    thumb = generator.thumbnail(dev, 64);
+    QCOMPARE(generator.numUpdatedTiles(), 32 * 16);
+}
+
+void KisIncrementalThumbnailTest::testSmallDevice()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    dev->fill(QRect(0, 0, 100, 50), KoColor(Qt::blue, cs));
+
+    KisIncrementalThumbnail generator;
+
+    // too small to be downsampled, the thumbnail is created directly
+    QImage thumb = generator.thumbnail(dev, 64);
+    QCOMPARE(thumb, dev->createThumbnail(64, 64, Qt::KeepAspectRatio, 1,
+                                         KoColorConversionTransformation::internalRenderingIntent(),
+                                         KoColorConversionTransformation::internalConversionFlags()));
+    QCOMPARE(generator.numUpdatedTiles(), 0);
+}
+
+SIMPLE_TEST_MAIN(KisIncrementalThumbnailTest)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISINCREMENTALTHUMBNAILTEST_H
+#define KISINCREMENTALTHUMBNAILTEST_H
+
+#include <simpletest.h>
+
+class KisIncrementalThumbnailTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testChangedTiles();
+    void testSmallDevice();
+};
+
+#endif // KISINCREMENTALTHUMBNAILTEST_H
@@ -0,0 +1,183 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisInputLatencyTrackerTest.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "KisInputLatencyTracker.h"
+#include "brushengine/kis_paint_information.h"
+
+namespace {
+const qint64 msInNs = 1000000;
+}
+
+void KisInputLatencyTrackerTest::testHistogram()
+{
+    KisInputLatencyTracker::Histogram h;
+
+    QCOMPARE(h.count, qint64(0));
+    QCOMPARE(h.percentileMs(50), 0.0);
+
+    for (int i = 1; i <= 100; i++) {
+        h.addSample(i * msInNs);
+    }
+
+    QCOMPARE(h.count, qint64(100));
+    QCOMPARE(h.meanMs(), 50.5);
+    QCOMPARE(h.minMs(), 1.0);
+    QCOMPARE(h.maxMs(), 100.0);
+
+    // the percentiles are rounded up to the bucket boundary
+    QVERIFY(h.percentileMs(50) >= 50.0);
+    QVERIFY(h.percentileMs(50) <= 50.5);
+    QVERIFY(h.percentileMs(99) >= 99.0);
+    QCOMPARE(h.percentileMs(100), 100.0);
+
+    // the samples longer than the histogram go into the last bucket
+    h.addSample(1000 * msInNs);
+    QCOMPARE(h.buckets.last(), qint64(1));
+    QCOMPARE(h.percentileMs(100), 1000.0);
+}
+
+void KisInputLatencyTrackerTest::testPipeline()
+{
+    KisInputLatencyTracker tracker;
+    tracker.setEnabled(true);
+
+    const qint64 inputTimestamp = KisInputLatencyTracker::now() - 5 * msInNs;
+
+    // nothing is pending, so the later stages are not measured
+    tracker.notifyProjectionMerged();
+    tracker.notifyFramePresented();
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::ProjectionMerged).count, qint64(0));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::EndToEnd).count, qint64(0));
+
+    tracker.notifyDabPainted(inputTimestamp - msInNs);
+    tracker.notifyDabPainted(inputTimestamp);
+    tracker.notifyProjectionMerged();
+    tracker.notifyTexturesUpdated();
+    tracker.notifyFramePresented();
+
+    // one more frame without new input must not produce a sample
+    tracker.notifyFramePresented();
+
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::DabPainted).count, qint64(2));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::ProjectionMerged).count, qint64(1));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::TexturesUpdated).count, qint64(1));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::FramePresented).count, qint64(1));
+
+    const KisInputLatencyTracker::Histogram endToEnd =
+        tracker.histogram(KisInputLatencyTracker::EndToEnd);
+
+    QCOMPARE(endToEnd.count, qint64(1));
+
+    // the newest event is the one measured
+    QVERIFY(endToEnd.minNs >= 5 * msInNs);
+    QVERIFY(endToEnd.minNs < 6 * msInNs);
+
+    tracker.reset();
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::DabPainted).count, qint64(0));
+}
+
+void KisInputLatencyTrackerTest::testTransformPipeline()
+{
+    KisInputLatencyTracker tracker;
+    tracker.setEnabled(true);
+
+    const qint64 now = KisInputLatencyTracker::now();
+
+    tracker.notifyTransformPreviewRendered(now - 40 * msInNs);
+    tracker.notifyProjectionMerged();
+    tracker.notifyTexturesUpdated();
+    tracker.notifyFramePresented();
+
+    // the transform drags are not mixed with the dabs
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::TransformPreviewRendered).count, qint64(1));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::TransformEndToEnd).count, qint64(1));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::DabPainted).count, qint64(0));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::EndToEnd).count, qint64(0));
+
+    // the intermediate stages are shared
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::ProjectionMerged).count, qint64(1));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::FramePresented).count, qint64(1));
+
+    QVERIFY(tracker.histogram(KisInputLatencyTracker::TransformEndToEnd).minNs >= 40 * msInNs);
+
+    // the newest event decides which end-to-end stage gets the sample
+    tracker.notifyTransformPreviewRendered(now - 20 * msInNs);
+    tracker.notifyDabPainted(now - 10 * msInNs);
+    tracker.notifyProjectionMerged();
+    tracker.notifyTexturesUpdated();
+    tracker.notifyFramePresented();
+
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::TransformPreviewRendered).count, qint64(2));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::DabPainted).count, qint64(1));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::TransformEndToEnd).count, qint64(1));
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::EndToEnd).count, qint64(1));
+}
+
+void KisInputLatencyTrackerTest::testDisabled()
+{
+    KisInputLatencyTracker tracker;
+    tracker.setEnabled(false);
+
+    tracker.notifyDabPainted(KisInputLatencyTracker::now());
+    tracker.notifyTransformPreviewRendered(KisInputLatencyTracker::now());
+    tracker.notifyProjectionMerged();
+    tracker.notifyTexturesUpdated();
+    tracker.notifyFramePresented();
+
+    for (int i = 0; i < KisInputLatencyTracker::NumStages; i++) {
+        QCOMPARE(tracker.histogram(static_cast<KisInputLatencyTracker::Stage>(i)).count, qint64(0));
+    }
+
+    // the infos without input events are ignored as well
+    tracker.setEnabled(true);
+    tracker.notifyDabPainted(0);
+    QCOMPARE(tracker.histogram(KisInputLatencyTracker::DabPainted).count, qint64(0));
+}
+
+void KisInputLatencyTrackerTest::testPaintInformationTimestamp()
+{
+    KisPaintInformation pi1(QPointF(0, 0), 1.0);
+    KisPaintInformation pi2(QPointF(10, 0), 1.0);
+
+    QCOMPARE(pi1.inputTimestamp(), qint64(0));
+
+    pi1.setInputTimestamp(100);
+    pi2.setInputTimestamp(200);
+
+    KisPaintInformation copy(pi1);
+    QCOMPARE(copy.inputTimestamp(), qint64(100));
+
+    const KisPaintInformation mixed = KisPaintInformation::mix(0.5, pi1, pi2);
+    QCOMPARE(mixed.inputTimestamp(), qint64(200));
+
+    const KisPaintInformation mixedPosition = KisPaintInformation::mixOnlyPosition(0.5, pi2, pi1);
+    QCOMPARE(mixedPosition.inputTimestamp(), qint64(200));
+}
+
+void KisInputLatencyTrackerTest::testJson()
+{
+    KisInputLatencyTracker tracker;
+    tracker.setEnabled(true);
+
+    tracker.notifyDabPainted(KisInputLatencyTracker::now() - msInNs);
+
+    const QJsonObject json = tracker.toJson();
+    const QJsonObject stages = json["stages"].toObject();
+
+    QCOMPARE(stages.size(), int(KisInputLatencyTracker::NumStages));
+
+    const QJsonObject dab = stages[KisInputLatencyTracker::stageName(KisInputLatencyTracker::DabPainted)].toObject();
+    QCOMPARE(dab["count"].toInt(), 1);
+    QCOMPARE(dab["buckets"].toArray().size(), KisInputLatencyTracker::Histogram::numBuckets);
+    QVERIFY(dab["meanMs"].toDouble() >= 1.0);
+}
+
+SIMPLE_TEST_MAIN(KisInputLatencyTrackerTest)
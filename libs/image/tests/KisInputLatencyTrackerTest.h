@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISINPUTLATENCYTRACKERTEST_H
+#define KISINPUTLATENCYTRACKERTEST_H
+
+#include <simpletest.h>
+
+class KisInputLatencyTrackerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testHistogram();
+    void testPipeline();
+    void testTransformPipeline();
+    void testDisabled();
+    void testPaintInformationTimestamp();
+    void testJson();
+};
+
+#endif // KISINPUTLATENCYTRACKERTEST_H
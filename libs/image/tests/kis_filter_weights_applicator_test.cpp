@@ -16,6 +16,7 @@
 #include "kistest.h"
 
 #include <sstream>
+#include <vector>
 
 //#define DEBUG_ENABLED
 #include "kis_filter_weights_applicator.h"
@@ -815,4 +816,141 @@ void KisFilterWeightsApplicatorTest::testProcessSolidLine()
 }
 
 
+/**
+ * The straightforward per-pixel version of processLine(): the span
+ * is recalculated for every dst pixel and the source pixels are
+ * passed to the mixing op as an array of pointers.
+ */
+void referenceProcessPixel(const KisFilterWeightsApplicator &applicator,
+                           KisFilterWeightsBuffer *buffer,
+                           const KoColorSpace *cs,
+                           const quint8 *defaultPixel,
+                           const std::vector<quint8> &srcLine,
+                           KisFilterWeightsApplicator::LinePos srcPos,
+                           bool clampToEdge,
+                           int dstPos, int line,
+                           quint8 *dst)
+{
+    const int pixelSize = cs->pixelSize();
+    const quint8 *leftBorderPixel = clampToEdge ? srcLine.data() : defaultPixel;
+    const quint8 *rightBorderPixel = clampToEdge ? srcLine.data() + (srcPos.size() - 1) * pixelSize : defaultPixel;
+
+    KisFilterWeightsApplicator::BlendSpan span = applicator.calculateBlendSpan(dstPos, line, buffer);
+
+    std::vector<const quint8*> colors(span.weights->span);
+    for (int j = 0; j < span.weights->span; j++) {
+        const int srcIndex = span.firstBlendPixel + j - srcPos.start();
+
+        colors[j] =
+            srcIndex < 0 ? leftBorderPixel :
+            srcIndex >= srcPos.size() ? rightBorderPixel :
+            srcLine.data() + srcIndex * pixelSize;
+    }
+
+    cs->mixColorsOp()->mixColors(colors.data(), span.weights->weight, span.weights->span, dst);
+}
+
+void KisFilterWeightsApplicatorTest::testProcessLinesMatchReference_data()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<QString>("filterId");
+    QTest::addColumn<qreal>("scale");
+    QTest::addColumn<qreal>("shear");
+    QTest::addColumn<bool>("clampToEdge");
+
+    const QStringList depths = {"U8", "U16", "F32"};
+    const QStringList filters = {"Bilinear", "Bicubic", "Lanczos3"};
+
+    Q_FOREACH (const QString &depth, depths) {
+        Q_FOREACH (const QString &filter, filters) {
+            QTest::addRow("%s-%s-down", qPrintable(depth), qPrintable(filter)) << depth << filter << 0.5 << 0.0 << false;
+            QTest::addRow("%s-%s-up-clamped", qPrintable(depth), qPrintable(filter)) << depth << filter << 1.7 << 0.0 << true;
+            QTest::addRow("%s-%s-mirrored", qPrintable(depth), qPrintable(filter)) << depth << filter << -0.8 << 0.0 << false;
+            QTest::addRow("%s-%s-shear", qPrintable(depth), qPrintable(filter)) << depth << filter << 0.873 << 0.35 << false;
+            QTest::addRow("%s-%s-shear-up-clamped", qPrintable(depth), qPrintable(filter)) << depth << filter << 1.3 << -0.2 << true;
+        }
+    }
+}
+
+void KisFilterWeightsApplicatorTest::testProcessLinesMatchReference()
+{
+    /**
+     * The idea of the test:
+     *
+     * The applicator reuses the spans between the lines of a pure scale
+     * and mixes the contiguous pixels of its line buffer. The result
+     * must be bit-identical to calculating the span for every pixel,
+     * including the sheared lines, where the spans cannot be reused.
+     */
+
+    QFETCH(QString, depthId);
+    QFETCH(QString, filterId);
+    QFETCH(qreal, scale);
+    QFETCH(qreal, shear);
+    QFETCH(bool, clampToEdge);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", depthId, "");
+    QVERIFY(cs);
+
+    KisFilterStrategy *filter = KisFilterStrategyRegistry::instance()->value(filterId);
+    QVERIFY(filter);
+
+    const int numLines = 64;
+    const int pixelSize = cs->pixelSize();
+    const qreal dx = 0.37;
+
+    /// the lines have different positions and lengths, so the spans
+    /// of a pure scale have to be recalculated when they change
+    auto lineRect = [] (int line) {
+        return QRect(line % 7 * 3, line, 200 - line % 5 * 11, 1);
+    };
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    for (int line = 0; line < numLines; line++) {
+        const QRect rc = lineRect(line);
+        for (int x = rc.left(); x <= rc.right(); x++) {
+            dev->setPixel(x, line, QColor((x * 7 + line * 13) % 256, (x * 3) % 256,
+                                          (line * 5) % 256, 128 + (x + line) % 128));
+        }
+    }
+
+    KisPaintDeviceSP pristine = new KisPaintDevice(*dev);
+    const KoColor defaultPixel = dev->defaultPixel();
+
+    KisFilterWeightsBuffer buf(filter, qAbs(scale));
+    KisFilterWeightsApplicator applicator(dev, dev, scale, shear, dx, clampToEdge);
+    const qreal support = filter->support(buf.weightsPositionScale().toFloat());
+
+    std::vector<quint8> srcLine;
+    std::vector<quint8> expected(pixelSize);
+    std::vector<quint8> actual(pixelSize);
+
+    for (int line = 0; line < numLines; line++) {
+        const QRect rc = lineRect(line);
+
+        KisFilterWeightsApplicator::LinePos srcPos(rc.left(), rc.width());
+        KisFilterWeightsApplicator::LinePos dstPos =
+            applicator.processLine<KisHLineIteratorSP>(srcPos, line, &buf, support);
+
+        QVERIFY(dstPos.size() > 0);
+
+        srcLine.resize(pixelSize * rc.width());
+        pristine->readBytes(srcLine.data(), rc);
+
+        for (int x = dstPos.start(); x < dstPos.end(); x++) {
+            referenceProcessPixel(applicator, &buf, cs, defaultPixel.data(),
+                                  srcLine, srcPos, clampToEdge,
+                                  x, line, expected.data());
+
+            dev->readBytes(actual.data(), x, line, 1, 1);
+
+            if (memcmp(expected.data(), actual.data(), pixelSize) != 0) {
+                QFAIL(QString("Pixel (%1, %2) differs from the reference").arg(x).arg(line).toLatin1());
+            }
+        }
+    }
+}
+
+
 KISTEST_MAIN(KisFilterWeightsApplicatorTest)
@@ -67,6 +67,9 @@ private Q_SLOTS:
     void benchmarkProcessesLine();
 
     void testProcessSolidLine();
+
+    void testProcessLinesMatchReference_data();
+    void testProcessLinesMatchReference();
 };
 
 #endif /* __KIS_FILTER_WEIGHTS_APPLICATOR_TEST_H */
@@ -21,6 +21,7 @@
 #include "kis_raster_keyframe_channel.h"
 #include "kis_time_span.h"
 #include "KisLockFrameGenerationLock.h"
+#include "kis_layer_utils.h"
 
 
 void checkFrame(KisImageAnimationInterface *i, KisImageSP image, int frameId, bool externalFrameActive, const QRect &rc)
@@ -181,6 +182,62 @@ void KisImageAnimationInterfaceTest::testFramesChangedSignal()
 
 }
 
+void KisImageAnimationInterfaceTest::testChangedNodesBetweenFrames()
+{
+    QRect refRect(QRect(0,0,512,512));
+    TestUtil::MaskParent p(refRect);
+
+    KisPaintLayerSP layer1 = p.layer;
+    KisPaintLayerSP layer2 = new KisPaintLayer(p.image, "paint2", OPACITY_OPAQUE_U8);
+    p.image->addNode(layer2);
+
+    const QRect rc1(101,101,100,100);
+    const QRect rc2(102,102,100,100);
+    const QRect rc3(103,103,100,100);
+
+    KisImageAnimationInterface *i = p.image->animationInterface();
+    KisPaintDeviceSP dev1 = layer1->paintDevice();
+    KisPaintDeviceSP dev2 = layer2->paintDevice();
+
+    layer1->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+    KisRasterKeyframeChannel *channel2 =
+        dynamic_cast<KisRasterKeyframeChannel*>(layer2->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true));
+
+    dev1->fill(rc1, KoColor(Qt::red, dev1->colorSpace()));
+    dev2->fill(rc2, KoColor(Qt::green, dev2->colorSpace()));
+
+    channel2->addKeyframe(10);
+    channel2->cloneKeyframe(0, 20);
+
+    // the background is static, only the second layer changes
+    QVERIFY(KisLayerUtils::findNodesChangedBetweenFrames(p.image->root(), 0, 5).isEmpty());
+    QCOMPARE(KisLayerUtils::findNodesChangedBetweenFrames(p.image->root(), 0, 10), KisNodeList({layer2}));
+    QCOMPARE(KisLayerUtils::findNodesChangedBetweenFrames(p.image->root(), 15, 20), KisNodeList({layer2}));
+
+    // instanced frames are identical
+    QVERIFY(KisLayerUtils::findNodesChangedBetweenFrames(p.image->root(), 0, 20).isEmpty());
+
+    p.image->refreshGraph();
+
+    i->switchCurrentTimeAsync(10);
+    p.image->waitForDone();
+
+    dev2->fill(rc3, KoColor(Qt::green, dev2->colorSpace()));
+    p.image->refreshGraph();
+    QCOMPARE(p.image->projection()->exactBounds(), rc1 | rc3);
+
+    // the projection is regenerated only for the changed layer
+    i->switchCurrentTimeAsync(20);
+    p.image->waitForDone();
+    QCOMPARE(i->projectionTime(), 20);
+    QCOMPARE(p.image->projection()->exactBounds(), rc1 | rc2);
+
+    i->switchCurrentTimeAsync(10);
+    p.image->waitForDone();
+    QCOMPARE(i->projectionTime(), 10);
+    QCOMPARE(p.image->projection()->exactBounds(), rc1 | rc3);
+}
+
 void KisImageAnimationInterfaceTest::testAnimationCompositionBug()
 {
     QRect rect(QRect(0,0,512,512));
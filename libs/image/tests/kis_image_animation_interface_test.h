@@ -19,6 +19,7 @@ class KisImageAnimationInterfaceTest : public QObject
 private Q_SLOTS:
     void testFrameRegeneration();
     void testFramesChangedSignal();
+    void testChangedNodesBetweenFrames();
 
     void testAnimationCompositionBug();
 
@@ -158,9 +158,9 @@ public:
     }
 
     template <typename MaskGenerator>
-    static void runMaskGenTest(MaskGenerator& generator, MaskType type) {
-        QRect bounds(0,0,700,700);
-        generator.setDiameter(499.5);
+    static void runMaskGenTest(MaskGenerator& generator, MaskType type,
+                               qreal diameter = 499.5, QRect bounds = QRect(0,0,700,700)) {
+        generator.setDiameter(diameter);
         MaskGenerator scalarGenerator(generator);
 
         scalarGenerator
@@ -249,4 +249,68 @@ void KisMaskSimilarityTest::testSoftRectMask()
     KisMaskSimilarityTester::runMaskGenTest(generator,RECT_SOFT);
 }
 
+void KisMaskSimilarityTest::testSpikyMasks()
+{
+    const KisCubicCurve pointsCurve(QString("0,1;1,0"));
+
+    {
+        KisCircleMaskGenerator generator(499.5, 0.5, 0.5, 0.5, 5, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,DEFAULT);
+    }
+
+    {
+        KisGaussCircleMaskGenerator generator(499.5, 0.5, 1, 1, 4, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,CIRC_GAUSS);
+    }
+
+    {
+        KisCurveCircleMaskGenerator generator(499.5, 0.5, 0.5, 0.5, 6, pointsCurve, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,CIRC_SOFT);
+    }
+
+    {
+        KisRectangleMaskGenerator generator(499.5, 0.5, 0.5, 0.5, 3, false);
+        KisMaskSimilarityTester::runMaskGenTest(generator,RECT);
+    }
+
+    {
+        KisGaussRectangleMaskGenerator generator(499.5, 0.5, 0.5, 0.2, 3, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,RECT_GAUSS);
+    }
+
+    {
+        KisCurveRectangleMaskGenerator generator(499.5, 0.5, 0.5, 0.2, 5, pointsCurve, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,RECT_SOFT);
+    }
+}
+
+void KisMaskSimilarityTest::testSupersampledMasks()
+{
+    // dabs smaller than 10px are supersampled when antialiasing is on
+    const QRect bounds(0,0,12,12);
+    const qreal diameter = 7.5;
+
+    const KisCubicCurve pointsCurve(QString("0,1;1,0"));
+
+    {
+        KisCircleMaskGenerator generator(diameter, 1.0, 0.5, 0.5, 2, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,DEFAULT, diameter, bounds);
+    }
+
+    {
+        KisCurveCircleMaskGenerator generator(diameter, 1.0, 0.5, 0.5, 2, pointsCurve, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,CIRC_SOFT, diameter, bounds);
+    }
+
+    {
+        KisRectangleMaskGenerator generator(diameter, 1.0, 0.5, 0.5, 2, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,RECT, diameter, bounds);
+    }
+
+    {
+        KisCurveRectangleMaskGenerator generator(diameter, 1.0, 0.5, 0.5, 2, pointsCurve, true);
+        KisMaskSimilarityTester::runMaskGenTest(generator,RECT_SOFT, diameter, bounds);
+    }
+}
+
 SIMPLE_TEST_MAIN(KisMaskSimilarityTest)
@@ -9,6 +9,7 @@
 #include <simpletest.h>
 #include "kis_node_graph_listener.h"
 #include "kis_node_facade.h"
+#include "kis_layer_utils.h"
 #include <testutil.h>
 
 void KisNodeGraphListenerTest::testUpdateOfListener()
@@ -96,4 +97,57 @@ void KisNodeGraphListenerTest::testSequenceNumber()
     QVERIFY(seqno != listener.graphSequenceNumber());
 }
 
+void KisNodeGraphListenerTest::testNodeIndex()
+{
+    KisNodeFacade nodeFacade;
+    TestUtil::TestGraphListener listener;
+
+    KisNodeSP rootNode = new TestNode();
+    KisNodeSP child1 = new TestNode();
+    KisNodeSP child2 = new TestNode();
+    KisNodeSP grandChild = new TestNode();
+
+    nodeFacade.setRoot(rootNode);
+    rootNode->setGraphListener(&listener);
+
+    nodeFacade.addNode(child1, rootNode);
+    nodeFacade.addNode(grandChild, child1);
+
+    QCOMPARE(listener.indexedNodesByUuid(grandChild->uuid()), KisNodeList() << grandChild);
+    QCOMPARE(KisLayerUtils::findNodeByUuid(rootNode, grandChild->uuid()), grandChild);
+    QCOMPARE(KisLayerUtils::findNodeByUuid(child1, child1->uuid()), child1);
+    QCOMPARE(KisLayerUtils::findNodeByUuid(child1, rootNode->uuid()), KisNodeSP());
+
+    // the nodes of a subtree are indexed when the subtree is connected
+    QVERIFY(listener.indexedNodesByUuid(child2->uuid()).isEmpty());
+    nodeFacade.removeNode(child1);
+    nodeFacade.addNode(child1, child2);
+    QVERIFY(listener.indexedNodesByUuid(grandChild->uuid()).isEmpty());
+    QCOMPARE(KisLayerUtils::findNodeByUuid(rootNode, grandChild->uuid()), KisNodeSP());
+
+    nodeFacade.addNode(child2, rootNode);
+    QCOMPARE(KisLayerUtils::findNodeByUuid(rootNode, child2->uuid()), child2);
+    QCOMPARE(KisLayerUtils::findNodeByUuid(rootNode, grandChild->uuid()), grandChild);
+
+    // changing the uuid of a connected node updates the index
+    const QUuid oldUuid = grandChild->uuid();
+    const QUuid newUuid = QUuid::createUuid();
+    grandChild->setUuid(newUuid);
+    QVERIFY(listener.indexedNodesByUuid(oldUuid).isEmpty());
+    QCOMPARE(KisLayerUtils::findNodeByUuid(rootNode, newUuid), grandChild);
+
+    // duplicated uuids are resolved in the graph order
+    child1->setUuid(newUuid);
+    QCOMPARE(listener.indexedNodesByUuid(newUuid).size(), 2);
+    QCOMPARE(KisLayerUtils::findNodeByUuid(rootNode, newUuid), child1);
+
+    QCOMPARE(listener.indexedNodesByClass().size(), 1);
+    QCOMPARE(listener.indexedNodesByClass().first().size(), 4);
+    QCOMPARE(KisLayerUtils::findNodeByType<TestNode>(child1), dynamic_cast<TestNode*>(child1.data()));
+
+    rootNode->setGraphListener(0);
+    QVERIFY(listener.indexedNodesByUuid(child2->uuid()).isEmpty());
+    QVERIFY(listener.indexedNodesByClass().isEmpty());
+}
+
 SIMPLE_TEST_MAIN(KisNodeGraphListenerTest)
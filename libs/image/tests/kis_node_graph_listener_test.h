@@ -30,6 +30,7 @@ private Q_SLOTS:
     void testUpdateOfListener();
     void testRecursiveUpdateOfListener();
     void testSequenceNumber();
+    void testNodeIndex();
 };
 
 #endif
@@ -9,6 +9,8 @@
 #include <simpletest.h>
 
 #include "kis_onion_skin_compositor.h"
+#include "kis_onion_skin_cache.h"
+#include "kis_paint_device_frames_interface.h"
 #include "kis_paint_device.h"
 #include "kis_raster_keyframe_channel.h"
 #include "kis_image_animation_interface.h"
@@ -146,4 +148,126 @@ void KisOnionSkinCompositorTest::testSettings()
     QVERIFY(chk.checkDevice(compositeDevice, p.image, "02_single_skin_tinted"));
 }
 
+void KisOnionSkinCompositorTest::testVisibleSkins()
+{
+    KisImageConfig config(false);
+    config.setNumberOfOnionSkins(2);
+    config.setOnionSkinOpacity(-1, 128);
+    config.setOnionSkinOpacity(-2, 0);
+    config.setOnionSkinOpacity(1, 128);
+    config.setOnionSkinOpacity(2, 64);
+
+    KisOnionSkinCompositor *compositor = KisOnionSkinCompositor::instance();
+    compositor->configChanged();
+
+    TestUtil::MaskParent p;
+    KisImageAnimationInterface *i = p.image->animationInterface();
+    KisPaintDeviceSP paintDevice = p.layer->paintDevice();
+    paintDevice->createKeyframeChannel(KoID());
+    KisRasterKeyframeChannel *keyframes = paintDevice->keyframeChannel();
+
+    keyframes->addKeyframe(0);
+    keyframes->addKeyframe(1);
+    keyframes->addKeyframe(2);
+    keyframes->addKeyframe(3);
+
+    i->switchCurrentTimeAsync(1);
+    p.image->waitForDone();
+
+    const QVector<KisOnionSkinCompositor::SkinFrame> skins = compositor->visibleSkins(paintDevice);
+
+    // the second backward skin is transparent and there is no frame for it anyway
+    QCOMPARE(skins.size(), 3);
+
+    QCOMPARE(skins[0].offset, -1);
+    QCOMPARE(skins[0].keyframe, keyframes->keyframeAt<KisRasterKeyframe>(0));
+
+    QCOMPARE(skins[1].offset, 1);
+    QCOMPARE(skins[1].keyframe, keyframes->keyframeAt<KisRasterKeyframe>(2));
+
+    QCOMPARE(skins[2].offset, 2);
+    QCOMPARE(skins[2].keyframe, keyframes->keyframeAt<KisRasterKeyframe>(3));
+    QVERIFY(skins[2].opacity < skins[1].opacity);
+}
+
+void KisOnionSkinCompositorTest::testCacheReusesTintedFrames()
+{
+    KisImageConfig config(false);
+    config.setOnionSkinTintColorBackward(Qt::blue);
+    config.setOnionSkinTintColorForward(Qt::red);
+    config.setNumberOfOnionSkins(2);
+    config.setOnionSkinOpacity(-1, 128);
+    config.setOnionSkinOpacity(-2, 128);
+    config.setOnionSkinOpacity(1, 128);
+    config.setOnionSkinOpacity(2, 128);
+
+    KisOnionSkinCompositor *compositor = KisOnionSkinCompositor::instance();
+    compositor->configChanged();
+
+    TestUtil::MaskParent p;
+    KisImageAnimationInterface *i = p.image->animationInterface();
+    KisPaintDeviceSP paintDevice = p.layer->paintDevice();
+    paintDevice->createKeyframeChannel(KoID());
+    KisRasterKeyframeChannel *keyframes = paintDevice->keyframeChannel();
+
+    QVector<int> frameIds;
+
+    for (int time = 0; time < 4; time++) {
+        keyframes->addKeyframe(time);
+
+        i->switchCurrentTimeAsync(time);
+        p.image->waitForDone();
+
+        paintDevice->fill(QRect(0, 64 * time, 512, 64), KoColor(Qt::green, paintDevice->colorSpace()));
+        frameIds.append(keyframes->keyframeAt<KisRasterKeyframe>(time)->frameID());
+    }
+
+    KisOnionSkinCache cache;
+
+    // frame 1: the skins are 0 (backward), 2 and 3 (forward)
+    i->switchCurrentTimeAsync(1);
+    p.image->waitForDone();
+    cache.projection(paintDevice);
+
+    KisPaintDeviceSP backward0 = cache.testingTintedFrame(frameIds[0], false);
+    KisPaintDeviceSP forward3 = cache.testingTintedFrame(frameIds[3], true);
+    QVERIFY(backward0);
+    QVERIFY(cache.testingTintedFrame(frameIds[2], true));
+    QVERIFY(forward3);
+
+    // frame 2: the skins are 1 and 0 (backward), 3 (forward); only
+    // frame 1 entered the range, the other two are reused
+    i->switchCurrentTimeAsync(2);
+    p.image->waitForDone();
+    cache.projection(paintDevice);
+
+    QCOMPARE(cache.testingTintedFrame(frameIds[0], false), backward0);
+    QCOMPARE(cache.testingTintedFrame(frameIds[3], true), forward3);
+    QVERIFY(cache.testingTintedFrame(frameIds[1], false));
+    QVERIFY(!cache.testingTintedFrame(frameIds[2], true));
+
+    // the content of frame 0 changes the way undo changes it,
+    // so it is tinted again on the next switch
+    paintDevice->framesInterface()->invalidateFrameCache(frameIds[0]);
+
+    i->switchCurrentTimeAsync(1);
+    p.image->waitForDone();
+    cache.projection(paintDevice);
+
+    QVERIFY(cache.testingTintedFrame(frameIds[0], false));
+    QVERIFY(cache.testingTintedFrame(frameIds[0], false) != backward0);
+    QCOMPARE(cache.testingTintedFrame(frameIds[3], true), forward3);
+
+    // the config change tints all the frames again
+    config.setOnionSkinTintColorForward(Qt::yellow);
+    compositor->configChanged();
+    cache.projection(paintDevice);
+
+    QVERIFY(cache.testingTintedFrame(frameIds[3], true));
+    QVERIFY(cache.testingTintedFrame(frameIds[3], true) != forward3);
+
+    // the frame that doesn't exist has no sequence number
+    QCOMPARE(paintDevice->framesInterface()->frameSequenceNumber(frameIds.last() + 100), -1);
+}
+
 SIMPLE_TEST_MAIN(KisOnionSkinCompositorTest)
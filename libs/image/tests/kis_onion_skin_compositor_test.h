@@ -17,6 +17,8 @@ private Q_SLOTS:
 
     void testComposite();
     void testSettings();
+    void testVisibleSkins();
+    void testCacheReusesTintedFrames();
 };
 
 #endif
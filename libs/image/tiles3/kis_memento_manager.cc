@@ -61,10 +61,20 @@
 
 #define namedTransactionInProgress() ((bool)m_currentMemento)
 
+namespace {
+/// the offset of the tile revisions of the next data manager
+quint64 initialTileRevision()
+{
+    static QAtomicInteger<quint64> s_lastDataManager;
+    return (s_lastDataManager.fetchAndAddRelaxed(1) + 1) << 32;
+}
+}
+
 KisMementoManager::KisMementoManager()
     : m_index(0),
       m_headsHashTable(0),
-      m_registrationBlocked(false)
+      m_registrationBlocked(false),
+      m_tileRevisionCounter(initialTileRevision())
 {
     /**
      * Tile change/delete registration is enabled for all
@@ -78,7 +88,8 @@ KisMementoManager::KisMementoManager(const KisMementoManager& rhs)
         m_cancelledRevisions(rhs.m_cancelledRevisions),
         m_headsHashTable(rhs.m_headsHashTable, 0),
         m_currentMemento(rhs.m_currentMemento),
-        m_registrationBlocked(rhs.m_registrationBlocked)
+        m_registrationBlocked(rhs.m_registrationBlocked),
+        m_tileRevisionCounter(initialTileRevision())
 {
     Q_ASSERT_X(!m_registrationBlocked,
                "KisMementoManager", "(impossible happened) "
@@ -7,6 +7,7 @@
 #ifndef KIS_MEMENTO_MANAGER_
 #define KIS_MEMENTO_MANAGER_
 
+#include <QAtomicInteger>
 #include <QList>
 
 #include "kis_memento_item.h"
@@ -113,6 +114,18 @@ public:
      */
     void purgeHistory(KisMementoSP oldestMemento);
 
+    /**
+     * Returns a new revision for a tile of the data manager, \see
+     * KisTile::revision(). The counter is per data manager (the memento
+     * manager is owned by exactly one), so that the tiles of different
+     * devices being painted at the same time don't contend for it.
+     * Every counter starts at its own offset, so the revisions of
+     * different data managers don't coincide either.
+     */
+    inline quint64 nextTileRevision() {
+        return m_tileRevisionCounter.fetchAndAddRelaxed(1) + 1;
+    }
+
 protected:
     qint32 findRevisionByMemento(KisMementoSP memento) const;
     void resetRevisionHistory(KisMementoItemList list);
@@ -158,6 +171,8 @@ protected:
      * \see rollforward()
      */
     bool m_registrationBlocked;
+
+    QAtomicInteger<quint64> m_tileRevisionCounter;
 };
 
 #endif /* KIS_MEMENTO_MANAGER_ */
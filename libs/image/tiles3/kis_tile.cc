@@ -30,6 +30,19 @@ void KisTile::init(qint32 col, qint32 row,
         mm->registerTileChange(this);
     }
     m_mementoManager.storeRelease(mm);
+    bumpRevision();
+}
+
+void KisTile::bumpRevision()
+{
+    /**
+     * The tiles that are not attached to a data manager are
+     * not visible to anyone, so their revision doesn't matter
+     */
+    KisMementoManager *mm = m_mementoManager.loadAcquire();
+    if (mm) {
+        m_revision.storeRelease(mm->nextTileRevision());
+    }
 }
 
 KisTile::KisTile(qint32 col, qint32 row,
@@ -125,6 +138,7 @@ void KisTile::notifyAttachedToDataManager(KisMementoManager *mm)
                 mm->registerTileChange(this);
             }
             m_mementoManager.storeRelease(mm);
+            bumpRevision();
 
 #ifdef DEAD_TILES_SANITY_CHECK
             m_sanityMMHasBeenInitializedManually.ref();
@@ -262,6 +276,7 @@ void KisTile::lockForWrite()
 
 void KisTile::unlockForWrite()
 {
+    bumpRevision();
     unblockSwapping();
     DEBUG_LOG_ACTION("unlock [W]");
 
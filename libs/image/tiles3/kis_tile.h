@@ -10,6 +10,7 @@
 #include <QReadWriteLock>
 
 #include <QMutex>
+#include <QAtomicInteger>
 #include <QAtomicPointer>
 
 #include <QRect>
@@ -87,6 +88,7 @@ public:
     }
     inline void setData(const quint8 *data) {
         m_tileData->setData(data);
+        bumpRevision();
     }
 
     inline qint32 row() const {
@@ -119,6 +121,19 @@ public:
         return m_tileData;
     }
 
+    /**
+     * The revision changes every time the tile is unlocked after
+     * writing. The revisions are taken from the 64-bit counter of the
+     * data manager (\see KisMementoManager::nextTileRevision()), so a
+     * tile that replaces another one (e.g. on undo) never has the
+     * revision of the replaced tile. It lets the users detect which
+     * tiles of a device have changed since some moment without
+     * comparing the data.
+     */
+    inline quint64 revision() const {
+        return m_revision.loadAcquire();
+    }
+
 private:
     void init(qint32 col, qint32 row,
               KisTileData *defaultTileData, KisMementoManager* mm);
@@ -128,6 +143,8 @@ private:
 
     inline void safeReleaseOldTileData(KisTileData *td);
 
+    void bumpRevision();
+
 private:
     KisTileData *m_tileData;
     mutable QStack<KisTileData*> m_oldTileData;
@@ -136,6 +153,8 @@ private:
     qint32 m_col;
     qint32 m_row;
 
+    QAtomicInteger<quint64> m_revision;
+
     /**
      * Added for faster retrieving by processors
      */
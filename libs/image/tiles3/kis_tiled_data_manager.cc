@@ -675,6 +675,21 @@ KisRegion KisTiledDataManager::region() const
     return KisRegion(std::move(rects));
 }
 
+QVector<KisTiledDataManager::TileRevision> KisTiledDataManager::tileRevisions() const
+{
+    QVector<TileRevision> revisions;
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        revisions.append({tile->col(), tile->row(), tile->revision()});
+        iter.next();
+    }
+
+    return revisions;
+}
+
 void KisTiledDataManager::setPixel(qint32 x, qint32 y, const quint8 * data)
 {
     KisTileDataWrapper tw(this, x, y, KisTileDataWrapper::WRITE);
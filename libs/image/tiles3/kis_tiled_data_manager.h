@@ -216,6 +216,19 @@ public:
 
     KisRegion region() const;
 
+    struct TileRevision {
+        qint32 col;
+        qint32 row;
+        quint64 revision;
+    };
+
+    /**
+     * Returns the revisions of all the existing tiles. Comparing them
+     * with the revisions fetched earlier tells which tiles have been
+     * changed, added or removed in the meantime, \see KisTile::revision()
+     */
+    QVector<TileRevision> tileRevisions() const;
+
     void clear(QRect clearRect, quint8 clearValue);
     void clear(QRect clearRect, const quint8 *clearPixel);
     void clear(qint32 x, qint32 y, qint32 w, qint32 h, quint8 clearValue);
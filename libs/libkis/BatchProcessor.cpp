@@ -0,0 +1,342 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "BatchProcessor.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHash>
+#include <QThread>
+
+#include <KisDocument.h>
+#include <KisMimeDatabase.h>
+#include <KisPart.h>
+#include <KisUsageLogger.h>
+#include <kis_assert.h>
+#include <kis_image.h>
+#include <kis_image_config.h>
+#include <kis_memory_statistics_server.h>
+
+#include "Document.h"
+#include "InfoObject.h"
+
+namespace {
+
+struct DocumentState {
+    /// the memory used by the image, in bytes. It is sampled when the
+    /// image is loaded and again when the script exports it
+    qint64 memorySize {0};
+    qint64 numPixels {0};
+
+    /// the files the document is being exported to and the memory used
+    /// by the copies of the image made for the exports, in bytes
+    QHash<QString, qint64> pendingExports;
+
+    /// true if the script does not need the document anymore
+    bool closed {false};
+};
+
+}
+
+struct BatchProcessor::Private {
+    Private() {}
+
+    int maxConcurrentExports {qMax(1, QThread::idealThreadCount())};
+    int memoryLimit {KisImageConfig(true).tilesSoftLimit()};
+
+    QHash<KisDocument*, DocumentState> documents;
+    int numRunningExports {0};
+
+    /// in bytes
+    qint64 memoryUsage {0};
+    qint64 peakMemoryUsage {0};
+
+    QElapsedTimer timer;
+    int exportedCount {0};
+    qint64 exportedPixels {0};
+    QStringList failedFiles;
+
+    bool isOverMemoryLimit(qint64 extraMemory = 0) const {
+        return memoryUsage + extraMemory >= qint64(memoryLimit) * 1024 * 1024;
+    }
+
+    void addMemoryUsage(qint64 value) {
+        memoryUsage += value;
+        peakMemoryUsage = qMax(peakMemoryUsage, memoryUsage);
+    }
+
+    /**
+     * The script may have resized or changed the image after loading
+     * it, so its memory use is sampled again before the export
+     */
+    void updateMemorySize(KisDocument *document) {
+        DocumentState &state = documents[document];
+
+        const qint64 newSize = KisMemoryStatisticsServer::instance()->fetchMemoryStatistics(document->image()).imageSize;
+        addMemoryUsage(newSize - state.memorySize);
+        state.memorySize = newSize;
+        state.numPixels = qint64(document->image()->width()) * document->image()->height();
+    }
+
+    /**
+     * @return true if the export of the document has been registered
+     * as pending and removes it
+     */
+    bool finishExport(KisDocument *document, const QString &filename) {
+        DocumentState &state = documents[document];
+
+        auto it = state.pendingExports.find(filename);
+        if (it == state.pendingExports.end()) return false;
+
+        memoryUsage -= it.value();
+        state.pendingExports.erase(it);
+        numRunningExports--;
+
+        return true;
+    }
+
+    /**
+     * The exports report their completion through queued signals, so
+     * the events should be processed while we are waiting for them.
+     * The finished documents and their saving copies are deleted with
+     * deleteLater(), which processEvents() doesn't handle when called
+     * outside of an event loop, so we delete them explicitly to actually
+     * release the memory.
+     */
+    void waitForExport() {
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    void deleteDocumentIfDone(KisDocument *document) {
+        auto it = documents.find(document);
+        KIS_SAFE_ASSERT_RECOVER_RETURN(it != documents.end());
+
+        if (!it->closed || !it->pendingExports.isEmpty()) return;
+
+        memoryUsage -= it->memorySize;
+        documents.erase(it);
+
+        KisPart::instance()->removeDocument(document, true);
+    }
+};
+
+BatchProcessor::BatchProcessor(QObject *parent)
+    : QObject(parent)
+    , d(new Private)
+{
+}
+
+BatchProcessor::~BatchProcessor()
+{
+    waitForDone();
+
+    Q_FOREACH (KisDocument *document, d->documents.keys()) {
+        d->documents[document].closed = true;
+        d->deleteDocumentIfDone(document);
+    }
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    delete d;
+}
+
+int BatchProcessor::maxConcurrentExports() const
+{
+    return d->maxConcurrentExports;
+}
+
+void BatchProcessor::setMaxConcurrentExports(int value)
+{
+    d->maxConcurrentExports = qMax(1, value);
+}
+
+int BatchProcessor::memoryLimit() const
+{
+    return d->memoryLimit;
+}
+
+void BatchProcessor::setMemoryLimit(int value)
+{
+    d->memoryLimit = qMax(1, value);
+}
+
+Document *BatchProcessor::openDocument(const QString &filename)
+{
+    if (!d->timer.isValid()) {
+        d->timer.start();
+    }
+
+    /**
+     * Only the exports can free memory, so if nothing is being exported,
+     * the documents are still needed by the script and we can only go on
+     */
+    while (d->isOverMemoryLimit() && d->numRunningExports > 0) {
+        d->waitForExport();
+    }
+
+    KisDocument *document = KisPart::instance()->createDocument();
+    document->setFileBatchMode(true);
+
+    if (!document->openPath(filename, KisDocument::DontAddToRecent)) {
+        delete document;
+        d->failedFiles << filename;
+        return 0;
+    }
+
+    KisImageSP image = document->image();
+    KIS_SAFE_ASSERT_RECOVER(image) {
+        delete document;
+        d->failedFiles << filename;
+        return 0;
+    }
+
+    KisPart::instance()->addDocument(document);
+
+    DocumentState state;
+    state.memorySize = KisMemoryStatisticsServer::instance()->fetchMemoryStatistics(image).imageSize;
+    state.numPixels = qint64(image->width()) * image->height();
+    d->documents.insert(document, state);
+
+    d->addMemoryUsage(state.memorySize);
+
+    connect(document, SIGNAL(sigCompleteBackgroundSaving(KritaUtils::ExportFileJob, KisImportExportErrorCode, QString, QString)),
+            SLOT(slotExportFinished(KritaUtils::ExportFileJob, KisImportExportErrorCode, QString, QString)));
+
+    return new Document(document, false);
+}
+
+bool BatchProcessor::exportDocument(Document *document, const QString &filename, const InfoObject &exportConfiguration)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(document, false);
+
+    KisDocument *kisDocument = document->document();
+    if (!kisDocument || !d->documents.contains(kisDocument)) {
+        qWarning() << "BatchProcessor::exportDocument: the document has not been opened by the processor";
+        return false;
+    }
+
+    kisDocument->image()->waitForDone();
+    d->updateMemorySize(kisDocument);
+
+    /**
+     * A document can be saved in one place at a time only, so when it is
+     * exported to several files, the exports wait for each other.
+     *
+     * The export works on a copy of the image (see
+     * KisDocument::lockAndCloneForSaving()), which is counted as using
+     * as much memory as the image itself. Like in openDocument(), only
+     * the running exports can free memory, so we don't wait if there
+     * are none.
+     */
+    while (d->numRunningExports >= d->maxConcurrentExports ||
+           !d->documents[kisDocument].pendingExports.isEmpty() ||
+           (d->numRunningExports > 0 &&
+            d->isOverMemoryLimit(d->documents[kisDocument].memorySize))) {
+
+        d->waitForExport();
+    }
+
+    const qint64 copySize = d->documents[kisDocument].memorySize;
+    d->documents[kisDocument].pendingExports.insert(filename, copySize);
+    d->addMemoryUsage(copySize);
+    d->numRunningExports++;
+
+    const QByteArray mimeType = KisMimeDatabase::mimeTypeForFile(filename, false).toLatin1();
+
+    const bool started =
+        kisDocument->exportDocument(filename, mimeType, false, false, exportConfiguration.configuration());
+
+    /**
+     * If the export has failed before it could report its completion,
+     * it is still registered as pending
+     */
+    if (!started && d->finishExport(kisDocument, filename)) {
+        d->failedFiles << filename;
+    }
+
+    return started;
+}
+
+void BatchProcessor::closeDocument(Document *document)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(document);
+
+    KisDocument *kisDocument = document->document();
+    if (!kisDocument || !d->documents.contains(kisDocument)) return;
+
+    d->documents[kisDocument].closed = true;
+    d->deleteDocumentIfDone(kisDocument);
+}
+
+void BatchProcessor::waitForDone()
+{
+    while (d->numRunningExports > 0) {
+        d->waitForExport();
+    }
+
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+int BatchProcessor::exportedCount() const
+{
+    return d->exportedCount;
+}
+
+int BatchProcessor::failedCount() const
+{
+    return d->failedFiles.size();
+}
+
+QStringList BatchProcessor::failedFiles() const
+{
+    return d->failedFiles;
+}
+
+int BatchProcessor::elapsedTime() const
+{
+    return d->timer.isValid() ? int(d->timer.elapsed()) : 0;
+}
+
+qreal BatchProcessor::documentsPerSecond() const
+{
+    const int elapsed = elapsedTime();
+    return elapsed > 0 ? 1000.0 * d->exportedCount / elapsed : 0.0;
+}
+
+qreal BatchProcessor::megapixelsPerSecond() const
+{
+    const int elapsed = elapsedTime();
+    return elapsed > 0 ? 1000.0 * d->exportedPixels / 1e6 / elapsed : 0.0;
+}
+
+int BatchProcessor::peakMemoryUsage() const
+{
+    return int(d->peakMemoryUsage / (1024 * 1024));
+}
+
+void BatchProcessor::slotExportFinished(const KritaUtils::ExportFileJob &job, KisImportExportErrorCode status, const QString &errorMessage, const QString &warningMessage)
+{
+    Q_UNUSED(warningMessage);
+
+    KisDocument *document = qobject_cast<KisDocument*>(sender());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(document);
+
+    auto it = d->documents.find(document);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(it != d->documents.end());
+
+    if (!d->finishExport(document, job.filePath)) return;
+
+    if (status.isOk()) {
+        d->exportedCount++;
+        d->exportedPixels += it->numPixels;
+    } else {
+        d->failedFiles << job.filePath;
+        KisUsageLogger::log(QString("Batch export of %1 failed: %2").arg(job.filePath, errorMessage));
+    }
+
+    d->deleteDocumentIfDone(document);
+}
@@ -0,0 +1,171 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef LIBKIS_BATCHPROCESSOR_H
+#define LIBKIS_BATCHPROCESSOR_H
+
+#include <QObject>
+#include <QStringList>
+
+#include "kritalibkis_export.h"
+#include "libkis.h"
+
+#include <KisImportExportErrorCode.h>
+#include <KisImportExportUtils.h>
+
+/**
+ * BatchProcessor converts many documents in one Krita process. It is
+ * meant for headless scripts run with kritarunner.
+ *
+ * Documents are loaded and processed by the script one after another,
+ * but exporting happens in the background: exportDocument() returns as
+ * soon as the export has been started, so the script can load the next
+ * document while the previous ones are still being encoded. All the
+ * documents share the resources and the color spaces of the process.
+ *
+ * @code
+ * batch = BatchProcessor()
+ * batch.setMemoryLimit(4096)
+ * for path in files:
+ *     doc = batch.openDocument(path)
+ *     if not doc:
+ *         continue
+ *     doc.scaleImage(1024, 1024, 72, 72, "Bicubic")
+ *     batch.exportDocument(doc, path.replace(".kra", ".png"), InfoObject())
+ *     batch.closeDocument(doc)
+ * batch.waitForDone()
+ * print(batch.exportedCount(), batch.documentsPerSecond())
+ * @endcode
+ *
+ * The documents opened by the processor belong to it. A document is
+ * deleted after closeDocument() has been called for it and all of its
+ * exports have finished. The Document objects pointing to it become
+ * invalid at that moment.
+ *
+ * The amount of memory held by the documents that are open or being
+ * exported is limited by memoryLimit(). Every running export holds a
+ * copy of its image, which is counted as well. openDocument() and
+ * exportDocument() wait for the running exports to finish instead of
+ * going over the limit.
+ */
+class KRITALIBKIS_EXPORT BatchProcessor : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(BatchProcessor)
+
+public:
+    explicit BatchProcessor(QObject *parent = 0);
+
+    /**
+     * Waits for all the running exports and deletes the documents
+     * opened by the processor
+     */
+    ~BatchProcessor() override;
+
+public Q_SLOTS:
+
+    /**
+     * @return the maximum number of documents exported at the same time.
+     * By default, it is the number of processor cores.
+     */
+    int maxConcurrentExports() const;
+
+    /**
+     * @brief setMaxConcurrentExports sets the maximum number of documents
+     * exported at the same time
+     */
+    void setMaxConcurrentExports(int value);
+
+    /**
+     * @return the amount of memory in MiB the documents handled by the
+     * processor may use. By default, it is the soft memory limit of
+     * Krita's tile engine.
+     */
+    int memoryLimit() const;
+
+    /**
+     * @brief setMemoryLimit sets the amount of memory in MiB the documents
+     * handled by the processor may use
+     */
+    void setMemoryLimit(int value);
+
+    /**
+     * @brief openDocument loads a document without showing any dialogs.
+     * If too much memory is used by the documents being exported, waits
+     * for some of the exports to finish first.
+     * @return the document or 0 if the file could not be loaded
+     */
+    Document *openDocument(const QString &filename);
+
+    /**
+     * @brief exportDocument starts exporting the document to @p filename
+     * in the background. The format is determined by the extension of
+     * the filename. If maxConcurrentExports() documents are already being
+     * exported or the copy of the image made for the export would not fit
+     * into memoryLimit(), waits for some of the running exports to finish
+     * first.
+     * @return false if the export could not be started
+     */
+    bool exportDocument(Document *document, const QString &filename, const InfoObject &exportConfiguration);
+
+    /**
+     * @brief closeDocument tells the processor that the script is done
+     * with the document. The document is deleted as soon as all of its
+     * exports are finished.
+     */
+    void closeDocument(Document *document);
+
+    /**
+     * @brief waitForDone waits for all the running exports to finish
+     */
+    void waitForDone();
+
+    /**
+     * @return the number of files exported successfully
+     */
+    int exportedCount() const;
+
+    /**
+     * @return the number of files that could not be loaded or exported
+     */
+    int failedCount() const;
+
+    /**
+     * @return the names of the files that could not be loaded or exported
+     */
+    QStringList failedFiles() const;
+
+    /**
+     * @return the time in milliseconds since the first document was opened
+     */
+    int elapsedTime() const;
+
+    /**
+     * @return the number of files exported per second since the first
+     * document was opened
+     */
+    qreal documentsPerSecond() const;
+
+    /**
+     * @return the number of exported megapixels per second since the first
+     * document was opened
+     */
+    qreal megapixelsPerSecond() const;
+
+    /**
+     * @return the largest amount of memory in MiB used by the documents
+     * handled by the processor at the same time
+     */
+    int peakMemoryUsage() const;
+
+private Q_SLOTS:
+    void slotExportFinished(const KritaUtils::ExportFileJob &job, KisImportExportErrorCode status, const QString &errorMessage, const QString &warningMessage);
+
+private:
+    struct Private;
+    Private *const d;
+};
+
+#endif // LIBKIS_BATCHPROCESSOR_H
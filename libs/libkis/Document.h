@@ -933,6 +933,7 @@ private:
     friend class View;
     friend class VectorLayer;
     friend class Shape;
+    friend class BatchProcessor;
     QPointer<KisDocument> document() const;
     void setOwnsDocument(bool ownsDocument);
 
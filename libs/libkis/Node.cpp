@@ -50,6 +50,7 @@
 #include "Node.h"
 #include "Channel.h"
 #include "Filter.h"
+#include "PixelTileIterator.h"
 #include "Selection.h"
 
 #include "GroupLayer.h"
@@ -605,6 +606,30 @@ bool Node::setPixelData(QByteArray value, int x, int y, int w, int h)
     return true;
 }
 
+PixelTileIterator *Node::pixelTiles(int x, int y, int w, int h, bool writable)
+{
+    if (!d->node) return 0;
+    KisPaintDeviceSP dev = d->node->paintDevice();
+    if (!dev) return 0;
+
+    return new PixelTileIterator(d->node, dev, QRect(x, y, w, h), writable);
+}
+
+PixelTileIterator *Node::projectionPixelTiles(int x, int y, int w, int h) const
+{
+    if (!d->node) return 0;
+
+    KisPaintDeviceSP dev;
+    if (const KisColorizeMask *mask = qobject_cast<const KisColorizeMask*>(d->node)) {
+        dev = mask->coloringProjection();
+    } else {
+        dev = d->node->projection();
+    }
+    if (!dev) return 0;
+
+    return new PixelTileIterator(d->node, dev, QRect(x, y, w, h), false);
+}
+
 QRect Node::bounds() const
 {
     if (!d->node) return QRect();
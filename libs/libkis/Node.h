@@ -445,6 +445,37 @@ public Q_SLOTS:
      */
     bool setPixelData(QByteArray value, int x, int y, int w, int h);
 
+    /**
+     * @brief pixelTiles gives direct access to the pixels of the Node, tile by tile, without
+     * copying them. Use it instead of pixelData() and setPixelData() when processing big images.
+     *
+     * The same pixels as with pixelData() are accessible, so group layers, file layers and
+     * clone layers cannot be written to.
+     *
+     * @param x x position from where to start
+     * @param y y position from where to start
+     * @param w width of the rectangle to iterate over
+     * @param h height of the rectangle to iterate over
+     * @param writable if true, the pixels can be modified in place. The node is updated once,
+     * when PixelTileIterator::finish() is called.
+     * @return an iterator over the tiles or 0 if the node has no pixel data. The caller takes
+     * the ownership of the iterator.
+     */
+    PixelTileIterator *pixelTiles(int x, int y, int w, int h, bool writable = false);
+
+    /**
+     * @brief projectionPixelTiles gives read-only access to the pixels of the Node's projection,
+     * tile by tile, without copying them. See projectionPixelData().
+     *
+     * @param x x position from where to start
+     * @param y y position from where to start
+     * @param w width of the rectangle to iterate over
+     * @param h height of the rectangle to iterate over
+     * @return an iterator over the tiles or 0 if the node has no projection. The caller takes
+     * the ownership of the iterator.
+     */
+    PixelTileIterator *projectionPixelTiles(int x, int y, int w, int h) const;
+
     /**
      * @brief bounds return the exact bounds of the node's paint device
      * @return the bounds, or an empty QRect if the node has no paint device or is empty.
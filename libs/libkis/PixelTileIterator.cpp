@@ -0,0 +1,151 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "PixelTileIterator.h"
+
+#include <KoColorSpace.h>
+
+#include <kis_node.h>
+#include <kis_paint_device.h>
+#include <kis_random_accessor_ng.h>
+
+struct PixelTileIterator::Private {
+    Private() {}
+
+    KisNodeSP node;
+    KisPaintDeviceSP device;
+    QRect rect;
+
+    KisRandomConstAccessorSP accessor;
+    KisRandomAccessorSP writableAccessor;
+
+    QRect tileRect;
+    quint8 *data {0};
+    int rowStride {0};
+    int pixelSize {0};
+    bool writable {false};
+    bool atEnd {false};
+
+    /// the area written through the iterator, updated in one go in finish()
+    QRect dirtyRect;
+};
+
+PixelTileIterator::PixelTileIterator(KisNodeSP node, KisPaintDeviceSP device, const QRect &rect, bool writable, QObject *parent)
+    : QObject(parent)
+    , d(new Private)
+{
+    d->node = node;
+    d->device = device;
+    d->rect = rect;
+    d->writable = writable;
+
+    if (!d->device || d->rect.isEmpty()) {
+        d->atEnd = true;
+        return;
+    }
+
+    d->pixelSize = d->device->pixelSize();
+
+    if (writable) {
+        d->writableAccessor = d->device->createRandomAccessorNG();
+        d->accessor = d->writableAccessor;
+    } else {
+        d->accessor = d->device->createRandomConstAccessorNG();
+    }
+}
+
+PixelTileIterator::~PixelTileIterator()
+{
+    finish();
+    delete d;
+}
+
+bool PixelTileIterator::next()
+{
+    if (d->atEnd) return false;
+
+    QPoint pos = d->rect.topLeft();
+
+    if (!d->tileRect.isEmpty()) {
+        pos = QPoint(d->tileRect.right() + 1, d->tileRect.top());
+
+        if (pos.x() > d->rect.right()) {
+            pos = QPoint(d->rect.left(), d->tileRect.bottom() + 1);
+        }
+    }
+
+    if (pos.y() > d->rect.bottom()) {
+        d->atEnd = true;
+        d->tileRect = QRect();
+        d->data = 0;
+        d->rowStride = 0;
+        return false;
+    }
+
+    d->accessor->moveTo(pos.x(), pos.y());
+
+    const int width = qMin(d->accessor->numContiguousColumns(pos.x()), d->rect.right() - pos.x() + 1);
+    const int height = qMin(d->accessor->numContiguousRows(pos.y()), d->rect.bottom() - pos.y() + 1);
+
+    d->tileRect = QRect(pos, QSize(width, height));
+    d->rowStride = d->accessor->rowStride(pos.x(), pos.y());
+
+    if (d->writableAccessor) {
+        d->data = d->writableAccessor->rawData();
+        d->dirtyRect |= d->tileRect;
+    } else {
+        // the sip bindings give a read-only buffer for non-writable iterators
+        d->data = const_cast<quint8*>(d->accessor->rawDataConst());
+    }
+
+    return true;
+}
+
+QRect PixelTileIterator::tileRect() const
+{
+    return d->tileRect;
+}
+
+int PixelTileIterator::rowStride() const
+{
+    return d->rowStride;
+}
+
+int PixelTileIterator::pixelSize() const
+{
+    return d->pixelSize;
+}
+
+bool PixelTileIterator::isWritable() const
+{
+    return d->writable;
+}
+
+void *PixelTileIterator::data() const
+{
+    return d->data;
+}
+
+int PixelTileIterator::dataSize() const
+{
+    if (!d->data) return 0;
+    return (d->tileRect.height() - 1) * d->rowStride + d->tileRect.width() * d->pixelSize;
+}
+
+void PixelTileIterator::finish()
+{
+    d->atEnd = true;
+    d->tileRect = QRect();
+    d->data = 0;
+    d->rowStride = 0;
+
+    d->accessor.clear();
+    d->writableAccessor.clear();
+
+    if (d->node && !d->dirtyRect.isEmpty()) {
+        d->node->setDirty(d->dirtyRect);
+    }
+    d->dirtyRect = QRect();
+}
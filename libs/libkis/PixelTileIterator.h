@@ -0,0 +1,102 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef LIBKIS_PIXELTILEITERATOR_H
+#define LIBKIS_PIXELTILEITERATOR_H
+
+#include <QObject>
+#include <QRect>
+
+#include "kritalibkis_export.h"
+#include "libkis.h"
+
+#include <kis_types.h>
+
+/**
+ * PixelTileIterator gives direct access to the pixels of a Node, one tile
+ * at a time, without copying them into a byte array.
+ *
+ * Get an iterator with Node::pixelTiles() or Node::projectionPixelTiles()
+ * and call next() until it returns false. After every successful call
+ * data() points to the pixels of the current tile, which covers tileRect()
+ * of the image. The rows of the tile are rowStride() bytes apart, and every
+ * row holds tileRect().width() pixels of pixelSize() bytes.
+ *
+ * @code
+ * it = node.pixelTiles(0, 0, 1024, 1024, True)
+ * while it.next():
+ *     rect = it.tileRect()
+ *     buf = numpy.frombuffer(it.data(), dtype=numpy.uint8)
+ *     # buf is a view into the tile, modify it in place
+ * it.finish()
+ * @endcode
+ *
+ * The buffer returned by data() is valid only until the next call to
+ * next() or finish(). If the iterator is writable, the node is
+ * updated once for all the visited tiles when finish() is called.
+ * The changes cannot be undone.
+ */
+class KRITALIBKIS_EXPORT PixelTileIterator : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(PixelTileIterator)
+
+public:
+    explicit PixelTileIterator(KisNodeSP node, KisPaintDeviceSP device, const QRect &rect, bool writable, QObject *parent = 0);
+    ~PixelTileIterator() override;
+
+public Q_SLOTS:
+
+    /**
+     * @brief next moves to the next tile intersecting the rectangle
+     * @return false if there are no more tiles
+     */
+    bool next();
+
+    /**
+     * @return the part of the image covered by the current tile, limited
+     * to the rectangle the iterator has been created for
+     */
+    QRect tileRect() const;
+
+    /**
+     * @return the distance in bytes between the rows of the current tile
+     */
+    int rowStride() const;
+
+    /**
+     * @return the size of a pixel in bytes
+     */
+    int pixelSize() const;
+
+    /**
+     * @return true if the pixels can be written through data()
+     */
+    bool isWritable() const;
+
+    /**
+     * @return the pointer to the top-left pixel of the current tile or
+     * null if the iterator is not on a tile
+     */
+    void *data() const;
+
+    /**
+     * @return the number of bytes from the top-left to the bottom-right
+     * pixel of the current tile, including the gaps between the rows
+     */
+    int dataSize() const;
+
+    /**
+     * @brief finish releases the tiles and, if the iterator is writable,
+     * notifies the node that its pixels have changed
+     */
+    void finish();
+
+private:
+    struct Private;
+    Private *const d;
+};
+
+#endif // LIBKIS_PIXELTILEITERATOR_H
@@ -22,7 +22,9 @@ class Filter;
 class InfoObject;
 class Krita;
 class Node;
+class PixelTileIterator;
 class Notifier;
+class BatchProcessor;
 class Resource;
 class Scratchpad;
 class Selection;
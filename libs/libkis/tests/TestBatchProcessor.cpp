@@ -0,0 +1,132 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "TestBatchProcessor.h"
+#include <simpletest.h>
+
+#include <QColor>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <BatchProcessor.h>
+#include <Document.h>
+#include <InfoObject.h>
+
+#include <testui.h>
+
+namespace {
+
+QStringList createSourceFiles(const QTemporaryDir &dir, int numFiles)
+{
+    QStringList files;
+
+    for (int i = 0; i < numFiles; i++) {
+        QImage image(64 + i, 32, QImage::Format_ARGB32);
+        image.fill(QColor(10 * i, 0, 0));
+
+        const QString path = dir.filePath(QString("source_%1.png").arg(i));
+        if (image.save(path)) {
+            files << path;
+        }
+    }
+
+    return files;
+}
+
+}
+
+void TestBatchProcessor::testConcurrentExport()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const int numFiles = 6;
+    const QStringList sources = createSourceFiles(dir, numFiles);
+    QCOMPARE(sources.size(), numFiles);
+
+    const QString missingFile = dir.filePath("missing.png");
+    const QString unsupportedFile = dir.filePath("unsupported.nonexistentformat");
+
+    BatchProcessor batch;
+    batch.setMaxConcurrentExports(2);
+
+    QVERIFY(!batch.openDocument(missingFile));
+
+    for (int i = 0; i < sources.size(); i++) {
+        Document *doc = batch.openDocument(sources[i]);
+        QVERIFY(doc);
+
+        QVERIFY(batch.exportDocument(doc, dir.filePath(QString("result_%1.png").arg(i)), InfoObject()));
+
+        // the first document is exported twice, the second export waits for the first one
+        if (i == 0) {
+            QVERIFY(batch.exportDocument(doc, dir.filePath("result_0_copy.png"), InfoObject()));
+
+            // may fail right away or when the export finishes, it is counted either way
+            batch.exportDocument(doc, unsupportedFile, InfoObject());
+        }
+
+        batch.closeDocument(doc);
+        delete doc;
+    }
+
+    batch.waitForDone();
+
+    QCOMPARE(batch.exportedCount(), numFiles + 1);
+    QCOMPARE(batch.failedCount(), 2);
+    QVERIFY(batch.failedFiles().contains(missingFile));
+    QVERIFY(batch.failedFiles().contains(unsupportedFile));
+    QVERIFY(batch.peakMemoryUsage() >= 0);
+
+    for (int i = 0; i < numFiles; i++) {
+        QImage result(dir.filePath(QString("result_%1.png").arg(i)));
+        QCOMPARE(result.size(), QSize(64 + i, 32));
+    }
+    QCOMPARE(QImage(dir.filePath("result_0_copy.png")).size(), QSize(64, 32));
+}
+
+void TestBatchProcessor::testExportUnderMemoryLimit()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const int numFiles = 4;
+    const QStringList sources = createSourceFiles(dir, numFiles);
+    QCOMPARE(sources.size(), numFiles);
+
+    /**
+     * Every document is over the limit, so each open and export has to
+     * wait for the previous export, but must never wait for nothing
+     */
+    BatchProcessor batch;
+    batch.setMemoryLimit(1);
+
+    for (int i = 0; i < sources.size(); i++) {
+        Document *doc = batch.openDocument(sources[i]);
+        QVERIFY(doc);
+
+        // the image grows after loading, the new size must be accounted for
+        doc->scaleImage(1024, 1024, 72, 72, "Bicubic");
+        doc->waitForDone();
+
+        QVERIFY(batch.exportDocument(doc, dir.filePath(QString("result_%1.png").arg(i)), InfoObject()));
+        batch.closeDocument(doc);
+        delete doc;
+    }
+
+    batch.waitForDone();
+
+    QCOMPARE(batch.exportedCount(), numFiles);
+    QCOMPARE(batch.failedCount(), 0);
+
+    // the 4 MiB image and its copy for the export
+    QVERIFY(batch.peakMemoryUsage() >= 8);
+
+    for (int i = 0; i < numFiles; i++) {
+        QCOMPARE(QImage(dir.filePath(QString("result_%1.png").arg(i))).size(), QSize(1024, 1024));
+    }
+}
+
+KISTEST_MAIN(TestBatchProcessor)
@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef TESTBATCHPROCESSOR_H
+#define TESTBATCHPROCESSOR_H
+
+#include <QObject>
+
+class TestBatchProcessor : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testConcurrentExport();
+    void testExportUnderMemoryLimit();
+};
+
+#endif
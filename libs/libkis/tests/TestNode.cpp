@@ -6,9 +6,12 @@
 #include <simpletest.h>
 #include <QColor>
 #include <QDataStream>
+#include <QRegion>
+#include <QScopedPointer>
 
 #include <KritaVersionWrapper.h>
 #include <Node.h>
+#include <PixelTileIterator.h>
 #include <Krita.h>
 
 #include <KoColorSpaceRegistry.h>
@@ -25,6 +28,8 @@
 
 #include <testui.h>
 
+#include <cstring>
+
 void TestNode::testSetColorSpace()
 {
     KisImageSP image = new KisImage(0, 100, 100, KoColorSpaceRegistry::instance()->rgb8(), "test");
@@ -110,6 +115,74 @@ void TestNode::testProjectionPixelData()
     }
 }
 
+void TestNode::testPixelTiles()
+{
+    KisImageSP image = new KisImage(0, 200, 200, KoColorSpaceRegistry::instance()->rgb8(), "test");
+    KisNodeSP layer = new KisPaintLayer(image, "test1", 255);
+    KisFillPainter gc(layer->paintDevice());
+    gc.fillRect(0, 0, 200, 200, KoColor(Qt::red, layer->colorSpace()));
+    NodeSP node = NodeSP(Node::createNode(image, layer));
+
+    const QRect rect(10, 20, 150, 100);
+
+    // the tiles cover the rect exactly once
+    {
+        QScopedPointer<PixelTileIterator> it(node->pixelTiles(rect.x(), rect.y(), rect.width(), rect.height()));
+        QVERIFY(it);
+        QVERIFY(!it->isWritable());
+        QCOMPARE(it->pixelSize(), 4);
+
+        QRegion covered;
+        int numTiles = 0;
+
+        while (it->next()) {
+            const QRect tileRect = it->tileRect();
+            QVERIFY(rect.contains(tileRect));
+            QVERIFY(!covered.intersects(tileRect));
+            covered += tileRect;
+            numTiles++;
+
+            QCOMPARE(it->dataSize(), (tileRect.height() - 1) * it->rowStride() + tileRect.width() * 4);
+
+            const quint8 *pixel = static_cast<const quint8*>(it->data());
+            QCOMPARE(pixel[0], quint8(0));
+            QCOMPARE(pixel[1], quint8(0));
+            QCOMPARE(pixel[2], quint8(255));
+            QCOMPARE(pixel[3], quint8(255));
+        }
+
+        QCOMPARE(covered, QRegion(rect));
+        QVERIFY(numTiles > 1);
+        QVERIFY(!it->next());
+        QVERIFY(!it->data());
+    }
+
+    // write in place
+    {
+        QScopedPointer<PixelTileIterator> it(node->pixelTiles(rect.x(), rect.y(), rect.width(), rect.height(), true));
+        QVERIFY(it->isWritable());
+
+        while (it->next()) {
+            quint8 *row = static_cast<quint8*>(it->data());
+            for (int y = 0; y < it->tileRect().height(); y++) {
+                memset(row, 255, it->tileRect().width() * it->pixelSize());
+                row += it->rowStride();
+            }
+        }
+        it->finish();
+    }
+
+    QColor pixel;
+    layer->paintDevice()->pixel(rect.x(), rect.y(), &pixel);
+    QCOMPARE(pixel, QColor(Qt::white));
+    layer->paintDevice()->pixel(rect.right(), rect.bottom(), &pixel);
+    QCOMPARE(pixel, QColor(Qt::white));
+    layer->paintDevice()->pixel(rect.x() - 1, rect.y(), &pixel);
+    QCOMPARE(pixel, QColor(Qt::red));
+    layer->paintDevice()->pixel(rect.right() + 1, rect.bottom(), &pixel);
+    QCOMPARE(pixel, QColor(Qt::red));
+}
+
 void TestNode::testThumbnail()
 {
     KisImageSP image = new KisImage(0, 100, 100, KoColorSpaceRegistry::instance()->rgb8(), "test");
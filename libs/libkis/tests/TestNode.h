@@ -16,6 +16,7 @@ private Q_SLOTS:
     void testSetColorProfile();
     void testPixelData();
     void testProjectionPixelData();
+    void testPixelTiles();
     void testThumbnail();
     void testMergeDown();
     void testFindChildNodes();
@@ -120,6 +120,14 @@ void KoBasicU8HistogramProducer::addRegionToBin(const quint8 * pixels, const qui
             selectionMask++;
             nPixels--;
         }
+    } else if (!m_skipTransparent) {
+        QVector<quint32*> bins(m_colorSpace->channelCount());
+        for (int i = 0; i < bins.size(); i++) {
+            bins[i] = m_bins[i].data();
+        }
+
+        m_colorSpace->addPixelsToHistogramU8(dstPixels, nPixels, 1, bins.data());
+        m_count += nPixels;
     } else {
         quint8 *dst = dstPixels;
         while (nPixels > 0) {
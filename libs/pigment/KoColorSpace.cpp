@@ -429,6 +429,18 @@ const KoColorConversionTransformation* KoColorSpace::fromRgbA16Converter() const
     return d->transfoFromRGBA16;
 }
 
+void KoColorSpace::addPixelsToHistogramU8(const quint8 *pixels, qint32 nPixels, qint32 stride, quint32 **bins) const
+{
+    const qint32 channelCount = this->channelCount();
+    const qint32 step = stride * pixelSize();
+
+    for (qint32 i = 0; i < nPixels; i += stride, pixels += step) {
+        for (qint32 c = 0; c < channelCount; c++) {
+            bins[c][scaleToU8(pixels, c)]++;
+        }
+    }
+}
+
 void KoColorSpace::toLabA16(const quint8 * src, quint8 * dst, quint32 nPixels) const
 {
     toLabA16Converter()->transform(src, dst, nPixels);
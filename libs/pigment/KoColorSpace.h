@@ -178,6 +178,15 @@ public:
      */
     virtual quint8 scaleToU8(const quint8 * srcPixel, qint32 channelPos) const = 0;
 
+    /**
+     * Add every \p stride-th pixel of \p pixels, starting with the first
+     * one, to the 8-bit histograms of the channels. \p bins should
+     * contain channelCount() pointers to arrays of 256 bins each. The
+     * values are scaled exactly as scaleToU8() does it, but without
+     * a virtual call per channel.
+     */
+    virtual void addPixelsToHistogramU8(const quint8 *pixels, qint32 nPixels, qint32 stride, quint32 **bins) const;
+
     /**
      * Set dstPixel to the pixel containing only the given channel of srcPixel. The remaining channels
      * should be set to whatever makes sense for 'empty' channels of this color space,
@@ -88,6 +88,10 @@ public:
         return KoColorSpaceMaths<typename _CSTrait::channels_type, quint8>::scaleToA(c);
     }
 
+    void addPixelsToHistogramU8(const quint8 *pixels, qint32 nPixels, qint32 stride, quint32 **bins) const override {
+        _CSTrait::addPixelsToHistogramU8(pixels, nPixels, stride, bins);
+    }
+
     void singleChannelPixel(quint8 *dstPixel, const quint8 *srcPixel, quint32 channelIndex) const override {
         _CSTrait::singleChannelPixel(dstPixel, srcPixel, channelIndex);
     }
@@ -155,6 +155,23 @@ struct KoColorSpaceTrait {
         return QString().setNum(100. *((qreal)c) / KoColorSpaceMathsTraits< channels_type>::unitValue);
     }
 
+    /**
+     * The number of channels is known at compile time, so the inner
+     * loop is unrolled and the bins of all the channels are updated
+     * without any branches
+     */
+    inline static void addPixelsToHistogramU8(const quint8 *pixels, qint32 nPixels, qint32 stride, quint32 **bins)
+    {
+        const channels_type *src = nativeArray(pixels);
+        const qint32 step = stride * channels_nb;
+
+        for (qint32 i = 0; i < nPixels; i += stride, src += step) {
+            for (uint c = 0; c < channels_nb; c++) {
+                bins[c][KoColorSpaceMaths<channels_type, quint8>::scaleToA(src[c])]++;
+            }
+        }
+    }
+
     inline static void normalisedChannelsValue(const quint8 *pixel, QVector<float> &v)
     {
         return normalisedChannelsValueImpl<channels_type>(pixel, v);
@@ -73,6 +73,46 @@ struct KoLabTraits : public KoColorSpaceTrait<_channels_type_, 4, 3> {
         d[b_pos] = nv;
     }
 
+    /**
+     * The a and b channels are scaled non-linearly, so that their
+     * neutral value is mapped into the middle of the 8-bit range
+     */
+    inline static quint8 scaleToU8(const quint8 *pixel, qint32 channelIndex)
+    {
+        const channels_type c = parent::nativeArray(pixel)[channelIndex];
+        qreal b = 0;
+        switch (channelIndex) {
+        case L_pos:
+            b = ((qreal)c) / math_trait::unitValueL;
+            break;
+        case a_pos:
+        case b_pos:
+            if (c <= math_trait::halfValueAB) {
+                b = ((qreal)c - math_trait::zeroValueAB) / (2.0 * (math_trait::halfValueAB - math_trait::zeroValueAB));
+            } else {
+                b = 0.5 + ((qreal)c - math_trait::halfValueAB) / (2.0 * (math_trait::unitValueAB - math_trait::halfValueAB));
+            }
+            break;
+        default:
+            b = ((qreal)c) / math_trait::unitValue;
+            break;
+        }
+
+        return KoColorSpaceMaths<qreal, quint8>::scaleToA(b);
+    }
+
+    /// hides the linear version of KoColorSpaceTrait
+    inline static void addPixelsToHistogramU8(const quint8 *pixels, qint32 nPixels, qint32 stride, quint32 **bins)
+    {
+        const qint32 step = stride * parent::pixelSize;
+
+        for (qint32 i = 0; i < nPixels; i += stride, pixels += step) {
+            for (uint c = 0; c < parent::channels_nb; c++) {
+                bins[c][scaleToU8(pixels, c)]++;
+            }
+        }
+    }
+
     // Lab has some... particulars
     inline static QString normalisedChannelValueText(const quint8 *pixel, quint32 channelIndex)
     {
@@ -0,0 +1,111 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedMatrixShaperTransform_H
+#define KoOptimizedMatrixShaperTransform_H
+
+#include "KoOptimizedMatrixShaperTransformBase.h"
+
+#include "KoMultiArchBuildSupport.h"
+
+template<typename SrcChannel,
+         typename DstChannel,
+         typename _impl,
+         typename EnableDummyType = void>
+class KoOptimizedMatrixShaperTransform : public KoOptimizedMatrixShaperTransformBase
+{
+public:
+    KoOptimizedMatrixShaperTransform(QSharedPointer<const Tables> tables)
+        : KoOptimizedMatrixShaperTransformBase(tables)
+    {
+    }
+
+    void transform(const quint8 *src, quint8 *dst, int numPixels) const override
+    {
+        transformScalar<SrcChannel, DstChannel>(src, dst, numPixels);
+    }
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+template<typename SrcChannel, typename DstChannel, typename _impl>
+class KoOptimizedMatrixShaperTransform<
+        SrcChannel, DstChannel, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KoOptimizedMatrixShaperTransformBase
+{
+public:
+    using float_v = xsimd::batch<float, _impl>;
+    using int_v = xsimd::batch<int, _impl>;
+
+    KoOptimizedMatrixShaperTransform(QSharedPointer<const Tables> tables)
+        : KoOptimizedMatrixShaperTransformBase(tables)
+    {
+    }
+
+    void transform(const quint8 *src, quint8 *dst, int numPixels) const override
+    {
+        const int vectorSize = static_cast<int>(float_v::size);
+        const int numBlocks = numPixels / vectorSize;
+        const int numScalarPixels = numPixels % vectorSize;
+
+        const float *m = m_tables->matrix;
+        const float_v zero(0.0f);
+        const float_v one(1.0f);
+        const float_v scale(static_cast<float>(linearSamples - 1));
+
+        alignas(64) float linear[3][float_v::size];
+        alignas(64) int index[3][float_v::size];
+
+        const SrcChannel *srcPixel = reinterpret_cast<const SrcChannel*>(src);
+        DstChannel *dstPixel = reinterpret_cast<DstChannel*>(dst);
+
+        /**
+         * The lookups into the transfer curve tables are done with
+         * scalar code, only the matrix multiplication, clamping and
+         * rounding are vectorized
+         */
+        for (int i = 0; i < numBlocks; i++) {
+            for (int j = 0; j < vectorSize; j++) {
+                const SrcChannel *pixel = srcPixel + 4 * j;
+                linear[0][j] = m_srcToLinear[0][pixel[2]];
+                linear[1][j] = m_srcToLinear[1][pixel[1]];
+                linear[2][j] = m_srcToLinear[2][pixel[0]];
+            }
+
+            const float_v r = float_v::load_aligned(linear[0]);
+            const float_v g = float_v::load_aligned(linear[1]);
+            const float_v b = float_v::load_aligned(linear[2]);
+
+            for (int ch = 0; ch < 3; ch++) {
+                float_v value = float_v(m[3 * ch]) * r +
+                    float_v(m[3 * ch + 1]) * g +
+                    float_v(m[3 * ch + 2]) * b;
+
+                value = xsimd::min(xsimd::max(value, zero), one) * scale;
+                xsimd::nearbyint_as_int(value).store_aligned(index[ch]);
+            }
+
+            for (int j = 0; j < vectorSize; j++) {
+                dstPixel[2] = dstValue<DstChannel>(0, index[0][j]);
+                dstPixel[1] = dstValue<DstChannel>(1, index[1][j]);
+                dstPixel[0] = dstValue<DstChannel>(2, index[2][j]);
+                dstPixel[3] = KoColorSpaceMaths<SrcChannel, DstChannel>::scaleToA(srcPixel[3]);
+
+                srcPixel += 4;
+                dstPixel += 4;
+            }
+        }
+
+        transformScalar<SrcChannel, DstChannel>(reinterpret_cast<const quint8*>(srcPixel),
+                                                reinterpret_cast<quint8*>(dstPixel),
+                                                numScalarPixels);
+    }
+};
+
+#endif /* defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+#endif // KoOptimizedMatrixShaperTransform_H
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedMatrixShaperTransformBase.h"
+
+KoOptimizedMatrixShaperTransformBase::KoOptimizedMatrixShaperTransformBase(QSharedPointer<const Tables> tables)
+    : m_tables(tables)
+{
+    for (int ch = 0; ch < 3; ch++) {
+        m_srcToLinear[ch] = m_tables->srcToLinear[ch].constData();
+        m_linearToDst[ch] = m_tables->linearToDst[ch].constData();
+    }
+}
+
+KoOptimizedMatrixShaperTransformBase::~KoOptimizedMatrixShaperTransformBase()
+{
+}
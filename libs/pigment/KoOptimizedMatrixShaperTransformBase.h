@@ -0,0 +1,120 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedMatrixShaperTransformBase_H
+#define KoOptimizedMatrixShaperTransformBase_H
+
+#include <QtGlobal>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "kritapigment_export.h"
+#include "KoColorSpaceMaths.h"
+
+/**
+ * @brief A color conversion between two matrix-shaper RGB profiles
+ *        that doesn't call into the color management engine
+ *
+ * Conversion between two matrix-shaper profiles consists of three
+ * steps: the source transfer curves, a 3x3 matrix and the inverse
+ * destination transfer curves. The curves are sampled into lookup
+ * tables once, when the transform is created, and the matrix step is
+ * vectorized. That is much cheaper than a generic lcms transform, and
+ * it is used for the most common case of painting in an sRGB-like
+ * space on an sRGB-like display.
+ *
+ * Only 8- and 16-bit integer RGBA data is supported.
+ *
+ * To create a transform, call a factory. It returns null if the
+ * conversion cannot be represented by a matrix-shaper transform, in
+ * which case the usual KoColorSpace::convertPixelsTo() should be used.
+ *
+ * \code{.cpp}
+ * QScopedPointer<KoOptimizedMatrixShaperTransformBase> transform(
+ *     KoOptimizedMatrixShaperTransformFactory::create(srcCS, dstCS, intent, flags));
+ *
+ * if (transform) {
+ *     transform->transform(src, dst, numPixels);
+ * } else {
+ *     srcCS->convertPixelsTo(src, dst, dstCS, numPixels, intent, flags);
+ * }
+ * \endcode
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedMatrixShaperTransformBase
+{
+public:
+    /**
+     * The number of samples of the inverse destination transfer curve
+     */
+    static const int linearSamples = 65536;
+
+    struct Tables
+    {
+        /// linear values of the source channels, indexed by the
+        /// channel value; in R, G, B order
+        QVector<float> srcToLinear[3];
+
+        /// destination channel values scaled to 16 bits, indexed by
+        /// the linear value multiplied by (linearSamples - 1)
+        QVector<quint16> linearToDst[3];
+
+        /// converts linear source RGB into linear destination RGB,
+        /// row-major
+        float matrix[9];
+    };
+
+    KoOptimizedMatrixShaperTransformBase(QSharedPointer<const Tables> tables);
+
+    virtual ~KoOptimizedMatrixShaperTransformBase();
+
+    virtual void transform(const quint8 *src, quint8 *dst, int numPixels) const = 0;
+
+protected:
+    template<typename SrcChannel, typename DstChannel>
+    void transformScalar(const quint8 *src, quint8 *dst, int numPixels) const
+    {
+        const SrcChannel *srcPixel = reinterpret_cast<const SrcChannel*>(src);
+        DstChannel *dstPixel = reinterpret_cast<DstChannel*>(dst);
+
+        const float *m = m_tables->matrix;
+
+        for (int i = 0; i < numPixels; i++) {
+            // Krita's RGB color spaces store channels in B, G, R, A order
+            const float r = m_srcToLinear[0][srcPixel[2]];
+            const float g = m_srcToLinear[1][srcPixel[1]];
+            const float b = m_srcToLinear[2][srcPixel[0]];
+
+            dstPixel[2] = toDst<DstChannel>(0, m[0] * r + m[1] * g + m[2] * b);
+            dstPixel[1] = toDst<DstChannel>(1, m[3] * r + m[4] * g + m[5] * b);
+            dstPixel[0] = toDst<DstChannel>(2, m[6] * r + m[7] * g + m[8] * b);
+            dstPixel[3] = KoColorSpaceMaths<SrcChannel, DstChannel>::scaleToA(srcPixel[3]);
+
+            srcPixel += 4;
+            dstPixel += 4;
+        }
+    }
+
+    static inline int linearIndex(float value) {
+        return static_cast<int>(qBound(0.0f, value, 1.0f) * (linearSamples - 1) + 0.5f);
+    }
+
+    template<typename DstChannel>
+    inline DstChannel dstValue(int channel, int index) const {
+        return KoColorSpaceMaths<quint16, DstChannel>::scaleToA(m_linearToDst[channel][index]);
+    }
+
+    template<typename DstChannel>
+    inline DstChannel toDst(int channel, float value) const {
+        return dstValue<DstChannel>(channel, linearIndex(value));
+    }
+
+protected:
+    QSharedPointer<const Tables> m_tables;
+    const float *m_srcToLinear[3];
+    const quint16 *m_linearToDst[3];
+};
+
+#endif // KoOptimizedMatrixShaperTransformBase_H
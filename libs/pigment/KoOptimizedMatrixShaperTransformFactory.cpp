@@ -0,0 +1,229 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedMatrixShaperTransformFactory.h"
+
+#include <QtMath>
+
+#include "KoColorModelStandardIds.h"
+#include "KoColorProfile.h"
+#include "KoColorSpace.h"
+
+#include "KoOptimizedMatrixShaperTransformFactoryImpl.h"
+
+namespace {
+
+using Tables = KoOptimizedMatrixShaperTransformBase::Tables;
+
+bool isMatrixShaperProfile(const KoColorProfile *profile)
+{
+    /**
+     * The profiles that have lookup tables for the perceptual or
+     * saturation intents are not pure matrix-shapers, lcms would
+     * use the tables instead of the matrix
+     */
+    return profile && profile->valid() &&
+        profile->hasColorants() && profile->hasTRC() &&
+        profile->supportsRelative() &&
+        !profile->supportsPerceptual() &&
+        !profile->supportsSaturation();
+}
+
+bool isSupportedColorSpace(const KoColorSpace *cs)
+{
+    return cs->colorModelId() == RGBAColorModelID &&
+        (cs->colorDepthId() == Integer8BitsColorDepthID ||
+         cs->colorDepthId() == Integer16BitsColorDepthID) &&
+        isMatrixShaperProfile(cs->profile());
+}
+
+bool haveSameWhitePoint(const KoColorProfile *lhs, const KoColorProfile *rhs)
+{
+    const QVector<qreal> lhsWhite = lhs->getWhitePointXYZ();
+    const QVector<qreal> rhsWhite = rhs->getWhitePointXYZ();
+
+    if (lhsWhite.size() != 3 || rhsWhite.size() != 3) return false;
+
+    for (int i = 0; i < 3; i++) {
+        if (qAbs(lhsWhite[i] - rhsWhite[i]) > 1e-4) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Returns the matrix converting linear RGB of \p profile into XYZ
+ */
+bool colorantsMatrix(const KoColorProfile *profile, qreal *matrix)
+{
+    const QVector<qreal> colorants = profile->getColorantsXYZ();
+    if (colorants.size() != 9) return false;
+
+    // the colorants are stored as the XYZ of the red, green and blue
+    // primaries, so they become the columns of the matrix
+    for (int channel = 0; channel < 3; channel++) {
+        for (int component = 0; component < 3; component++) {
+            matrix[3 * component + channel] = colorants[3 * channel + component];
+        }
+    }
+
+    return true;
+}
+
+bool invertMatrix(const qreal *m, qreal *result)
+{
+    const qreal det =
+        m[0] * (m[4] * m[8] - m[5] * m[7]) -
+        m[1] * (m[3] * m[8] - m[5] * m[6]) +
+        m[2] * (m[3] * m[7] - m[4] * m[6]);
+
+    if (qAbs(det) < 1e-12) return false;
+
+    result[0] = (m[4] * m[8] - m[5] * m[7]) / det;
+    result[1] = (m[2] * m[7] - m[1] * m[8]) / det;
+    result[2] = (m[1] * m[5] - m[2] * m[4]) / det;
+    result[3] = (m[5] * m[6] - m[3] * m[8]) / det;
+    result[4] = (m[0] * m[8] - m[2] * m[6]) / det;
+    result[5] = (m[2] * m[3] - m[0] * m[5]) / det;
+    result[6] = (m[3] * m[7] - m[4] * m[6]) / det;
+    result[7] = (m[1] * m[6] - m[0] * m[7]) / det;
+    result[8] = (m[0] * m[4] - m[1] * m[3]) / det;
+
+    return true;
+}
+
+bool calculateMatrix(const KoColorProfile *srcProfile, const KoColorProfile *dstProfile, float *matrix)
+{
+    if (*srcProfile == *dstProfile) {
+        for (int i = 0; i < 9; i++) {
+            matrix[i] = (i % 4 == 0) ? 1.0f : 0.0f;
+        }
+        return true;
+    }
+
+    qreal srcToXYZ[9];
+    qreal dstToXYZ[9];
+    qreal xyzToDst[9];
+
+    if (!colorantsMatrix(srcProfile, srcToXYZ) ||
+        !colorantsMatrix(dstProfile, dstToXYZ) ||
+        !invertMatrix(dstToXYZ, xyzToDst)) {
+
+        return false;
+    }
+
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            qreal value = 0.0;
+            for (int k = 0; k < 3; k++) {
+                value += xyzToDst[3 * row + k] * srcToXYZ[3 * k + col];
+            }
+            matrix[3 * row + col] = static_cast<float>(value);
+        }
+    }
+
+    return true;
+}
+
+void sampleSourceCurves(const KoColorProfile *profile, int numSamples, Tables *tables)
+{
+    QVector<qreal> value(3);
+
+    for (int ch = 0; ch < 3; ch++) {
+        tables->srcToLinear[ch].resize(numSamples);
+    }
+
+    for (int i = 0; i < numSamples; i++) {
+        const qreal normalized = qreal(i) / (numSamples - 1);
+        value.fill(normalized);
+        profile->linearizeFloatValue(value);
+
+        for (int ch = 0; ch < 3; ch++) {
+            tables->srcToLinear[ch][i] = static_cast<float>(value[ch]);
+        }
+    }
+}
+
+void sampleDestinationCurves(const KoColorProfile *profile, Tables *tables)
+{
+    const int numSamples = KoOptimizedMatrixShaperTransformBase::linearSamples;
+    QVector<qreal> value(3);
+
+    for (int ch = 0; ch < 3; ch++) {
+        tables->linearToDst[ch].resize(numSamples);
+    }
+
+    for (int i = 0; i < numSamples; i++) {
+        const qreal normalized = qreal(i) / (numSamples - 1);
+        value.fill(normalized);
+        profile->delinearizeFloatValue(value);
+
+        for (int ch = 0; ch < 3; ch++) {
+            tables->linearToDst[ch][i] =
+                static_cast<quint16>(qBound(0, qRound(value[ch] * 65535.0), 65535));
+        }
+    }
+}
+
+template<typename SrcChannel>
+KoOptimizedMatrixShaperTransformBase* createForSource(const KoColorSpace *dstColorSpace,
+                                                      QSharedPointer<const Tables> tables)
+{
+    if (dstColorSpace->colorDepthId() == Integer8BitsColorDepthID) {
+        return createOptimizedClass<
+            KoOptimizedMatrixShaperTransformFactoryImpl<SrcChannel, quint8>>(tables);
+    } else {
+        return createOptimizedClass<
+            KoOptimizedMatrixShaperTransformFactoryImpl<SrcChannel, quint16>>(tables);
+    }
+}
+
+}
+
+bool KoOptimizedMatrixShaperTransformFactory::isSupported(const KoColorSpace *srcColorSpace,
+                                                          const KoColorSpace *dstColorSpace,
+                                                          KoColorConversionTransformation::Intent renderingIntent,
+                                                          KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    /**
+     * Absolute colorimetric intent doesn't map the white points, and
+     * the black point compensation is a no-op for matrix-shapers, since
+     * their black point is always zero
+     */
+    return srcColorSpace && dstColorSpace &&
+        renderingIntent != KoColorConversionTransformation::IntentAbsoluteColorimetric &&
+        !conversionFlags.testFlag(KoColorConversionTransformation::GamutCheck) &&
+        !conversionFlags.testFlag(KoColorConversionTransformation::SoftProofing) &&
+        isSupportedColorSpace(srcColorSpace) &&
+        isSupportedColorSpace(dstColorSpace) &&
+        haveSameWhitePoint(srcColorSpace->profile(), dstColorSpace->profile());
+}
+
+KoOptimizedMatrixShaperTransformBase *
+KoOptimizedMatrixShaperTransformFactory::create(const KoColorSpace *srcColorSpace,
+                                                const KoColorSpace *dstColorSpace,
+                                                KoColorConversionTransformation::Intent renderingIntent,
+                                                KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    if (!isSupported(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags)) {
+        return nullptr;
+    }
+
+    QSharedPointer<Tables> tables(new Tables());
+
+    if (!calculateMatrix(srcColorSpace->profile(), dstColorSpace->profile(), tables->matrix)) {
+        return nullptr;
+    }
+
+    const bool srcIs8Bit = srcColorSpace->colorDepthId() == Integer8BitsColorDepthID;
+
+    sampleSourceCurves(srcColorSpace->profile(), srcIs8Bit ? 256 : 65536, tables.data());
+    sampleDestinationCurves(dstColorSpace->profile(), tables.data());
+
+    return srcIs8Bit ?
+        createForSource<quint8>(dstColorSpace, tables) :
+        createForSource<quint16>(dstColorSpace, tables);
+}
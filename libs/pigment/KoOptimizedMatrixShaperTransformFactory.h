@@ -0,0 +1,43 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedMatrixShaperTransformFACTORY_H
+#define KoOptimizedMatrixShaperTransformFACTORY_H
+
+#include "KoOptimizedMatrixShaperTransformBase.h"
+#include "KoColorConversionTransformation.h"
+
+class KoColorSpace;
+
+/**
+ * \see KoOptimizedMatrixShaperTransformBase
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedMatrixShaperTransformFactory
+{
+public:
+    /**
+     * @return true if the conversion from \p srcColorSpace to \p dstColorSpace
+     * can be done with a matrix-shaper transform, that is, both spaces are
+     * 8- or 16-bit integer RGBA with matrix-shaper profiles sharing the same
+     * white point, and the intent and flags do not require anything but
+     * a colorimetric conversion.
+     */
+    static bool isSupported(const KoColorSpace *srcColorSpace,
+                            const KoColorSpace *dstColorSpace,
+                            KoColorConversionTransformation::Intent renderingIntent,
+                            KoColorConversionTransformation::ConversionFlags conversionFlags);
+
+    /**
+     * Creates a transform optimized for the current CPU or returns null
+     * if the conversion is not supported.
+     */
+    static KoOptimizedMatrixShaperTransformBase* create(const KoColorSpace *srcColorSpace,
+                                                        const KoColorSpace *dstColorSpace,
+                                                        KoColorConversionTransformation::Intent renderingIntent,
+                                                        KoColorConversionTransformation::ConversionFlags conversionFlags);
+};
+
+#endif // KoOptimizedMatrixShaperTransformFACTORY_H
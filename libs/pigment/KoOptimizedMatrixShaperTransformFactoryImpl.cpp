@@ -0,0 +1,30 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedMatrixShaperTransformFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedMatrixShaperTransform.h"
+
+template<typename SrcChannel, typename DstChannel>
+template<typename _impl>
+KoOptimizedMatrixShaperTransformBase *
+KoOptimizedMatrixShaperTransformFactoryImpl<SrcChannel, DstChannel>::create(
+    QSharedPointer<const KoOptimizedMatrixShaperTransformBase::Tables> tables)
+{
+    return new KoOptimizedMatrixShaperTransform<SrcChannel, DstChannel, _impl>(tables);
+}
+
+template KoOptimizedMatrixShaperTransformBase *
+KoOptimizedMatrixShaperTransformFactoryImpl<quint8, quint8>::create<xsimd::current_arch>(QSharedPointer<const KoOptimizedMatrixShaperTransformBase::Tables>);
+template KoOptimizedMatrixShaperTransformBase *
+KoOptimizedMatrixShaperTransformFactoryImpl<quint8, quint16>::create<xsimd::current_arch>(QSharedPointer<const KoOptimizedMatrixShaperTransformBase::Tables>);
+template KoOptimizedMatrixShaperTransformBase *
+KoOptimizedMatrixShaperTransformFactoryImpl<quint16, quint8>::create<xsimd::current_arch>(QSharedPointer<const KoOptimizedMatrixShaperTransformBase::Tables>);
+template KoOptimizedMatrixShaperTransformBase *
+KoOptimizedMatrixShaperTransformFactoryImpl<quint16, quint16>::create<xsimd::current_arch>(QSharedPointer<const KoOptimizedMatrixShaperTransformBase::Tables>);
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedMatrixShaperTransformFACTORYIMPL_H
+#define KoOptimizedMatrixShaperTransformFACTORYIMPL_H
+
+#include <KoOptimizedMatrixShaperTransformBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+template<typename SrcChannel, typename DstChannel>
+class KRITAPIGMENT_EXPORT KoOptimizedMatrixShaperTransformFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoOptimizedMatrixShaperTransformBase* create(QSharedPointer<const KoOptimizedMatrixShaperTransformBase::Tables> tables);
+};
+
+#endif // KoOptimizedMatrixShaperTransformFACTORYIMPL_H
@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataDownsamplerU8_H
+#define KoOptimizedPixelDataDownsamplerU8_H
+
+#include "KoOptimizedPixelDataDownsamplerU8Base.h"
+
+#include "KoMultiArchBuildSupport.h"
+
+#include <cstdint>
+
+template<typename _impl, typename EnableDummyType = void>
+class KoOptimizedPixelDataDownsamplerU8 : public KoOptimizedPixelDataDownsamplerU8Base
+{
+public:
+    void downsampleRows(const quint8 *srcRow0, const quint8 *srcRow1,
+                        quint8 *dstRow, int numDstPixels) const override
+    {
+        downsampleRowsScalar(srcRow0, srcRow1, dstRow, numDstPixels);
+    }
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+template<typename _impl>
+class KoOptimizedPixelDataDownsamplerU8<
+        _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KoOptimizedPixelDataDownsamplerU8Base
+{
+public:
+    void downsampleRows(const quint8 *srcRow0, const quint8 *srcRow1,
+                        quint8 *dstRow, int numDstPixels) const override
+    {
+        using uint64_v = xsimd::batch<uint64_t, _impl>;
+
+        /**
+         * Every 64-bit lane holds two neighbouring pixels of a row. Even
+         * and odd bytes of the pixels are split into 16-bit fields, so the
+         * four values of a channel can be summed without overflowing into
+         * the neighbouring channel. The averaged pixel ends up in the low
+         * 32 bits of the lane.
+         */
+        const uint64_v channelsMask(0x00FF00FF00FF00FFull);
+        const uint64_v resultMask(0x00FF00FFull);
+        const uint64_v rounding(0x00020002ull);
+
+        const int vectorSize = static_cast<int>(uint64_v::size);
+        const int numBlocks = numDstPixels / vectorSize;
+        const int numScalarPixels = numDstPixels % vectorSize;
+
+        alignas(64) uint64_t buffer[uint64_v::size];
+        quint32 *dstPixels = reinterpret_cast<quint32*>(dstRow);
+
+        for (int i = 0; i < numBlocks; i++) {
+            const auto row0 = uint64_v::load_unaligned(reinterpret_cast<const uint64_t*>(srcRow0));
+            const auto row1 = uint64_v::load_unaligned(reinterpret_cast<const uint64_t*>(srcRow1));
+
+            auto even = (row0 & channelsMask) + (row1 & channelsMask);
+            auto odd = ((row0 >> 8) & channelsMask) + ((row1 >> 8) & channelsMask);
+
+            even = ((even + (even >> 32) + rounding) >> 2) & resultMask;
+            odd = ((odd + (odd >> 32) + rounding) >> 2) & resultMask;
+
+            (even | (odd << 8)).store_aligned(buffer);
+
+            for (int j = 0; j < vectorSize; j++) {
+                dstPixels[j] = static_cast<quint32>(buffer[j]);
+            }
+
+            srcRow0 += vectorSize * 8;
+            srcRow1 += vectorSize * 8;
+            dstPixels += vectorSize;
+        }
+
+        downsampleRowsScalar(srcRow0, srcRow1,
+                             reinterpret_cast<quint8*>(dstPixels),
+                             numScalarPixels);
+    }
+};
+
+#endif /* defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+#endif // KoOptimizedPixelDataDownsamplerU8_H
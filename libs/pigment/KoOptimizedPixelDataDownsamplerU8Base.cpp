@@ -0,0 +1,36 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataDownsamplerU8Base.h"
+
+KoOptimizedPixelDataDownsamplerU8Base::KoOptimizedPixelDataDownsamplerU8Base()
+{
+}
+
+KoOptimizedPixelDataDownsamplerU8Base::~KoOptimizedPixelDataDownsamplerU8Base()
+{
+}
+
+void KoOptimizedPixelDataDownsamplerU8Base::downsampleRowsScalar(const quint8 *srcRow0,
+                                                                 const quint8 *srcRow1,
+                                                                 quint8 *dstRow,
+                                                                 int numDstPixels)
+{
+    static const int pixelSize = 4;
+
+    for (int i = 0; i < numDstPixels; i++) {
+        for (int ch = 0; ch < pixelSize; ch++) {
+            const int sum = srcRow0[ch] + srcRow0[ch + pixelSize] +
+                srcRow1[ch] + srcRow1[ch + pixelSize];
+
+            dstRow[ch] = static_cast<quint8>((sum + 2) >> 2);
+        }
+
+        dstRow += pixelSize;
+        srcRow0 += 2 * pixelSize;
+        srcRow1 += 2 * pixelSize;
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataDownsamplerU8Base_H
+#define KoOptimizedPixelDataDownsamplerU8Base_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Downsamples 8-bit four-channel pixel data by a factor of 2
+ *
+ * Every destination pixel is a rounded average of a 2x2 block of
+ * source pixels, each channel averaged separately. It is used for
+ * building the mipmap pyramid of the QPainter canvas, so it must be
+ * fast enough to keep up with the user painting on a zoomed out
+ * canvas.
+ *
+ * The actual implementation is placed in class
+ * `KoOptimizedPixelDataDownsamplerU8`.
+ *
+ * To create a downsampler, just call a factory. It will create a version
+ * of the downsampler optimized for your CPU architecture.
+ *
+ * \code{.cpp}
+ * QScopedPointer<KoOptimizedPixelDataDownsamplerU8Base> downsampler(
+ *     KoOptimizedPixelDataDownsamplerU8Factory::createRgbaDownsampler());
+ *
+ * // average two source rows into one destination row
+ * downsampler->downsampleRows(srcRow0, srcRow1, dstRow, numDstPixels);
+ * \endcode
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataDownsamplerU8Base
+{
+public:
+    KoOptimizedPixelDataDownsamplerU8Base();
+
+    virtual ~KoOptimizedPixelDataDownsamplerU8Base();
+
+    /**
+     * Averages \p srcRow0 and \p srcRow1, each containing
+     * 2 * \p numDstPixels pixels, into \p dstRow
+     */
+    virtual void downsampleRows(const quint8 *srcRow0, const quint8 *srcRow1,
+                                quint8 *dstRow, int numDstPixels) const = 0;
+
+protected:
+    static void downsampleRowsScalar(const quint8 *srcRow0, const quint8 *srcRow1,
+                                     quint8 *dstRow, int numDstPixels);
+};
+
+#endif // KoOptimizedPixelDataDownsamplerU8Base_H
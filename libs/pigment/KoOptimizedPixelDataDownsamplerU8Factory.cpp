@@ -0,0 +1,16 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataDownsamplerU8Factory.h"
+
+#include "KoOptimizedPixelDataDownsamplerU8FactoryImpl.h"
+
+
+KoOptimizedPixelDataDownsamplerU8Base *KoOptimizedPixelDataDownsamplerU8Factory::createRgbaDownsampler()
+{
+    return createOptimizedClass<
+            KoOptimizedPixelDataDownsamplerU8FactoryImpl>();
+}
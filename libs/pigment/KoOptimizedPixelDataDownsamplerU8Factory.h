@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataDownsamplerU8FACTORY_H
+#define KoOptimizedPixelDataDownsamplerU8FACTORY_H
+
+#include "KoOptimizedPixelDataDownsamplerU8Base.h"
+
+/**
+ * \see KoOptimizedPixelDataDownsamplerU8Base
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataDownsamplerU8Factory
+{
+public:
+    static KoOptimizedPixelDataDownsamplerU8Base* createRgbaDownsampler();
+};
+
+
+#endif // KoOptimizedPixelDataDownsamplerU8FACTORY_H
@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataDownsamplerU8FactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedPixelDataDownsamplerU8.h"
+
+template<>
+KoOptimizedPixelDataDownsamplerU8Base *
+KoOptimizedPixelDataDownsamplerU8FactoryImpl::create<xsimd::current_arch>()
+{
+    return new KoOptimizedPixelDataDownsamplerU8<xsimd::current_arch>();
+}
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
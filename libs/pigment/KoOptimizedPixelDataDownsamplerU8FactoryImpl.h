@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataDownsamplerU8FACTORYIMPL_H
+#define KoOptimizedPixelDataDownsamplerU8FACTORYIMPL_H
+
+#include <KoOptimizedPixelDataDownsamplerU8Base.h>
+#include <KoMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataDownsamplerU8FactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoOptimizedPixelDataDownsamplerU8Base* create();
+};
+
+#endif // KoOptimizedPixelDataDownsamplerU8FACTORYIMPL_H
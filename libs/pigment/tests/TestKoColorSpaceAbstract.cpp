@@ -599,4 +599,64 @@ void TestKoColorSpaceAbstract::testBitBltCrossColorSpaceWithChannelFlags()
 }
 
 
+void TestKoColorSpaceAbstract::testAddPixelsToHistogramU8_data()
+{
+    QTest::addColumn<QString>("modelId");
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<int>("stride");
+
+    QTest::newRow("u8") << RGBAColorModelID.id() << Integer8BitsColorDepthID.id() << 1;
+    QTest::newRow("u8-stride") << RGBAColorModelID.id() << Integer8BitsColorDepthID.id() << 3;
+    QTest::newRow("u16") << RGBAColorModelID.id() << Integer16BitsColorDepthID.id() << 1;
+    QTest::newRow("u16-stride") << RGBAColorModelID.id() << Integer16BitsColorDepthID.id() << 3;
+    QTest::newRow("f32") << RGBAColorModelID.id() << Float32BitsColorDepthID.id() << 2;
+
+    // Lab scales the a and b channels non-linearly
+    QTest::newRow("lab-u16") << LABAColorModelID.id() << Integer16BitsColorDepthID.id() << 1;
+    QTest::newRow("lab-u16-stride") << LABAColorModelID.id() << Integer16BitsColorDepthID.id() << 3;
+}
+
+void TestKoColorSpaceAbstract::testAddPixelsToHistogramU8()
+{
+    QFETCH(QString, modelId);
+    QFETCH(QString, depthId);
+    QFETCH(int, stride);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace(modelId, depthId);
+    QVERIFY(cs);
+
+    const int numPixels = 1000;
+    const int channelCount = cs->channelCount();
+
+    QVector<float> channels(channelCount);
+    QByteArray pixels(numPixels * cs->pixelSize(), 0);
+
+    for (int i = 0; i < numPixels; i++) {
+        for (int c = 0; c < channelCount; c++) {
+            channels[c] = float((i * 37 + c * 101) % 1000) / 999.0f;
+        }
+        cs->fromNormalisedChannelsValue(reinterpret_cast<quint8*>(pixels.data()) + i * cs->pixelSize(), channels);
+    }
+
+    QVector<QVector<quint32>> expectedBins(channelCount, QVector<quint32>(256, 0));
+    QVector<QVector<quint32>> bins(channelCount, QVector<quint32>(256, 0));
+    QVector<quint32*> binPointers(channelCount);
+
+    for (int c = 0; c < channelCount; c++) {
+        binPointers[c] = bins[c].data();
+    }
+
+    const quint8 *src = reinterpret_cast<const quint8*>(pixels.constData());
+
+    for (int i = 0; i < numPixels; i += stride) {
+        for (int c = 0; c < channelCount; c++) {
+            expectedBins[c][cs->scaleToU8(src + i * cs->pixelSize(), c)]++;
+        }
+    }
+
+    cs->addPixelsToHistogramU8(src, numPixels, stride, binPointers.data());
+
+    QCOMPARE(bins, expectedBins);
+}
+
 SIMPLE_TEST_MAIN(TestKoColorSpaceAbstract)
@@ -0,0 +1,188 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoOptimizedMatrixShaperTransform.h"
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+#include <QVector>
+
+#include <simpletest.h>
+
+#include "KoColorModelStandardIds.h"
+#include "KoColorProfile.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceRegistry.h"
+#include "KoOptimizedMatrixShaperTransformFactory.h"
+#include "KoOptimizedMatrixShaperTransformFactoryImpl.h"
+
+namespace {
+
+const KoColorSpace* rgbColorSpace(const KoID &depth, const KoColorProfile *profile)
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depth.id(), profile);
+}
+
+QVector<quint8> randomPixels(const KoColorSpace *cs, int numPixels)
+{
+    QVector<quint8> pixels(numPixels * cs->pixelSize());
+
+    QRandomGenerator random(numPixels);
+    for (int i = 0; i < pixels.size(); i++) {
+        pixels[i] = static_cast<quint8>(random.bounded(256));
+    }
+
+    // pure black, white and primaries go first
+    const quint8 specialPixels[][4] = {
+        {0, 0, 0, 255}, {255, 255, 255, 255},
+        {255, 0, 0, 255}, {0, 255, 0, 255}, {0, 0, 255, 128}
+    };
+
+    const int channelSize = cs->pixelSize() / 4;
+    for (int i = 0; i < 5 && i < numPixels; i++) {
+        for (int ch = 0; ch < 4; ch++) {
+            for (int b = 0; b < channelSize; b++) {
+                pixels[i * cs->pixelSize() + ch * channelSize + b] = specialPixels[i][ch];
+            }
+        }
+    }
+
+    return pixels;
+}
+
+int maxChannelDifference(const KoColorSpace *cs, const QVector<quint8> &lhs, const QVector<quint8> &rhs)
+{
+    int result = 0;
+
+    if (cs->colorDepthId() == Integer8BitsColorDepthID) {
+        for (int i = 0; i < lhs.size(); i++) {
+            result = qMax(result, qAbs(int(lhs[i]) - int(rhs[i])));
+        }
+    } else {
+        const quint16 *lhsPtr = reinterpret_cast<const quint16*>(lhs.constData());
+        const quint16 *rhsPtr = reinterpret_cast<const quint16*>(rhs.constData());
+        for (int i = 0; i < lhs.size() / 2; i++) {
+            result = qMax(result, qAbs(int(lhsPtr[i]) - int(rhsPtr[i])));
+        }
+    }
+
+    return result;
+}
+
+}
+
+void TestKoOptimizedMatrixShaperTransform::testCompareWithLcms_data()
+{
+    QTest::addColumn<QString>("srcDepth");
+    QTest::addColumn<QString>("dstDepth");
+    QTest::addColumn<QString>("dstProfile");
+    QTest::addColumn<int>("tolerance");
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+    const QString srgb = registry->rgb8()->profile()->name();
+    const QString rec2020Linear = registry->p2020G10Profile()->name();
+    const QString rec709Linear = registry->p709G10Profile()->name();
+
+    QTest::newRow("u8-srgb-u8-srgb") << Integer8BitsColorDepthID.id() << Integer8BitsColorDepthID.id() << srgb << 1;
+    QTest::newRow("u8-srgb-u8-709-linear") << Integer8BitsColorDepthID.id() << Integer8BitsColorDepthID.id() << rec709Linear << 2;
+    QTest::newRow("u8-srgb-u8-2020-linear") << Integer8BitsColorDepthID.id() << Integer8BitsColorDepthID.id() << rec2020Linear << 2;
+    QTest::newRow("u8-srgb-u16-2020-linear") << Integer8BitsColorDepthID.id() << Integer16BitsColorDepthID.id() << rec2020Linear << 64;
+    QTest::newRow("u16-srgb-u8-709-linear") << Integer16BitsColorDepthID.id() << Integer8BitsColorDepthID.id() << rec709Linear << 2;
+    QTest::newRow("u16-srgb-u16-2020-linear") << Integer16BitsColorDepthID.id() << Integer16BitsColorDepthID.id() << rec2020Linear << 64;
+}
+
+void TestKoOptimizedMatrixShaperTransform::testCompareWithLcms()
+{
+    QFETCH(QString, srcDepth);
+    QFETCH(QString, dstDepth);
+    QFETCH(QString, dstProfile);
+    QFETCH(int, tolerance);
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    const KoColorSpace *srcCS = registry->colorSpace(RGBAColorModelID.id(), srcDepth, registry->rgb8()->profile());
+    const KoColorSpace *dstCS = registry->colorSpace(RGBAColorModelID.id(), dstDepth, dstProfile);
+    QVERIFY(srcCS);
+    QVERIFY(dstCS);
+
+    const KoColorConversionTransformation::Intent intent = KoColorConversionTransformation::IntentPerceptual;
+    const KoColorConversionTransformation::ConversionFlags flags =
+        KoColorConversionTransformation::HighQuality | KoColorConversionTransformation::BlackpointCompensation;
+
+    QScopedPointer<KoOptimizedMatrixShaperTransformBase> transform(
+        KoOptimizedMatrixShaperTransformFactory::create(srcCS, dstCS, intent, flags));
+    QVERIFY(transform);
+
+    const int numPixels = 1031;
+    const QVector<quint8> src = randomPixels(srcCS, numPixels);
+
+    QVector<quint8> optimizedResult(numPixels * dstCS->pixelSize());
+    QVector<quint8> lcmsResult(numPixels * dstCS->pixelSize());
+
+    transform->transform(src.constData(), optimizedResult.data(), numPixels);
+    srcCS->convertPixelsTo(src.constData(), lcmsResult.data(), dstCS, numPixels, intent, flags);
+
+    QVERIFY2(maxChannelDifference(dstCS, optimizedResult, lcmsResult) <= tolerance,
+             qPrintable(QString("difference: %1").arg(maxChannelDifference(dstCS, optimizedResult, lcmsResult))));
+}
+
+void TestKoOptimizedMatrixShaperTransform::testCompareWithScalar()
+{
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+    const KoColorSpace *srcCS = registry->rgb8();
+    const KoColorSpace *dstCS = rgbColorSpace(Integer16BitsColorDepthID, registry->p2020G10Profile());
+
+    QScopedPointer<KoOptimizedMatrixShaperTransformBase> optimized(
+        KoOptimizedMatrixShaperTransformFactory::create(srcCS, dstCS,
+                                                        KoColorConversionTransformation::IntentPerceptual,
+                                                        KoColorConversionTransformation::HighQuality));
+    QVERIFY(optimized);
+
+    const int numPixels = 67;
+    const QVector<quint8> src = randomPixels(srcCS, numPixels);
+
+    QVector<quint8> optimizedResult(numPixels * dstCS->pixelSize());
+    optimized->transform(src.constData(), optimizedResult.data(), numPixels);
+
+    // the tail of every length is processed by the scalar code path,
+    // so the results of all the prefixes must match the whole run
+    for (int length = 1; length < 20; length++) {
+        QVector<quint8> partialResult(length * dstCS->pixelSize());
+        optimized->transform(src.constData(), partialResult.data(), length);
+        QVERIFY(std::equal(partialResult.begin(), partialResult.end(), optimizedResult.begin()));
+    }
+}
+
+void TestKoOptimizedMatrixShaperTransform::testUnsupported()
+{
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    const KoColorSpace *rgb8 = registry->rgb8();
+    const KoColorSpace *rgb16 = rgbColorSpace(Integer16BitsColorDepthID, registry->p709G10Profile());
+    const KoColorSpace *rgbF32 = rgbColorSpace(Float32BitsColorDepthID, registry->p2020G10Profile());
+    const KoColorSpace *lab16 = registry->lab16();
+
+    const KoColorConversionTransformation::Intent intent = KoColorConversionTransformation::IntentPerceptual;
+    const KoColorConversionTransformation::ConversionFlags flags = KoColorConversionTransformation::HighQuality;
+
+    QVERIFY(KoOptimizedMatrixShaperTransformFactory::isSupported(rgb8, rgb16, intent, flags));
+
+    QVERIFY(!KoOptimizedMatrixShaperTransformFactory::isSupported(rgb8, lab16, intent, flags));
+    QVERIFY(!KoOptimizedMatrixShaperTransformFactory::isSupported(lab16, rgb8, intent, flags));
+
+    if (rgbF32) {
+        QVERIFY(!KoOptimizedMatrixShaperTransformFactory::isSupported(rgb8, rgbF32, intent, flags));
+    }
+
+    QVERIFY(!KoOptimizedMatrixShaperTransformFactory::isSupported(
+                rgb8, rgb16, KoColorConversionTransformation::IntentAbsoluteColorimetric, flags));
+    QVERIFY(!KoOptimizedMatrixShaperTransformFactory::isSupported(
+                rgb8, rgb16, intent, flags | KoColorConversionTransformation::SoftProofing));
+
+    QVERIFY(!KoOptimizedMatrixShaperTransformFactory::create(rgb8, lab16, intent, flags));
+}
+
+SIMPLE_TEST_MAIN(TestKoOptimizedMatrixShaperTransform)
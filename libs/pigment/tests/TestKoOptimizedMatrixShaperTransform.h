@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDMATRIXSHAPERTRANSFORM_H
+#define TESTKOOPTIMIZEDMATRIXSHAPERTRANSFORM_H
+
+#include <QObject>
+
+class TestKoOptimizedMatrixShaperTransform : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testCompareWithLcms_data();
+    void testCompareWithLcms();
+    void testCompareWithScalar();
+    void testUnsupported();
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoOptimizedPixelDataDownsamplerU8.h"
+
+#include <algorithm>
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+#include <QVector>
+
+#include <simpletest.h>
+
+#include "KoOptimizedPixelDataDownsamplerU8Factory.h"
+#include "KoOptimizedPixelDataDownsamplerU8FactoryImpl.h"
+
+void TestKoOptimizedPixelDataDownsamplerU8::testDownsampleRows_data()
+{
+    QTest::addColumn<int>("numDstPixels");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("7") << 7;
+    QTest::newRow("32") << 32;
+    QTest::newRow("61") << 61;
+}
+
+void TestKoOptimizedPixelDataDownsamplerU8::testDownsampleRows()
+{
+    QFETCH(int, numDstPixels);
+
+    QScopedPointer<KoOptimizedPixelDataDownsamplerU8Base> optimized(
+        KoOptimizedPixelDataDownsamplerU8Factory::createRgbaDownsampler());
+    QScopedPointer<KoOptimizedPixelDataDownsamplerU8Base> scalar(
+        createScalarClass<KoOptimizedPixelDataDownsamplerU8FactoryImpl>());
+
+    const int numSrcBytes = numDstPixels * 2 * 4;
+
+    QVector<quint8> row0(numSrcBytes);
+    QVector<quint8> row1(numSrcBytes);
+
+    QRandomGenerator random(numDstPixels);
+    for (int i = 0; i < numSrcBytes; i++) {
+        row0[i] = static_cast<quint8>(random.bounded(256));
+        row1[i] = static_cast<quint8>(random.bounded(256));
+    }
+
+    // the extreme values must not overflow into the neighbouring channels
+    std::fill(row0.begin(), row0.begin() + 8, 255);
+    std::fill(row1.begin(), row1.begin() + 8, 255);
+
+    QVector<quint8> optimizedResult(numDstPixels * 4);
+    QVector<quint8> scalarResult(numDstPixels * 4);
+
+    optimized->downsampleRows(row0.constData(), row1.constData(), optimizedResult.data(), numDstPixels);
+    scalar->downsampleRows(row0.constData(), row1.constData(), scalarResult.data(), numDstPixels);
+
+    QCOMPARE(optimizedResult, scalarResult);
+
+    for (int ch = 0; ch < 4; ch++) {
+        QCOMPARE(int(scalarResult[ch]), 255);
+
+        const int sum = row0[8 + ch] + row0[12 + ch] + row1[8 + ch] + row1[12 + ch];
+        if (numDstPixels > 1) {
+            QCOMPARE(int(scalarResult[4 + ch]), (sum + 2) / 4);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestKoOptimizedPixelDataDownsamplerU8)
@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDPIXELDATADOWNSAMPLERU8_H
+#define TESTKOOPTIMIZEDPIXELDATADOWNSAMPLERU8_H
+
+#include <QObject>
+
+class TestKoOptimizedPixelDataDownsamplerU8 : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testDownsampleRows_data();
+    void testDownsampleRows();
+};
+
+#endif
@@ -9,8 +9,12 @@
 
 #include <QIODevice>
 #include <QMap>
+#include <QSharedPointer>
+#include <QtConcurrent>
 #include <QtEndian>
 #include <QtGlobal>
+#include <cstring>
+#include <numeric>
 
 #include <KoColorSpace.h>
 #include <KoColorSpaceMaths.h>
@@ -298,41 +302,141 @@ void readAlphaMaskPixelCommon(int channelSize, const QMap<quint16, QByteArray> &
     }
 }
 
-QMap<quint16, QByteArray> fetchChannelsBytes(QIODevice &io, QVector<ChannelInfo *> channelInfoRecords, int row, int width, int channelSize, bool processMasks)
+/**
+ * The height of the row bands the channels are decoded in. It is equal
+ * to the height of a tile, so that every band is written into the
+ * device in a single pass over a row of tiles.
+ */
+static const int decodingBandHeight = 64;
+
+struct ChannelDecodingJob {
+    ChannelInfo *info = nullptr;
+
+    // the compressed data of the current band
+    QByteArray compressedBytes;
+
+    // ZIP channels are a single stream, which is inflated band by band
+    QSharedPointer<Compression::ZipRowDecoder> zipDecoder;
+
+    QByteArray uncompressedBytes;
+    bool failed = false;
+};
+
+/**
+ * Reads the compressed data of the rows [firstRow, firstRow + numRows)
+ * of the channel. The device can only be read sequentially, so it is
+ * done for all the channels before the band is decoded in parallel.
+ */
+void fetchChannelBand(QIODevice &io, ChannelDecodingJob &job, int firstRow, int numRows, int rowLength)
+{
+    ChannelInfo *channelInfo = job.info;
+
+    if (channelInfo->compressionType == psd_compression_type::Uncompressed) {
+        const qint64 bandLength = qint64(rowLength) * numRows;
+
+        io.seek(channelInfo->channelDataStart + channelInfo->channelOffset);
+        job.compressedBytes = io.read(bandLength);
+        channelInfo->channelOffset += bandLength;
+    } else if (channelInfo->compressionType == psd_compression_type::RLE) {
+        qint64 rleLength = 0;
+        for (int row = firstRow; row < firstRow + numRows && row < channelInfo->rleRowLengths.size(); row++) {
+            rleLength += channelInfo->rleRowLengths[row];
+        }
+
+        io.seek(channelInfo->channelDataStart + channelInfo->channelOffset);
+        job.compressedBytes = io.read(rleLength);
+        channelInfo->channelOffset += rleLength;
+    }
+}
+
+void decodeChannelBand(ChannelDecodingJob &job, int firstRow, int numRows, int rowLength)
 {
-    const int uncompressedLength = width * channelSize;
+    const int bandLength = rowLength * numRows;
+
+    switch (job.info->compressionType) {
+    case psd_compression_type::Uncompressed:
+        job.uncompressedBytes = job.compressedBytes;
+        job.failed = job.uncompressedBytes.size() != bandLength;
+        break;
+    case psd_compression_type::RLE: {
+        // every row is a separate PackBits stream, broken rows are left transparent
+        job.uncompressedBytes = QByteArray(bandLength, '\0');
+
+        const char *src = job.compressedBytes.constData();
+        int srcLeft = job.compressedBytes.size();
+
+        for (int row = 0; row < numRows && firstRow + row < job.info->rleRowLengths.size(); row++) {
+            const int rleLength = static_cast<int>(job.info->rleRowLengths[firstRow + row]);
+            if (rleLength > srcLeft) {
+                dbgFile << "RLE data of the channel is truncated" << ppVar(job.info->channelId) << ppVar(firstRow + row);
+                break;
+            }
+
+            const QByteArray rowBytes = Compression::uncompress(rowLength, QByteArray::fromRawData(src, rleLength), psd_compression_type::RLE);
+            if (rowBytes.size() == rowLength) {
+                memcpy(job.uncompressedBytes.data() + row * rowLength, rowBytes.constData(), static_cast<size_t>(rowLength));
+            }
+
+            src += rleLength;
+            srcLeft -= rleLength;
+        }
+        break;
+    }
+    case psd_compression_type::ZIP:
+    case psd_compression_type::ZIPWithPrediction:
+        job.uncompressedBytes.resize(bandLength);
+        job.failed = !job.zipDecoder->readRows(job.uncompressedBytes.data(), numRows);
+        break;
+    default:
+        job.failed = true;
+    }
+
+    job.compressedBytes.clear();
+}
 
-    QMap<quint16, QByteArray> channelBytes;
+QVector<ChannelDecodingJob> prepareChannelsDecoding(QIODevice &io, QVector<ChannelInfo *> channelInfoRecords, const QRect &layerRect, int channelSize, bool processMasks)
+{
+    QVector<ChannelDecodingJob> jobs;
 
     Q_FOREACH (ChannelInfo *channelInfo, channelInfoRecords) {
         // user supplied masks are ignored here
         if (!processMasks && channelInfo->channelId < -1)
             continue;
 
-        io.seek(channelInfo->channelDataStart + channelInfo->channelOffset);
+        ChannelDecodingJob job;
+        job.info = channelInfo;
 
-        if (channelInfo->compressionType == psd_compression_type::Uncompressed) {
-            channelBytes[channelInfo->channelId] = io.read(uncompressedLength);
-            channelInfo->channelOffset += uncompressedLength;
-        } else if (channelInfo->compressionType == psd_compression_type::RLE) {
-            int rleLength = channelInfo->rleRowLengths[row];
-            QByteArray compressedBytes = io.read(rleLength);
-            QByteArray uncompressedBytes = Compression::uncompress(uncompressedLength, compressedBytes, channelInfo->compressionType);
-            channelBytes.insert(channelInfo->channelId, uncompressedBytes);
-            channelInfo->channelOffset += rleLength;
-        } else {
+        if (channelInfo->compressionType == psd_compression_type::ZIP
+            || channelInfo->compressionType == psd_compression_type::ZIPWithPrediction) {
+
+            io.seek(channelInfo->channelDataStart);
+            job.zipDecoder.reset(new Compression::ZipRowDecoder(io.read(channelInfo->channelDataLength),
+                                                                channelInfo->compressionType,
+                                                                layerRect.width(),
+                                                                channelSize * 8));
+        } else if (channelInfo->compressionType != psd_compression_type::Uncompressed
+                   && channelInfo->compressionType != psd_compression_type::RLE) {
             QString error = QString("Unsupported Compression mode: %1")
                                 .arg(static_cast<std::uint16_t>(channelInfo->compressionType));
-            dbgFile << "ERROR: fetchChannelsBytes:" << error;
+            dbgFile << "ERROR: prepareChannelsDecoding:" << error;
             throw KisAslReaderUtils::ASLParseException(error);
         }
+
+        jobs.append(job);
     }
 
-    return channelBytes;
+    return jobs;
 }
 
 using PixelFunc = std::function<void(int, const QMap<quint16, QByteArray> &, int, quint8 *)>;
 
+/**
+ * The channels are decoded in bands of rows: the compressed data of the
+ * band is read for all the channels, then the channels are decoded in
+ * parallel and the band is written into the device before the next one
+ * is decoded. This way, only one band of the uncompressed planes is kept
+ * in memory at a time.
+ */
 void readCommon(KisPaintDeviceSP dev,
                 QIODevice &io,
                 const QRect &layerRect,
@@ -348,58 +452,57 @@ void readCommon(KisPaintDeviceSP dev,
         return;
     }
 
-    if (infoRecords.first()->compressionType == psd_compression_type::ZIP || infoRecords.first()->compressionType == psd_compression_type::ZIPWithPrediction) {
-        const int numPixels = channelSize * layerRect.width() * layerRect.height();
+    QVector<ChannelDecodingJob> jobs = prepareChannelsDecoding(io, infoRecords, layerRect, channelSize, processMasks);
 
-        QMap<quint16, QByteArray> channelBytes;
+    const int rowLength = layerRect.width() * channelSize;
+
+    int bandTop = layerRect.top();
+    while (bandTop <= layerRect.bottom()) {
+        // align the bands to the rows of tiles of the device
+        const int bandOffset = (bandTop % decodingBandHeight + decodingBandHeight) % decodingBandHeight;
+        const int bandBottom = qMin(layerRect.bottom(), bandTop - bandOffset + decodingBandHeight - 1);
+        const QRect bandRect(layerRect.left(), bandTop, layerRect.width(), bandBottom - bandTop + 1);
 
-        Q_FOREACH (ChannelInfo *info, infoRecords) {
-            io.seek(info->channelDataStart);
-            QByteArray compressedBytes = io.read(info->channelDataLength);
-            QByteArray uncompressedBytes;
+        const int firstRow = bandTop - layerRect.top();
+        const int numRows = bandRect.height();
+
+        for (ChannelDecodingJob &job : jobs) {
+            fetchChannelBand(io, job, firstRow, numRows, rowLength);
+        }
 
-            uncompressedBytes = Compression::uncompress(numPixels, compressedBytes, infoRecords.first()->compressionType, layerRect.width(), channelSize * 8);
+        QtConcurrent::blockingMap(jobs, [&](ChannelDecodingJob &job) {
+            decodeChannelBand(job, firstRow, numRows, rowLength);
+        });
 
-            if (uncompressedBytes.size() != numPixels) {
-                QString error = QString("Failed to unzip channel data: id = %1, compression = %2")
-                                    .arg(info->channelId)
-                                    .arg(static_cast<std::uint16_t>(info->compressionType));
+        QMap<quint16, QByteArray> channelBytes;
+
+        // exceptions cannot cross the thread pool, so report errors here
+        for (ChannelDecodingJob &job : jobs) {
+            if (job.failed) {
+                QString error = QString("Failed to decompress channel data: id = %1, compression = %2")
+                                    .arg(job.info->channelId)
+                                    .arg(static_cast<std::uint16_t>(job.info->compressionType));
                 dbgFile << "ERROR:" << error;
-                dbgFile << "      " << ppVar(info->channelId);
-                dbgFile << "      " << ppVar(info->channelDataStart);
-                dbgFile << "      " << ppVar(info->channelDataLength);
-                dbgFile << "      " << ppVar(info->compressionType);
+                dbgFile << "      " << ppVar(job.info->channelId);
+                dbgFile << "      " << ppVar(job.info->channelDataStart);
+                dbgFile << "      " << ppVar(job.info->channelDataLength);
+                dbgFile << "      " << ppVar(job.info->compressionType);
+                dbgFile << "      " << ppVar(firstRow);
                 throw KisAslReaderUtils::ASLParseException(error);
             }
 
-            channelBytes.insert(info->channelId, uncompressedBytes);
+            channelBytes.insert(job.info->channelId, job.uncompressedBytes);
+            job.uncompressedBytes.clear();
         }
 
-        KisSequentialIterator it(dev, layerRect);
+        KisSequentialIterator it(dev, bandRect);
         int col = 0;
         while (it.nextPixel()) {
             pixelFunc(channelSize, channelBytes, col, it.rawData());
             col++;
         }
 
-    } else {
-        KisHLineIteratorSP it = dev->createHLineIteratorNG(layerRect.left(), layerRect.top(), layerRect.width());
-        for (int i = 0; i < layerRect.height(); i++) {
-            QMap<quint16, QByteArray> channelBytes;
-
-            channelBytes = fetchChannelsBytes(io, infoRecords, i, layerRect.width(), channelSize, processMasks);
-
-            for (int col = 0; col < layerRect.width(); col++) {
-                pixelFunc(channelSize, channelBytes, col, it->rawData());
-                it->nextPixel();
-            }
-
-            /// don't write-access the row right after the
-            /// the end of the read area
-            if (i < layerRect.height() - 1) {
-                it->nextRow();
-            }
-        }
+        bandTop = bandBottom + 1;
     }
 }
 
@@ -473,10 +576,29 @@ void readAlphaMaskChannels(QIODevice &io,
     }
 }
 
+QVector<QByteArray> compressChannelDataRLE(const quint8 *plane, const int channelSize, const QRect &rc)
+{
+    QVector<QByteArray> compressedRows;
+    compressedRows.reserve(rc.height());
+
+    const int stride = channelSize * rc.width();
+    for (qint32 row = 0; row < rc.height(); ++row) {
+        QByteArray uncompressed = QByteArray::fromRawData((const char *)plane + row * stride, stride);
+        compressedRows.append(Compression::compress(uncompressed, psd_compression_type::RLE));
+    }
+
+    return compressedRows;
+}
+
+QByteArray compressChannelDataZIP(const quint8 *plane, const int channelSize, const QRect &rc)
+{
+    QByteArray uncompressed = QByteArray::fromRawData(reinterpret_cast<const char *>(plane), rc.width() * rc.height() * channelSize);
+    return Compression::compress(uncompressed, psd_compression_type::ZIP);
+}
+
 template<psd_byte_order byteOrder = psd_byte_order::psdBigEndian>
 void writeChannelDataRLEImpl(QIODevice &io,
-                             const quint8 *plane,
-                             const int channelSize,
+                             const QVector<QByteArray> &compressedRows,
                              const QRect &rc,
                              const qint64 sizeFieldOffset,
                              const qint64 rleBlockOffset,
@@ -513,10 +635,10 @@ void writeChannelDataRLEImpl(QIODevice &io,
         }
     }
 
-    const int stride = channelSize * rc.width();
+    KIS_ASSERT_RECOVER_RETURN(compressedRows.size() == rc.height());
+
     for (qint32 row = 0; row < rc.height(); ++row) {
-        QByteArray uncompressed = QByteArray::fromRawData((const char *)plane + row * stride, stride);
-        QByteArray compressed = Compression::compress(uncompressed, psd_compression_type::RLE);
+        const QByteArray &compressed = compressedRows[row];
 
         KisAslWriterUtils::OffsetStreamPusher<quint16, byteOrder> rleExternalTag(io, 0, channelRLESizePos + row * static_cast<qint64>(sizeof(quint16)));
 
@@ -528,9 +650,7 @@ void writeChannelDataRLEImpl(QIODevice &io,
 
 template<psd_byte_order byteOrder = psd_byte_order::psdBigEndian>
 void writeChannelDataZIPImpl(QIODevice &io,
-                             const quint8 *plane,
-                             const int channelSize,
-                             const QRect &rc,
+                             const QByteArray &compressed,
                              const qint64 sizeFieldOffset,
                              const bool writeCompressionType)
 {
@@ -544,9 +664,6 @@ void writeChannelDataZIPImpl(QIODevice &io,
         SAFE_WRITE_EX(byteOrder, io, static_cast<quint16>(psd_compression_type::ZIP));
     }
 
-    QByteArray uncompressed(reinterpret_cast<const char *>(plane), rc.width() * rc.height() * channelSize);
-    QByteArray compressed(Compression::compress(uncompressed, psd_compression_type::ZIP));
-
     if (compressed.size() == 0 || io.write(compressed) != compressed.size()) {
         throw KisAslWriterUtils::ASLWriteException("Failed to write image data");
     }
@@ -563,9 +680,9 @@ void writeChannelDataRLE(QIODevice &io,
 {
     switch (byteOrder) {
     case psd_byte_order::psdLittleEndian:
-        return writeChannelDataRLEImpl<psd_byte_order::psdLittleEndian>(io, plane, channelSize, rc, sizeFieldOffset, rleBlockOffset, writeCompressionType);
+        return writeChannelDataRLEImpl<psd_byte_order::psdLittleEndian>(io, compressChannelDataRLE(plane, channelSize, rc), rc, sizeFieldOffset, rleBlockOffset, writeCompressionType);
     default:
-        return writeChannelDataRLEImpl(io, plane, channelSize, rc, sizeFieldOffset, rleBlockOffset, writeCompressionType);
+        return writeChannelDataRLEImpl(io, compressChannelDataRLE(plane, channelSize, rc), rc, sizeFieldOffset, rleBlockOffset, writeCompressionType);
     }
 }
 
@@ -663,6 +780,34 @@ void writePixelDataCommonImpl(QIODevice &io,
     KIS_ASSERT_RECOVER_RETURN(planes.size() >= writingInfoList.size());
 
     const int numPixels = rc.width() * rc.height();
+    const bool useZip = compressionType == psd_compression_type::ZIP || compressionType == psd_compression_type::ZIPWithPrediction;
+
+    // the channels are prepared and compressed in parallel, only
+    // writing them into the device must be sequential
+
+    QVector<int> channelIndexes(writingInfoList.size());
+    std::iota(channelIndexes.begin(), channelIndexes.end(), 0);
+
+    QVector<QVector<QByteArray>> compressedChannels(writingInfoList.size());
+
+    // access the containers via raw pointers to avoid detach checks in the workers
+    quint8 **planesPtr = planes.data();
+    QVector<QByteArray> *compressedPtr = compressedChannels.data();
+    const ChannelWritingInfo *infoPtr = writingInfoList.constData();
+
+    QtConcurrent::blockingMap(channelIndexes, [&](int i) {
+        // WARNING: Pixel data is ALWAYS in big endian!!!
+        preparePixelForWrite<psd_byte_order::psdBigEndian>(planesPtr[i], numPixels, channelSize, infoPtr[i].channelId, colorMode);
+
+        if (useZip) {
+            compressedPtr[i] = {compressChannelDataZIP(planesPtr[i], channelSize, rc)};
+        } else {
+            compressedPtr[i] = compressChannelDataRLE(planesPtr[i], channelSize, rc);
+        }
+
+        delete[] planesPtr[i];
+        planesPtr[i] = nullptr;
+    });
 
     // write down the planes
 
@@ -671,24 +816,15 @@ void writePixelDataCommonImpl(QIODevice &io,
             const ChannelWritingInfo &info = writingInfoList[i];
 
             dbgFile << "\tWriting channel" << i << "psd channel id" << info.channelId;
-
-            // WARNING: Pixel data is ALWAYS in big endian!!!
-            preparePixelForWrite<psd_byte_order::psdBigEndian>(planes[i], numPixels, channelSize, info.channelId, colorMode);
-
             dbgFile << "\t\tchannel start" << ppVar(io.pos()) << ", compression type" << compressionType;
 
-            switch (compressionType) {
-            case psd_compression_type::ZIP:
-            case psd_compression_type::ZIPWithPrediction: {
-                writeChannelDataZIPImpl<byteOrder>(io, planes[i], channelSize, rc, info.sizeFieldOffset, writeCompressionType);
-                break;
-            }
-            case psd_compression_type::RLE:
-            default: {
-                writeChannelDataRLEImpl<byteOrder>(io, planes[i], channelSize, rc, info.sizeFieldOffset, info.rleBlockOffset, writeCompressionType);
-                break;
-            }
+            if (useZip) {
+                writeChannelDataZIPImpl<byteOrder>(io, compressedChannels[i].first(), info.sizeFieldOffset, writeCompressionType);
+            } else {
+                writeChannelDataRLEImpl<byteOrder>(io, compressedChannels[i], rc, info.sizeFieldOffset, info.rleBlockOffset, writeCompressionType);
             }
+
+            compressedChannels[i].clear();
         }
 
     } catch (KisAslWriterUtils::ASLWriteException &e) {
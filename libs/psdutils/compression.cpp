@@ -12,6 +12,7 @@
 #include <QBuffer>
 #include <QtEndian>
 #include <algorithm>
+#include <cstring>
 #include <zlib.h>
 
 #include <kis_debug.h>
@@ -22,30 +23,29 @@ namespace KisRLE
 // from gimp's psd-save.c
 int compress(const QByteArray &src, QByteArray &dst)
 {
-    int length = src.size();
+    const int length = src.size();
+
+    // a literal packet costs one header byte per 128 bytes of
+    // input, so twice the input size is always enough; the buffer
+    // is not initialized, every byte up to the final size is written
     dst.resize(length * 2);
-    dst.fill(0, length * 2);
 
-    int remaining = length;
-    quint8 i, j;
-    quint32 dest_ptr = 0;
     const char *start = src.constData();
+    char *const outStart = dst.data();
+    char *out = outStart;
+
+    int remaining = length;
 
-    length = 0;
     while (remaining > 0) {
         /* Look for characters matching the first */
-        i = 0;
-        while ((i < 128) && (remaining - i > 0) && (start[0] == start[i]))
+        int i = 1;
+        while ((i < 128) && (i < remaining) && (start[0] == start[i]))
             i++;
 
         if (i > 1) /* Match found */
         {
-            dst[dest_ptr++] = static_cast<char>(-(i - 1));
-            dst[dest_ptr++] = *start;
-
-            start += i;
-            remaining -= i;
-            length += 2;
+            *out++ = static_cast<char>(-(i - 1));
+            *out++ = *start;
         } else { /* Look for characters different from the previous */
             i = 0;
             while ((i < 128) && (remaining - (i + 1) > 0) && (start[i] != start[(i + 1)] || remaining - (i + 2) <= 0 || start[i] != start[(i + 2)]))
@@ -58,20 +58,19 @@ int compress(const QByteArray &src, QByteArray &dst)
                 i = 1;
             }
 
-            if (i > 0) /* Some distinct ones found */
-            {
-                dst[dest_ptr++] = static_cast<char>(i - 1U);
-                for (j = 0; j < i; j++) {
-                    dst[dest_ptr++] = start[j];
-                }
-                start += i;
-                remaining -= i;
-                length += i + 1;
-            }
+            /* Some distinct ones found */
+            *out++ = static_cast<char>(i - 1);
+            std::memcpy(out, start, static_cast<size_t>(i));
+            out += i;
         }
+
+        start += i;
+        remaining -= i;
     }
-    dst.resize(length);
-    return length;
+
+    const int packedLength = static_cast<int>(out - outStart);
+    dst.resize(packedLength);
+    return packedLength;
 }
 
 QByteArray compress(const QByteArray &data)
@@ -167,32 +166,28 @@ int compress(const char *input, int unpacked_len, char *dst, int maxout)
         return 0;
     }
 
-    int flush = Z_PARTIAL_FLUSH;
-
+    // the output buffer is sized with compressBound(), so the whole
+    // stream is expected to be produced in a single pass
     do {
-        state = deflate(&stream, flush);
-        if (state == Z_STREAM_END) {
-            dbgFile << "Finished deflating";
-            flush = Z_FINISH;
-        } else if (state != Z_OK) {
-            dbgFile << "Error deflating" << state << stream.msg;
-            break;
-        }
-    } while (stream.avail_in > 0);
+        state = deflate(&stream, Z_FINISH);
+    } while (state == Z_OK && stream.avail_out > 0);
 
-    if (state != Z_OK || stream.avail_in > 0) {
+    const int result = static_cast<int>(stream.total_out);
+    deflateEnd(&stream);
+
+    if (state != Z_STREAM_END) {
         dbgFile << "Failed deflating" << state << stream.msg;
         return 0;
     }
 
-    dbgFile << "Success, deflated size:" << stream.total_out;
+    dbgFile << "Success, deflated size:" << result;
 
-    return static_cast<int>(stream.total_out);
+    return result;
 }
 
 QByteArray compress(const QByteArray &data)
 {
-    QByteArray output(data.length() * 4, '\0');
+    QByteArray output(static_cast<int>(compressBound(static_cast<uLong>(data.size()))), Qt::Uninitialized);
     const int result = KisZip::compress(data.constData(), data.size(), output.data(), output.size());
     output.resize(result);
     return output;
@@ -228,29 +223,36 @@ int psd_unzip_without_prediction(const char *src, int packed_len, char *dst, int
             break;
         } else if (state == Z_DATA_ERROR) {
             dbgFile << "Error inflating" << state << stream.msg;
-            if (inflateSync(&stream) != Z_OK)
+            if (inflateSync(&stream) != Z_OK) {
+                inflateEnd(&stream);
                 return 0;
+            }
             continue;
+        } else if (state != Z_OK) {
+            // truncated or otherwise broken stream, the caller
+            // reports the failure below
+            break;
         }
     } while (stream.avail_out > 0);
 
+    const int result = static_cast<int>(stream.total_out);
+    inflateEnd(&stream);
+
     if ((state != Z_STREAM_END && state != Z_OK) || stream.avail_out > 0) {
         dbgFile << "Failed inflating" << state << stream.msg;
         return 0;
     }
 
-    return static_cast<int>(stream.total_out);
+    return result;
 }
 
 template<typename T>
-inline void psd_unzip_with_prediction(QByteArray &dst_buf, int row_size);
+inline void psd_unzip_with_prediction(uint8_t *buf, int dst_len, int row_size);
 
 template<>
-inline void psd_unzip_with_prediction<uint8_t>(QByteArray &dst_buf, const int row_size)
+inline void psd_unzip_with_prediction<uint8_t>(uint8_t *buf, int dst_len, const int row_size)
 {
-    auto *buf = reinterpret_cast<uint8_t *>(dst_buf.data());
     int len = 0;
-    int dst_len = dst_buf.size();
 
     while (dst_len > 0) {
         len = row_size;
@@ -264,11 +266,9 @@ inline void psd_unzip_with_prediction<uint8_t>(QByteArray &dst_buf, const int ro
 }
 
 template<>
-inline void psd_unzip_with_prediction<uint16_t>(QByteArray &dst_buf, const int row_size)
+inline void psd_unzip_with_prediction<uint16_t>(uint8_t *buf, int dst_len, const int row_size)
 {
-    auto *buf = reinterpret_cast<uint8_t *>(dst_buf.data());
     int len = 0;
-    int dst_len = dst_buf.size();
 
     while (dst_len > 0) {
         len = row_size;
@@ -294,9 +294,9 @@ QByteArray psd_unzip_with_prediction(const QByteArray &src, int dst_len, int row
         errKrita << "Unsupported bit depth for prediction";
         return {};
     } else if (color_depth == 16) {
-        psd_unzip_with_prediction<quint16>(dst_buf, row_size);
+        psd_unzip_with_prediction<quint16>(reinterpret_cast<uint8_t *>(dst_buf.data()), dst_buf.size(), row_size);
     } else {
-        psd_unzip_with_prediction<quint8>(dst_buf, row_size);
+        psd_unzip_with_prediction<quint8>(reinterpret_cast<uint8_t *>(dst_buf.data()), dst_buf.size(), row_size);
     }
 
     return dst_buf;
@@ -414,3 +414,89 @@ QByteArray Compression::compress(QByteArray bytes, psd_compression_type compress
 
     return QByteArray();
 }
+
+struct Compression::ZipRowDecoder::Private
+{
+    QByteArray bytes;
+    z_stream stream{};
+    bool initialized = false;
+    bool finished = false;
+
+    psd_compression_type compressionType = psd_compression_type::ZIP;
+    int rowSize = 0;
+    int colorDepth = 0;
+};
+
+Compression::ZipRowDecoder::ZipRowDecoder(const QByteArray &bytes, psd_compression_type compressionType, int row_size, int color_depth)
+    : m_d(new Private)
+{
+    m_d->bytes = bytes;
+    m_d->compressionType = compressionType;
+    m_d->rowSize = row_size;
+    m_d->colorDepth = color_depth;
+
+    m_d->stream.data_type = Z_BINARY;
+    m_d->stream.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(m_d->bytes.constData()));
+    m_d->stream.avail_in = static_cast<uInt>(m_d->bytes.size());
+
+    m_d->initialized = inflateInit(&m_d->stream) == Z_OK;
+}
+
+Compression::ZipRowDecoder::~ZipRowDecoder()
+{
+    if (m_d->initialized) {
+        inflateEnd(&m_d->stream);
+    }
+}
+
+bool Compression::ZipRowDecoder::readRows(char *dst, int numRows)
+{
+    if (!m_d->initialized) return false;
+
+    const int length = m_d->rowSize * (m_d->colorDepth / 8) * numRows;
+    if (length <= 0) return true;
+
+    const bool usePrediction = m_d->compressionType == psd_compression_type::ZIPWithPrediction;
+
+    if (usePrediction && m_d->colorDepth == 32) {
+        // Placeholded for future implementation.
+        errKrita << "Unsupported bit depth for prediction";
+        return false;
+    }
+
+    m_d->stream.next_out = reinterpret_cast<Bytef *>(dst);
+    m_d->stream.avail_out = static_cast<uInt>(length);
+
+    while (m_d->stream.avail_out > 0 && !m_d->finished) {
+        const int state = inflate(&m_d->stream, Z_PARTIAL_FLUSH);
+
+        if (state == Z_STREAM_END) {
+            m_d->finished = true;
+        } else if (state == Z_DATA_ERROR) {
+            dbgFile << "Error inflating" << state << m_d->stream.msg;
+            if (inflateSync(&m_d->stream) != Z_OK) {
+                return false;
+            }
+        } else if (state != Z_OK) {
+            dbgFile << "Failed inflating" << state << m_d->stream.msg;
+            return false;
+        }
+    }
+
+    if (m_d->stream.avail_out > 0) {
+        dbgFile << "ZIP data of the channel is truncated";
+        return false;
+    }
+
+    if (usePrediction) {
+        uint8_t *buf = reinterpret_cast<uint8_t *>(dst);
+
+        if (m_d->colorDepth == 16) {
+            KisZip::psd_unzip_with_prediction<quint16>(buf, length, m_d->rowSize);
+        } else {
+            KisZip::psd_unzip_with_prediction<quint8>(buf, length, m_d->rowSize);
+        }
+    }
+
+    return true;
+}
@@ -10,6 +10,7 @@
 #include "kritapsdutils_export.h"
 
 #include <QByteArray>
+#include <QScopedPointer>
 #include <psd.h>
 
 class KRITAPSDUTILS_EXPORT Compression
@@ -17,6 +18,31 @@ class KRITAPSDUTILS_EXPORT Compression
 public:
     static QByteArray uncompress(int unpacked_len, QByteArray bytes, psd_compression_type compressionType, int row_size = 0, int color_depth = 0);
     static QByteArray compress(QByteArray bytes, psd_compression_type compressionType, int row_size = 0, int color_depth = 0);
+
+    /**
+     * Inflates a ZIP-compressed channel plane a few rows at a time, so
+     * that the whole uncompressed plane never has to be kept in memory
+     */
+    class KRITAPSDUTILS_EXPORT ZipRowDecoder
+    {
+    public:
+        ZipRowDecoder(const QByteArray &bytes, psd_compression_type compressionType, int row_size, int color_depth);
+        ~ZipRowDecoder();
+
+        /**
+         * Decompresses the next \p numRows rows of the plane into \p dst
+         *
+         * @return false if the stream is broken, truncated or uses
+         *         an unsupported prediction mode
+         */
+        bool readRows(char *dst, int numRows);
+
+    private:
+        Q_DISABLE_COPY(ZipRowDecoder)
+
+        struct Private;
+        QScopedPointer<Private> m_d;
+    };
 };
 
 #endif // PSD_COMPRESSION_H
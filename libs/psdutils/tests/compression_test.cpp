@@ -10,6 +10,7 @@
 #include <QByteArray>
 #include <QCoreApplication>
 #include <QDataStream>
+#include <QVector>
 #include <cmath>
 #include <klocalizedstring.h>
 
@@ -17,6 +18,8 @@
 #include <kis_debug.h>
 #include <simpletest.h>
 
+Q_DECLARE_METATYPE(psd_compression_type)
+
 void CompressionTest::testCompressionRLE()
 {
     QByteArray ba("Twee eeee aaaaa asdasda47892347981    wwwwwwwwwwwwWWWWWWWWWW");
@@ -89,4 +92,105 @@ void CompressionTest::testCompressionUncompressed()
     QVERIFY(qstrcmp(ba, uncompressed) == 0);
 }
 
+namespace
+{
+/**
+ * Generates a channel plane that looks like a typical painting layer:
+ * transparent margins, flat fills, smooth gradients and some noise
+ */
+QByteArray generateChannelPlane(int width, int height)
+{
+    QByteArray plane(width * height, '\0');
+    quint8 *ptr = reinterpret_cast<quint8 *>(plane.data());
+
+    srand(42);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            quint8 value = 0;
+
+            if (x < width / 8 || x >= width - width / 8) {
+                value = 0;
+            } else if (y < height / 3) {
+                value = 200;
+            } else if (y < 2 * height / 3) {
+                value = static_cast<quint8>((x * 255) / width);
+            } else {
+                value = static_cast<quint8>(rand() % 256);
+            }
+
+            *ptr++ = value;
+        }
+    }
+
+    return plane;
+}
+
+const int largePlaneWidth = 4096;
+const int largePlaneHeight = 256;
+} // namespace
+
+void CompressionTest::testCompressionLargePlane_data()
+{
+    QTest::addColumn<psd_compression_type>("compressionType");
+
+    QTest::newRow("rle") << psd_compression_type::RLE;
+    QTest::newRow("zip") << psd_compression_type::ZIP;
+    QTest::newRow("zip-prediction") << psd_compression_type::ZIPWithPrediction;
+}
+
+void CompressionTest::testCompressionLargePlane()
+{
+    QFETCH(psd_compression_type, compressionType);
+
+    const QByteArray plane = generateChannelPlane(largePlaneWidth, largePlaneHeight);
+
+    if (compressionType == psd_compression_type::RLE) {
+        // PSD stores RLE data row by row
+        for (int row = 0; row < largePlaneHeight; row++) {
+            const QByteArray uncompressedRow = plane.mid(row * largePlaneWidth, largePlaneWidth);
+            const QByteArray compressed = Compression::compress(uncompressedRow, compressionType);
+            QVERIFY(compressed.size() > 0);
+            QVERIFY(compressed.size() <= 2 * largePlaneWidth);
+
+            const QByteArray uncompressed = Compression::uncompress(largePlaneWidth, compressed, compressionType);
+            QCOMPARE(uncompressed, uncompressedRow);
+        }
+    } else {
+        const QByteArray compressed = Compression::compress(plane, compressionType, largePlaneWidth, 8);
+        QVERIFY(compressed.size() > 0);
+        QVERIFY(compressed.size() < plane.size());
+
+        const QByteArray uncompressed = Compression::uncompress(plane.size(), compressed, compressionType, largePlaneWidth, 8);
+        QCOMPARE(uncompressed, plane);
+    }
+}
+
+void CompressionTest::benchmarkCompressRLE()
+{
+    const QByteArray plane = generateChannelPlane(largePlaneWidth, largePlaneHeight);
+
+    QBENCHMARK {
+        for (int row = 0; row < largePlaneHeight; row++) {
+            Compression::compress(QByteArray::fromRawData(plane.constData() + row * largePlaneWidth, largePlaneWidth), psd_compression_type::RLE);
+        }
+    }
+}
+
+void CompressionTest::benchmarkUncompressRLE()
+{
+    const QByteArray plane = generateChannelPlane(largePlaneWidth, largePlaneHeight);
+
+    QVector<QByteArray> compressedRows;
+    for (int row = 0; row < largePlaneHeight; row++) {
+        compressedRows.append(Compression::compress(plane.mid(row * largePlaneWidth, largePlaneWidth), psd_compression_type::RLE));
+    }
+
+    QBENCHMARK {
+        Q_FOREACH (const QByteArray &compressed, compressedRows) {
+            Compression::uncompress(largePlaneWidth, compressed, psd_compression_type::RLE);
+        }
+    }
+}
+
 SIMPLE_TEST_MAIN(CompressionTest)
@@ -17,6 +17,12 @@ private Q_SLOTS:
     void testCompressionRLE();
     void testCompressionZIP();
     void testCompressionUncompressed();
+
+    void testCompressionLargePlane_data();
+    void testCompressionLargePlane();
+
+    void benchmarkCompressRLE();
+    void benchmarkUncompressRLE();
 };
 
 #endif
@@ -9,11 +9,14 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QDirIterator>
+#include <QFileInfo>
 #include <QStringList>
 #include <QElapsedTimer>
 #include <QDataStream>
 #include <QByteArray>
 #include <QMessageBox>
+#include <QThread>
+#include <QThreadStorage>
 
 #include <KritaVersionWrapper.h>
 
@@ -34,12 +37,26 @@
 const QString dbDriver = "QSQLITE";
 
 const QString KisResourceCacheDb::resourceCacheDbFilename { "resourcecache.sqlite" };
-const QString KisResourceCacheDb::databaseVersion { "0.0.17" };
+const QString KisResourceCacheDb::databaseVersion { "0.0.19" };
 QStringList KisResourceCacheDb::storageTypes { QStringList() };
 QStringList KisResourceCacheDb::disabledBundles { QStringList() << "Krita_3_Default_Resources.bundle" };
+const QVector<int> KisResourceCacheDb::thumbnailLevelSizes { 64, 128, 256 };
 
 bool KisResourceCacheDb::s_valid {false};
 QString KisResourceCacheDb::s_lastError {QString()};
+QString KisResourceCacheDb::s_databasePath {QString()};
+
+namespace {
+/// removes the connection made by threadLocalDatabase() when its thread exits
+struct ThreadLocalConnection {
+    ~ThreadLocalConnection() {
+        QSqlDatabase::removeDatabase(name);
+    }
+    QString name;
+};
+
+QThreadStorage<ThreadLocalConnection*> s_threadLocalConnections;
+}
 
 bool KisResourceCacheDb::isValid()
 {
@@ -178,15 +195,21 @@ QSqlError createDatabase(const QString &location)
                 schemaIsOutDated = true;
                 KisBackup::numberedBackupFile(location + "/" + KisResourceCacheDb::resourceCacheDbFilename);
 
-                if (newSchemaVersionNumber == QVersionNumber::fromString("0.0.17")
+                if (newSchemaVersionNumber == QVersionNumber::fromString("0.0.19")
                         && QVersionNumber::compare(oldSchemaVersionNumber, QVersionNumber::fromString("0.0.14")) > 0
-                        && QVersionNumber::compare(oldSchemaVersionNumber, QVersionNumber::fromString("0.0.17")) < 0) {
+                        && QVersionNumber::compare(oldSchemaVersionNumber, QVersionNumber::fromString("0.0.19")) < 0) {
                     bool from14to15 = oldSchemaVersionNumber == QVersionNumber::fromString("0.0.14");
                     bool from15to16 = oldSchemaVersionNumber == QVersionNumber::fromString("0.0.14")
                             || oldSchemaVersionNumber == QVersionNumber::fromString("0.0.15");
                     bool from16to17 = oldSchemaVersionNumber == QVersionNumber::fromString("0.0.14")
                             || oldSchemaVersionNumber == QVersionNumber::fromString("0.0.15")
                             || oldSchemaVersionNumber == QVersionNumber::fromString("0.0.16");
+                    bool from17to18 = oldSchemaVersionNumber == QVersionNumber::fromString("0.0.14")
+                            || oldSchemaVersionNumber == QVersionNumber::fromString("0.0.15")
+                            || oldSchemaVersionNumber == QVersionNumber::fromString("0.0.16")
+                            || oldSchemaVersionNumber == QVersionNumber::fromString("0.0.17");
+                    bool from18to19 = from17to18
+                            || oldSchemaVersionNumber == QVersionNumber::fromString("0.0.18");
 
                     bool success = true;
                     if (from14to15) {
@@ -241,6 +264,38 @@ QSqlError createDatabase(const QString &location)
                         }
                     }
 
+                    if (from17to18) {
+                        qWarning() << "Going to update storages table";
+
+                        QSqlQuery q;
+                        q.prepare("ALTER TABLE  storages\n"
+                                  "ADD   COLUMN fingerprint TEXT");
+                        if (!q.exec()) {
+                            qWarning() << "Could not update the storages table." << q.lastError();
+                            success = false;
+                        }
+                        else {
+                            qWarning() << "Updated table storages: success.";
+                        }
+                    }
+
+                    if (from18to19) {
+                        qWarning() << "Going to create resource_thumbnails table";
+
+                        QFile f(":/create_resource_thumbnails.sql");
+                        if (f.open(QFile::ReadOnly)) {
+                            QSqlQuery q;
+                            if (!q.exec(f.readAll())) {
+                                qWarning() << "Could not create table resource_thumbnails" << q.lastError();
+                                return db.lastError();
+                            }
+                            infoResources << "Created table resource_thumbnails";
+                        }
+                        else {
+                            return QSqlError("Error executing SQL", QString("Could not find SQL file for resource_thumbnails table"), QSqlError::StatementError);
+                        }
+                    }
+
                     if (success) {
                         if (!updateSchemaVersion()) {
                             return QSqlError("Error executing SQL", QString("Could not update schema version."), QSqlError::StatementError);
@@ -293,6 +348,23 @@ QSqlError createDatabase(const QString &location)
         }
     }
 
+    // this table came in version 0.0.19, it is not checked for presence
+    // above, since the older databases get it during the migration
+    {
+        QFile f(":/create_resource_thumbnails.sql");
+        if (f.open(QFile::ReadOnly)) {
+            QSqlQuery q;
+            if (!q.exec(f.readAll())) {
+                qWarning() << "Could not create table resource_thumbnails" << q.lastError();
+                return db.lastError();
+            }
+            infoResources << "Created table resource_thumbnails";
+        }
+        else {
+            return QSqlError("Error executing SQL", QString("Could not find SQL file resource_thumbnails"), QSqlError::StatementError);
+        }
+    }
+
     // Create indexes
     QStringList indexes;
 
@@ -381,6 +453,7 @@ bool KisResourceCacheDb::initialize(const QString &location)
     QSqlError err = createDatabase(location);
 
     s_valid = !err.isValid();
+    s_databasePath = location + "/" + resourceCacheDbFilename;
     switch (err.type()) {
     case QSqlError::NoError:
         s_lastError = QString();
@@ -766,9 +839,11 @@ bool KisResourceCacheDb::makeResourceTheCurrentVersion(int resourceId, KoResourc
     r = q.exec();
     if (!r) {
         qWarning() << "Could not update resource" << q.boundValues() << q.lastError();
+        return r;
     }
 
-    return r;
+    // the levels of the new thumbnail are made when it is shown
+    return removeThumbnailLevels(resourceId);
 }
 
 bool KisResourceCacheDb::removeResourceCompletely(int resourceId)
@@ -829,9 +904,193 @@ bool KisResourceCacheDb::removeResourceCompletely(int resourceId)
         }
     }
 
+    {
+        QSqlQuery q;
+        r = q.prepare("DELETE FROM resource_thumbnails \n"
+                      "WHERE resource_id = :resource_id;");
+
+        if (!r) {
+            qWarning() << "Could not prepare removeResourceCompletely4 statement" << q.lastError();
+            return r;
+        }
+
+        q.bindValue(":resource_id", resourceId);
+        r = q.exec();
+        if (!r) {
+            qWarning() << "Could not execute removeResourceCompletely4 statement" << q.lastError() << resourceId;
+            return r;
+        }
+    }
+
     return r;
 }
 
+bool KisResourceCacheDb::updateThumbnailLevels(int resourceId, const QImage &thumbnail)
+{
+    return storeThumbnailLevels(resourceId, encodeThumbnailLevels(thumbnail));
+}
+
+QMap<int, QByteArray> KisResourceCacheDb::encodeThumbnailLevels(const QImage &thumbnail)
+{
+    QMap<int, QByteArray> levels;
+
+    if (thumbnail.isNull()) return levels;
+
+    const int thumbnailSize = qMax(thumbnail.width(), thumbnail.height());
+
+    Q_FOREACH(int size, thumbnailLevelSizes) {
+        // the full thumbnail is used for the bigger sizes
+        if (size >= thumbnailSize) break;
+
+        const QImage scaled = thumbnail.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+        QBuffer buf;
+        buf.open(QBuffer::WriteOnly);
+        scaled.save(&buf, "PNG");
+        buf.close();
+
+        levels.insert(size, buf.data());
+    }
+
+    return levels;
+}
+
+bool KisResourceCacheDb::removeThumbnailLevels(int resourceId)
+{
+    QSqlQuery q;
+    if (!q.prepare("DELETE FROM resource_thumbnails\n"
+                   "WHERE resource_id = :resource_id;")) {
+        qWarning() << "Could not prepare delete thumbnail levels statement" << q.lastError();
+        return false;
+    }
+
+    q.bindValue(":resource_id", resourceId);
+    if (!q.exec()) {
+        qWarning() << "Could not execute delete thumbnail levels statement" << q.lastError() << resourceId;
+        return false;
+    }
+
+    return true;
+}
+
+bool KisResourceCacheDb::storeThumbnailLevels(int resourceId, const QMap<int, QByteArray> &levels)
+{
+    if (!removeThumbnailLevels(resourceId)) return false;
+
+    QSqlQuery q;
+    if (!q.prepare("INSERT INTO resource_thumbnails\n"
+                   "(resource_id, size, thumbnail)\n"
+                   "VALUES\n"
+                   "(:resource_id, :size, :thumbnail);")) {
+        qWarning() << "Could not prepare insert thumbnail level statement" << q.lastError();
+        return false;
+    }
+
+    for (auto it = levels.constBegin(); it != levels.constEnd(); ++it) {
+        q.bindValue(":resource_id", resourceId);
+        q.bindValue(":size", it.key());
+        q.bindValue(":thumbnail", it.value());
+
+        if (!q.exec()) {
+            qWarning() << "Could not execute insert thumbnail level statement" << q.lastError() << resourceId << it.key();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QByteArray KisResourceCacheDb::thumbnailLevel(int resourceId, int minimumSize)
+{
+    return thumbnailLevel(resourceId, minimumSize, QSqlDatabase::database());
+}
+
+QByteArray KisResourceCacheDb::thumbnailLevel(int resourceId, int minimumSize, const QSqlDatabase &database)
+{
+    QSqlQuery q(database);
+    q.setForwardOnly(true);
+    if (!q.prepare("SELECT thumbnail\n"
+                   "FROM   resource_thumbnails\n"
+                   "WHERE  resource_id = :resource_id\n"
+                   "AND    size >= :size\n"
+                   "ORDER BY size\n"
+                   "LIMIT 1")) {
+        qWarning() << "Could not prepare thumbnail level query" << q.lastError();
+        return QByteArray();
+    }
+
+    q.bindValue(":resource_id", resourceId);
+    q.bindValue(":size", minimumSize);
+
+    if (!q.exec()) {
+        qWarning() << "Could not execute thumbnail level query" << q.lastError() << resourceId;
+        return QByteArray();
+    }
+
+    return q.first() ? q.value(0).toByteArray() : QByteArray();
+}
+
+QByteArray KisResourceCacheDb::resourceThumbnail(int resourceId)
+{
+    return resourceThumbnail(resourceId, QSqlDatabase::database());
+}
+
+QByteArray KisResourceCacheDb::resourceThumbnail(int resourceId, const QSqlDatabase &database)
+{
+    QSqlQuery q(database);
+    q.setForwardOnly(true);
+    if (!q.prepare("SELECT thumbnail FROM resources WHERE resources.id = :resource_id")) {
+        qWarning() << "Could not prepare resource thumbnail query" << q.lastError();
+        return QByteArray();
+    }
+
+    q.bindValue(":resource_id", resourceId);
+
+    if (!q.exec()) {
+        qWarning() << "Could not execute resource thumbnail query" << q.lastError() << resourceId;
+        return QByteArray();
+    }
+
+    return q.first() ? q.value(0).toByteArray() : QByteArray();
+}
+
+QSqlDatabase KisResourceCacheDb::threadLocalDatabase()
+{
+    if (!s_threadLocalConnections.hasLocalData()) {
+        ThreadLocalConnection *connection = new ThreadLocalConnection();
+        connection->name = QString("resourcecache-%1").arg(quintptr(QThread::currentThread()));
+
+        QSqlDatabase db = QSqlDatabase::addDatabase(dbDriver, connection->name);
+        db.setDatabaseName(s_databasePath);
+        // the GUI thread may be writing to the database at the same time
+        db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=1000");
+        if (!db.open()) {
+            qWarning() << "Could not open a thread-local connection to the resource database" << db.lastError();
+        }
+
+        s_threadLocalConnections.setLocalData(connection);
+    }
+
+    return QSqlDatabase::database(s_threadLocalConnections.localData()->name);
+}
+
+bool KisResourceCacheDb::removeOrphanedThumbnailLevels()
+{
+    QSqlQuery q;
+    if (!q.prepare("DELETE FROM resource_thumbnails\n"
+                   "WHERE  resource_id NOT IN (SELECT id FROM resources)")) {
+        qWarning() << "Could not prepare delete orphaned thumbnail levels query" << q.lastError();
+        return false;
+    }
+
+    if (!q.exec()) {
+        qWarning() << "Could not execute delete orphaned thumbnail levels query" << q.lastError();
+        return false;
+    }
+
+    return true;
+}
+
 bool KisResourceCacheDb::getResourceIdFromFilename(QString filename, QString resourceType, QString storageLocation, int &outResourceId)
 {
     QSqlQuery q;
@@ -1054,7 +1313,7 @@ bool KisResourceCacheDb::addResource(KisResourceStorageSP storage, QDateTime tim
 
 }
 
-bool KisResourceCacheDb::addResources(KisResourceStorageSP storage, QString resourceType)
+bool KisResourceCacheDb::addResources(KisResourceStorageSP storage, QString resourceType, const KisResourceStorageScan *scan)
 {
     QSqlDatabase::database().transaction();
     QSharedPointer<KisResourceStorage::ResourceIterator> iter = storage->resources(resourceType);
@@ -1072,7 +1331,9 @@ bool KisResourceCacheDb::addResources(KisResourceStorageSP storage, QString reso
             KoResourceSP resource = verIt->resource();
             if (resource && resource->valid()) {
                 resource->setVersion(verIt->guessedVersion());
-                resource->setMD5Sum(storage->resourceMd5(verIt->url()));
+                const auto md5It = scan ? scan->md5Sums.constFind(verIt->url()) : QHash<QString, QString>::const_iterator();
+                resource->setMD5Sum(scan && md5It != scan->md5Sums.constEnd() ?
+                                    *md5It : storage->resourceMd5(verIt->url()));
 
                 if (resourceId < 0) {
                     if (addResource(storage, iter->lastModified(), resource, iter->type())) {
@@ -1414,7 +1675,7 @@ bool KisResourceCacheDb::addTags(KisResourceStorageSP storage, QString resourceT
     return true;
 }
 
-bool KisResourceCacheDb::addStorage(KisResourceStorageSP storage, bool preinstalled)
+bool KisResourceCacheDb::addStorage(KisResourceStorageSP storage, bool preinstalled, const KisResourceStorageScan *scan)
 {
     bool r = true;
 
@@ -1499,7 +1760,7 @@ bool KisResourceCacheDb::addStorage(KisResourceStorageSP storage, bool preinstal
     }
 
     Q_FOREACH(const QString &resourceType, KisResourceLoaderRegistry::instance()->resourceTypes()) {
-        if (!KisResourceCacheDb::addResources(storage, resourceType)) {
+        if (!KisResourceCacheDb::addResources(storage, resourceType, scan)) {
             qWarning() << "Failed to add all resources for storage" << storage;
             r = false;
         }
@@ -1609,7 +1870,7 @@ bool KisResourceCacheDb::deleteStorage(QString location)
             return false;
         }
     }
-    return true;
+    return removeOrphanedThumbnailLevels();
 }
 
 bool KisResourceCacheDb::deleteStorage(KisResourceStorageSP storage)
@@ -1652,7 +1913,7 @@ QDebug operator<<(QDebug dbg, const ResourceVersion &ver)
 }
 }
 
-bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
+bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage, const KisResourceStorageScan *scan)
 {
     QElapsedTimer t;
     t.start();
@@ -1684,7 +1945,7 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
     if (!q.first()) {
         // This is a new storage, the user must have dropped it in the path before restarting Krita, so add it.
         debugResource << "Adding storage to the database:" << storage;
-        if (!addStorage(storage, false)) {
+        if (!addStorage(storage, false, scan)) {
             qWarning() << "Could not add new storage" << storage->name() << "to the database";
             success = false;
         }
@@ -1693,6 +1954,20 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
 
     storage->setStorageId(q.value("id").toInt());
 
+    KisResourceStorageScan localScan;
+    if (!scan) {
+        localScan = scanStorage(storage, nullptr);
+        scan = &localScan;
+    }
+
+    auto resourceMd5 = [storage, scan] (const QString &url) {
+        auto it = scan->md5Sums.constFind(url);
+        return it != scan->md5Sums.constEnd() ? *it : storage->resourceMd5(url);
+    };
+
+    const QString relativeStorageLocation =
+        KisResourceLocator::instance()->makeStorageLocationRelative(storage->location());
+
     /// We compare resource versions one-by-one because the storage may have multiple
     /// versions of them
 
@@ -1709,37 +1984,31 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
 
         int nextInexistentResourceId = std::numeric_limits<int>::min();
 
-        QSharedPointer<KisResourceStorage::ResourceIterator> iter = storage->resources(resourceType);
-        while (iter->hasNext()) {
-            iter->next();
+        const QVector<QVector<KisResourceStorageScan::Version>> scannedResources =
+            scan->resources.value(resourceType);
 
+        for (auto resIt = scannedResources.begin(); resIt != scannedResources.end(); ++resIt) {
             const int firstResourceVersionPosition = resourcesInStorage.size();
 
             int detectedResourceId = nextInexistentResourceId;
-            QSharedPointer<KisResourceStorage::ResourceIterator> verIt =
-                    iter->versions();
 
-            while (verIt->hasNext()) {
-                verIt->next();
+            for (auto verIt = resIt->begin(); verIt != resIt->end(); ++verIt) {
 
-                // verIt->url() contains paths like "brushes/ink.png" or "brushes/subfolder/splash.png".
+                // verIt->url contains paths like "brushes/ink.png" or "brushes/subfolder/splash.png".
                 // we need to cut off the first part and get "ink.png" in the first case,
                 // but "subfolder/splash.png" in the second case in order for subfolders to work
-                // so it cannot just use QFileInfo(verIt->url()).fileName() here.
-                QString path = QDir::fromNativeSeparators(verIt->url()); // make sure it uses Unix separators
+                // so it cannot just use QFileInfo(verIt->url).fileName() here.
+                QString path = QDir::fromNativeSeparators(verIt->url); // make sure it uses Unix separators
                 int folderEndIdx = path.indexOf("/");
                 QString properFilenameWithSubfolders = path.right(path.length() - folderEndIdx - 1);
                 int id = resourceIdForResource(properFilenameWithSubfolders,
-                                               verIt->type(),
-                                               KisResourceLocator::instance()->makeStorageLocationRelative(storage->location()));
+                                               resourceType,
+                                               relativeStorageLocation);
 
                 ResourceVersion item;
-                item.url = verIt->url();
-                item.version = verIt->guessedVersion();
-
-                // we use lower precision than the normal QDateTime
-                item.timestamp = QDateTime::fromSecsSinceEpoch(verIt->lastModified().toSecsSinceEpoch());
-
+                item.url = verIt->url;
+                item.version = verIt->version;
+                item.timestamp = verIt->timestamp;
                 item.resourceId = id;
 
                 if (detectedResourceId < 0 && id >= 0) {
@@ -1828,7 +2097,7 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
             }
 
             res->setVersion(itA->version);
-            res->setMD5Sum(storage->resourceMd5(itA->url));
+            res->setMD5Sum(resourceMd5(itA->url));
             if (!res->valid()) {
                 KisUsageLogger::log("Could not retrieve md5 for resource " + itA->url);
                 ++itA;
@@ -1853,7 +2122,7 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
             for (auto it = std::next(itA); it != nextResource; ++it) {
                 KoResourceSP res = storage->resource(it->url);
                 res->setVersion(it->version);
-                res->setMD5Sum(storage->resourceMd5(it->url));
+                res->setMD5Sum(resourceMd5(it->url));
                 if (!res->valid()) {
                     continue;
                 }
@@ -1885,7 +2154,7 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
                 KoResourceSP res = storage->resource(itA->url);
                 if (res) {
                     res->setVersion(itA->version);
-                    res->setMD5Sum(storage->resourceMd5(itA->url));
+                    res->setMD5Sum(resourceMd5(itA->url));
 
                     const bool result = addResourceVersionImpl(itA->resourceId, itA->timestamp, storage, res);
                     KIS_SAFE_ASSERT_RECOVER_NOOP(result);
@@ -1926,6 +2195,171 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
     return success;
 }
 
+KisResourceStorageScan KisResourceCacheDb::scanStorage(KisResourceStorageSP storage, const QSet<QString> *knownUrls)
+{
+    KisResourceStorageScan scan;
+
+    Q_FOREACH(const QString &resourceType, KisResourceLoaderRegistry::instance()->resourceTypes()) {
+        QVector<QVector<KisResourceStorageScan::Version>> &resources = scan.resources[resourceType];
+
+        QSharedPointer<KisResourceStorage::ResourceIterator> iter = storage->resources(resourceType);
+        while (iter->hasNext()) {
+            iter->next();
+
+            QVector<KisResourceStorageScan::Version> versions;
+
+            QSharedPointer<KisResourceStorage::ResourceIterator> verIt =
+                    iter->versions();
+
+            while (verIt->hasNext()) {
+                verIt->next();
+
+                KisResourceStorageScan::Version version;
+                version.url = verIt->url();
+                version.version = verIt->guessedVersion();
+
+                // we use lower precision than the normal QDateTime
+                version.timestamp = QDateTime::fromSecsSinceEpoch(verIt->lastModified().toSecsSinceEpoch());
+
+                if (knownUrls && !knownUrls->contains(version.url)) {
+                    scan.md5Sums.insert(version.url, storage->resourceMd5(version.url));
+                }
+
+                versions.append(version);
+            }
+
+            resources.append(versions);
+        }
+    }
+
+    return scan;
+}
+
+QSet<QString> KisResourceCacheDb::knownResourceUrls(KisResourceStorageSP storage)
+{
+    QSet<QString> urls;
+
+    QSqlQuery q;
+    q.setForwardOnly(true);
+    if (!q.prepare("SELECT resource_types.name, versioned_resources.filename\n"
+                   "FROM   versioned_resources\n"
+                   ",      resources\n"
+                   ",      resource_types\n"
+                   ",      storages\n"
+                   "WHERE  versioned_resources.resource_id = resources.id\n"
+                   "AND    resources.resource_type_id = resource_types.id\n"
+                   "AND    versioned_resources.storage_id = storages.id\n"
+                   "AND    storages.location = :location")) {
+        qWarning() << "Could not prepare known resource urls query" << q.lastError();
+        return urls;
+    }
+
+    q.bindValue(":location", changeToEmptyIfNull(KisResourceLocator::instance()->makeStorageLocationRelative(storage->location())));
+
+    if (!q.exec()) {
+        qWarning() << "Could not exec known resource urls query" << q.boundValues() << q.lastError();
+        return urls;
+    }
+
+    while (q.next()) {
+        urls.insert(q.value(0).toString() + "/" + q.value(1).toString());
+    }
+
+    return urls;
+}
+
+QString KisResourceCacheDb::storageFingerprint(KisResourceStorageSP storage)
+{
+    /// Folder storages can be changed by the user at any moment,
+    /// so they are always synchronized completely
+    if (storage->type() != KisResourceStorage::StorageType::Bundle &&
+        storage->type() != KisResourceStorage::StorageType::AdobeBrushLibrary &&
+        storage->type() != KisResourceStorage::StorageType::AdobeStyleLibrary) {
+
+        return QString();
+    }
+
+    QFileInfo info(storage->location());
+    if (!info.exists()) return QString();
+
+    QStringList fingerprint;
+    fingerprint << KritaVersionWrapper::versionString()
+                << KisResourceLoaderRegistry::instance()->resourceTypes().join(',')
+                << QString::number(info.size())
+                << QString::number(info.lastModified().toMSecsSinceEpoch());
+
+    /// The resources of the bundle modified by the user are saved
+    /// into a folder next to the bundle file
+    if (storage->type() == KisResourceStorage::StorageType::Bundle) {
+        int numModifiedFiles = 0;
+        qint64 modifiedSize = 0;
+        qint64 lastModified = 0;
+
+        QDirIterator it(storage->location() + "_modified", QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            numModifiedFiles++;
+            modifiedSize += it.fileInfo().size();
+            lastModified = qMax(lastModified, it.fileInfo().lastModified().toMSecsSinceEpoch());
+        }
+
+        fingerprint << QString::number(numModifiedFiles)
+                    << QString::number(modifiedSize)
+                    << QString::number(lastModified);
+    }
+
+    return fingerprint.join(';');
+}
+
+bool KisResourceCacheDb::storageIsUpToDate(KisResourceStorageSP storage, const QString &fingerprint)
+{
+    if (fingerprint.isEmpty()) return false;
+
+    QSqlQuery q;
+    if (!q.prepare("SELECT id\n"
+                   ",      fingerprint\n"
+                   "FROM   storages\n"
+                   "WHERE  location = :location\n")) {
+        qWarning() << "Could not prepare storage fingerprint statement" << q.lastError();
+        return false;
+    }
+
+    q.bindValue(":location", changeToEmptyIfNull(KisResourceLocator::instance()->makeStorageLocationRelative(storage->location())));
+    if (!q.exec()) {
+        qWarning() << "Could not execute storage fingerprint statement" << q.boundValues() << q.lastError();
+        return false;
+    }
+
+    if (!q.first() || q.value("fingerprint").toString() != fingerprint) {
+        return false;
+    }
+
+    storage->setStorageId(q.value("id").toInt());
+
+    return true;
+}
+
+bool KisResourceCacheDb::setStorageFingerprint(KisResourceStorageSP storage, const QString &fingerprint)
+{
+    QSqlQuery q;
+    if (!q.prepare("UPDATE storages\n"
+                   "SET    fingerprint = :fingerprint\n"
+                   "WHERE  location = :location\n")) {
+        qWarning() << "Could not prepare update storage fingerprint statement" << q.lastError();
+        return false;
+    }
+
+    q.bindValue(":fingerprint", changeToEmptyIfNull(fingerprint));
+    q.bindValue(":location", changeToEmptyIfNull(KisResourceLocator::instance()->makeStorageLocationRelative(storage->location())));
+
+    if (!q.exec()) {
+        qWarning() << "Could not execute update storage fingerprint statement" << q.boundValues() << q.lastError();
+        return false;
+    }
+
+    return true;
+}
+
 void KisResourceCacheDb::deleteTemporaryResources()
 {
     QSqlDatabase::database().transaction();
@@ -1993,6 +2427,8 @@ void KisResourceCacheDb::deleteTemporaryResources()
         qWarning() << "Could not execute delete Unknown or Memory storages query." << q.lastError();
     }
 
+    removeOrphanedThumbnailLevels();
+
     QSqlDatabase::database().commit();
 }
 
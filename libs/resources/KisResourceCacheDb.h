@@ -13,6 +13,37 @@
 
 #include <KisResourceStorage.h>
 
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+class QImage;
+class QSqlDatabase;
+
+/**
+ * The contents of a storage collected without accessing the database.
+ * Collecting it is the slowest part of the synchronization, so the
+ * storages are scanned in parallel and only the database updates are
+ * serialized.
+ */
+struct KisResourceStorageScan
+{
+    struct Version {
+        QString url;
+        int version = -1;
+        QDateTime timestamp;
+    };
+
+    /// resource type -> resources -> versions of the resource
+    QHash<QString, QVector<QVector<Version>>> resources;
+
+    /// md5 sums of the versions that are not known to the database yet,
+    /// indexed by url
+    QHash<QString, QString> md5Sums;
+};
+
 /**
  * @brief The KisResourceCacheDb class encapsulates the database that
  * caches information about the resources available to the user.
@@ -57,11 +88,13 @@ private:
     friend class KisResourceLocator;
     friend class TestResourceLocator;
     friend class TestResourceCacheDb;
+    friend class KisResourceLocatorBenchmark;
     friend class KisAllTagsModel;
     friend class KisResourceLoaderRegistry;
     friend class KisResourceUserOperations;
     friend class KisDocument;
     friend class KisAllResourcesModel;
+    friend class KisResourceThumbnailCache;
 
     explicit KisResourceCacheDb(); // Deleted
     ~KisResourceCacheDb(); // Deleted
@@ -95,6 +128,59 @@ private:
     static bool makeResourceTheCurrentVersion(int resourceId, KoResourceSP resource);
     static bool removeResourceCompletely(int resourceId);
 
+    /**
+     * Stores the copies of \p thumbnail scaled down to the sizes of
+     * thumbnailLevelSizes, so that the resource views don't have to
+     * decode and scale the full thumbnail
+     */
+    static bool updateThumbnailLevels(int resourceId, const QImage &thumbnail);
+
+    /**
+     * Scales \p thumbnail down to the sizes of thumbnailLevelSizes that
+     * are smaller than the thumbnail itself and encodes them as PNG.
+     * Doesn't access the database, so it can be called from any thread.
+     *
+     * The levels are not made when the resources are added, since that
+     * would slow down the synchronization of every storage. They are
+     * made by KisResourceThumbnailCache the first time the thumbnail is
+     * shown instead.
+     *
+     * @return the PNG data of the levels, indexed by their size
+     */
+    static QMap<int, QByteArray> encodeThumbnailLevels(const QImage &thumbnail);
+
+    /// Replaces the stored thumbnail levels of the resource with \p levels
+    static bool storeThumbnailLevels(int resourceId, const QMap<int, QByteArray> &levels);
+
+    /// Removes the stored thumbnail levels of the resource, e.g. when its thumbnail changes
+    static bool removeThumbnailLevels(int resourceId);
+
+    /**
+     * @return the PNG data of the smallest stored thumbnail of the resource
+     * that is at least \p minimumSize pixels in both dimensions, or
+     * an empty array if there is no such thumbnail
+     */
+    static QByteArray thumbnailLevel(int resourceId, int minimumSize);
+    static QByteArray thumbnailLevel(int resourceId, int minimumSize, const QSqlDatabase &database);
+
+    /// @return the PNG data of the full-size thumbnail of the resource
+    static QByteArray resourceThumbnail(int resourceId);
+    static QByteArray resourceThumbnail(int resourceId, const QSqlDatabase &database);
+
+    /**
+     * @return a read-only connection to the database owned by the calling
+     * thread. The connections cannot be shared between threads, so the
+     * queries made outside the GUI thread should use this one. The
+     * connection is removed when the thread exits.
+     */
+    static QSqlDatabase threadLocalDatabase();
+
+    /// Removes the thumbnails of the resources that are no longer in the database
+    static bool removeOrphanedThumbnailLevels();
+
+    /// the longest sides of the scaled thumbnails kept in the database
+    static const QVector<int> thumbnailLevelSizes;
+
     /// The function will find the resource only if it is the latest version
     static bool getResourceIdFromFilename(QString filename, QString resourceType, QString storageLocation, int &outResourceId);
     /// Note that here you can put even the original filename - any filename from the versioned_resources - and it will still find it
@@ -103,7 +189,12 @@ private:
 
 
     static bool addResource(KisResourceStorageSP storage, QDateTime timestamp, KoResourceSP resource, const QString &resourceType);
-    static bool addResources(KisResourceStorageSP storage, QString resourceType);
+    /**
+     * Adds all the resources of \p resourceType from the storage. The md5
+     * sums already calculated in \p scan are reused, the others are
+     * calculated here.
+     */
+    static bool addResources(KisResourceStorageSP storage, QString resourceType, const KisResourceStorageScan *scan = nullptr);
 
     /// Make this resource active or inactive; this does not remove the resource from disk or from the database
     static bool setResourceActive(int resourceId, bool active = false);
@@ -114,7 +205,7 @@ private:
     static bool addTag(const QString &resourceType, const QString storageLocation, KisTagSP tag);
     static bool addTags(KisResourceStorageSP storage, QString resourceType);
 
-    static bool addStorage(KisResourceStorageSP storage, bool preinstalled);
+    static bool addStorage(KisResourceStorageSP storage, bool preinstalled, const KisResourceStorageScan *scan = nullptr);
     static bool addStorageTags(KisResourceStorageSP storage);
 
     /// Actually delete the storage and all its resources from the database (i.e., nothing is set to inactive, it's deleted)
@@ -122,7 +213,40 @@ private:
     /// Actually delete the storage and all its resources from the database (i.e., nothing is set to inactive, it's deleted)
     ///  location - relative
     static bool deleteStorage(QString location);
-    static bool synchronizeStorage(KisResourceStorageSP storage);
+    /**
+     * Synchronizes the database with the contents of the storage. If
+     * \p scan is null, the storage is scanned right here.
+     */
+    static bool synchronizeStorage(KisResourceStorageSP storage, const KisResourceStorageScan *scan = nullptr);
+
+    /**
+     * Collects the resources of the storage. The function doesn't
+     * access the database, so it can be called from any thread. If
+     * \p knownUrls is not null, the md5 sums are calculated for the
+     * versions absent in it.
+     */
+    static KisResourceStorageScan scanStorage(KisResourceStorageSP storage, const QSet<QString> *knownUrls);
+
+    /**
+     * The urls of the resource versions of the storage present in the
+     * database, e.g. "brushes/ink.png"
+     */
+    static QSet<QString> knownResourceUrls(KisResourceStorageSP storage);
+
+    /**
+     * A string that changes whenever the file(s) of the storage change.
+     * Empty for the storages that cannot be fingerprinted cheaply (i.e.
+     * folders), they are always synchronized. Doesn't access the database.
+     */
+    static QString storageFingerprint(KisResourceStorageSP storage);
+
+    /**
+     * @return true if the storage is present in the database and has
+     * been synchronized with \p fingerprint. In that case the storage
+     * id is assigned as well.
+     */
+    static bool storageIsUpToDate(KisResourceStorageSP storage, const QString &fingerprint);
+    static bool setStorageFingerprint(KisResourceStorageSP storage, const QString &fingerprint);
 
     /**
      * @brief metaDataForId
@@ -144,6 +268,7 @@ private:
 
     static bool s_valid;
     static QString s_lastError;
+    static QString s_databasePath;
 };
 
 #endif // KISRESOURCECACHEDB_H
@@ -18,6 +18,7 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QBuffer>
+#include <QtConcurrent>
 
 #include <kconfig.h>
 #include <kconfiggroup.h>
@@ -53,6 +54,7 @@ public:
     QHash<QPair<QString, QString>, KoResourceSP> resourceCache;
     QMap<QPair<QString, QString>, KisTagSP> tagCache;
     QStringList errorMessages;
+    QStringList lastSynchronizedStorages;
 };
 
 KisResourceLocator::KisResourceLocator(QObject *parent)
@@ -1044,10 +1046,21 @@ void KisResourceLocator::findStorages()
 
     // And add bundles and adobe libraries
     QStringList filters = QStringList() << "*.bundle" << "*.abr" << "*.asl";
+    QStringList storageFiles;
     QDirIterator iter(d->resourceLocation, filters, QDir::Files, QDirIterator::Subdirectories);
     while (iter.hasNext()) {
         iter.next();
-        KisResourceStorageSP storage = QSharedPointer<KisResourceStorage>::create(iter.filePath());
+        storageFiles << iter.filePath();
+    }
+
+    // opening the bundles means unzipping their manifests, so do that in parallel
+    const QList<KisResourceStorageSP> storages =
+        QtConcurrent::blockingMapped<QList<KisResourceStorageSP>>(storageFiles,
+            [] (const QString &location) {
+                return QSharedPointer<KisResourceStorage>::create(location);
+            });
+
+    Q_FOREACH(KisResourceStorageSP storage, storages) {
         if (!storage->valid()) {
             // we still add the storage to the list and try to read whatever possible
             qWarning() << "KisResourceLocator::findStorages: the storage is invalid" << storage->location();
@@ -1153,6 +1166,7 @@ QString KisResourceLocator::makeStorageLocationAbsolute(QString storageLocation)
 bool KisResourceLocator::synchronizeDb()
 {
     d->errorMessages.clear();
+    d->lastSynchronizedStorages.clear();
 
     // Add resource types that have been added since first-time installation.
     Q_FOREACH(auto loader, KisResourceLoaderRegistry::instance()->values()) {
@@ -1161,15 +1175,65 @@ bool KisResourceLocator::synchronizeDb()
 
 
     findStorages();
+
+    struct StorageSyncJob {
+        KisResourceStorageSP storage;
+        QString fingerprint;
+        QSet<QString> knownUrls;
+        QSharedPointer<KisResourceStorageScan> scan;
+    };
+
+    QVector<StorageSyncJob> jobs;
+    QVector<StorageSyncJob*> parallelJobs;
+
     Q_FOREACH(const KisResourceStorageSP storage, d->storages) {
-        if (!KisResourceCacheDb::synchronizeStorage(storage)) {
-            d->errorMessages.append(i18n("Could not synchronize %1 with the database", storage->location()));
+        StorageSyncJob job;
+        job.storage = storage;
+        job.fingerprint = KisResourceCacheDb::storageFingerprint(storage);
+
+        // the storage hasn't changed since the last synchronization
+        if (KisResourceCacheDb::storageIsUpToDate(storage, job.fingerprint)) continue;
+
+        job.knownUrls = KisResourceCacheDb::knownResourceUrls(storage);
+        jobs.append(job);
+    }
+
+    /// Only bundles and folders are scanned in parallel, the other storages
+    /// calculate md5 sums by loading the resources, which is not thread-safe
+    for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+        if (it->storage->type() == KisResourceStorage::StorageType::Bundle ||
+            it->storage->type() == KisResourceStorage::StorageType::Folder) {
+
+            parallelJobs.append(&*it);
         }
     }
 
-    Q_FOREACH(const KisResourceStorageSP storage, d->storages) {
-        if (!KisResourceCacheDb::addStorageTags(storage)) {
-            d->errorMessages.append(i18n("Could not synchronize %1 with the database", storage->location()));
+    QtConcurrent::blockingMap(parallelJobs,
+        [] (StorageSyncJob *job) {
+            // the storages new to the database have no known urls, so the
+            // md5 sums of all their resources are calculated here as well
+            job->scan.reset(new KisResourceStorageScan(KisResourceCacheDb::scanStorage(job->storage, &job->knownUrls)));
+        });
+
+    QVector<StorageSyncJob*> synchronizedJobs;
+
+    for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+        if (!KisResourceCacheDb::synchronizeStorage(it->storage, it->scan.data())) {
+            d->errorMessages.append(i18n("Could not synchronize %1 with the database", it->storage->location()));
+            continue;
+        }
+        synchronizedJobs.append(&*it);
+        d->lastSynchronizedStorages.append(it->storage->location());
+    }
+
+    Q_FOREACH(StorageSyncJob *job, synchronizedJobs) {
+        if (!KisResourceCacheDb::addStorageTags(job->storage)) {
+            d->errorMessages.append(i18n("Could not synchronize %1 with the database", job->storage->location()));
+            continue;
+        }
+
+        if (!job->fingerprint.isEmpty()) {
+            KisResourceCacheDb::setStorageFingerprint(job->storage, job->fingerprint);
         }
     }
 
@@ -1203,6 +1267,10 @@ bool KisResourceLocator::synchronizeDb()
     return d->errorMessages.isEmpty();
 }
 
+QStringList KisResourceLocator::lastSynchronizedStorages() const
+{
+    return d->lastSynchronizedStorages;
+}
 
 QString KisResourceLocator::makeStorageLocationRelative(QString location) const
 {
@@ -152,6 +152,7 @@ private:
     friend class KisAllTagResourceModel;
     friend class KisStorageModel;
     friend class TestResourceLocator;
+    friend class KisResourceLocatorBenchmark;
     friend class TestResourceModel;
     friend class Resource;
     friend class KisResourceCacheDb;
@@ -327,6 +328,13 @@ private:
     // Synchronize on restarting Krita to see whether the user has added any storages or resources to the resources location
     bool synchronizeDb();
 
+    /**
+     * The locations of the storages actually synchronized by the last
+     * synchronizeDb() call. The storages whose fingerprint hasn't changed
+     * since the previous synchronization are not included.
+     */
+    QStringList lastSynchronizedStorages() const;
+
     void findStorages();
     QList<KisResourceStorageSP> storages() const;
 
@@ -6,10 +6,16 @@
 
 #include "KisResourceThumbnailCache.h"
 
+#include <QCache>
+#include <QFutureWatcher>
 #include <QMap>
 #include <QModelIndex>
+#include <QSet>
 #include <QSize>
+#include <QSqlDatabase>
+#include <QtConcurrent>
 
+#include <KisResourceCacheDb.h>
 #include <KisResourceLocator.h>
 #include <KisResourceModel.h>
 
@@ -21,58 +27,107 @@ struct ImageScalingParameters {
     QSize size;
     Qt::AspectRatioMode aspectRatioMode;
     Qt::TransformationMode transformationMode;
-
-    bool operator<(const ImageScalingParameters &other) const
-    {
-        if (size != other.size) {
-            if (size.width() != other.size.width()) {
-                return size.width() < other.size.width();
-            } else {
-                return size.height() < other.size.height();
-            }
-        } else if (aspectRatioMode != other.aspectRatioMode) {
-            return aspectRatioMode < other.aspectRatioMode;
-        } else if (transformationMode != other.transformationMode) {
-            return transformationMode < other.transformationMode;
-        } else {
-            // they're the same
-            return false;
-        }
-    }
 };
 
 namespace
 {
 using ResourceKey = QPair<QString, QString>;
-using ThumbnailCacheT = QMap<ImageScalingParameters, QImage>;
+
+/// the memory used by the scaled thumbnails, in KiB
+const int scaledThumbnailCacheSize = 64 * 1024;
+
+/// the memory used by the full-size thumbnails, in KiB
+const int originalThumbnailCacheSize = 32 * 1024;
+
+QString scaledKeyPrefix(const ResourceKey &key)
+{
+    return key.first + '\n' + key.second + '\n';
+}
+
+QString scaledKey(const ResourceKey &key, const ImageScalingParameters &param)
+{
+    return scaledKeyPrefix(key) +
+        QString("%1x%2:%3:%4")
+            .arg(param.size.width())
+            .arg(param.size.height())
+            .arg(int(param.aspectRatioMode))
+            .arg(int(param.transformationMode));
+}
+
+int imageCost(const QImage &image)
+{
+    return qMax(1, int(image.sizeInBytes() / 1024));
+}
+
+struct DecodedThumbnail {
+    ResourceKey key;
+    QString scaledKey;
+    int resourceId = -1;
+    ImageScalingParameters param;
+    int generation = 0;
+
+    /// set only if the full-size thumbnail has been decoded
+    QImage original;
+    QImage scaled;
+
+    /// the pre-scaled thumbnails to be stored in the database, made when
+    /// the database doesn't have them yet
+    QMap<int, QByteArray> levels;
+};
+
 } // namespace
 
 struct KisResourceThumbnailCache::Private {
-    QMap<ResourceKey, ThumbnailCacheT> scaledThumbnailCache;
-    QMap<ResourceKey, QImage> originalImageCache;
+    Private() {
+        scaledThumbnailCache.setMaxCost(scaledThumbnailCacheSize);
+        originalImageCache.setMaxCost(originalThumbnailCacheSize);
+    }
 
-    QImage getExactMatch(const ResourceKey &key, ImageScalingParameters param) const;
+    QCache<QString, QImage> scaledThumbnailCache;
+    QCache<ResourceKey, QImage> originalImageCache;
+
+    /// the scaled thumbnails being decoded in the background
+    QSet<QString> pendingThumbnails;
+
+    /// the resources whose thumbnail is missing or could not be decoded,
+    /// they are not requested again until the resource changes
+    QSet<ResourceKey> failedThumbnails;
+
+    /// incremented on every removal, so that the thumbnails decoded
+    /// in the background from outdated data are dropped
+    int generation = 0;
+
+    qint64 numLookups = 0;
+    qint64 numHits = 0;
+
+    QImage getExactMatch(const ResourceKey &key, ImageScalingParameters param);
     QImage getOriginal(const ResourceKey &key) const;
     void insertOriginal(const ResourceKey &key, const QImage &image);
     bool containsOriginal(const ResourceKey &key) const;
+    void insertScaled(const QString &scaledKey, const QImage &image);
+
+    /// runs on the thread pool, so it uses its own database connection
+    static DecodedThumbnail loadThumbnail(DecodedThumbnail request);
 
     ResourceKey
     key(const QString &storageLocation, const QString &resourceType, const QString &filename) const;
+    ResourceKey key(const QModelIndex &index) const;
 };
 
 QImage KisResourceThumbnailCache::Private::getExactMatch(const ResourceKey &key,
-                                                         ImageScalingParameters param) const
+                                                         ImageScalingParameters param)
 {
-    const auto thumbnailEntries = scaledThumbnailCache.find(key);
-    if (thumbnailEntries != scaledThumbnailCache.end()) {
-        const auto scaledThumbnail = thumbnailEntries->find(param);
-        if (scaledThumbnail != thumbnailEntries->end()) {
-            return *scaledThumbnail;
-        }
+    numLookups++;
+
+    const QImage *scaledThumbnail = scaledThumbnailCache.object(scaledKey(key, param));
+    if (scaledThumbnail) {
+        numHits++;
+        return *scaledThumbnail;
     }
 
-    const auto originalImage = originalImageCache.find(key);
-    if (originalImage != originalImageCache.end() && originalImage->size() == param.size) {
+    const QImage *originalImage = originalImageCache.object(key);
+    if (originalImage && originalImage->size() == param.size) {
+        numHits++;
         return *originalImage;
     }
 
@@ -81,7 +136,8 @@ QImage KisResourceThumbnailCache::Private::getExactMatch(const ResourceKey &key,
 
 QImage KisResourceThumbnailCache::Private::getOriginal(const ResourceKey &key) const
 {
-    return originalImageCache[key];
+    const QImage *image = originalImageCache.object(key);
+    return image ? *image : QImage();
 }
 
 void KisResourceThumbnailCache::Private::insertOriginal(const ResourceKey &key, const QImage &image)
@@ -89,7 +145,7 @@ void KisResourceThumbnailCache::Private::insertOriginal(const ResourceKey &key,
     // Someone else has added the image to this cache, when the only path to here is from a method which
     // checks whether this cache contains it or not.
     KIS_ASSERT(!originalImageCache.contains(key));
-    originalImageCache.insert(key, image);
+    originalImageCache.insert(key, new QImage(image), imageCost(image));
 }
 
 bool KisResourceThumbnailCache::Private::containsOriginal(const ResourceKey &key) const
@@ -97,6 +153,46 @@ bool KisResourceThumbnailCache::Private::containsOriginal(const ResourceKey &key
     return originalImageCache.contains(key);
 }
 
+void KisResourceThumbnailCache::Private::insertScaled(const QString &scaledKey, const QImage &image)
+{
+    scaledThumbnailCache.insert(scaledKey, new QImage(image), imageCost(image));
+}
+
+DecodedThumbnail KisResourceThumbnailCache::Private::loadThumbnail(DecodedThumbnail request)
+{
+    const QSqlDatabase database = KisResourceCacheDb::threadLocalDatabase();
+
+    const int size = qMax(request.param.size.width(), request.param.size.height());
+    QByteArray data = KisResourceCacheDb::thumbnailLevel(request.resourceId, size, database);
+    bool isOriginal = false;
+
+    if (data.isEmpty()) {
+        // the thumbnail is too small to have pre-scaled versions or
+        // they haven't been made yet
+        data = KisResourceCacheDb::resourceThumbnail(request.resourceId, database);
+        isOriginal = true;
+    }
+
+    QImage image;
+    if (!data.isEmpty()) {
+        image.loadFromData(data, "PNG");
+    }
+
+    if (!image.isNull()) {
+        request.scaled = image.scaled(request.param.size, request.param.aspectRatioMode, request.param.transformationMode);
+
+        if (isOriginal) {
+            request.original = image;
+
+            if (KisResourceCacheDb::thumbnailLevel(request.resourceId, 0, database).isEmpty()) {
+                request.levels = KisResourceCacheDb::encodeThumbnailLevels(image);
+            }
+        }
+    }
+
+    return request;
+}
+
 ResourceKey KisResourceThumbnailCache::Private::key(const QString &storageLocation,
                                                     const QString &resourceType,
                                                     const QString &filename) const
@@ -104,6 +200,17 @@ ResourceKey KisResourceThumbnailCache::Private::key(const QString &storageLocati
     return {storageLocation, resourceType + "/" + filename};
 }
 
+ResourceKey KisResourceThumbnailCache::Private::key(const QModelIndex &index) const
+{
+    const QString storageLocation = KisResourceLocator::instance()->makeStorageLocationAbsolute(
+        index.data(Qt::UserRole + KisAbstractResourceModel::Location).value<QString>());
+    const QString resourceType =
+        index.data(Qt::UserRole + KisAbstractResourceModel::ResourceType).value<QString>();
+    const QString filename = index.data(Qt::UserRole + KisAbstractResourceModel::Filename).value<QString>();
+
+    return key(storageLocation, resourceType, filename);
+}
+
 KisResourceThumbnailCache *KisResourceThumbnailCache::instance()
 {
     return s_instance;
@@ -139,6 +246,7 @@ void KisResourceThumbnailCache::insert(const QString &storageLocation,
 
 void KisResourceThumbnailCache::insert(const QPair<QString, QString> &key, const QImage &image)
 {
+    m_d->failedThumbnails.remove(key);
     m_d->insertOriginal(key, image);
 }
 
@@ -151,17 +259,19 @@ void KisResourceThumbnailCache::remove(const QString &storageLocation,
 
 void KisResourceThumbnailCache::remove(const QPair<QString, QString> &key)
 {
-    if (m_d->originalImageCache.contains(key)) {
-        m_d->originalImageCache.remove(key);
+    m_d->originalImageCache.remove(key);
+    m_d->failedThumbnails.remove(key);
 
-        if (m_d->scaledThumbnailCache.contains(key)) {
-            m_d->scaledThumbnailCache.remove(key);
+    // the scaled thumbnails may exist without the original one, since
+    // they are usually made from the pre-scaled thumbnails
+    const QString prefix = scaledKeyPrefix(key);
+    Q_FOREACH (const QString &scaledKey, m_d->scaledThumbnailCache.keys()) {
+        if (scaledKey.startsWith(prefix)) {
+            m_d->scaledThumbnailCache.remove(scaledKey);
         }
-    } else {
-        // Something must have gone wrong for thumbnail to exist in scaledThumbnailCache but not be in
-        // original.
-        KIS_ASSERT(!m_d->scaledThumbnailCache.contains(key));
     }
+
+    m_d->generation++;
 }
 
 QImage KisResourceThumbnailCache::getImage(const QModelIndex &index,
@@ -169,15 +279,9 @@ QImage KisResourceThumbnailCache::getImage(const QModelIndex &index,
                                            Qt::AspectRatioMode aspectMode,
                                            Qt::TransformationMode transformMode)
 {
-    const QString storageLocation = KisResourceLocator::instance()->makeStorageLocationAbsolute(
-        index.data(Qt::UserRole + KisAbstractResourceModel::Location).value<QString>());
-    const QString resourceType =
-        index.data(Qt::UserRole + KisAbstractResourceModel::ResourceType).value<QString>();
-    const QString filename = index.data(Qt::UserRole + KisAbstractResourceModel::Filename).value<QString>();
-
     const ImageScalingParameters param = {size, aspectMode, transformMode};
 
-    ResourceKey key = m_d->key(storageLocation, resourceType, filename);
+    ResourceKey key = m_d->key(index);
 
     QImage result = m_d->getExactMatch(key, param);
     if (!result.isNull()) {
@@ -185,6 +289,24 @@ QImage KisResourceThumbnailCache::getImage(const QModelIndex &index,
     } else if (m_d->containsOriginal(key)) {
         result = m_d->getOriginal(key);
     } else {
+        if (param.size.isValid()) {
+            // the pre-scaled thumbnail is much cheaper to decode than the original one
+            const int resourceId = index.data(Qt::UserRole + KisAbstractResourceModel::Id).toInt();
+            const QByteArray data =
+                KisResourceCacheDb::thumbnailLevel(resourceId, qMax(param.size.width(), param.size.height()));
+
+            if (!data.isEmpty()) {
+                QImage level;
+                level.loadFromData(data, "PNG");
+
+                if (!level.isNull()) {
+                    const QImage scaledImage = level.scaled(param.size, param.aspectRatioMode, param.transformationMode);
+                    m_d->insertScaled(scaledKey(key, param), scaledImage);
+                    return scaledImage;
+                }
+            }
+        }
+
         result = index.data(Qt::UserRole + KisAbstractResourceModel::Thumbnail).value<QImage>();
         // KisResourceQueryMapper should have inserted the image, so we don't have to.
         // Why there? Because most of the API usage for Thumbnail is going to be from index.data(), so we just
@@ -195,15 +317,97 @@ QImage KisResourceThumbnailCache::getImage(const QModelIndex &index,
     // if the size that the has been demanded, we will then cache the size and then pass it.
     if (!result.isNull() && param.size.isValid()) {
         const QImage scaledImage = result.scaled(param.size, param.aspectRatioMode, param.transformationMode);
-        if (m_d->scaledThumbnailCache.contains(key)) {
-            m_d->scaledThumbnailCache[key].insert(param, scaledImage);
-        } else {
-            ThumbnailCacheT scaledCacheMap;
-            scaledCacheMap.insert(param, scaledImage);
-            m_d->scaledThumbnailCache.insert(key, scaledCacheMap);
-        }
+        m_d->insertScaled(scaledKey(key, param), scaledImage);
         return scaledImage;
     } else {
         return result;
     }
 }
+
+QImage KisResourceThumbnailCache::getImageLazily(const QModelIndex &index,
+                                                 const QSize size,
+                                                 Qt::AspectRatioMode aspectMode,
+                                                 Qt::TransformationMode transformMode)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(size.isValid(), getImage(index));
+
+    const ImageScalingParameters param = {size, aspectMode, transformMode};
+
+    const ResourceKey key = m_d->key(index);
+
+    QImage result = m_d->getExactMatch(key, param);
+    if (!result.isNull()) {
+        return result;
+    }
+
+    // scaling the decoded original is cheap enough
+    if (m_d->containsOriginal(key)) {
+        return getImage(index, size, aspectMode, transformMode);
+    }
+
+    if (m_d->failedThumbnails.contains(key)) {
+        return QImage();
+    }
+
+    DecodedThumbnail request;
+    request.key = key;
+    request.scaledKey = scaledKey(key, param);
+    request.resourceId = index.data(Qt::UserRole + KisAbstractResourceModel::Id).toInt();
+    request.param = param;
+    request.generation = m_d->generation;
+
+    if (m_d->pendingThumbnails.contains(request.scaledKey)) {
+        return QImage();
+    }
+
+    m_d->pendingThumbnails.insert(request.scaledKey);
+
+    QFutureWatcher<DecodedThumbnail> *watcher = new QFutureWatcher<DecodedThumbnail>(this);
+
+    connect(watcher, &QFutureWatcher<DecodedThumbnail>::finished, this, [this, watcher] () {
+        const DecodedThumbnail decoded = watcher->result();
+        watcher->deleteLater();
+
+        m_d->pendingThumbnails.remove(decoded.scaledKey);
+
+        // the resource has been changed while the thumbnail was being
+        // decoded, the views will request the new one on repaint
+        if (decoded.generation != m_d->generation) {
+            emit sigThumbnailLoaded();
+            return;
+        }
+
+        // don't emit the signal, otherwise the views would request
+        // the thumbnail again on every repaint
+        if (decoded.scaled.isNull()) {
+            m_d->failedThumbnails.insert(decoded.key);
+            return;
+        }
+
+        if (!decoded.original.isNull() && !m_d->containsOriginal(decoded.key)) {
+            m_d->insertOriginal(decoded.key, decoded.original);
+        }
+
+        if (!decoded.levels.isEmpty()) {
+            KisResourceCacheDb::storeThumbnailLevels(decoded.resourceId, decoded.levels);
+        }
+
+        m_d->insertScaled(decoded.scaledKey, decoded.scaled);
+
+        emit sigThumbnailLoaded();
+    });
+
+    watcher->setFuture(QtConcurrent::run(&Private::loadThumbnail, request));
+
+    return QImage();
+}
+
+qint64 KisResourceThumbnailCache::numLookups() const
+{
+    return m_d->numLookups;
+}
+
+qint64 KisResourceThumbnailCache::numHits() const
+{
+    return m_d->numHits;
+}
@@ -8,17 +8,29 @@
 #define __KISRESOURCETHUMBNAILCACHE_H_
 
 #include <QImage>
+#include <QObject>
 #include <QScopedPointer>
 
 #include "kritaresources_export.h"
 
 class QModelIndex;
 
-class KRITARESOURCES_EXPORT KisResourceThumbnailCache
+/**
+ * The cache of the resource thumbnails shown in the resource views.
+ *
+ * The scaled and the full-size thumbnails are kept in bounded LRU
+ * caches. The scaled ones are made from the pre-scaled thumbnails
+ * stored in the database when possible, so the full-size thumbnail
+ * doesn't have to be decoded at all.
+ *
+ * All the methods must be called from the GUI thread.
+ */
+class KRITARESOURCES_EXPORT KisResourceThumbnailCache : public QObject
 {
+    Q_OBJECT
 public:
     KisResourceThumbnailCache();
-    ~KisResourceThumbnailCache();
+    ~KisResourceThumbnailCache() override;
 
     static KisResourceThumbnailCache *instance();
 
@@ -27,6 +39,32 @@ public:
                     Qt::AspectRatioMode aspectMode = Qt::IgnoreAspectRatio,
                     Qt::TransformationMode transformMode = Qt::FastTransformation);
 
+    /**
+     * Same as getImage() with a valid size, but never reads or decodes
+     * the thumbnail in the calling thread. If the scaled thumbnail is
+     * not in the cache, it is loaded in the background, a null image is
+     * returned and sigThumbnailLoaded() is emitted when the thumbnail
+     * is ready.
+     *
+     * The resources whose thumbnail could not be loaded are not tried
+     * again until they change.
+     */
+    QImage getImageLazily(const QModelIndex &index,
+                          const QSize size,
+                          Qt::AspectRatioMode aspectMode = Qt::IgnoreAspectRatio,
+                          Qt::TransformationMode transformMode = Qt::FastTransformation);
+
+    /// the number of scaled thumbnail lookups and the number of them found in the cache
+    qint64 numLookups() const;
+    qint64 numHits() const;
+
+Q_SIGNALS:
+    /**
+     * Emitted when a thumbnail requested with getImageLazily() has been
+     * decoded, the views should repaint themselves
+     */
+    void sigThumbnailLoaded();
+
 private:
     friend class KisResourceQueryMapper;
     friend class KisResourceLocator;
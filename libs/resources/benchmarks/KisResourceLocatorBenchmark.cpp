@@ -0,0 +1,132 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisResourceLocatorBenchmark.h"
+
+#include <simpletest.h>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QImage>
+#include <QStandardPaths>
+
+#include <kconfiggroup.h>
+#include <ksharedconfig.h>
+
+#include <KoTestConfig.h>
+
+#include <KisResourceCacheDb.h>
+#include <KisResourceLocator.h>
+
+#include <ResourceTestHelper.h>
+
+/// the number of copies of the test bundle the resource folder is filled with
+const int numGeneratedBundles = 200;
+
+void KisResourceLocatorBenchmark::initTestCase()
+{
+    ResourceTestHelper::initTestDb();
+    ResourceTestHelper::createDummyLoaderRegistry();
+
+    QVERIFY(m_dstLocation.isValid());
+
+    const QString dstLocation = m_dstLocation.path() + '/';
+
+    KConfigGroup cfg(KSharedConfig::openConfig(), "");
+    cfg.writeEntry(KisResourceLocator::resourceLocationKey, dstLocation);
+
+    m_locator = KisResourceLocator::instance();
+
+    QTemporaryDir emptyInstallationLocation;
+    QVERIFY(emptyInstallationLocation.isValid());
+
+    KisResourceCacheDb::initialize(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    QVERIFY(m_locator->initialize(emptyInstallationLocation.path()) == KisResourceLocator::LocatorError::Ok);
+
+    /**
+     * The bundles are generated after the database has been initialized,
+     * so that the first synchronization finds them as new storages, the
+     * same way as it happens after the user has dropped them into the
+     * resource folder.
+     */
+    const QString srcBundle = KRITA_SOURCE_DIR + QString("/libs/resources/tests/data/bundles/test1.bundle");
+    QVERIFY(QFile::exists(srcBundle));
+
+    QDir().mkpath(dstLocation + "bundles");
+    for (int i = 0; i < numGeneratedBundles; i++) {
+        QVERIFY(QFile::copy(srcBundle, dstLocation + QString("bundles/generated_%1.bundle").arg(i)));
+    }
+}
+
+void KisResourceLocatorBenchmark::cleanupTestCase()
+{
+    ResourceTestHelper::rmTestDb();
+}
+
+void KisResourceLocatorBenchmark::benchmarkSynchronizeNewBundles()
+{
+    QBENCHMARK_ONCE {
+        QVERIFY(m_locator->synchronizeDb());
+    }
+}
+
+void KisResourceLocatorBenchmark::benchmarkSynchronizeUnchangedBundles()
+{
+    QBENCHMARK {
+        QVERIFY(m_locator->synchronizeDb());
+    }
+}
+
+void KisResourceLocatorBenchmark::benchmarkSynchronizeTouchedBundles()
+{
+    const QDateTime newTime = QDateTime::currentDateTime().addSecs(60);
+
+    QDirIterator iter(m_dstLocation.path() + "/bundles", QStringList() << "*.bundle", QDir::Files);
+    while (iter.hasNext()) {
+        iter.next();
+        QFile file(iter.filePath());
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(newTime, QFileDevice::FileModificationTime));
+    }
+
+    // the bundles should be rescanned, but their resources are already known
+    QBENCHMARK_ONCE {
+        QVERIFY(m_locator->synchronizeDb());
+    }
+}
+
+void KisResourceLocatorBenchmark::benchmarkEncodeThumbnailLevels()
+{
+    /**
+     * Measures what the pre-scaled thumbnails of the default resources
+     * would cost if they were made during the synchronization. The
+     * presets are PNG files that are their own thumbnails, the brush
+     * tips and patterns are read only when Qt can decode them.
+     */
+    QVector<QImage> thumbnails;
+
+    Q_FOREACH (const QString &folder, QStringList() << "paintoppresets" << "brushes" << "patterns") {
+        QDirIterator iter(KRITA_SOURCE_DIR + QString("/krita/data/") + folder, QDir::Files);
+        while (iter.hasNext()) {
+            const QImage image(iter.next());
+            if (!image.isNull()) {
+                thumbnails.append(image);
+            }
+        }
+    }
+
+    QVERIFY(!thumbnails.isEmpty());
+    qDebug() << "Encoding the thumbnail levels of" << thumbnails.size() << "default resources";
+
+    QBENCHMARK {
+        Q_FOREACH (const QImage &thumbnail, thumbnails) {
+            KisResourceCacheDb::encodeThumbnailLevels(thumbnail);
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KisResourceLocatorBenchmark)
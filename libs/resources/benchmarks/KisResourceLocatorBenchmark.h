@@ -0,0 +1,33 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISRESOURCELOCATORBENCHMARK_H
+#define KISRESOURCELOCATORBENCHMARK_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class KisResourceLocator;
+
+class KisResourceLocatorBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkSynchronizeNewBundles();
+    void benchmarkSynchronizeUnchangedBundles();
+    void benchmarkSynchronizeTouchedBundles();
+
+    void benchmarkEncodeThumbnailLevels();
+
+private:
+    QTemporaryDir m_dstLocation;
+    KisResourceLocator *m_locator {nullptr};
+};
+
+#endif // KISRESOURCELOCATORBENCHMARK_H
@@ -0,0 +1,8 @@
+CREATE TABLE IF NOT EXISTS resource_thumbnails (
+    id INTEGER PRIMARY KEY
+,   resource_id INTEGER      /* points to the resource the thumbnail belongs to */
+,   size INTEGER             /* the thumbnail fits into a size x size square */
+,   thumbnail BLOB           /* the thumbnail of the resource scaled down to the size, PNG */
+,   FOREIGN KEY(resource_id) REFERENCES resources(id)
+,   UNIQUE(resource_id, size)
+);
@@ -6,6 +6,7 @@ CREATE TABLE IF NOT EXISTS storages (
 ,   pre_installed INTEGER
 ,   active INTEGER
 ,   thumbnail BLOB           /* the image representing the storage visually*/
+,   fingerprint TEXT         /* size and modification time of the storage files at the last synchronization */
 ,   FOREIGN KEY(storage_type_id) REFERENCES storage_types(id)
 ,   UNIQUE(location)
 );
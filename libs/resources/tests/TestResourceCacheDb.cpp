@@ -39,7 +39,8 @@ void TestResourceCacheDb::testCreateDatabase()
                                        << "tags"
                                        << "resources"
                                        << "versioned_resources"
-                                       << "resource_tags";
+                                       << "resource_tags"
+                                       << "resource_thumbnails";
     QStringList dbTables = sqlDb.tables();
 
     Q_FOREACH(const QString &table, tables) {
@@ -96,6 +97,50 @@ void TestResourceCacheDb::testMetaData()
     QVERIFY(m3.size() == 0);
 }
 
+void TestResourceCacheDb::testThumbnailLevels()
+{
+    QImage img(300, 150, QImage::Format_ARGB32);
+    img.fill(Qt::red);
+
+    // the levels are only made for the sizes smaller than the thumbnail
+    QCOMPARE(KisResourceCacheDb::encodeThumbnailLevels(img).keys(), QList<int>() << 64 << 128 << 256);
+    QVERIFY(KisResourceCacheDb::encodeThumbnailLevels(QImage()).isEmpty());
+
+    QVERIFY(KisResourceCacheDb::updateThumbnailLevels(1, img));
+
+    // the smallest level big enough is returned
+    QImage level;
+    QVERIFY(level.loadFromData(KisResourceCacheDb::thumbnailLevel(1, 100), "PNG"));
+    QCOMPARE(level.size(), QSize(128, 64));
+
+    QVERIFY(level.loadFromData(KisResourceCacheDb::thumbnailLevel(1, 32), "PNG"));
+    QCOMPARE(level.size(), QSize(64, 32));
+
+    // the full thumbnail should be used for the bigger sizes
+    QVERIFY(KisResourceCacheDb::thumbnailLevel(1, 257).isEmpty());
+
+    // the levels are replaced on update
+    QImage smallImg(100, 100, QImage::Format_ARGB32);
+    smallImg.fill(Qt::blue);
+
+    QVERIFY(KisResourceCacheDb::updateThumbnailLevels(1, smallImg));
+    QVERIFY(level.loadFromData(KisResourceCacheDb::thumbnailLevel(1, 32), "PNG"));
+    QCOMPARE(level.size(), QSize(64, 64));
+    QVERIFY(KisResourceCacheDb::thumbnailLevel(1, 100).isEmpty());
+
+    // the levels are made again when the thumbnail is shown next time
+    QVERIFY(KisResourceCacheDb::removeThumbnailLevels(1));
+    QVERIFY(KisResourceCacheDb::thumbnailLevel(1, 32).isEmpty());
+
+    // the thread-local connection sees the same data
+    QVERIFY(KisResourceCacheDb::updateThumbnailLevels(1, smallImg));
+    QVERIFY(!KisResourceCacheDb::thumbnailLevel(1, 32, KisResourceCacheDb::threadLocalDatabase()).isEmpty());
+
+    // there is no resource with id 1, so the levels are orphaned
+    QVERIFY(KisResourceCacheDb::removeOrphanedThumbnailLevels());
+    QVERIFY(KisResourceCacheDb::thumbnailLevel(1, 32).isEmpty());
+}
+
 void TestResourceCacheDb::cleanupTestCase()
 {
     QDir dbLocation(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
@@ -17,6 +17,7 @@ private Q_SLOTS:
     void testCreateDatabase();
     void testLookupTables();
     void testMetaData();
+    void testThumbnailLevels();
     void cleanupTestCase();
 private:
 };
@@ -113,6 +113,51 @@ void TestResourceLocator::testLocatorSynchronization()
     }
 }
 
+void TestResourceLocator::testUnchangedStoragesAreSkipped()
+{
+    int numBundles = 0;
+
+    Q_FOREACH(KisResourceStorageSP storage, m_locator->storages()) {
+        const QString fingerprint = KisResourceCacheDb::storageFingerprint(storage);
+
+        if (storage->type() == KisResourceStorage::StorageType::Bundle) {
+            QVERIFY(!fingerprint.isEmpty());
+            QVERIFY(KisResourceCacheDb::storageIsUpToDate(storage, fingerprint));
+            QVERIFY(!KisResourceCacheDb::storageIsUpToDate(storage, fingerprint + "changed"));
+            numBundles++;
+        } else {
+            QVERIFY(fingerprint.isEmpty());
+        }
+    }
+
+    QCOMPARE(numBundles, 2);
+
+    QVERIFY(m_locator->synchronizeDb());
+
+    KisResourceStorageSP changedBundle;
+
+    Q_FOREACH(KisResourceStorageSP storage, m_locator->storages()) {
+        if (storage->type() == KisResourceStorage::StorageType::Bundle) {
+            QVERIFY(!m_locator->lastSynchronizedStorages().contains(storage->location()));
+            changedBundle = storage;
+        }
+    }
+
+    QVERIFY(changedBundle);
+    QVERIFY(KisResourceCacheDb::setStorageFingerprint(changedBundle, "changed"));
+
+    QVERIFY(m_locator->synchronizeDb());
+    QVERIFY(m_locator->lastSynchronizedStorages().contains(changedBundle->location()));
+    QVERIFY(KisResourceCacheDb::storageIsUpToDate(changedBundle, KisResourceCacheDb::storageFingerprint(changedBundle)));
+
+    QSqlQuery query;
+    bool r = query.exec("SELECT COUNT(*) FROM resources");
+    QVERIFY(r);
+    QVERIFY(query.lastError() == QSqlError());
+    query.first();
+    QCOMPARE(query.value(0).toInt(), 7);
+}
+
 void TestResourceLocator::testResourceLocationBase()
 {
     QCOMPARE(m_locator->resourceLocationBase(), m_dstLocation);
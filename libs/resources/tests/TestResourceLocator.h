@@ -20,6 +20,7 @@ private Q_SLOTS:
     void testLocatorInitialization();
     void testStorageInitialization();
     void testLocatorSynchronization();
+    void testUnchangedStoragesAreSkipped();
 
     void testResourceLocationBase();
     void testResource();
@@ -13,6 +13,8 @@
 
 #include "KisIconToolTip.h"
 
+#include <KisResourceThumbnailCache.h>
+
 
 struct  Q_DECL_HIDDEN KisResourceItemListView::Private
 {
@@ -49,6 +51,9 @@ KisResourceItemListView::KisResourceItemListView(QWidget *parent)
 
     connect(this, SIGNAL(clicked(QModelIndex)), SIGNAL(currentResourceClicked(const QModelIndex &)));
 
+    // the thumbnails are decoded in the background, so repaint when they are ready
+    connect(KisResourceThumbnailCache::instance(), SIGNAL(sigThumbnailLoaded()), viewport(), SLOT(update()));
+
     m_d->prev_scrollbar_style = horizontalScrollBar()->styleSheet();
 }
 
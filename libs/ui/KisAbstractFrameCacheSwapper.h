@@ -7,6 +7,7 @@
 #define KISABSTRACTFRAMECACHESWAPPER_H
 
 #include "kritaui_export.h"
+#include "KisFrameCacheStatistics.h"
 
 class QRect;
 
@@ -33,6 +34,8 @@ public:
 
     virtual int frameLevelOfDetail(int frameId) const = 0;
     virtual QRect frameDirtyRect(int frameId) const = 0;
+
+    virtual KisFrameCacheStatistics statistics() const = 0;
 };
 
 #endif // KISABSTRACTFRAMECACHESWAPPER_H
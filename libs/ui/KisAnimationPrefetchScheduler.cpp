@@ -0,0 +1,93 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAnimationPrefetchScheduler.h"
+
+#include "kis_assert.h"
+#include "kis_time_span.h"
+#include "KisFrameCacheStatistics.h"
+
+
+void KisAnimationPrefetchScheduler::setLimits(int framesLimit, qint64 memoryLimit)
+{
+    m_framesLimit = framesLimit;
+    m_memoryLimit = memoryLimit;
+}
+
+int KisAnimationPrefetchScheduler::framesLimit() const
+{
+    return m_framesLimit;
+}
+
+void KisAnimationPrefetchScheduler::setRequest(int frame, int direction)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(direction == 1 || direction == -1);
+
+    m_requestFrame = frame;
+    m_requestDirection = direction;
+}
+
+void KisAnimationPrefetchScheduler::resetRequest()
+{
+    m_requestFrame = -1;
+    m_requestDirection = 1;
+}
+
+bool KisAnimationPrefetchScheduler::hasRequest() const
+{
+    return m_requestFrame >= 0;
+}
+
+int KisAnimationPrefetchScheduler::nextFrame(const KisTimeSpan &range,
+                                             const KisFrameCacheStatistics &stats,
+                                             FrameCachedFunction isCached) const
+{
+    if (!hasRequest()) return -1;
+    if (!range.isValid() || range.isInfinite()) return -1;
+
+    int numFrames = qMin(m_framesLimit, range.duration());
+
+    if (m_memoryLimit > 0) {
+        if (stats.storedBytes >= m_memoryLimit) return -1;
+
+        if (stats.bytesPerFrame() > 0) {
+            const qint64 framesInBudget =
+                (m_memoryLimit - stats.storedBytes) / stats.bytesPerFrame();
+            numFrames = int(qMin(qint64(numFrames), qMax(framesInBudget, qint64(1))));
+        }
+    }
+
+    for (int i = 0; i < numFrames; i++) {
+        int frame = m_requestFrame + i * m_requestDirection - range.start();
+        frame = range.start() + (frame % range.duration() + range.duration()) % range.duration();
+
+        if (!isCached(frame)) {
+            return frame;
+        }
+    }
+
+    return -1;
+}
+
+void KisAnimationPrefetchScheduler::startRegeneration(int frame)
+{
+    m_regeneratedFrame = frame;
+}
+
+void KisAnimationPrefetchScheduler::finishRegeneration()
+{
+    m_regeneratedFrame = -1;
+}
+
+int KisAnimationPrefetchScheduler::regeneratedFrame() const
+{
+    return m_regeneratedFrame;
+}
+
+bool KisAnimationPrefetchScheduler::isRegenerationStale(const KisTimeSpan &changedRange) const
+{
+    return m_regeneratedFrame >= 0 && changedRange.contains(m_regeneratedFrame);
+}
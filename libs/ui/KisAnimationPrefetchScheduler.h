@@ -0,0 +1,82 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISANIMATIONPREFETCHSCHEDULER_H
+#define KISANIMATIONPREFETCHSCHEDULER_H
+
+#include <QtGlobal>
+
+#include <functional>
+
+#include "kritaui_export.h"
+
+class KisTimeSpan;
+struct KisFrameCacheStatistics;
+
+/**
+ * KisAnimationPrefetchScheduler decides which frames ahead of the playhead
+ * KisAnimationCachePopulator should regenerate and when the frame being
+ * regenerated becomes stale. It knows nothing about the images and the
+ * caches themselves, so that the decisions could be tested separately.
+ */
+class KRITAUI_EXPORT KisAnimationPrefetchScheduler
+{
+public:
+    /**
+     * Returns true if \p frame is already in the cache
+     */
+    using FrameCachedFunction = std::function<bool(int)>;
+
+    /**
+     * Sets the maximum number of frames prefetched ahead of the playhead
+     * and the amount of memory the cache may use (zero means unlimited)
+     */
+    void setLimits(int framesLimit, qint64 memoryLimit);
+
+    int framesLimit() const;
+
+    /**
+     * Requests prefetching of the frames following \p frame in \p direction
+     * (1 or -1). The new request replaces the previous one.
+     */
+    void setRequest(int frame, int direction);
+
+    void resetRequest();
+    bool hasRequest() const;
+
+    /**
+     * @return the first uncached frame ahead of the playhead, wrapped around
+     * \p range, or -1 if all the frames within the limits are cached or the
+     * memory budget of the cache, as given by \p stats, is exhausted
+     */
+    int nextFrame(const KisTimeSpan &range,
+                  const KisFrameCacheStatistics &stats,
+                  FrameCachedFunction isCached) const;
+
+    /**
+     * Remembers that \p frame is being regenerated
+     */
+    void startRegeneration(int frame);
+    void finishRegeneration();
+    int regeneratedFrame() const;
+
+    /**
+     * @return true if the frame being regenerated is in \p changedRange,
+     * so its result would be stale right after being cached
+     */
+    bool isRegenerationStale(const KisTimeSpan &changedRange) const;
+
+private:
+    int m_framesLimit = 24;
+    qint64 m_memoryLimit = 0;
+
+    int m_requestFrame = -1;
+    int m_requestDirection = 1;
+
+    int m_regeneratedFrame = -1;
+};
+
+#endif // KISANIMATIONPREFETCHSCHEDULER_H
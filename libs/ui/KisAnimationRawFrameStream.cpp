@@ -0,0 +1,192 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAnimationRawFrameStream.h"
+
+#include <QByteArray>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QRect>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <KoColorConversionTransformation.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_assert.h"
+#include "kis_paint_device.h"
+#include "kis_time_span.h"
+
+
+struct KisAnimationRawFrameStream::Private
+{
+    Private(const KisTimeSpan &_range, FrameWriter _writer)
+        : range(_range),
+          writer(_writer),
+          nextFrame(_range.start())
+    {
+    }
+
+    KisTimeSpan range;
+    FrameWriter writer;
+
+    mutable QMutex mutex;
+    QWaitCondition frameWritten;
+    QMap<int, QPair<QByteArray, int>> pendingFrames;
+    qint64 pendingBytes = 0;
+    int nextFrame = 0;
+    bool failed = false;
+    bool cancelled = false;
+
+    /**
+     * Only one thread writes at a time. The threads that come
+     * later find their frames already written by the first one.
+     */
+    QMutex writeMutex;
+
+    /**
+     * The amount of the queued frames data after which the frames
+     * that come too early start to wait for the encoder
+     */
+    static const qint64 maxPendingBytes = 256 * 1024 * 1024;
+
+    void writePendingFrames();
+};
+
+void KisAnimationRawFrameStream::Private::writePendingFrames()
+{
+    QMutexLocker writeLocker(&writeMutex);
+
+    while (true) {
+        QByteArray data;
+        int numFrames = 0;
+
+        {
+            QMutexLocker l(&mutex);
+            if (failed || cancelled) break;
+
+            auto it = pendingFrames.find(nextFrame);
+            if (it == pendingFrames.end()) break;
+
+            data = it->first;
+            numFrames = it->second;
+            pendingFrames.erase(it);
+            pendingBytes -= data.size();
+        }
+
+        bool result = true;
+
+        for (int i = 0; i < numFrames && result; i++) {
+            result = writer(data);
+        }
+
+        QMutexLocker l(&mutex);
+        nextFrame += numFrames;
+
+        if (!result) {
+            failed = true;
+            pendingFrames.clear();
+            pendingBytes = 0;
+        }
+
+        frameWritten.wakeAll();
+    }
+}
+
+KisAnimationRawFrameStream::KisAnimationRawFrameStream(const KisTimeSpan &range, FrameWriter writer, QObject *parent)
+    : QObject(parent),
+      m_d(new Private(range, writer))
+{
+}
+
+KisAnimationRawFrameStream::~KisAnimationRawFrameStream()
+{
+    cancel();
+
+    // wait for the frame that is being written right now
+    QMutexLocker writeLocker(&m_d->writeMutex);
+}
+
+void KisAnimationRawFrameStream::addFrame(int frame, const QByteArray &data, int numFrames)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(numFrames > 0);
+
+    {
+        QMutexLocker l(&m_d->mutex);
+        KIS_SAFE_ASSERT_RECOVER_RETURN(frame >= m_d->nextFrame);
+
+        // the next frame in order is always accepted, otherwise the stream
+        // would stall with all the rendering threads waiting for each other
+        while (frame > m_d->nextFrame &&
+               m_d->pendingBytes > m_d->maxPendingBytes &&
+               !m_d->failed && !m_d->cancelled) {
+
+            m_d->frameWritten.wait(&m_d->mutex);
+        }
+
+        if (m_d->failed || m_d->cancelled) return;
+
+        m_d->pendingFrames.insert(frame, qMakePair(data, numFrames));
+        m_d->pendingBytes += data.size();
+
+        if (frame != m_d->nextFrame) return;
+    }
+
+    m_d->writePendingFrames();
+}
+
+void KisAnimationRawFrameStream::cancel()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->cancelled = true;
+    m_d->pendingFrames.clear();
+    m_d->pendingBytes = 0;
+    m_d->frameWritten.wakeAll();
+}
+
+bool KisAnimationRawFrameStream::isComplete() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return !m_d->failed && m_d->nextFrame > m_d->range.end();
+}
+
+bool KisAnimationRawFrameStream::hasFailed() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->failed;
+}
+
+const KoColorSpace *KisAnimationRawFrameStream::rawFrameColorSpace()
+{
+    return KoColorSpaceRegistry::instance()->rgb8();
+}
+
+QByteArray KisAnimationRawFrameStream::rawFrameData(KisPaintDeviceSP device, const QRect &rc)
+{
+    const KoColorSpace *srcColorSpace = device->colorSpace();
+    const KoColorSpace *dstColorSpace = rawFrameColorSpace();
+    const int numPixels = rc.width() * rc.height();
+
+    QByteArray data(numPixels * static_cast<int>(dstColorSpace->pixelSize()), Qt::Uninitialized);
+
+    if (*srcColorSpace == *dstColorSpace) {
+        device->readBytes(reinterpret_cast<quint8*>(data.data()), rc);
+    } else {
+        QVector<quint8> srcData(numPixels * static_cast<int>(srcColorSpace->pixelSize()));
+        device->readBytes(srcData.data(), rc);
+        srcColorSpace->convertPixelsTo(srcData.constData(),
+                                       reinterpret_cast<quint8*>(data.data()),
+                                       dstColorSpace,
+                                       static_cast<quint32>(numPixels),
+                                       KoColorConversionTransformation::internalRenderingIntent(),
+                                       KoColorConversionTransformation::internalConversionFlags());
+    }
+
+    return data;
+}
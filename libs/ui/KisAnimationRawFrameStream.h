@@ -0,0 +1,93 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISANIMATIONRAWFRAMESTREAM_H
+#define KISANIMATIONRAWFRAMESTREAM_H
+
+#include <QObject>
+#include <QScopedPointer>
+
+#include <functional>
+
+#include "kis_types.h"
+#include "kritaui_export.h"
+
+class QByteArray;
+class QRect;
+class KisTimeSpan;
+class KoColorSpace;
+
+/**
+ * KisAnimationRawFrameStream collects the raw pixel data of the rendered
+ * frames and passes it to a writer function (usually, the standard input
+ * of the encoder) strictly in the order of the frames.
+ *
+ * The frames are rendered by several image clones in parallel, so they
+ * may arrive in any order and from any thread. The frames that arrive too
+ * early are kept until all the preceding frames are written. The writer is
+ * called by the rendering thread that completes the next frame in order,
+ * never by the GUI thread, so it is allowed to block until the encoder
+ * consumes the data.
+ */
+class KRITAUI_EXPORT KisAnimationRawFrameStream : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * The writer returns false if the frame could not be written, which
+     * stops the stream.
+     */
+    using FrameWriter = std::function<bool(const QByteArray &)>;
+
+    KisAnimationRawFrameStream(const KisTimeSpan &range, FrameWriter writer, QObject *parent = nullptr);
+    ~KisAnimationRawFrameStream() override;
+
+    /**
+     * Adds the data of \p frame to the stream. The frame is written
+     * \p numFrames times, which is used for the frames held by the
+     * keyframes. The data is implicitly shared, so the repeated frames
+     * are not copied.
+     *
+     * Thread-safe. If \p frame is the next one in order, it is written,
+     * along with all the queued frames following it, before the call
+     * returns. When too much data is already queued, a frame that comes
+     * too early blocks the calling thread until the encoder catches up.
+     */
+    void addFrame(int frame, const QByteArray &data, int numFrames = 1);
+
+    /**
+     * Drops all the queued frames and wakes up the threads waiting in
+     * addFrame(). The frames added afterwards are ignored.
+     */
+    void cancel();
+
+    /**
+     * @return true when all the frames of the range have been written
+     */
+    bool isComplete() const;
+
+    /**
+     * @return true if the writer has failed to write a frame
+     */
+    bool hasFailed() const;
+
+    /**
+     * The color space of the raw frames: 8-bit sRGB, stored in memory
+     * as B, G, R, A bytes ("bgra" pixel format of ffmpeg)
+     */
+    static const KoColorSpace *rawFrameColorSpace();
+
+    /**
+     * Converts the rect \p rc of \p device into a raw frame
+     */
+    static QByteArray rawFrameData(KisPaintDeviceSP device, const QRect &rc);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISANIMATIONRAWFRAMESTREAM_H
@@ -0,0 +1,75 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAsyncAnimationFramesStreamingRenderer.h"
+
+#include "kis_image.h"
+#include "kis_paint_device.h"
+#include "kis_time_span.h"
+#include "KisAnimationRawFrameStream.h"
+
+
+struct KisAsyncAnimationFramesStreamingRenderer::Private
+{
+    Private(KisAnimationRawFrameStream *_stream, const KisTimeSpan &_range)
+        : stream(_stream),
+          range(_range)
+    {
+    }
+
+    KisAnimationRawFrameStream *stream;
+    KisTimeSpan range;
+};
+
+KisAsyncAnimationFramesStreamingRenderer::KisAsyncAnimationFramesStreamingRenderer(KisAnimationRawFrameStream *stream,
+                                                                                   const KisTimeSpan &range)
+    : m_d(new Private(stream, range))
+{
+    connect(this, SIGNAL(sigCompleteRegenerationInternal(int)), SLOT(notifyFrameCompleted(int)));
+    connect(this, SIGNAL(sigCancelRegenerationInternal(int, KisAsyncAnimationRendererBase::CancelReason)), SLOT(notifyFrameCancelled(int, KisAsyncAnimationRendererBase::CancelReason)));
+}
+
+KisAsyncAnimationFramesStreamingRenderer::~KisAsyncAnimationFramesStreamingRenderer()
+{
+}
+
+void KisAsyncAnimationFramesStreamingRenderer::frameCompletedCallback(int frame, const KisRegion &requestedRegion)
+{
+    KisImageSP image = requestedImage();
+    if (!image) return;
+
+    KIS_SAFE_ASSERT_RECOVER (requestedRegion == image->bounds()) {
+        emit sigCancelRegenerationInternal(frame, KisAsyncAnimationRendererBase::RenderingFailed);
+        return;
+    }
+
+    if (m_d->stream->hasFailed()) {
+        emit sigCancelRegenerationInternal(frame, KisAsyncAnimationRendererBase::RenderingFailed);
+        return;
+    }
+
+    // the conversion happens in the worker thread, only writing is serialized
+    const QByteArray data = KisAnimationRawFrameStream::rawFrameData(image->projection(), image->bounds());
+
+    // the frames held by the keyframe share the same data
+    KisTimeSpan identicals = KisTimeSpan::calculateIdenticalFramesRecursive(image->root(), frame);
+    identicals &= m_d->range;
+
+    const int numFrames =
+        identicals.isValid() && identicals.start() < identicals.end() ?
+            identicals.end() - frame + 1 : 1;
+
+    m_d->stream->addFrame(frame, data, numFrames);
+
+    emit sigCompleteRegenerationInternal(frame);
+}
+
+void KisAsyncAnimationFramesStreamingRenderer::frameCancelledCallback(int frame, CancelReason cancelReason)
+{
+    // wake up the rendering threads waiting for this frame to be written
+    m_d->stream->cancel();
+    notifyFrameCancelled(frame, cancelReason);
+}
@@ -0,0 +1,40 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISASYNCANIMATIONFRAMESSTREAMINGRENDERER_H
+#define KISASYNCANIMATIONFRAMESSTREAMINGRENDERER_H
+
+#include <KisAsyncAnimationRendererBase.h>
+
+class KisTimeSpan;
+class KisAnimationRawFrameStream;
+
+/**
+ * A renderer that passes the raw data of the rendered frames into a
+ * KisAnimationRawFrameStream instead of saving them into files
+ */
+class KisAsyncAnimationFramesStreamingRenderer : public KisAsyncAnimationRendererBase
+{
+    Q_OBJECT
+public:
+    KisAsyncAnimationFramesStreamingRenderer(KisAnimationRawFrameStream *stream,
+                                             const KisTimeSpan &range);
+    ~KisAsyncAnimationFramesStreamingRenderer();
+
+protected:
+    void frameCompletedCallback(int frame, const KisRegion &requestedRegion) override;
+    void frameCancelledCallback(int frame, CancelReason cancelReason) override;
+
+Q_SIGNALS:
+    void sigCompleteRegenerationInternal(int frame);
+    void sigCancelRegenerationInternal(int frame, KisAsyncAnimationRendererBase::CancelReason cancelReason);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISASYNCANIMATIONFRAMESSTREAMINGRENDERER_H
@@ -0,0 +1,69 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISFRAMECACHESTATISTICS_H
+#define KISFRAMECACHESTATISTICS_H
+
+#include <QtGlobal>
+#include <QDebug>
+
+/**
+ * Memory usage and hit rates of the animation frame cache
+ */
+struct KisFrameCacheStatistics
+{
+    /// the number of frames currently stored in the cache
+    int numFrames = 0;
+
+    /// the size of the stored frames before delta encoding,
+    /// deduplication and compression
+    qint64 rawBytes = 0;
+
+    /// the amount of memory (or disk space) actually used by the frames
+    qint64 storedBytes = 0;
+
+    /// the number of tiles passed to the storage and the number of
+    /// them found to be a duplicate of an already stored tile
+    qint64 numTileLookups = 0;
+    qint64 numTileHits = 0;
+
+    /// the number of frames requested from the cache during
+    /// playback and the number of them found in the cache
+    qint64 numFrameLookups = 0;
+    qint64 numFrameHits = 0;
+
+    qint64 bytesPerFrame() const {
+        return numFrames > 0 ? storedBytes / numFrames : 0;
+    }
+
+    qreal compressionRatio() const {
+        return storedBytes > 0 ? qreal(rawBytes) / storedBytes : 1.0;
+    }
+
+    qreal tileHitRate() const {
+        return numTileLookups > 0 ? qreal(numTileHits) / numTileLookups : 0.0;
+    }
+
+    qreal frameHitRate() const {
+        return numFrameLookups > 0 ? qreal(numFrameHits) / numFrameLookups : 0.0;
+    }
+};
+
+inline QDebug operator<<(QDebug dbg, const KisFrameCacheStatistics &stats)
+{
+    QDebugStateSaver saver(dbg);
+    dbg.nospace() << "KisFrameCacheStatistics("
+                  << "frames: " << stats.numFrames
+                  << ", bytes per frame: " << stats.bytesPerFrame()
+                  << ", stored: " << stats.storedBytes
+                  << ", raw: " << stats.rawBytes
+                  << ", compression: " << stats.compressionRatio()
+                  << ", tile hit rate: " << stats.tileHitRate()
+                  << ", frame hit rate: " << stats.frameHitRate()
+                  << ")";
+    return dbg;
+}
+
+#endif // KISFRAMECACHESTATISTICS_H
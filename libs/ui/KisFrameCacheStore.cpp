@@ -115,8 +115,8 @@ FrameInfo::~FrameInfo()
 
 struct KRITAUI_NO_EXPORT KisFrameCacheStore::Private
 {
-    Private(const QString &frameCachePath)
-        : serializer(frameCachePath)
+    Private(KisFrameDataSerializer::Storage storage, const QString &frameCachePath)
+        : serializer(storage, frameCachePath)
     {
     }
 
@@ -139,7 +139,12 @@ KisFrameCacheStore::KisFrameCacheStore()
 }
 
 KisFrameCacheStore::KisFrameCacheStore(const QString &frameCachePath)
-    : m_d(new Private(frameCachePath))
+    : KisFrameCacheStore(KisFrameDataSerializer::StoreOnDisk, frameCachePath)
+{
+}
+
+KisFrameCacheStore::KisFrameCacheStore(KisFrameDataSerializer::Storage storage, const QString &frameCachePath)
+    : m_d(new Private(storage, frameCachePath))
 {
 }
 
@@ -370,3 +375,13 @@ QRect KisFrameCacheStore::frameDirtyRect(int frameId) const
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), QRect());
     return m_d->savedFrames[frameId]->dirtyImageRect();
 }
+
+KisFrameCacheStatistics KisFrameCacheStore::statistics() const
+{
+    KisFrameCacheStatistics stats = m_d->serializer.statistics();
+
+    // copy-frames have no data of their own, but still count as frames
+    stats.numFrames = m_d->savedFrames.size();
+
+    return stats;
+}
@@ -11,6 +11,7 @@
 #include "kis_types.h"
 
 #include "opengl/kis_texture_tile_info_pool.h"
+#include "KisFrameDataSerializer.h"
 
 class KisOpenGLUpdateInfoBuilder;
 
@@ -33,6 +34,9 @@ typedef KisSharedPtr<KisOpenGLUpdateInfo> KisOpenGLUpdateInfoSP;
  *
  * 4) The in-memory cache of the keyframes is stored in serializable
  *    KisFrameDataSerializer::Frame format.
+ *
+ * The frames may be stored either on disk or in memory (compressed and
+ * deduplicated), depending on the storage type of the serializer.
  */
 
 class KRITAUI_EXPORT KisFrameCacheStore
@@ -40,6 +44,7 @@ class KRITAUI_EXPORT KisFrameCacheStore
 public:
     KisFrameCacheStore();
     KisFrameCacheStore(const QString &frameCachePath);
+    KisFrameCacheStore(KisFrameDataSerializer::Storage storage, const QString &frameCachePath = QString());
 
     ~KisFrameCacheStore();
 
@@ -55,6 +60,8 @@ public:
     int frameLevelOfDetail(int frameId) const;
     QRect frameDirtyRect(int frameId) const;
 
+    KisFrameCacheStatistics statistics() const;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -12,8 +12,8 @@
 
 struct KisFrameCacheSwapper::Private
 {
-    Private(const KisOpenGLUpdateInfoBuilder &_builder, const QString &frameCachePath)
-        : frameStore(frameCachePath),
+    Private(const KisOpenGLUpdateInfoBuilder &_builder, KisFrameDataSerializer::Storage storage, const QString &frameCachePath)
+        : frameStore(storage, frameCachePath),
           builder(_builder)
     {
     }
@@ -28,7 +28,12 @@ KisFrameCacheSwapper::KisFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &bui
 }
 
 KisFrameCacheSwapper::KisFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &builder, const QString &frameCachePath)
-    : m_d(new Private(builder, frameCachePath))
+    : KisFrameCacheSwapper(builder, KisFrameDataSerializer::StoreOnDisk, frameCachePath)
+{
+}
+
+KisFrameCacheSwapper::KisFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &builder, KisFrameDataSerializer::Storage storage, const QString &frameCachePath)
+    : m_d(new Private(builder, storage, frameCachePath))
 {
 }
 
@@ -70,3 +75,8 @@ QRect KisFrameCacheSwapper::frameDirtyRect(int frameId) const
 {
     return m_d->frameStore.frameDirtyRect(frameId);
 }
+
+KisFrameCacheStatistics KisFrameCacheSwapper::statistics() const
+{
+    return m_d->frameStore.statistics();
+}
@@ -9,6 +9,7 @@
 #include <QScopedPointer>
 
 #include "KisAbstractFrameCacheSwapper.h"
+#include "KisFrameDataSerializer.h"
 
 class KisOpenGLUpdateInfoBuilder;
 
@@ -30,6 +31,7 @@ class KRITAUI_EXPORT KisFrameCacheSwapper : public KisAbstractFrameCacheSwapper
 public:
     KisFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &builder);
     KisFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &builder, const QString &frameCachePath);
+    KisFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &builder, KisFrameDataSerializer::Storage storage, const QString &frameCachePath = QString());
     ~KisFrameCacheSwapper();
 
     // WARNING: after transferring \p info to saveFrame() the object becomes invalid
@@ -45,6 +47,8 @@ public:
 
     QRect frameDirtyRect(int frameId) const override;
 
+    KisFrameCacheStatistics statistics() const override;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
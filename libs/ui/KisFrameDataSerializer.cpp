@@ -9,20 +9,59 @@
 
 #include <QTemporaryDir>
 #include <QElapsedTimer>
+#include <QHash>
+#include <QSharedPointer>
 
 #include "tiles3/swap/kis_lzf_compression.h"
 
+namespace {
+
+/**
+ * A compressed tile buffer stored in memory. The buffer is shared
+ * between all the frame tiles that have identical content.
+ */
+struct StoredTileData
+{
+    uint hash = 0;
+    int refCount = 0;
+    bool isCompressed = false;
+    QByteArray data;
+};
+
+typedef QSharedPointer<StoredTileData> StoredTileDataSP;
+
+struct StoredFrameTile
+{
+    int col = -1;
+    int row = -1;
+    QRect rect;
+    StoredTileDataSP data;
+};
+
+struct StoredFrame
+{
+    int pixelSize = 0;
+    qint64 rawBytes = 0;
+    std::vector<StoredFrameTile> tiles;
+};
+
+}
+
 struct KRITAUI_NO_EXPORT KisFrameDataSerializer::Private
 {
-    Private(const QString &frameCachePath)
-        : framesDir(
-              (!frameCachePath.isEmpty() && QTemporaryDir(frameCachePath + "/KritaFrameCacheXXXXXX").isValid()
-               ? frameCachePath
-               : QDir::tempPath())
-              + "/KritaFrameCacheXXXXXX")
+    Private(Storage _storage, const QString &frameCachePath)
+        : storage(_storage)
     {
-        framesDirObject = QDir(framesDir.path());
-        framesDirObject.makeAbsolute();
+        if (storage == StoreOnDisk) {
+            framesDir.reset(new QTemporaryDir(
+                (!frameCachePath.isEmpty() && QTemporaryDir(frameCachePath + "/KritaFrameCacheXXXXXX").isValid()
+                 ? frameCachePath
+                 : QDir::tempPath())
+                + "/KritaFrameCacheXXXXXX"));
+
+            framesDirObject = QDir(framesDir->path());
+            framesDirObject.makeAbsolute();
+        }
     }
 
     QString subfolderNameForFrame(int frameId)
@@ -54,20 +93,117 @@ struct KRITAUI_NO_EXPORT KisFrameDataSerializer::Private
         return reinterpret_cast<quint8*>(compressionBuffer.data());
     }
 
-    QTemporaryDir framesDir;
+    StoredTileDataSP acquireTileData(const quint8 *data, int size, bool isCompressed);
+    void releaseTileData(StoredTileDataSP tileData);
+
+    Storage storage = StoreOnDisk;
+
+    QScopedPointer<QTemporaryDir> framesDir;
     QDir framesDirObject;
     int nextFrameId = 0;
 
     QByteArray compressionBuffer;
+
+    QHash<int, StoredFrame> memoryFrames;
+    QMultiHash<uint, StoredTileDataSP> tilesByHash;
+
+    /**
+     * For the frames stored on disk we keep only the sizes
+     * of the saved files: {raw size, stored size}
+     */
+    QHash<int, QPair<qint64, qint64>> diskFrameSizes;
+
+    KisFrameCacheStatistics stats;
 };
 
+StoredTileDataSP KisFrameDataSerializer::Private::acquireTileData(const quint8 *data, int size, bool isCompressed)
+{
+    const uint hash = qHashBits(data, size, uint(isCompressed));
+
+    stats.numTileLookups++;
+
+    /**
+     * The hash is used only for lookup, the tiles are considered
+     * identical only when their compressed data is bitwise equal.
+     */
+    for (auto it = tilesByHash.find(hash); it != tilesByHash.end() && it.key() == hash; ++it) {
+        StoredTileDataSP candidate = it.value();
+
+        if (candidate->isCompressed == isCompressed &&
+            candidate->data.size() == size &&
+            std::memcmp(candidate->data.constData(), data, size) == 0) {
+
+            candidate->refCount++;
+            stats.numTileHits++;
+            return candidate;
+        }
+    }
+
+    StoredTileDataSP tileData(new StoredTileData());
+    tileData->hash = hash;
+    tileData->refCount = 1;
+    tileData->isCompressed = isCompressed;
+    tileData->data = QByteArray(reinterpret_cast<const char*>(data), size);
+
+    tilesByHash.insert(hash, tileData);
+    stats.storedBytes += size;
+
+    return tileData;
+}
+
+void KisFrameDataSerializer::Private::releaseTileData(StoredTileDataSP tileData)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(tileData->refCount > 0);
+
+    if (--tileData->refCount > 0) return;
+
+    for (auto it = tilesByHash.find(tileData->hash); it != tilesByHash.end() && it.key() == tileData->hash; ++it) {
+        if (it.value() == tileData) {
+            tilesByHash.erase(it);
+            break;
+        }
+    }
+
+    stats.storedBytes -= tileData->data.size();
+}
+
+namespace {
+
+bool decompressTileData(KisLzfCompression &compression,
+                        KisFrameDataSerializer::FrameTile &tile, int pixelSize,
+                        const quint8 *data, int inputSize, bool isCompressed)
+{
+    const int frameByteSize = pixelSize * tile.rect.width() * tile.rect.height();
+
+    tile.data.allocate(pixelSize);
+
+    if (isCompressed) {
+        const int decompressedSize =
+            compression.decompress(data, inputSize, tile.data.data(), frameByteSize);
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(frameByteSize == decompressedSize, false);
+    } else {
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(frameByteSize == inputSize, false);
+        memcpy(tile.data.data(), data, inputSize);
+    }
+
+    return true;
+}
+
+}
+
 KisFrameDataSerializer::KisFrameDataSerializer()
     : KisFrameDataSerializer(QString())
 {
 }
 
 KisFrameDataSerializer::KisFrameDataSerializer(const QString &frameCachePath)
-    : m_d(new Private(frameCachePath))
+    : KisFrameDataSerializer(StoreOnDisk, frameCachePath)
+{
+}
+
+KisFrameDataSerializer::KisFrameDataSerializer(Storage storage, const QString &frameCachePath)
+    : m_d(new Private(storage, frameCachePath))
 {
 }
 
@@ -81,6 +217,40 @@ int KisFrameDataSerializer::saveFrame(const KisFrameDataSerializer::Frame &frame
 
     const int frameId = m_d->generateFrameId();
 
+    if (m_d->storage == StoreInMemory) {
+        StoredFrame storedFrame;
+        storedFrame.pixelSize = frame.pixelSize;
+
+        for (int i = 0; i < int(frame.frameTiles.size()); i++) {
+            const FrameTile &tile = frame.frameTiles[i];
+
+            const int frameByteSize = frame.pixelSize * tile.rect.width() * tile.rect.height();
+            const int maxBufferSize = compression.outputBufferSize(frameByteSize);
+            quint8 *buffer = m_d->getCompressionBuffer(maxBufferSize);
+
+            const int compressedSize =
+                compression.compress(tile.data.data(), frameByteSize, buffer, maxBufferSize);
+
+            const bool isCompressed = compressedSize < frameByteSize;
+
+            StoredFrameTile storedTile;
+            storedTile.col = tile.col;
+            storedTile.row = tile.row;
+            storedTile.rect = tile.rect;
+            storedTile.data = isCompressed ?
+                m_d->acquireTileData(buffer, compressedSize, true) :
+                m_d->acquireTileData(tile.data.data(), frameByteSize, false);
+
+            storedFrame.rawBytes += frameByteSize;
+            storedFrame.tiles.push_back(storedTile);
+        }
+
+        m_d->stats.rawBytes += storedFrame.rawBytes;
+        m_d->memoryFrames[frameId] = std::move(storedFrame);
+
+        return frameId;
+    }
+
     const QString frameSubfolder = m_d->subfolderNameForFrame(frameId);
 
     if (!m_d->framesDirObject.exists(frameSubfolder)) {
@@ -105,6 +275,9 @@ int KisFrameDataSerializer::saveFrame(const KisFrameDataSerializer::Frame &frame
 
     stream << int(frame.frameTiles.size());
 
+    qint64 rawBytes = 0;
+    qint64 storedBytes = 0;
+
     for (int i = 0; i < int(frame.frameTiles.size()); i++) {
         const FrameTile &tile = frame.frameTiles[i];
 
@@ -131,10 +304,17 @@ int KisFrameDataSerializer::saveFrame(const KisFrameDataSerializer::Frame &frame
             stream << frameByteSize;
             stream.writeRawData((char*)tile.data.data(), frameByteSize);
         }
+
+        rawBytes += frameByteSize;
+        storedBytes += isCompressed ? compressedSize : frameByteSize;
     }
 
     file.close();
 
+    m_d->diskFrameSizes.insert(frameId, qMakePair(rawBytes, storedBytes));
+    m_d->stats.rawBytes += rawBytes;
+    m_d->stats.storedBytes += storedBytes;
+
     return frameId;
 }
 
@@ -150,6 +330,36 @@ KisFrameDataSerializer::Frame KisFrameDataSerializer::loadFrame(int frameId, Kis
 
     qint64 compressionTime = 0;
 
+    if (m_d->storage == StoreInMemory) {
+        auto it = m_d->memoryFrames.constFind(frameId);
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(it != m_d->memoryFrames.constEnd(), frame);
+
+        frame.pixelSize = it->pixelSize;
+
+        for (const StoredFrameTile &storedTile : it->tiles) {
+            FrameTile tile(pool);
+            tile.col = storedTile.col;
+            tile.row = storedTile.row;
+            tile.rect = storedTile.rect;
+
+            const int frameByteSize = frame.pixelSize * tile.rect.width() * tile.rect.height();
+            KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(frameByteSize <= pool->chunkSize(frame.pixelSize),
+                                                 KisFrameDataSerializer::Frame());
+
+            const bool result =
+                decompressTileData(compression, tile, frame.pixelSize,
+                                   reinterpret_cast<const quint8*>(storedTile.data->data.constData()),
+                                   storedTile.data->data.size(),
+                                   storedTile.data->isCompressed);
+
+            KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(result, KisFrameDataSerializer::Frame());
+
+            frame.frameTiles.push_back(std::move(tile));
+        }
+
+        return frame;
+    }
+
     const QString framePath = m_d->filePathForFrame(frameId);
 
     QFile file(framePath);
@@ -221,27 +431,79 @@ KisFrameDataSerializer::Frame KisFrameDataSerializer::loadFrame(int frameId, Kis
 
 void KisFrameDataSerializer::moveFrame(int srcFrameId, int dstFrameId)
 {
+    if (m_d->storage == StoreInMemory) {
+        KIS_SAFE_ASSERT_RECOVER_RETURN(m_d->memoryFrames.contains(srcFrameId));
+
+        KIS_SAFE_ASSERT_RECOVER(!m_d->memoryFrames.contains(dstFrameId)) {
+            forgetFrame(dstFrameId);
+        }
+
+        m_d->memoryFrames[dstFrameId] = m_d->memoryFrames.take(srcFrameId);
+        return;
+    }
+
     const QString srcFramePath = m_d->filePathForFrame(srcFrameId);
     const QString dstFramePath = m_d->filePathForFrame(dstFrameId);
     KIS_SAFE_ASSERT_RECOVER_RETURN(QFileInfo(srcFramePath).exists());
 
     KIS_SAFE_ASSERT_RECOVER(!QFileInfo(dstFramePath).exists()) {
-        QFile::remove(dstFramePath);
+        forgetFrame(dstFrameId);
     }
 
     QFile::rename(srcFramePath, dstFramePath);
+
+    if (m_d->diskFrameSizes.contains(srcFrameId)) {
+        m_d->diskFrameSizes.insert(dstFrameId, m_d->diskFrameSizes.take(srcFrameId));
+    }
 }
 
 bool KisFrameDataSerializer::hasFrame(int frameId) const
 {
+    if (m_d->storage == StoreInMemory) {
+        return m_d->memoryFrames.contains(frameId);
+    }
+
     const QString framePath = m_d->filePathForFrame(frameId);
     return QFileInfo(framePath).exists();
 }
 
 void KisFrameDataSerializer::forgetFrame(int frameId)
 {
+    if (m_d->storage == StoreInMemory) {
+        auto it = m_d->memoryFrames.find(frameId);
+        if (it == m_d->memoryFrames.end()) return;
+
+        for (const StoredFrameTile &storedTile : it->tiles) {
+            m_d->releaseTileData(storedTile.data);
+        }
+
+        m_d->stats.rawBytes -= it->rawBytes;
+        m_d->memoryFrames.erase(it);
+        return;
+    }
+
     const QString framePath = m_d->filePathForFrame(frameId);
     QFile::remove(framePath);
+
+    auto it = m_d->diskFrameSizes.find(frameId);
+    if (it != m_d->diskFrameSizes.end()) {
+        m_d->stats.rawBytes -= it->first;
+        m_d->stats.storedBytes -= it->second;
+        m_d->diskFrameSizes.erase(it);
+    }
+}
+
+KisFrameDataSerializer::Storage KisFrameDataSerializer::storage() const
+{
+    return m_d->storage;
+}
+
+KisFrameCacheStatistics KisFrameDataSerializer::statistics() const
+{
+    KisFrameCacheStatistics stats = m_d->stats;
+    stats.numFrames = m_d->storage == StoreInMemory ?
+        m_d->memoryFrames.size() : m_d->diskFrameSizes.size();
+    return stats;
 }
 
 boost::optional<qreal> KisFrameDataSerializer::estimateFrameUniqueness(const KisFrameDataSerializer::Frame &lhs, const KisFrameDataSerializer::Frame &rhs, qreal portion)
@@ -13,6 +13,8 @@
 // TODO: extract DataBuffer into a separate file
 #include "opengl/kis_texture_tile_update_info.h"
 
+#include "KisFrameCacheStatistics.h"
+
 #include <vector>
 #include <boost/optional.hpp>
 
@@ -27,7 +29,11 @@ class QString;
  *    which contains raw data in it (the data may be not a pixel data,
  *    but a preprocessed pixel differences)
  *
- * 2) Compress this data and save it on disk
+ * 2) Compress this data and save it on disk or keep it in memory
+ *
+ * When the frames are stored in memory, the compressed tiles are
+ * deduplicated: the tiles with identical content (e.g. unchanged
+ * parts of the difference frames) share the same buffer.
  */
 
 class KRITAUI_EXPORT KisFrameDataSerializer
@@ -94,9 +100,15 @@ public:
         }
     };
 
+    enum Storage {
+        StoreOnDisk,
+        StoreInMemory
+    };
+
 public:
     KisFrameDataSerializer();
     KisFrameDataSerializer(const QString &frameCachePath);
+    KisFrameDataSerializer(Storage storage, const QString &frameCachePath = QString());
     ~KisFrameDataSerializer();
 
     int saveFrame(const Frame &frame);
@@ -107,6 +119,14 @@ public:
     bool hasFrame(int frameId) const;
     void forgetFrame(int frameId);
 
+    Storage storage() const;
+
+    /**
+     * Returns the number of the stored frames, their sizes and
+     * the tile deduplication hit rate
+     */
+    KisFrameCacheStatistics statistics() const;
+
     static boost::optional<qreal> estimateFrameUniqueness(const Frame &lhs, const Frame &rhs, qreal portion);
     static bool subtractFrames(Frame &dst, const Frame &src);
     static void addFrames(Frame &dst, const Frame &src);
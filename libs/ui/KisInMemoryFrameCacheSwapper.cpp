@@ -8,10 +8,24 @@
 #include <QMap>
 #include <kis_update_info.h>
 
+namespace {
+qint64 frameDataSize(KisOpenGLUpdateInfoSP info)
+{
+    qint64 size = 0;
+
+    Q_FOREACH (KisTextureTileUpdateInfoSP tile, info->tileList) {
+        size += tile->patchPixelsLength();
+    }
+
+    return size;
+}
+}
+
 
 struct KRITAUI_NO_EXPORT KisInMemoryFrameCacheSwapper::Private
 {
     QMap<int, KisOpenGLUpdateInfoSP> framesMap;
+    qint64 framesDataSize = 0;
 };
 
 KisInMemoryFrameCacheSwapper::KisInMemoryFrameCacheSwapper()
@@ -26,9 +40,12 @@ KisInMemoryFrameCacheSwapper::~KisInMemoryFrameCacheSwapper()
 void KisInMemoryFrameCacheSwapper::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, const QRect &imageBounds)
 {
     Q_UNUSED(imageBounds);
-    KIS_SAFE_ASSERT_RECOVER_NOOP(!m_d->framesMap.contains(frameId));
+    KIS_SAFE_ASSERT_RECOVER(!m_d->framesMap.contains(frameId)) {
+        m_d->framesDataSize -= frameDataSize(m_d->framesMap[frameId]);
+    }
 
     m_d->framesMap.insert(frameId, info);
+    m_d->framesDataSize += frameDataSize(info);
 }
 
 KisOpenGLUpdateInfoSP KisInMemoryFrameCacheSwapper::loadFrame(int frameId)
@@ -49,7 +66,7 @@ void KisInMemoryFrameCacheSwapper::moveFrame(int srcFrameId, int dstFrameId)
 void KisInMemoryFrameCacheSwapper::forgetFrame(int frameId)
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(m_d->framesMap.contains(frameId));
-    m_d->framesMap.remove(frameId);
+    m_d->framesDataSize -= frameDataSize(m_d->framesMap.take(frameId));
 }
 
 bool KisInMemoryFrameCacheSwapper::hasFrame(int frameId) const
@@ -70,3 +87,12 @@ QRect KisInMemoryFrameCacheSwapper::frameDirtyRect(int frameId) const
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!m_d->framesMap[frameId].isNull(), QRect());
     return m_d->framesMap[frameId]->dirtyImageRect();
 }
+
+KisFrameCacheStatistics KisInMemoryFrameCacheSwapper::statistics() const
+{
+    KisFrameCacheStatistics stats;
+    stats.numFrames = m_d->framesMap.size();
+    stats.rawBytes = m_d->framesDataSize;
+    stats.storedBytes = m_d->framesDataSize;
+    return stats;
+}
@@ -33,6 +33,8 @@ public:
 
     QRect frameDirtyRect(int frameId) const override;
 
+    KisFrameCacheStatistics statistics() const override;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
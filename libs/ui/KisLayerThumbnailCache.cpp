@@ -8,6 +8,8 @@
 #include "kis_image.h"
 #include "KisIdleTasksManager.h"
 #include "kis_layer_utils.h"
+#include "KisIncrementalThumbnail.h"
+#include "kis_pointer_utils.h"
 
 #include "KisRunnableStrokeJobUtils.h"
 #include "KisRunnableStrokeJobsInterface.h"
@@ -19,6 +21,8 @@ struct ThumbnailRecord {
     int seqNo = -1;
     int maxSize = 0;
 };
+
+using ThumbnailGeneratorSP = QSharedPointer<KisIncrementalThumbnail>;
 } // namespace
 
 struct ThumbnailsStroke : KisIdleTaskStrokeStrategy
@@ -26,14 +30,18 @@ struct ThumbnailsStroke : KisIdleTaskStrokeStrategy
     Q_OBJECT
 public:
 
-    ThumbnailsStroke(KisImageSP image, int maxSize, const QMap<KisNodeWSP, ThumbnailRecord> &cache)
+    ThumbnailsStroke(KisImageSP image, int maxSize,
+                     const QMap<KisNodeWSP, ThumbnailRecord> &cache,
+                     const QMap<KisNodeWSP, ThumbnailGeneratorSP> &generators)
         : KisIdleTaskStrokeStrategy(QLatin1String("layer-thumbnails-stroke"), kundo2_i18n("Update layer thumbnails"))
         , m_root(image->root())
         , m_maxSize(maxSize)
         , m_cache(cache)
+        , m_generators(generators)
     {
         // thread-safety!
         m_cache.detach();
+        m_generators.detach();
     }
 
     void initStrokeCallback() override
@@ -67,8 +75,15 @@ public:
             }
 
             if (shouldRegenerateThumbnail) {
-                addJobConcurrent(jobs, [node, this] () mutable {
-                    QImage image = node->createThumbnail(m_maxSize, m_maxSize, Qt::KeepAspectRatio);
+                ThumbnailGeneratorSP generator = m_generators.value(node);
+
+                addJobConcurrent(jobs, [node, generator, this] () mutable {
+                    KisPaintDeviceSP source = generator ? node->thumbnailSourceDevice() : KisPaintDeviceSP();
+
+                    QImage image = source ?
+                        generator->thumbnail(source, m_maxSize) :
+                        node->createThumbnail(m_maxSize, m_maxSize, Qt::KeepAspectRatio);
+
                     this->sigThumbnailGenerated(node, node->thumbnailSeqNo(), m_maxSize, image);
                 });
             }
@@ -84,6 +99,7 @@ private:
     KisNodeSP m_root;
     int m_maxSize;
     QMap<KisNodeWSP, ThumbnailRecord> m_cache;
+    QMap<KisNodeWSP, ThumbnailGeneratorSP> m_generators;
 
 };
 
@@ -95,6 +111,14 @@ struct KisLayerThumbnailCache::Private
     int maxSize = 32;
     QMap<KisNodeWSP, ThumbnailRecord> cache;
 
+    /**
+     * The generators keep the downsampled copies of the layers, so that
+     * only the changed tiles are processed when the thumbnail is updated.
+     * They are created in the GUI thread and only used by the stroke jobs.
+     */
+    QMap<KisNodeWSP, ThumbnailGeneratorSP> generators;
+
+    void updateGenerators(KisImageSP image);
     void cleanupDeletedNodes();
 };
 
@@ -110,7 +134,8 @@ void KisLayerThumbnailCache::setIdleTaskManagerImpl(KisIdleTasksManager *manager
 {
     if (manager) {
         m_d->taskGuard = manager->addIdleTaskWithGuard([this] (KisImageSP image) {
-            ThumbnailsStroke *stroke = new ThumbnailsStroke(image, m_d->maxSize, m_d->cache);
+            m_d->updateGenerators(image);
+            ThumbnailsStroke *stroke = new ThumbnailsStroke(image, m_d->maxSize, m_d->cache, m_d->generators);
             connect(stroke, SIGNAL(sigThumbnailGenerated(KisNodeSP, int, int, QImage)), this, SLOT(slotThumbnailGenerated(KisNodeSP, int, int, QImage)));
             return stroke;
         });
@@ -123,6 +148,7 @@ void KisLayerThumbnailCache::setImage(KisImageSP image)
 {
     m_d->image = image;
     m_d->cache.clear();
+    m_d->generators.clear();
 
     if (m_d->image && m_d->taskGuard.isValid()) {
         m_d->taskGuard.trigger();
@@ -176,6 +202,17 @@ QImage KisLayerThumbnailCache::thumbnail(KisNodeSP node) const
     return image;
 }
 
+void KisLayerThumbnailCache::Private::updateGenerators(KisImageSP image)
+{
+    KisLayerUtils::recursiveApplyNodes(image->root(), [this] (KisNodeSP node) {
+        if (!node->parent() || node->isFakeNode()) return;
+
+        if (node->thumbnailSourceDevice() && !generators.contains(node)) {
+            generators.insert(node, toQShared(new KisIncrementalThumbnail()));
+        }
+    });
+}
+
 void KisLayerThumbnailCache::Private::cleanupDeletedNodes()
 {
     for (auto it = cache.begin(); it != cache.end();) {
@@ -185,6 +222,14 @@ void KisLayerThumbnailCache::Private::cleanupDeletedNodes()
             ++it;
         }
     }
+
+    for (auto it = generators.begin(); it != generators.end();) {
+        if (!it.key()) {
+            it = generators.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void KisLayerThumbnailCache::notifyNodeRemoved(KisNodeSP node)
@@ -206,6 +251,7 @@ void KisLayerThumbnailCache::notifyNodeAdded(KisNodeSP node)
 void KisLayerThumbnailCache::clear()
 {
     m_d->cache.clear();
+    m_d->generators.clear();
 }
 
 void KisLayerThumbnailCache::slotThumbnailGenerated(KisNodeSP node, int seqNo, int maxSize, const QImage &thumb)
@@ -14,6 +14,9 @@
 #include "animation/KisFrameDisplayProxy.h"
 #include "KisViewManager.h"
 #include "kis_config.h"
+#include "KisPart.h"
+#include "kis_animation_cache_populator.h"
+#include "kis_animation_frame_cache.h"
 
 #include "kis_onion_skin_compositor.h"
 
@@ -284,6 +287,22 @@ int KisPlaybackEngine::frameWrap(int frame, int startFrame, int endFrame)
     return frame;
 }
 
+void KisPlaybackEngine::fillFrameCacheStatistics(PlaybackStats &stats) const
+{
+    KisCanvas2 *canvas = activeCanvas();
+    if (!canvas) return;
+
+    KisAnimationFrameCacheSP cache = canvas->frameCache();
+    if (cache) {
+        const KisFrameCacheStatistics cacheStats = cache->statistics();
+        stats.cacheHitRate = cacheStats.frameHitRate();
+        stats.cacheBytesPerFrame = cacheStats.bytesPerFrame();
+        stats.cacheCompressionRatio = cacheStats.compressionRatio();
+    }
+
+    stats.regenerationLatency = KisPart::instance()->cachePopulator()->averageRegenerationTime();
+}
+
 KisCanvas2 *KisPlaybackEngine::activeCanvas() const
 {
     return m_d->activeCanvas;
@@ -50,6 +50,15 @@ public:
         qreal expectedFps {0.0};
         qreal realFps {0.0};
         qreal droppedFramesPortion {0.0};
+
+        // portion of the frames found in the animation cache on playback
+        qreal cacheHitRate {0.0};
+        // memory used by a single frame stored in the animation cache
+        qint64 cacheBytesPerFrame {0};
+        // size of the raw frame data divided by the size of the stored data
+        qreal cacheCompressionRatio {1.0};
+        // average time (ms) needed to regenerate a frame for the cache
+        qreal regenerationLatency {0.0};
     };
 
 public Q_SLOTS:
@@ -105,6 +114,11 @@ protected:
     class KisCanvas2* activeCanvas() const;
     int frameWrap(int frame, int startFrame, int endFrame);
 
+    /**
+     * Fills the animation cache related fields of \p stats
+     */
+    void fillFrameCacheStatistics(PlaybackStats &stats) const;
+
 protected Q_SLOTS:
     virtual void setCanvas(KoCanvasBase* p_canvas) override;
     virtual void unsetCanvas() override;
@@ -560,6 +560,7 @@ KisPlaybackEngine::PlaybackStats KisPlaybackEngineMLT::playbackStatistics() cons
         const qreal avgTimePerFrame = m_d->frameStats.averageFrameDuration.rollingMeanSafe();
         stats.realFps = !qFuzzyIsNull(avgTimePerFrame) ? 1000.0 / avgTimePerFrame : 0.0;
 
+        fillFrameCacheStatistics(stats);
     }
 
     return stats;
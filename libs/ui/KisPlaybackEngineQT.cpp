@@ -221,6 +221,8 @@ KisPlaybackEngine::PlaybackStats KisPlaybackEngineQT::playbackStatistics() const
 
         const qreal avgTimePerFrame = m_d->measure.averageTimePerFrame.rollingMeanSafe();
         stats.realFps = !qFuzzyIsNull(avgTimePerFrame) ? 1000.0 / avgTimePerFrame : 0.0;
+
+        fillFrameCacheStatistics(stats);
     }
 
     return stats;
@@ -17,6 +17,8 @@
 #include "KisAnimationRenderingOptions.h"
 #include "KisMimeDatabase.h"
 #include "dialogs/KisAsyncAnimationFramesSaveDialog.h"
+#include "dialogs/KisAsyncAnimationFramesStreamDialog.h"
+#include "KisAnimationRawFrameStream.h"
 #include "kis_time_span.h"
 #include "KisMainWindow.h"
 
@@ -49,7 +51,12 @@ void KisAnimationRender::render(KisDocument *doc, KisViewManager *viewManager, K
         }
     }
 
-    const bool batchMode = false; // TODO: fetch correctly!
+    if (KisAnimationVideoSaver::supportsStreaming(doc->image(), encoderOptions)) {
+        renderStreaming(doc, viewManager, encoderOptions);
+        return;
+    }
+
+    const bool batchMode = doc->fileBatchMode();
     KisAsyncAnimationFramesSaveDialog exporter(doc->image(),
                                                KisTimeSpan::fromTimeToTime(encoderOptions.firstFrame,
                                                                       encoderOptions.lastFrame),
@@ -138,6 +145,63 @@ void KisAnimationRender::render(KisDocument *doc, KisViewManager *viewManager, K
     }
 }
 
+void KisAnimationRender::renderStreaming(KisDocument *doc, KisViewManager *viewManager, const KisAnimationRenderingOptions &encoderOptions)
+{
+    const QString resultFile = encoderOptions.resolveAbsoluteVideoFilePath();
+    KIS_SAFE_ASSERT_RECOVER_NOOP(QFileInfo(resultFile).isAbsolute());
+
+    {
+        const QFileInfo info(resultFile);
+        QDir dir(info.absolutePath());
+
+        if (!dir.exists()) {
+            dir.mkpath(info.absolutePath());
+        }
+        KIS_SAFE_ASSERT_RECOVER_NOOP(dir.exists());
+    }
+
+    const bool batchMode = doc->fileBatchMode();
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(encoderOptions.firstFrame, encoderOptions.lastFrame);
+
+    KisAnimationVideoSaver encoder(doc, batchMode);
+    KisImportExportErrorCode res = encoder.startStreamEncoding(encoderOptions, doc->image()->bounds().size());
+
+    if (!res.isOk()) {
+        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Krita"), i18n("Could not render animation:\n%1", doc->errorMessage()));
+        return;
+    }
+
+    KisAsyncAnimationRenderDialogBase::Result result = KisAsyncAnimationRenderDialogBase::RenderFailed;
+
+    {
+        // the rendered frames go straight into the encoder's stdin, no image sequence is saved;
+        // the frames are written by the rendering threads, never by the GUI thread
+        KisAnimationRawFrameStream stream(range, [&encoder] (const QByteArray &frameData) {
+            return encoder.writeStreamFrame(frameData);
+        });
+
+        KisAsyncAnimationFramesStreamDialog exporter(doc->image(), range, &stream);
+        exporter.setBatchMode(batchMode);
+
+        result = exporter.regenerateRange(viewManager->mainWindow()->viewManager());
+
+        // the stream waits for the frame that is still being written
+        // on destruction, so it must go away before the encoder finishes
+    }
+
+    res = encoder.finishStreamEncoding(result != KisAsyncAnimationRenderDialogBase::RenderComplete);
+
+    if (result == KisAsyncAnimationRenderDialogBase::RenderComplete) {
+        if (!res.isOk()) {
+            QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Krita"), i18n("Could not render animation:\n%1", res.errorMessage()));
+        }
+    } else if (result == KisAsyncAnimationRenderDialogBase::RenderTimedOut) {
+        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Rendering error"), "Animation frame rendering has timed out. Output files are incomplete.\nTry to increase \"Frame Rendering Timeout\" or reduce \"Frame Rendering Clones Limit\" in Krita settings");
+    } else if (result == KisAsyncAnimationRenderDialogBase::RenderFailed) {
+        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Rendering error"), i18n("Failed to render animation frames! Output files are incomplete."));
+    }
+}
+
 bool KisAnimationRender::mustHaveEvenDimensions(const QString &mimeType, KisAnimationRenderingOptions::RenderMode renderMode)
 {
     return (mimeType == "video/mp4" || mimeType == "video/x-matroska") && renderMode != KisAnimationRenderingOptions::RENDER_FRAMES_ONLY;
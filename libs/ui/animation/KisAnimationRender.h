@@ -18,6 +18,13 @@ namespace KisAnimationRender {
 
     KRITAUI_EXPORT void render(KisDocument *doc, KisViewManager* viewManager, KisAnimationRenderingOptions encoderOptions);
 
+    /**
+     * Renders the animation into a video without saving the frames into
+     * files: the frames are piped into the encoder as raw pixel data.
+     * Used by render() when KisAnimationVideoSaver::supportsStreaming().
+     */
+    void renderStreaming(KisDocument *doc, KisViewManager* viewManager, const KisAnimationRenderingOptions &encoderOptions);
+
     bool mustHaveEvenDimensions(const QString &mimeType, KisAnimationRenderingOptions::RenderMode renderMode);
     bool hasEvenDimensions(int width, int height);
 
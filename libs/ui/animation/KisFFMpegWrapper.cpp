@@ -198,6 +198,72 @@ void KisFFMpegWrapper::waitForFinished(int msecs)
 
 }
 
+bool KisFFMpegWrapper::waitForStarted(QString *errorMessage, int msecs)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_process, false);
+
+    if (m_process->state() == QProcess::Starting) {
+        m_process->waitForStarted(msecs);
+    }
+
+    if (m_process->state() != QProcess::Running) {
+        if (errorMessage) {
+            *errorMessage = m_process->errorString();
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool KisFFMpegWrapper::writeToStdin(const QByteArray &data)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_process, false);
+
+    if (m_process->state() == QProcess::Starting && !m_process->waitForStarted(FFMPEG_TIMEOUT)) {
+        return false;
+    }
+
+    if (m_process->state() != QProcess::Running) {
+        return false;
+    }
+
+    if (m_process->write(data) != data.size()) {
+        return false;
+    }
+
+    // don't keep more than a couple of frames in the pipe buffer
+    const qint64 maxPendingBytes = qMax(qint64(64 * 1024 * 1024), 2 * qint64(data.size()));
+
+    while (m_process->bytesToWrite() > maxPendingBytes) {
+        if (!m_process->waitForBytesWritten(FFMPEG_TIMEOUT)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+KisImportExportErrorCode KisFFMpegWrapper::closeStdinAndWait(int msecs)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_process, ImportExportCodes::InternalError);
+
+    // the channel is closed only after all the pending data is written
+    m_process->closeWriteChannel();
+    m_process->waitForFinished(msecs);
+
+    if (m_process->state() != QProcess::NotRunning) {
+        reset();
+        return ImportExportCodes::Failure;
+    }
+
+    const bool success =
+        m_process->exitStatus() == QProcess::NormalExit &&
+        m_process->exitCode() == 0;
+
+    return success ? ImportExportCodes::OK : ImportExportCodes::Failure;
+}
+
 void KisFFMpegWrapper::updateProgressDialog(int progressValue) {
     
     dbgFile << "Update Progress" << progressValue << "/" << m_processSettings.totalFrames;
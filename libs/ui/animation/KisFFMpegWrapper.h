@@ -55,6 +55,35 @@ public:
     void waitForFinished(int msecs = FFMPEG_TIMEOUT);
     void reset();
 
+    /**
+     * Waits until the process started with startNonBlocking() is running.
+     * Like the rest of the process I/O, it must be called from the thread
+     * of the wrapper.
+     *
+     * @return false if the process could not be started, in which case
+     *         \p errorMessage (when not null) is set to the reason
+     */
+    bool waitForStarted(QString *errorMessage = nullptr, int msecs = FFMPEG_TIMEOUT);
+
+    /**
+     * Writes \p data into the standard input of the process started with
+     * startNonBlocking(). When the process cannot consume the data fast
+     * enough, the call blocks until the pending data drops below a limit,
+     * so that the written frames don't pile up in memory. Like the rest of
+     * the process I/O, it must be called from the thread of the wrapper,
+     * which must not be the GUI thread when the process is fed with frames.
+     *
+     * @return false if the process is not running or the data could not
+     *         be written
+     */
+    bool writeToStdin(const QByteArray &data);
+
+    /**
+     * Closes the standard input of the process, which signals the end of
+     * the stream to it, and waits for the process to finish.
+     */
+    KisImportExportErrorCode closeStdinAndWait(int msecs = FFMPEG_TIMEOUT);
+
     static QJsonObject findProcessPath(const QString &processName, const QString &customLocation, bool processInfo);
     static QJsonObject findProcessInfo(const QString &processName, const QString &processPath, bool includeProcessInfo);
     static QStringList getSupportedCodecs(const QJsonObject& ffmpegJsonProcessInput);
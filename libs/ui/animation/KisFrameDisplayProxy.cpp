@@ -10,6 +10,8 @@
 #include "kis_canvas2.h"
 #include "kis_image_animation_interface.h"
 #include "KisCanvasAnimationState.h"
+#include "KisPart.h"
+#include "kis_animation_cache_populator.h"
 
 struct Private {
     Private(KisCanvas2* c)
@@ -74,6 +76,13 @@ bool KisFrameDisplayProxy::displayFrame(int frame, bool forceReproject)
     KisImageAnimationInterface* ai = m_d->canvas->image()->animationInterface();
 
     if (frame != m_d->intendedFrame) {
+        if (cache) {
+            // playback always goes forward, scrubbing may go both ways
+            const bool isPlaying = m_d->canvas->animationState()->playbackState() == PLAYING;
+            const int direction = isPlaying || frame > m_d->intendedFrame ? 1 : -1;
+            KisPart::instance()->cachePopulator()->requestPrefetch(m_d->canvas->image(), frame, direction);
+        }
+
         m_d->intendedFrame = frame;
         emit sigFrameChange();
     }
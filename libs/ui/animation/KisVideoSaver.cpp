@@ -14,6 +14,7 @@
 #include <QEventLoop>
 #include <QTemporaryFile>
 #include <QTemporaryDir>
+#include <QThread>
 #include <QTime>
 
 #include <KisDocument.h>
@@ -39,6 +40,9 @@ KisAnimationVideoSaver::KisAnimationVideoSaver(KisDocument *doc, bool batchMode)
 
 KisAnimationVideoSaver::~KisAnimationVideoSaver()
 {
+    if (m_streamingWrapper) {
+        finishStreamEncoding(true);
+    }
 }
 
 KisImageSP KisAnimationVideoSaver::image()
@@ -47,17 +51,148 @@ KisImageSP KisAnimationVideoSaver::image()
 }
 
 KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFilesMask, const KisAnimationRenderingOptions &options)
+{
+    const QStringList inputArgs =
+        QStringList() << "-start_number" << QString::number(options.sequenceStart) << "-start_number_range" << "1"
+                      << "-i" << savedFilesMask; // Input frame(s) file mask..
+
+    KisFFMpegWrapperSettings ffmpegSettings;
+    KisImportExportErrorCode result = prepareEncoderSettings(inputArgs, options, &ffmpegSettings);
+
+    if (!result.isOk()) {
+        return result;
+    }
+
+    QScopedPointer<KisFFMpegWrapper> ffmpegWrapper(new KisFFMpegWrapper(this));
+    return ffmpegWrapper->start(ffmpegSettings);
+}
+
+bool KisAnimationVideoSaver::supportsStreaming(KisImageSP image, const KisAnimationRenderingOptions &options)
+{
+    // the palette for GIF files is generated in a separate pass over the frames
+    const bool isGif = QFileInfo(options.resolveAbsoluteVideoFilePath()).suffix().toLower() == "gif";
+
+    // HDR videos need the frames in the high bit depth PNG form
+    const bool isHDR = options.frameExportConfig && options.frameExportConfig->getBool("saveAsHDR", false);
+
+    return options.renderMode() == KisAnimationRenderingOptions::RENDER_VIDEO_ONLY &&
+        !isGif && !isHDR &&
+        image->colorSpace()->colorDepthId() == Integer8BitsColorDepthID;
+}
+
+KisImportExportErrorCode KisAnimationVideoSaver::startStreamEncoding(const KisAnimationRenderingOptions &options, const QSize &frameSize)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!m_streamingWrapper, ImportExportCodes::InternalError);
+
+    // see KisAnimationRawFrameStream::rawFrameColorSpace()
+    const QStringList inputArgs =
+        QStringList() << "-f" << "rawvideo"
+                      << "-pix_fmt" << "bgra"
+                      << "-s" << QString("%1x%2").arg(frameSize.width()).arg(frameSize.height())
+                      << "-i" << "-"; // frames come from stdin
+
+    KisFFMpegWrapperSettings ffmpegSettings;
+    KisImportExportErrorCode result = prepareEncoderSettings(inputArgs, options, &ffmpegSettings);
+
+    if (!result.isOk()) {
+        return result;
+    }
+
+    // the progress is shown by the frames rendering dialog
+    ffmpegSettings.batchMode = true;
+
+    // QProcess can be used only from the thread it lives in, so the whole
+    // wrapper lives in the encoder thread, which also waits for the pipe
+    m_encoderThread.reset(new QThread());
+    m_encoderThread->setObjectName("KisAnimationVideoSaver encoder");
+    m_encoderThread->start();
+
+    m_streamingWrapper.reset(new KisFFMpegWrapper());
+    m_streamingWrapper->moveToThread(m_encoderThread.data());
+
+    bool started = false;
+    QString errorMessage;
+
+    KisFFMpegWrapper *wrapper = m_streamingWrapper.data();
+    QMetaObject::invokeMethod(wrapper,
+                              [wrapper, ffmpegSettings, &started, &errorMessage] () {
+                                  wrapper->startNonBlocking(ffmpegSettings);
+                                  started = wrapper->waitForStarted(&errorMessage);
+
+                                  if (!started) {
+                                      // the process must be destroyed in its own thread
+                                      wrapper->reset();
+                                  }
+                              },
+                              Qt::BlockingQueuedConnection);
+
+    if (!started) {
+        m_encoderThread->quit();
+        m_encoderThread->wait();
+
+        m_streamingWrapper.reset();
+        m_encoderThread.reset();
+
+        m_doc->setErrorMessage(i18n("ffmpeg could not be started: %1", errorMessage));
+        return ImportExportCodes::Failure;
+    }
+
+    return ImportExportCodes::OK;
+}
+
+bool KisAnimationVideoSaver::writeStreamFrame(const QByteArray &frameData)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_streamingWrapper, false);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(QThread::currentThread() != m_encoderThread.data(), false);
+
+    bool result = false;
+
+    KisFFMpegWrapper *wrapper = m_streamingWrapper.data();
+    QMetaObject::invokeMethod(wrapper,
+                              [wrapper, &frameData, &result] () {
+                                  result = wrapper->writeToStdin(frameData);
+                              },
+                              Qt::BlockingQueuedConnection);
+
+    return result;
+}
+
+KisImportExportErrorCode KisAnimationVideoSaver::finishStreamEncoding(bool cancelled)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_streamingWrapper, ImportExportCodes::InternalError);
+
+    KisImportExportErrorCode result = ImportExportCodes::Cancelled;
+
+    KisFFMpegWrapper *wrapper = m_streamingWrapper.data();
+    QMetaObject::invokeMethod(wrapper,
+                              [wrapper, cancelled, &result] () {
+                                  if (!cancelled) {
+                                      result = wrapper->closeStdinAndWait();
+                                  }
+
+                                  // the process must be destroyed in its own thread
+                                  wrapper->reset();
+                              },
+                              Qt::BlockingQueuedConnection);
+
+    m_encoderThread->quit();
+    m_encoderThread->wait();
+
+    m_streamingWrapper.reset();
+    m_encoderThread.reset();
+
+    return result;
+}
+
+KisImportExportErrorCode KisAnimationVideoSaver::prepareEncoderSettings(const QStringList &inputArgs, const KisAnimationRenderingOptions &options, KisFFMpegWrapperSettings *encoderSettings)
 {
     if (!QFileInfo(options.ffmpegPath).exists()) {
         m_doc->setErrorMessage(i18n("ffmpeg could not be found at %1", options.ffmpegPath));
         return ImportExportCodes::Failure;
     }
 
-    KisImportExportErrorCode resultOuter = ImportExportCodes::OK;
-
     KisImageAnimationInterface *animation = m_image->animationInterface();
 
-    const int sequenceStart = options.sequenceStart;
     const KisTimeSpan clipRange = KisTimeSpan::fromTimeToTime(options.firstFrame,
                                                               options.lastFrame);
 
@@ -84,8 +219,6 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
     QStringList additionalOptionsList = options.customFFMpegOptions.split(' ', QString::SkipEmptyParts);
 #endif
 
-    QScopedPointer<KisFFMpegWrapper> ffmpegWrapper(new KisFFMpegWrapper(this));
-    
     {
         
         QStringList paletteArgs;
@@ -95,8 +228,7 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
         
         args << "-y" // Auto Confirm...
              << "-r" << QString::number(options.frameRate) // Frame rate for video...
-             << "-start_number" << QString::number(sequenceStart) << "-start_number_range" << "1"
-             << "-i" << savedFilesMask; // Input frame(s) file mask..
+             << inputArgs;
 
         const int lavfiOptionsIndex = additionalOptionsList.indexOf("-lavfi");
 
@@ -108,8 +240,7 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
       
         if ( suffix == "gif" ) {
             paletteArgs << "-r" << QString::number(options.frameRate)
-                        << "-start_number" << QString::number(sequenceStart) << "-start_number_range" << "1"
-                        << "-i" << savedFilesMask;
+                        << inputArgs;
             
             const int paletteOptionsIndex = additionalOptionsList.indexOf("-palettegen");
             QString palettegenString = "palettegen";
@@ -141,6 +272,7 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
                                                "Creating palette for %1 file format.", "[suffix]");
             ffmpegSettings.logPath = QDir::tempPath() + QDir::separator() + "krita" + QDir::separator() + "ffmpeg.log";
             
+            QScopedPointer<KisFFMpegWrapper> ffmpegWrapper(new KisFFMpegWrapper(this));
             KisImportExportErrorCode result = ffmpegWrapper->start(ffmpegSettings);
 
             if (!result.isOk()) {
@@ -152,9 +284,6 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
             }
             
             args << "-i" << palettePath;
-
-            // We need to kill the process so we can reuse it later down the chain. BUG:446320
-            ffmpegWrapper->reset();
         }
         
         QVector<QFileInfo> audioFiles = m_doc->getAudioTracks();
@@ -187,13 +316,12 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
         
         args << additionalOptionsList;
 
-        dbgFile << "savedFilesMask" << savedFilesMask
-                << "save files offset" << sequenceStart
+        dbgFile << "input args" << inputArgs
                 << "start" << QString::number(clipRange.start()) 
                 << "duration" << clipRange.duration();
 
 
-        KisFFMpegWrapperSettings ffmpegSettings;
+        KisFFMpegWrapperSettings &ffmpegSettings = *encoderSettings;
         ffmpegSettings.processPath = options.ffmpegPath;
         ffmpegSettings.args = args;
         ffmpegSettings.outputFile = resultFile;
@@ -201,12 +329,9 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
         ffmpegSettings.logPath = QDir::tempPath() + QDir::separator() + "krita" + QDir::separator() + "ffmpeg.log";
         ffmpegSettings.progressMessage = i18nc("Animation export dialog for tracking ffmpeg progress. arg1: file-suffix, arg2: progress frame number, arg3: totalFrameCount.",
                                                "Creating desired %1 file: %2/%3 frames.", "[suffix]", "[progress]", "[framecount]");
-
-        resultOuter = ffmpegWrapper->start(ffmpegSettings);
     }
-     
 
-    return resultOuter;
+    return ImportExportCodes::OK;
 }
 
 KisImportExportErrorCode KisAnimationVideoSaver::convert(KisDocument *document, const QString &savedFilesMask, const KisAnimationRenderingOptions &options, bool batchMode)
@@ -15,6 +15,9 @@
 
 class KisDocument;
 class KisAnimationRenderingOptions;
+class KisFFMpegWrapper;
+class QThread;
+struct KisFFMpegWrapperSettings;
 
 #include "kritaui_export.h"
 
@@ -49,10 +52,48 @@ public:
 
     static KisImportExportErrorCode convert(KisDocument *document, const QString &savedFilesMask, const KisAnimationRenderingOptions &options, bool batchMode);
 
+    /**
+     * @return true if the frames of \p image can be piped into the encoder
+     * directly instead of being saved into an image sequence first. That is
+     * possible only when the sequence is not kept, the frames are 8-bit
+     * and the encoder needs to see them only once (GIF needs two passes).
+     */
+    static bool supportsStreaming(KisImageSP image, const KisAnimationRenderingOptions &options);
+
+    /**
+     * @brief start the encoder that reads raw frames from its standard input
+     *
+     * The frames must be passed via writeStreamFrame() in the order of the
+     * video and the encoding finished with finishStreamEncoding().
+     *
+     * @param frameSize the size of every frame in pixels
+     */
+    KisImportExportErrorCode startStreamEncoding(const KisAnimationRenderingOptions &options, const QSize &frameSize);
+
+    /**
+     * Passes a raw frame, as generated by KisAnimationRawFrameStream::rawFrameData(),
+     * to the encoder. The encoder process is driven by its own thread; the
+     * call blocks until that thread has written the frame into the pipe.
+     */
+    bool writeStreamFrame(const QByteArray &frameData);
+
+    /**
+     * Closes the stream and waits for the encoder to finish the file. If
+     * \p cancelled is true, the encoder is killed instead.
+     */
+    KisImportExportErrorCode finishStreamEncoding(bool cancelled = false);
+
+private:
+    KisImportExportErrorCode prepareEncoderSettings(const QStringList &inputArgs,
+                                                    const KisAnimationRenderingOptions &options,
+                                                    KisFFMpegWrapperSettings *encoderSettings);
+
 private:
     KisImageSP m_image;
     KisDocument* m_doc;
     bool m_batchMode;
+    QScopedPointer<QThread> m_encoderThread;
+    QScopedPointer<KisFFMpegWrapper> m_streamingWrapper;
 };
 
 #endif
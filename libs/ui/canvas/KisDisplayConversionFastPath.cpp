@@ -0,0 +1,109 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDisplayConversionFastPath.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+
+#include <KoOptimizedMatrixShaperTransformFactory.h>
+
+namespace {
+
+struct TransformKey
+{
+    const KoColorSpace *srcColorSpace;
+    const KoColorSpace *dstColorSpace;
+    KoColorConversionTransformation::Intent renderingIntent;
+    KoColorConversionTransformation::ConversionFlags conversionFlags;
+
+    bool operator==(const TransformKey &rhs) const {
+        return srcColorSpace == rhs.srcColorSpace &&
+            dstColorSpace == rhs.dstColorSpace &&
+            renderingIntent == rhs.renderingIntent &&
+            conversionFlags == rhs.conversionFlags;
+    }
+};
+
+inline uint qHash(const TransformKey &key, uint seed = 0)
+{
+    return ::qHash(quintptr(key.srcColorSpace), seed) ^
+        ::qHash(quintptr(key.dstColorSpace), seed) ^
+        ::qHash(int(key.renderingIntent) | (int(key.conversionFlags) << 8), seed);
+}
+
+/**
+ * The display configuration changes rarely, so the cache is tiny.
+ * When it overflows, it is simply dropped.
+ */
+const int maxCachedTransforms = 16;
+
+}
+
+struct Q_DECL_HIDDEN KisDisplayConversionFastPath::Private
+{
+    QMutex mutex;
+
+    /// null values mark the conversions that are not supported
+    QHash<TransformKey, QSharedPointer<const KoOptimizedMatrixShaperTransformBase>> transforms;
+};
+
+KisDisplayConversionFastPath::KisDisplayConversionFastPath()
+    : m_d(new Private)
+{
+}
+
+KisDisplayConversionFastPath::~KisDisplayConversionFastPath()
+{
+}
+
+bool KisDisplayConversionFastPath::convert(const KoColorSpace *srcColorSpace, const quint8 *src,
+                                           quint8 *dst, const KoColorSpace *dstColorSpace,
+                                           int numPixels,
+                                           KoColorConversionTransformation::Intent renderingIntent,
+                                           KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    const TransformKey key {srcColorSpace, dstColorSpace, renderingIntent, conversionFlags};
+
+    QSharedPointer<const KoOptimizedMatrixShaperTransformBase> transform;
+
+    {
+        QMutexLocker l(&m_d->mutex);
+
+        auto it = m_d->transforms.constFind(key);
+        if (it != m_d->transforms.constEnd()) {
+            transform = *it;
+        } else {
+            /**
+             * Sampling the curves takes a few milliseconds, but it
+             * happens only once per display configuration, so we can
+             * afford doing that under the lock and avoid creating the
+             * same transform in several threads
+             */
+            transform.reset(
+                KoOptimizedMatrixShaperTransformFactory::create(srcColorSpace, dstColorSpace,
+                                                                renderingIntent, conversionFlags));
+
+            if (m_d->transforms.size() >= maxCachedTransforms) {
+                m_d->transforms.clear();
+            }
+            m_d->transforms.insert(key, transform);
+        }
+    }
+
+    if (!transform) return false;
+
+    transform->transform(src, dst, numPixels);
+    return true;
+}
+
+void KisDisplayConversionFastPath::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->transforms.clear();
+}
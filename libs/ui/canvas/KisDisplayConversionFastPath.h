@@ -0,0 +1,55 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDISPLAYCONVERSIONFASTPATH_H
+#define KISDISPLAYCONVERSIONFASTPATH_H
+
+#include <QScopedPointer>
+
+#include <KoColorConversionTransformation.h>
+
+#include "kritaui_export.h"
+
+class KoColorSpace;
+
+/**
+ * Converts the image pixels into the display color space without
+ * calling into lcms when both the image and the display have 8- or
+ * 16-bit RGB matrix-shaper profiles, e.g. sRGB or linear Rec.709.
+ * The transforms are created lazily and shared between the calls,
+ * the unsupported conversions are remembered so that the check
+ * happens only once per color space pair.
+ *
+ * When convert() returns false, the caller should fall back to
+ * KoColorSpace::convertPixelsTo().
+ *
+ * The class is thread-safe.
+ *
+ * \see KoOptimizedMatrixShaperTransformBase
+ */
+class KRITAUI_EXPORT KisDisplayConversionFastPath
+{
+public:
+    KisDisplayConversionFastPath();
+    ~KisDisplayConversionFastPath();
+
+    bool convert(const KoColorSpace *srcColorSpace, const quint8 *src,
+                 quint8 *dst, const KoColorSpace *dstColorSpace,
+                 int numPixels,
+                 KoColorConversionTransformation::Intent renderingIntent,
+                 KoColorConversionTransformation::ConversionFlags conversionFlags);
+
+    /**
+     * Drops all the cached transforms
+     */
+    void clear();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISDISPLAYCONVERSIONFASTPATH_H
@@ -85,6 +85,7 @@
 #include "KoZoomController.h"
 
 #include <KisStrokeSpeedMonitor.h>
+#include <KisInputLatencyTracker.h>
 #include "opengl/kis_opengl_canvas_debugger.h"
 
 #include "kis_wrapped_rect.h"
@@ -857,6 +858,8 @@ void KisCanvas2::updateCanvasProjection()
 
     auto uploadData = [this, tryIssueCanvasUpdates](const QVector<KisUpdateInfoSP> &infoObjects) {
         QVector<QRect> viewportRects = m_d->canvasWidget->updateCanvasProjection(infoObjects);
+        KisInputLatencyTracker::instance()->notifyTexturesUpdated();
+
         const QRect vRect = std::accumulate(viewportRects.constBegin(), viewportRects.constEnd(),
                                             QRect(), std::bit_or<QRect>());
 
@@ -1145,8 +1148,18 @@ void KisCanvas2::notifyLevelOfDetailChange()
 {
     KisImageSP image = this->image();
 
-    if (m_d->bootstrapLodBlocked || !m_d->lodIsSupported()) {
+    if (m_d->bootstrapLodBlocked) {
         image->setLodPreferences(KisLodPreferences(KisLodPreferences::None, 0));
+    } else if (!m_d->lodIsSupported()) {
+        /**
+         * QPainter canvas upscales the level of detail planes itself
+         * (see KisImagePyramid::updateCache()), which is good enough
+         * for the strokes that explicitly ask for a LoD preview only
+         */
+        image->setLodPreferences(
+            KisLodPreferences(!m_d->currentCanvasIsOpenGL ?
+                                  KisLodPreferences::LodPreviewSupported :
+                                  KisLodPreferences::None, 0));
     } else {
         const qreal effectiveZoom = m_d->coordinatesConverter->effectiveZoom();
 
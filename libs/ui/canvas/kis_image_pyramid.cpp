@@ -6,11 +6,13 @@
 #include "kis_image_pyramid.h"
 
 #include <QBitArray>
+#include <cstring>
 #include <KoChannelInfo.h>
 #include <KoCompositeOp.h>
 #include <KoColorSpaceRegistry.h>
 #include <KoColorModelStandardIds.h>
 #include <KoColorSpaceMaths.h>
+#include <KoOptimizedPixelDataDownsamplerU8Factory.h>
 
 #include "kis_display_filter.h"
 #include "kis_painter.h"
@@ -20,6 +22,7 @@
 #include "kis_debug.h"
 #include "kis_config.h"
 #include "kis_image_config.h"
+#include "kis_lod_transform.h"
 
 //#define DEBUG_PYRAMID
 
@@ -81,11 +84,33 @@ inline void alignRectBy2(qint32 &x, qint32 &y, qint32 &w, qint32 &h)
     h += isOdd(h);
 }
 
+/**
+ * Fills @p dstRect of the base plane with the pixels of the level of
+ * detail plane using the nearest neighbour, @p srcRect is the rect of
+ * the Lod plane covering it
+ */
+inline void upscaleLodPixels(const quint8 *src, const QRect &srcRect,
+                             quint8 *dst, const QRect &dstRect,
+                             int levelOfDetail, int pixelSize)
+{
+    const int srcRowStride = srcRect.width() * pixelSize;
+
+    for (int y = dstRect.top(); y <= dstRect.bottom(); y++) {
+        const quint8 *srcLine = src + ((y >> levelOfDetail) - srcRect.y()) * srcRowStride;
+
+        for (int x = dstRect.left(); x <= dstRect.right(); x++) {
+            memcpy(dst, srcLine + ((x >> levelOfDetail) - srcRect.x()) * pixelSize, pixelSize);
+            dst += pixelSize;
+        }
+    }
+}
+
 
 /************* class KisImagePyramid ********************************/
 
 KisImagePyramid::KisImagePyramid(qint32 pyramidHeight)
-        : m_monitorProfile(0)
+        : m_downsampler(KoOptimizedPixelDataDownsamplerU8Factory::createRgbaDownsampler())
+        , m_monitorProfile(0)
         , m_monitorColorSpace(0)
         , m_pyramidHeight(pyramidHeight)
 {
@@ -104,8 +129,8 @@ void KisImagePyramid::setMonitorProfile(const KoColorProfile* monitorProfile,
 {
     m_monitorProfile = monitorProfile;
     /**
-     * If you change pixel size here, don't forget to change it
-     * in optimized function downsamplePixels()
+     * If you change pixel size here, don't forget to change
+     * the downsampler in the constructor
      */
     m_monitorColorSpace = KoColorSpaceRegistry::instance()->rgb8(monitorProfile);
     m_renderingIntent = renderingIntent;
@@ -165,6 +190,16 @@ void KisImagePyramid::setImage(KisImageWSP newImage)
 
         // Get the full image size
         QRect rc = m_originalImage->projection()->exactBounds();
+        const int lod = m_originalImage->currentLevelOfDetail();
+
+        if (lod > 0) {
+            rc = KisLodTransform::upscaledRect(rc, lod);
+        }
+
+        {
+            QMutexLocker l(&m_lodPreviewMutex);
+            m_lodPreviewRect = lod > 0 ? rc : QRect();
+        }
 
         KisImageConfig config(true);
 
@@ -172,7 +207,7 @@ void KisImagePyramid::setImage(KisImageWSP newImage)
         int patchHeight = config.updatePatchHeight();
 
         if (rc.width() * rc.height() <= patchWidth * patchHeight) {
-            retrieveImageData(rc);
+            retrieveImageData(rc, lod);
         }
         else {
             qint32 firstCol = rc.x() / patchWidth;
@@ -187,7 +222,7 @@ void KisImagePyramid::setImage(KisImageWSP newImage)
                                        i * patchHeight,
                                        patchWidth, patchHeight);
                     QRect patchRect = rc & maxPatchRect;
-                    retrieveImageData(patchRect);
+                    retrieveImageData(patchRect, lod);
                 }
             }
 
@@ -203,24 +238,61 @@ void KisImagePyramid::setImageSize(qint32 w, qint32 h)
     /* nothing interesting */
 }
 
-void KisImagePyramid::updateCache(const QRect &dirtyImageRect)
+QRect KisImagePyramid::updateCache(const QRect &dirtyImageRect)
 {
-    retrieveImageData(dirtyImageRect);
+    return updateCache(dirtyImageRect, m_originalImage->currentLevelOfDetail());
 }
 
-void KisImagePyramid::retrieveImageData(const QRect &rect)
+QRect KisImagePyramid::updateCache(const QRect &dirtyImageRect, int lod)
+{
+    QRect updateRect = dirtyImageRect;
+
+    /**
+     * The level of detail strokes are always followed by their Lod0
+     * counterparts (or by a full reread of the image if they are
+     * cancelled), so the first Lod0 update restores the full
+     * resolution of everything we have previewed. The previewed
+     * area might be a bit bigger than the one touched by the Lod0
+     * stroke, because the Lod plane is aligned to its pixels.
+     */
+    {
+        QMutexLocker l(&m_lodPreviewMutex);
+
+        if (lod > 0) {
+            m_lodPreviewRect |= dirtyImageRect;
+        } else if (!m_lodPreviewRect.isEmpty()) {
+            updateRect |= m_lodPreviewRect;
+            m_lodPreviewRect = QRect();
+        }
+    }
+
+    retrieveImageData(updateRect, lod);
+
+    return updateRect;
+}
+
+void KisImagePyramid::retrieveImageData(const QRect &rect, int levelOfDetail)
 {
     // XXX: use QThreadStorage to cache the two patches (512x512) of pixels. Note
     // that when we do that, we need to reset that cache when the projection's
     // colorspace changes.
     const KoColorSpace *projectionCs = m_originalImage->projection()->colorSpace();
     KisPaintDeviceSP originalProjection = m_originalImage->projection();
-    quint32 numPixels = rect.width() * rect.height();
+
+    /**
+     * In the level of detail mode the projection contains the scaled down
+     * plane only, so we convert its pixels and upscale them in the end
+     */
+    const QRect srcRect = levelOfDetail > 0 ?
+        KisLodTransform::scaledRect(KisLodTransform::alignedRect(rect, levelOfDetail), levelOfDetail) :
+        rect;
+
+    quint32 numPixels = srcRect.width() * srcRect.height();
 
     QScopedArrayPointer<quint8> originalBytes(
         new quint8[originalProjection->colorSpace()->pixelSize() * numPixels]);
 
-    originalProjection->readBytes(originalBytes.data(), rect);
+    originalProjection->readBytes(originalBytes.data(), srcRect);
 
     if (m_displayFilter &&
         m_useOcio &&
@@ -278,7 +350,16 @@ void KisImagePyramid::retrieveImageData(const QRect &rect)
         }
 
         QScopedArrayPointer<quint8> dst(new quint8[m_monitorColorSpace->pixelSize() * numPixels]);
-        projectionCs->convertPixelsTo(originalBytes.data(), dst.data(), m_monitorColorSpace, numPixels, m_renderingIntent, m_conversionFlags);
+        if (!m_conversionFastPath.convert(projectionCs, originalBytes.data(), dst.data(), m_monitorColorSpace, numPixels, m_renderingIntent, m_conversionFlags)) {
+            projectionCs->convertPixelsTo(originalBytes.data(), dst.data(), m_monitorColorSpace, numPixels, m_renderingIntent, m_conversionFlags);
+        }
+        originalBytes.swap(dst);
+    }
+
+    if (levelOfDetail > 0) {
+        const int pixelSize = m_monitorColorSpace->pixelSize();
+        QScopedArrayPointer<quint8> dst(new quint8[pixelSize * rect.width() * rect.height()]);
+        upscaleLodPixels(originalBytes.data(), srcRect, dst.data(), rect, levelOfDetail, pixelSize);
         originalBytes.swap(dst);
     }
 
@@ -343,8 +424,8 @@ QRect KisImagePyramid::downsampleByFactor2(const QRect& srcRect,
 
             Q_ASSERT(!isOdd(conseqPixels));
 
-            downsamplePixels(srcIt0->oldRawData(), srcIt1->oldRawData(),
-                             dstIt->rawData(), conseqPixels);
+            m_downsampler->downsampleRows(srcIt0->oldRawData(), srcIt1->oldRawData(),
+                                          dstIt->rawData(), conseqPixels / 2);
 
 
             srcIt1->nextPixels(conseqPixels);
@@ -359,39 +440,6 @@ QRect KisImagePyramid::downsampleByFactor2(const QRect& srcRect,
     return QRect(dstX, dstY, dstWidth, dstHeight);
 }
 
-void  KisImagePyramid::downsamplePixels(const quint8 *srcRow0,
-                                        const quint8 *srcRow1,
-                                        quint8 *dstRow,
-                                        qint32 numSrcPixels)
-{
-    /**
-     * FIXME (mandatory): Use SSE and friends here.
-     */
-
-    qint16 b = 0;
-    qint16 g = 0;
-    qint16 r = 0;
-    qint16 a = 0;
-
-    static const qint32 pixelSize = 4; // This is preview argb8 mode
-
-    for (qint32 i = 0; i < numSrcPixels / 2; i++) {
-        b = srcRow0[0] + srcRow1[0] + srcRow0[4] + srcRow1[4];
-        g = srcRow0[1] + srcRow1[1] + srcRow0[5] + srcRow1[5];
-        r = srcRow0[2] + srcRow1[2] + srcRow0[6] + srcRow1[6];
-        a = srcRow0[3] + srcRow1[3] + srcRow0[7] + srcRow1[7];
-
-        dstRow[0] = b / 4;
-        dstRow[1] = g / 4;
-        dstRow[2] = r / 4;
-        dstRow[3] = a / 4;
-
-        dstRow += pixelSize;
-        srcRow0 += 2 * pixelSize;
-        srcRow1 += 2 * pixelSize;
-    }
-}
-
 int KisImagePyramid::findFirstGoodPlaneIndex(qreal scale,
         QSize originalSize)
 {
@@ -8,6 +8,7 @@
 #define __KIS_IMAGE_PYRAMID
 
 #include <QImage>
+#include <QMutex>
 #include <QVector>
 #include <QThreadStorage>
 
@@ -15,7 +16,9 @@
 #include <kis_image.h>
 #include <kis_paint_device.h>
 #include "kis_projection_backend.h"
+#include "KisDisplayConversionFastPath.h"
 
+class KoOptimizedPixelDataDownsamplerU8Base;
 
 class KisImagePyramid : QObject, public KisProjectionBackend
 {
@@ -30,7 +33,7 @@ public:
     void setMonitorProfile(const KoColorProfile* monitorProfile, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::ConversionFlags conversionFlags) override;
     void setChannelFlags(const QBitArray &channelFlags) override;
     void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter) override;
-    void updateCache(const QRect &dirtyImageRect) override;
+    QRect updateCache(const QRect &dirtyImageRect) override;
     void recalculateCache(KisPPUpdateInfoSP info) override;
 
     KisImagePatch getNearestPatch(KisPPUpdateInfoSP info) override;
@@ -62,8 +65,15 @@ public:
     void alignSourceRect(QRect& rect, qreal scale) override;
 
 private:
+    friend class KisImagePyramidTest;
 
-    void retrieveImageData(const QRect &rect);
+    /**
+     * Updates the cache assuming the image is in \p levelOfDetail mode,
+     * see updateCache()
+     */
+    QRect updateCache(const QRect &dirtyImageRect, int levelOfDetail);
+
+    void retrieveImageData(const QRect &rect, int levelOfDetail);
     void rebuildPyramid();
     void clearPyramid();
 
@@ -75,14 +85,6 @@ private:
     QRect downsampleByFactor2(const QRect& srcRect,
                               KisPaintDevice* src, KisPaintDevice* dst);
 
-    /**
-     * Auxiliary function. Downsamples two lines in @srcRow0
-     * and @srcRow1 into one line @dstRow
-     * Note: @numSrcPixels must be EVEN
-     */
-    void downsamplePixels(const quint8 *srcRow0, const quint8 *srcRow1,
-                          quint8 *dstRow, qint32 numSrcPixels);
-
     /**
      * Searches for the last pyramid plane that can cover
      * canvas on current zoom level
@@ -104,11 +106,23 @@ private Q_SLOTS:
 private:
 
     QVector<KisPaintDeviceSP> m_pyramid;
+
+    /**
+     * Averages 2x2 blocks of the monitor-space pixels, optimized
+     * for the current CPU architecture
+     */
+    QScopedPointer<KoOptimizedPixelDataDownsamplerU8Base> m_downsampler;
     KisImageWSP  m_originalImage;
 
     const KoColorProfile* m_monitorProfile {0};
     const KoColorSpace* m_monitorColorSpace {0};
 
+    /**
+     * Converts the projection into the monitor space without lcms
+     * when both have matrix-shaper profiles
+     */
+    KisDisplayConversionFastPath m_conversionFastPath;
+
     QSharedPointer<KisDisplayFilter> m_displayFilter;
 
     KoColorConversionTransformation::Intent m_renderingIntent { KoColorConversionTransformation::IntentPerceptual };
@@ -122,6 +136,13 @@ private:
 
     bool m_useOcio {false};
 
+    /**
+     * The area of the base plane that has been filled with the upscaled
+     * level of detail plane and should be reread in full resolution
+     */
+    QRect m_lodPreviewRect;
+    QMutex m_lodPreviewMutex;
+
     QBitArray m_channelFlags;
     bool m_allChannelsSelected {false};
     bool m_onlyOneChannelSelected {false};
@@ -203,10 +203,10 @@ KisUpdateInfoSP KisPrescaledProjection::updateCache(const QRect &dirtyImageRect)
     QRect croppedImageRect = dirtyImageRect & m_d->image->bounds();
     if (croppedImageRect.isEmpty()) return new KisPPUpdateInfo();
 
-    KisPPUpdateInfoSP info = getInitialUpdateInformation(croppedImageRect);
-    m_d->projectionBackend->updateCache(croppedImageRect);
+    const QRect updatedImageRect =
+        m_d->projectionBackend->updateCache(croppedImageRect) & m_d->image->bounds();
 
-    return info;
+    return getInitialUpdateInformation(updatedImageRect);
 }
 
 void KisPrescaledProjection::recalculateCache(KisUpdateInfoSP info)
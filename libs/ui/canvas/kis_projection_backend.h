@@ -40,8 +40,11 @@ public:
      * Updates the cache of the backend by reading from
      * an associated image. All data transfers with
      * KisImage should happen here
+     *
+     * @return the rect of the cache that has actually been updated,
+     * it might be bigger than @p dirtyImageRect
      */
-    virtual void updateCache(const QRect &dirtyImageRect) = 0;
+    virtual QRect updateCache(const QRect &dirtyImageRect) = 0;
 
     /**
      * Prescales the cache of the backend. It is intended to be
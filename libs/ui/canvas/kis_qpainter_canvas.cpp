@@ -32,6 +32,7 @@
 
 #include <kis_image.h>
 #include <kis_layer.h>
+#include <KisInputLatencyTracker.h>
 
 #include "KisViewManager.h"
 #include "kis_canvas2.h"
@@ -123,6 +124,8 @@ void KisQPainterCanvas::paintEvent(QPaintEvent * ev)
 
     gc.end();
     m_d->repaintDbg.paint(this, ev);
+
+    KisInputLatencyTracker::instance()->notifyFramePresented();
 }
 
 void KisQPainterCanvas::drawImage(QPainter & gc, const QRect &updateWidgetRect) const
@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAsyncAnimationFramesStreamDialog.h"
+
+#include <kis_image.h>
+#include <kis_time_span.h>
+
+#include <KisAnimationRawFrameStream.h>
+#include <KisAsyncAnimationFramesStreamingRenderer.h>
+
+#include <klocalizedstring.h>
+
+struct KisAsyncAnimationFramesStreamDialog::Private {
+    Private(KisImageSP _image,
+            const KisTimeSpan &_range,
+            KisAnimationRawFrameStream *_stream)
+        : originalImage(_image),
+          range(_range),
+          stream(_stream)
+    {
+    }
+
+    KisImageSP originalImage;
+    KisTimeSpan range;
+    KisAnimationRawFrameStream *stream;
+};
+
+KisAsyncAnimationFramesStreamDialog::KisAsyncAnimationFramesStreamDialog(KisImageSP originalImage,
+                                                                         const KisTimeSpan &range,
+                                                                         KisAnimationRawFrameStream *stream)
+    : KisAsyncAnimationRenderDialogBase(i18n("Encoding frames..."), originalImage, 0),
+      m_d(new Private(originalImage, range, stream))
+{
+}
+
+KisAsyncAnimationFramesStreamDialog::~KisAsyncAnimationFramesStreamDialog()
+{
+}
+
+KisAsyncAnimationRenderDialogBase::Result KisAsyncAnimationFramesStreamDialog::regenerateRange(KisViewManager *viewManager)
+{
+    KisAsyncAnimationRenderDialogBase::Result renderingResult = KisAsyncAnimationRenderDialogBase::regenerateRange(viewManager);
+
+    // the frames are written by the rendering threads, so all of them are
+    // in the stream by the time the last frame is reported as completed
+    if (renderingResult == RenderComplete && !m_d->stream->isComplete()) {
+        renderingResult = RenderFailed;
+    }
+
+    if (renderingResult != RenderComplete) {
+        m_d->stream->cancel();
+    }
+
+    return renderingResult;
+}
+
+QList<int> KisAsyncAnimationFramesStreamDialog::calcDirtyFrames() const
+{
+    QList<int> result;
+    for (int frame = m_d->range.start(); frame <= m_d->range.end(); frame++) {
+        KisTimeSpan heldFrameTimeRange = KisTimeSpan::calculateIdenticalFramesRecursive(m_d->originalImage->root(), frame);
+
+        // Clamp holds that begin before the rendered range onto it
+        heldFrameTimeRange &= m_d->range;
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(heldFrameTimeRange.isValid(), result);
+
+        result.append(heldFrameTimeRange.start());
+
+        if (heldFrameTimeRange.isInfinite()) {
+            break;
+        } else {
+            frame = heldFrameTimeRange.end();
+        }
+    }
+    return result;
+}
+
+KisAsyncAnimationRendererBase *KisAsyncAnimationFramesStreamDialog::createRenderer(KisImageSP image)
+{
+    Q_UNUSED(image);
+    return new KisAsyncAnimationFramesStreamingRenderer(m_d->stream, m_d->range);
+}
+
+void KisAsyncAnimationFramesStreamDialog::initializeRendererForFrame(KisAsyncAnimationRendererBase *renderer, KisImageSP image, int frame)
+{
+    Q_UNUSED(renderer);
+    Q_UNUSED(image);
+    Q_UNUSED(frame);
+}
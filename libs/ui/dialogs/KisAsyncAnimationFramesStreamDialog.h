@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISASYNCANIMATIONFRAMESSTREAMDIALOG_H
+#define KISASYNCANIMATIONFRAMESSTREAMDIALOG_H
+
+#include "KisAsyncAnimationRenderDialogBase.h"
+#include "kis_types.h"
+
+class KisAnimationRawFrameStream;
+
+/**
+ * Renders the frames of the range and passes them into \p stream in the
+ * order of the frames, without saving them into files
+ */
+class KRITAUI_EXPORT KisAsyncAnimationFramesStreamDialog : public KisAsyncAnimationRenderDialogBase
+{
+public:
+    KisAsyncAnimationFramesStreamDialog(KisImageSP image,
+                                        const KisTimeSpan &range,
+                                        KisAnimationRawFrameStream *stream);
+
+    ~KisAsyncAnimationFramesStreamDialog();
+
+    Result regenerateRange(KisViewManager *viewManager) override;
+
+protected:
+    QList<int> calcDirtyFrames() const override;
+    KisAsyncAnimationRendererBase* createRenderer(KisImageSP image) override;
+    void initializeRendererForFrame(KisAsyncAnimationRendererBase *renderer,
+                                    KisImageSP image, int frame) override;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISASYNCANIMATIONFRAMESSTREAMDIALOG_H
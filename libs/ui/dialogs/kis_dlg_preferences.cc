@@ -1515,6 +1515,8 @@ void PerformanceTab::load(bool requestDefault)
 
     if (cfg.useOnDiskAnimationCacheSwapping(requestDefault)) {
         optOnDisk->setChecked(true);
+    } else if (cfg.useCompressedInMemoryAnimationCache(requestDefault)) {
+        optInMemoryCompressed->setChecked(true);
     } else {
         optInMemory->setChecked(true);
     }
@@ -1577,6 +1579,7 @@ void PerformanceTab::save()
     }
 
     cfg.setUseOnDiskAnimationCacheSwapping(optOnDisk->isChecked());
+    cfg.setUseCompressedInMemoryAnimationCache(optInMemoryCompressed->isChecked());
 
     cfg.setUseAnimationCacheFrameSizeLimit(chkCachedFramesSizeLimit->isChecked());
     cfg.setAnimationCacheFrameSizeLimit(intCachedFramesSizeLimit->value());
@@ -10,6 +10,7 @@
 
 #include <QTimer>
 #include <QMutex>
+#include <QElapsedTimer>
 #include <QtConcurrent>
 
 #include "kis_config.h"
@@ -28,6 +29,8 @@
 #include "kis_node_manager.h"
 #include "kis_keyframe_channel.h"
 #include "KisMainWindow.h"
+#include "KisRollingMeanAccumulatorWrapper.h"
+#include "KisAnimationPrefetchScheduler.h"
 
 #include <KisLockFrameGenerationLock.h>
 #include "KisAsyncAnimationCacheRenderer.h"
@@ -49,10 +52,29 @@ struct KisAnimationCachePopulator::Private
     static const int IDLE_COUNT_THRESHOLD = 4;
     static const int IDLE_CHECK_INTERVAL = 500;
     static const int BETWEEN_FRAMES_INTERVAL = 10;
+    static const int PREFETCH_RETRY_INTERVAL = 50;
+    static const int REGENERATION_STATS_WINDOW = 50;
 
     KisAsyncAnimationCacheRenderer regenerator;
     bool calculateAnimationCacheInBackground = true;
 
+    /**
+     * The frames ahead of the playhead of this image should be regenerated
+     * without waiting for the user to become idle. Only the latest request
+     * is kept, the older ones are stale anyway.
+     */
+    KisImageWSP prefetchImage;
+    KisAnimationPrefetchScheduler prefetchScheduler;
+
+    /**
+     * Used for cancellation of the frame being regenerated
+     * when the image changes it
+     */
+    KisSignalAutoConnectionsStore regeneratedImageConnections;
+
+    QElapsedTimer regenerationTimer;
+    KisRollingMeanAccumulatorWrapper regenerationTime {REGENERATION_STATS_WINDOW};
+
     enum State {
         NotWaitingForAnything,
         WaitingForIdle,
@@ -94,6 +116,22 @@ struct KisAnimationCachePopulator::Private
 
     void generateIfIdle()
     {
+        if (prefetchImage) {
+            RegenerationRequestResult result = tryRequestPrefetch();
+
+            if (result == RequestSuccessful) {
+                return;
+            } else if (result == RequestPostponed) {
+                enterState(BetweenFrames, PREFETCH_RETRY_INTERVAL);
+                return;
+            }
+
+            // everything ahead of the playhead is cached or the memory
+            // budget is exhausted, so fall back to the idle-time caching
+            prefetchImage = 0;
+            prefetchScheduler.resetRequest();
+        }
+
         if (part->idleWatcher()->isIdle()) {
             idleCounter++;
 
@@ -116,6 +154,27 @@ struct KisAnimationCachePopulator::Private
     }
 
 
+    RegenerationRequestResult tryRequestPrefetch()
+    {
+        KisImageSP image = prefetchImage;
+        if (!image) return RequestRejected;
+
+        KisAnimationFrameCacheSP cache = KisAnimationFrameCache::cacheForImage(image);
+        if (!cache) return RequestRejected;
+
+        KisImageAnimationInterface *animation = image->animationInterface();
+        if (!animation->hasAnimation()) return RequestRejected;
+
+        const int frame =
+            prefetchScheduler.nextFrame(animation->documentPlaybackRange(),
+                                        cache->statistics(),
+                                        [cache] (int frame) {
+                                            return cache->frameStatus(frame) == KisAnimationFrameCache::Cached;
+                                        });
+
+        return frame >= 0 ? tryRequestGeneration(cache, KisTimeSpan(), frame) : RequestRejected;
+    }
+
     RegenerationRequestResult tryRequestGeneration()
     {
         if (!priorityFrames.isEmpty()) {
@@ -223,6 +282,14 @@ struct KisAnimationCachePopulator::Private
 
         regenerator.setFrameCache(cache);
 
+        prefetchScheduler.startRegeneration(frame);
+        regeneratedImageConnections.clear();
+        regeneratedImageConnections.addConnection(
+            cache->image()->animationInterface(), &KisImageAnimationInterface::sigFramesChanged,
+            q, &KisAnimationCachePopulator::slotFramesChanged);
+
+        regenerationTimer.start();
+
         // if we ever decide to add ROI to background cache
         // regeneration, it should be added here :)
         regenerator.startFrameRegeneration(cache->image(), frame, KisAsyncAnimationRendererBase::Cancellable, std::move(lock));
@@ -251,7 +318,12 @@ struct KisAnimationCachePopulator::Private
         return str;
     }
 
-    void enterState(State newState)
+    void finishRegeneration() {
+        prefetchScheduler.finishRegeneration();
+        regeneratedImageConnections.clear();
+    }
+
+    void enterState(State newState, int timeoutOverride = -1)
     {
         //ENTER_FUNCTION() << debugStateToString(state) << "->" << debugStateToString(newState);
 
@@ -276,6 +348,10 @@ struct KisAnimationCachePopulator::Private
             break;
         }
 
+        if (timerTimeout >= 0 && timeoutOverride >= 0) {
+            timerTimeout = timeoutOverride;
+        }
+
         if (timerTimeout >= 0) {
             timer.start(timerTimeout);
         } else {
@@ -331,20 +407,68 @@ void KisAnimationCachePopulator::slotRequestRegeneration()
     m_d->enterState(Private::WaitingForIdle);
 }
 
+void KisAnimationCachePopulator::requestPrefetch(KisImageSP image, int frame, int direction)
+{
+    if (!m_d->calculateAnimationCacheInBackground) return;
+    if (!m_d->prefetchScheduler.framesLimit()) return;
+    if (!KisAnimationFrameCache::cacheForImage(image)) return;
+
+    m_d->prefetchImage = image;
+    m_d->prefetchScheduler.setRequest(frame, direction);
+
+    if (m_d->state == Private::NotWaitingForAnything ||
+        m_d->state == Private::WaitingForIdle) {
+
+        m_d->enterState(Private::BetweenFrames);
+    }
+}
+
+qreal KisAnimationCachePopulator::averageRegenerationTime() const
+{
+    return m_d->regenerationTime.rollingMeanSafe();
+}
+
 void KisAnimationCachePopulator::slotRegeneratorFrameCancelled()
 {
+    m_d->finishRegeneration();
+
     KIS_ASSERT_RECOVER_RETURN(m_d->state == Private::WaitingForFrame);
-    m_d->enterState(Private::NotWaitingForAnything);
+
+    // the prefetch is continued immediately if it has been
+    // cancelled due to the image changes
+    m_d->enterState(m_d->prefetchImage ?
+                    Private::BetweenFrames : Private::NotWaitingForAnything);
 }
 
 void KisAnimationCachePopulator::slotRegeneratorFrameReady()
 {
+    m_d->regenerationTime(m_d->regenerationTimer.elapsed());
+    m_d->finishRegeneration();
+
     m_d->enterState(Private::BetweenFrames);
 }
 
+void KisAnimationCachePopulator::slotFramesChanged(const KisTimeSpan &range, const QRect &rect)
+{
+    Q_UNUSED(rect);
+
+    /**
+     * If the frame being regenerated has been changed, its result
+     * is stale and would be invalidated right after being cached,
+     * so just cancel it.
+     */
+    if (m_d->state == Private::WaitingForFrame &&
+        m_d->prefetchScheduler.isRegenerationStale(range)) {
+
+        m_d->regenerator.cancelCurrentFrameRendering(KisAsyncAnimationRendererBase::UserCancelled);
+    }
+}
+
 void KisAnimationCachePopulator::slotConfigChanged()
 {
     KisConfig cfg(true);
     m_d->calculateAnimationCacheInBackground = cfg.calculateAnimationCacheInBackground();
+    m_d->prefetchScheduler.setLimits(cfg.animationCachePrefetchFrames(),
+                                     qint64(cfg.animationCachePrefetchMemoryLimit()) * 1024 * 1024);
     QTimer::singleShot(1000, this, SLOT(slotRequestRegeneration()));
 }
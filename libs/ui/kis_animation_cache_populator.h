@@ -11,6 +11,8 @@
 #include "kis_types.h"
 
 class KisPart;
+class KisTimeSpan;
+class QRect;
 
 class KisAnimationCachePopulator : public QObject
 {
@@ -28,6 +30,22 @@ public:
     bool regenerate(KisAnimationFrameCacheSP cache, int frame);
     void requestRegenerationWithPriorityFrame(KisImageSP image, int frameIndex);
 
+    /**
+     * Request regeneration of the frames following \p frame in
+     * \p direction (1 for forward, -1 for backward playback or
+     * scrubbing). Unlike the usual background caching, the frames
+     * are regenerated without waiting for the user to become idle,
+     * limited by the prefetch frames count and memory budget. A new
+     * request replaces the previous one.
+     */
+    void requestPrefetch(KisImageSP image, int frame, int direction);
+
+    /**
+     * @return the rolling average time (in milliseconds) between a
+     * frame regeneration request and the frame being cached
+     */
+    qreal averageRegenerationTime() const;
+
 public Q_SLOTS:
     void slotRequestRegeneration();
 
@@ -36,6 +54,7 @@ private Q_SLOTS:
 
     void slotRegeneratorFrameCancelled();
     void slotRegeneratorFrameReady();
+    void slotFramesChanged(const KisTimeSpan &range, const QRect &rect);
 
     void slotConfigChanged();
 
@@ -47,6 +47,9 @@ struct KisAnimationFrameCache::Private
     QScopedPointer<KisAbstractFrameCacheSwapper> swapper;
     int frameSizeLimit = 777;
 
+    qint64 numFrameLookups = 0;
+    qint64 numFrameHits = 0;
+
     KisOpenGLUpdateInfoSP fetchFrameDataImpl(KisImageSP image, const QRect &requestedRect, int lod);
 
     struct Frame
@@ -96,6 +99,12 @@ struct KisAnimationFrameCache::Private
     KisOpenGLUpdateInfoSP getFrame(int time)
     {
         const int frameId = getFrameIdAtTime(time);
+
+        numFrameLookups++;
+        if (frameId >= 0) {
+            numFrameHits++;
+        }
+
         return frameId >= 0 ? swapper->loadFrame(frameId) : 0;
     }
 
@@ -220,6 +229,7 @@ KisAnimationFrameCache::KisAnimationFrameCache(KisOpenGLImageTexturesSP textures
 
 KisAnimationFrameCache::~KisAnimationFrameCache()
 {
+    dbgUI << "Destroying animation frame cache:" << statistics();
     Private::caches.remove(m_d->textures);
 }
 
@@ -276,11 +286,15 @@ void KisAnimationFrameCache::framesChanged(const KisTimeSpan &range, const QRect
 void KisAnimationFrameCache::slotConfigChanged()
 {
     m_d->newFrames.clear();
+    m_d->numFrameLookups = 0;
+    m_d->numFrameHits = 0;
 
     KisImageConfig cfg(true);
 
     if (cfg.useOnDiskAnimationCacheSwapping()) {
         m_d->swapper.reset(new KisFrameCacheSwapper(m_d->textures->updateInfoBuilder(), cfg.swapDir()));
+    } else if (cfg.useCompressedInMemoryAnimationCache()) {
+        m_d->swapper.reset(new KisFrameCacheSwapper(m_d->textures->updateInfoBuilder(), KisFrameDataSerializer::StoreInMemory));
     } else {
         m_d->swapper.reset(new KisInMemoryFrameCacheSwapper());
     }
@@ -340,6 +354,14 @@ void KisAnimationFrameCache::addConvertedFrameData(KisOpenGLUpdateInfoSP info, i
     emit changed();
 }
 
+KisFrameCacheStatistics KisAnimationFrameCache::statistics() const
+{
+    KisFrameCacheStatistics stats = m_d->swapper->statistics();
+    stats.numFrameLookups = m_d->numFrameLookups;
+    stats.numFrameHits = m_d->numFrameHits;
+    return stats;
+}
+
 void KisAnimationFrameCache::dropLowQualityFrames(const KisTimeSpan &range, const QRect &regionOfInterest, const QRect &minimalRect)
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(!range.isInfinite());
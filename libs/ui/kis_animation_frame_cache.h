@@ -13,6 +13,7 @@
 #include "kritaui_export.h"
 #include "kis_types.h"
 #include "kis_shared.h"
+#include "KisFrameCacheStatistics.h"
 
 class KisImage;
 class KisImageAnimationInterface;
@@ -63,6 +64,12 @@ public:
 
     bool framesHaveValidRoi(const KisTimeSpan &range, const QRect &regionOfInterest);
 
+    /**
+     * Returns the memory usage of the cached frames and the hit rates
+     * of the frame lookups and of the tile deduplication
+     */
+    KisFrameCacheStatistics statistics() const;
+
 Q_SIGNALS:
     void changed();
 
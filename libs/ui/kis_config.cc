@@ -2367,6 +2367,26 @@ void KisConfig::setCalculateAnimationCacheInBackground(bool value)
     m_cfg.writeEntry("calculateAnimationCacheInBackground", value);
 }
 
+int KisConfig::animationCachePrefetchFrames(bool defaultValue) const
+{
+    return defaultValue ? 24 : m_cfg.readEntry("animationCachePrefetchFrames", 24);
+}
+
+void KisConfig::setAnimationCachePrefetchFrames(int value)
+{
+    m_cfg.writeEntry("animationCachePrefetchFrames", value);
+}
+
+int KisConfig::animationCachePrefetchMemoryLimit(bool defaultValue) const
+{
+    return defaultValue ? 1024 : m_cfg.readEntry("animationCachePrefetchMemoryLimit", 1024);
+}
+
+void KisConfig::setAnimationCachePrefetchMemoryLimit(int value)
+{
+    m_cfg.writeEntry("animationCachePrefetchMemoryLimit", value);
+}
+
 QColor KisConfig::defaultAssistantsColor(bool defaultValue) const
 {
     static const QColor defaultColor = QColor(176, 176, 176, 255);
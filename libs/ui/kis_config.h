@@ -637,6 +637,13 @@ public:
     bool calculateAnimationCacheInBackground(bool defaultValue = false) const;
     void setCalculateAnimationCacheInBackground(bool value);
 
+    int animationCachePrefetchFrames(bool defaultValue = false) const;
+    void setAnimationCachePrefetchFrames(int value);
+
+    /// memory budget of the playback prefetch in MiB, 0 means unlimited
+    int animationCachePrefetchMemoryLimit(bool defaultValue = false) const;
+    void setAnimationCachePrefetchMemoryLimit(int value);
+
     QColor defaultAssistantsColor(bool defaultValue = false) const;
     void setDefaultAssistantsColor(const QColor &color) const;
 
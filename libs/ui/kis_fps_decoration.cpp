@@ -12,6 +12,7 @@
 #include "kis_coordinates_converter.h"
 #include "opengl/kis_opengl_canvas_debugger.h"
 #include <KisStrokeSpeedMonitor.h>
+#include <KisInputLatencyTracker.h>
 #include <QGraphicsScene>
 #include <QGraphicsPixmapItem>
 #include <QGraphicsDropShadowEffect>
@@ -121,5 +122,18 @@ QString KisFpsDecoration::getText() const
                 .arg(monitor->avgFps(), 0, 'f', 1);
     }
 
+    KisInputLatencyTracker *tracker = KisInputLatencyTracker::instance();
+
+    if (tracker->isEnabled()) {
+        const KisInputLatencyTracker::Histogram latency =
+            tracker->histogram(KisInputLatencyTracker::EndToEnd);
+
+        if (latency.count > 0) {
+            lines << QString("Input latency 50%/95% (ms): %1/%2")
+                    .arg(latency.percentileMs(50), 0, 'f', 1)
+                    .arg(latency.percentileMs(95), 0, 'f', 1);
+        }
+    }
+
     return lines.join('\n');
 }
@@ -39,6 +39,7 @@
 #include <KoCompositeOpRegistry.h>
 #include <KoColorModelStandardIds.h>
 #include "KisOpenGLBufferCircularStorage.h"
+#include "KisInputLatencyTracker.h"
 #include "kis_painting_tweaks.h"
 #include <KisOptimizedBrushOutline.h>
 
@@ -391,6 +392,8 @@ void KisOpenGLCanvasRenderer::paintCanvasOnly(const QRect &canvasImageDirtyRect,
         }
         renderCanvasGL(fullUpdateRect);
     }
+
+    KisInputLatencyTracker::instance()->notifyFramePresented();
 }
 
 void KisOpenGLCanvasRenderer::paintToolOutline(const KisOptimizedBrushOutline &path, const QRect &viewportUpdateRect)
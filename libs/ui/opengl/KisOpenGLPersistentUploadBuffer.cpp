@@ -0,0 +1,254 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOpenGLPersistentUploadBuffer.h"
+
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QSharedPointer>
+
+#include <cstring>
+#include <deque>
+
+#include "kis_assert.h"
+#include "KisOpenGLSync.h"
+
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace {
+
+typedef void (QOPENGLF_APIENTRYP kis_glBufferStorage)(GLenum, GLsizeiptr, const void*, GLbitfield);
+
+/**
+ * Every reservation starts at a cache-line boundary, which also keeps
+ * the offsets aligned to the size of any texel type
+ */
+const int reservationAlignment = 64;
+
+inline int alignedSize(int size) {
+    return (size + reservationAlignment - 1) & ~(reservationAlignment - 1);
+}
+
+struct Region {
+    int begin = 0;
+    int end = 0;
+
+    /// null while the batch the region belongs to is not finished yet
+    QSharedPointer<KisOpenGLSync> sync;
+};
+
+}
+
+struct Q_DECL_HIDDEN KisOpenGLPersistentUploadBuffer::Private
+{
+    QOpenGLExtraFunctions *f = nullptr;
+    GLuint bufferId = 0;
+    quint8 *mappedData = nullptr;
+    int capacity = 0;
+
+    /// the regions still used by the GPU, in the order of allocation
+    std::deque<Region> regions;
+
+    int head = 0;
+    int writePos = 0;
+    int reservedEnd = 0;
+
+    void releaseSignaledRegions() {
+        while (!regions.empty() &&
+               regions.front().sync &&
+               regions.front().sync->isSignaled()) {
+
+            regions.pop_front();
+        }
+    }
+
+    bool isRangeUsed(int begin, int end) const {
+        for (auto it = regions.begin(); it != regions.end(); ++it) {
+            if (begin < it->end && it->begin < end) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+KisOpenGLPersistentUploadBuffer::KisOpenGLPersistentUploadBuffer()
+    : m_d(new Private)
+{
+}
+
+KisOpenGLPersistentUploadBuffer::~KisOpenGLPersistentUploadBuffer()
+{
+    reset();
+}
+
+bool KisOpenGLPersistentUploadBuffer::allocate(int capacity)
+{
+    reset();
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(capacity > 0, false);
+
+    QOpenGLContext *ctx = QOpenGLContext::currentContext();
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(ctx, false);
+
+    /**
+     * Without fences we would have no way to know when the GPU has
+     * finished reading the data, so the buffer cannot be reused safely
+     */
+    if (!KisOpenGLSync::isAvailable()) return false;
+
+    kis_glBufferStorage bufferStorage =
+        reinterpret_cast<kis_glBufferStorage>(
+            ctx->getProcAddress(ctx->isOpenGLES() ? "glBufferStorageEXT" : "glBufferStorage"));
+
+    if (!bufferStorage) return false;
+
+    m_d->f = ctx->extraFunctions();
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    m_d->f->glGenBuffers(1, &m_d->bufferId);
+    m_d->f->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_d->bufferId);
+    bufferStorage(GL_PIXEL_UNPACK_BUFFER, capacity, nullptr, flags);
+    m_d->mappedData = static_cast<quint8*>(
+        m_d->f->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, capacity, flags));
+    m_d->f->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!m_d->mappedData) {
+        m_d->f->glDeleteBuffers(1, &m_d->bufferId);
+        m_d->bufferId = 0;
+        m_d->f = nullptr;
+        return false;
+    }
+
+    m_d->capacity = capacity;
+    m_d->head = 0;
+
+    return true;
+}
+
+void KisOpenGLPersistentUploadBuffer::reset()
+{
+    m_d->regions.clear();
+
+    if (m_d->bufferId) {
+        m_d->f->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_d->bufferId);
+        m_d->f->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        m_d->f->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        m_d->f->glDeleteBuffers(1, &m_d->bufferId);
+    }
+
+    m_d->f = nullptr;
+    m_d->bufferId = 0;
+    m_d->mappedData = nullptr;
+    m_d->capacity = 0;
+    m_d->head = 0;
+    m_d->writePos = 0;
+    m_d->reservedEnd = 0;
+}
+
+bool KisOpenGLPersistentUploadBuffer::isValid() const
+{
+    return m_d->mappedData;
+}
+
+int KisOpenGLPersistentUploadBuffer::capacity() const
+{
+    return m_d->capacity;
+}
+
+void KisOpenGLPersistentUploadBuffer::beginBatch()
+{
+    // the previous batch might have been interrupted, so fence it now
+    endBatch();
+}
+
+bool KisOpenGLPersistentUploadBuffer::reserve(int size)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(isValid(), false);
+
+    const int reservedSize = alignedSize(size);
+    if (reservedSize > m_d->capacity) return false;
+
+    m_d->releaseSignaledRegions();
+
+    int begin = m_d->head;
+    if (begin + reservedSize > m_d->capacity) {
+        begin = 0;
+    }
+    const int end = begin + reservedSize;
+
+    if (m_d->isRangeUsed(begin, end)) return false;
+
+    if (!m_d->regions.empty() &&
+        !m_d->regions.back().sync &&
+        m_d->regions.back().end == begin) {
+
+        m_d->regions.back().end = end;
+    } else {
+        Region region;
+        region.begin = begin;
+        region.end = end;
+        m_d->regions.push_back(region);
+    }
+
+    m_d->head = end;
+    m_d->writePos = begin;
+    m_d->reservedEnd = end;
+
+    return true;
+}
+
+std::optional<const void*> KisOpenGLPersistentUploadBuffer::append(const void *data, int size)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->writePos + size <= m_d->reservedEnd, std::nullopt);
+
+    const int offset = m_d->writePos;
+    memcpy(m_d->mappedData + offset, data, size);
+    m_d->writePos += size;
+
+    return reinterpret_cast<const void*>(static_cast<quintptr>(offset));
+}
+
+void KisOpenGLPersistentUploadBuffer::bind()
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(isValid());
+    m_d->f->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_d->bufferId);
+}
+
+void KisOpenGLPersistentUploadBuffer::release()
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(isValid());
+    m_d->f->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void KisOpenGLPersistentUploadBuffer::endBatch()
+{
+    QSharedPointer<KisOpenGLSync> sync;
+
+    for (auto it = m_d->regions.begin(); it != m_d->regions.end(); ++it) {
+        if (!it->sync) {
+            if (!sync) {
+                sync.reset(new KisOpenGLSync());
+            }
+            it->sync = sync;
+        }
+    }
+
+    m_d->writePos = 0;
+    m_d->reservedEnd = 0;
+}
@@ -0,0 +1,95 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPENGLPERSISTENTUPLOADBUFFER_H
+#define KISOPENGLPERSISTENTUPLOADBUFFER_H
+
+#include <QScopedPointer>
+
+#include <optional>
+
+#include "kritaui_export.h"
+
+/**
+ * A pixel unpack buffer that is allocated with glBufferStorage() and
+ * stays mapped into the client memory for the whole lifetime of the
+ * object. It is used as a ring buffer for uploading many texture tiles
+ * in one pass: the data of every tile is copied into the mapped memory
+ * directly, without any glBufferData() calls, and the GPU is told to
+ * fetch it from the corresponding offset.
+ *
+ * The uploads are grouped into batches. When the batch is finished, the
+ * space used by it is protected by a fence (KisOpenGLSync) and is reused
+ * only after the GPU has signalled the fence. When there is no free
+ * space left, reserve() fails and the caller is expected to upload the
+ * data in some other way. The buffer never waits for the GPU.
+ *
+ * All the methods must be called with the GL context current.
+ */
+class KRITAUI_EXPORT KisOpenGLPersistentUploadBuffer
+{
+public:
+    KisOpenGLPersistentUploadBuffer();
+    ~KisOpenGLPersistentUploadBuffer();
+
+    KisOpenGLPersistentUploadBuffer(const KisOpenGLPersistentUploadBuffer &) = delete;
+    KisOpenGLPersistentUploadBuffer &operator=(const KisOpenGLPersistentUploadBuffer &) = delete;
+
+    /**
+     * Allocates and maps a buffer of \p capacity bytes. Returns false
+     * if persistent mapping or fences are not supported by the context.
+     */
+    bool allocate(int capacity);
+
+    /**
+     * Unmaps and deletes the buffer
+     */
+    void reset();
+
+    bool isValid() const;
+    int capacity() const;
+
+    /**
+     * Starts a new batch of uploads
+     */
+    void beginBatch();
+
+    /**
+     * Reserves \p size bytes for the following append() calls. Returns
+     * false if that amount of space is still used by the GPU.
+     */
+    bool reserve(int size);
+
+    /**
+     * Copies \p data into the reserved space and returns the value that
+     * should be passed to glTexSubImage2D() instead of the data pointer
+     * while the buffer is bound. The value is an offset in the buffer, so
+     * it may legitimately be null. Returns std::nullopt if the data doesn't
+     * fit into the reserved space.
+     */
+    std::optional<const void*> append(const void *data, int size);
+
+    /**
+     * Binds the buffer to GL_PIXEL_UNPACK_BUFFER
+     */
+    void bind();
+
+    /**
+     * Resets GL_PIXEL_UNPACK_BUFFER binding
+     */
+    void release();
+
+    /**
+     * Puts a fence after the uploads issued in the current batch
+     */
+    void endBatch();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISOPENGLPERSISTENTUPLOADBUFFER_H
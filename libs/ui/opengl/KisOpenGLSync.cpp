@@ -88,6 +88,10 @@ namespace Sync {
         return Sync::Signaled;
     }
 
+    bool isAvailable() {
+        return k_glFenceSync && k_glGetSynciv && k_glDeleteSync;
+    }
+
     void deleteSync(GLsync syncObject) {
         if(syncObject && k_glDeleteSync) {
             k_glDeleteSync(syncObject);
@@ -114,3 +118,8 @@ void KisOpenGLSync::init(QOpenGLContext *ctx)
 {
     Sync::init(ctx);
 }
+
+bool KisOpenGLSync::isAvailable()
+{
+    return Sync::isAvailable();
+}
@@ -25,6 +25,12 @@ public:
 
     static void init(QOpenGLContext *ctx);
 
+    /**
+     * Returns true if the sync functions have been resolved by init(),
+     * otherwise the sync objects are always reported as signaled
+     */
+    static bool isAvailable();
+
 private:
     GLsync m_syncObject = 0;
 };
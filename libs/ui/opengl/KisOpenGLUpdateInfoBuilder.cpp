@@ -8,6 +8,8 @@
 // TODO: conversion options into a separate file!
 #include "kis_update_info.h"
 #include "opengl/kis_texture_tile_info_pool.h"
+#include "opengl/KisTextureTileConversionCache.h"
+#include "canvas/KisDisplayConversionFastPath.h"
 
 #include "KisProofingConfiguration.h"
 
@@ -32,6 +34,19 @@ struct KRITAUI_NO_EXPORT KisOpenGLUpdateInfoBuilder::Private
 
     KisTextureTileInfoPoolSP pool;
     QReadWriteLock lock;
+
+    /**
+     * Keeps the display conversion results of the entire tiles. Partial
+     * updates (e.g. the ones coming from a brush stroke) are rarely
+     * repeated, so they are not cached to avoid trashing the cache.
+     */
+    KisTextureTileConversionCache conversionCache;
+
+    /**
+     * Converts the tiles without lcms when both the image and the
+     * display have matrix-shaper profiles
+     */
+    KisDisplayConversionFastPath conversionFastPath;
 };
 
 
@@ -145,7 +160,9 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
                     if (m_d->proofingTransform) {
                         tileInfo->proofTo(m_d->conversionOptions.m_destinationColorSpace, m_d->proofingConfig->conversionFlags, m_d->proofingTransform.data());
                     } else {
-                        tileInfo->convertTo(m_d->conversionOptions.m_destinationColorSpace, m_d->conversionOptions.m_renderingIntent, m_d->conversionOptions.m_conversionFlags);
+                        tileInfo->convertTo(m_d->conversionOptions.m_destinationColorSpace, m_d->conversionOptions.m_renderingIntent, m_d->conversionOptions.m_conversionFlags,
+                                            tileInfo->isEntireTileUpdated() ? &m_d->conversionCache : nullptr,
+                                            &m_d->conversionFastPath);
                     }
                 }
 
@@ -208,6 +225,8 @@ void KisOpenGLUpdateInfoBuilder::setConversionOptions(const ConversionOptions &o
     m_d->conversionOptions = options;
     // the proofing transform becomes invalid when the target colorspace changes
     m_d->proofingTransform.reset();
+    // the same goes for the cached conversions
+    m_d->conversionCache.clear();
 }
 
 void KisOpenGLUpdateInfoBuilder::setChannelFlags(const QBitArray &channelFrags, bool onlyOneChannelSelected, int selectedChannelIndex)
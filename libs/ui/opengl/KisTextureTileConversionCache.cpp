@@ -0,0 +1,156 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTextureTileConversionCache.h"
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <cstring>
+
+#include "kis_assert.h"
+
+
+namespace {
+
+struct Entry
+{
+    const KoColorSpace *srcColorSpace = nullptr;
+    const KoColorSpace *dstColorSpace = nullptr;
+    KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::IntentPerceptual;
+    KoColorConversionTransformation::ConversionFlags conversionFlags;
+
+    // implicitly shared, so the data can be compared outside the lock
+    QByteArray srcData;
+    QByteArray dstData;
+};
+
+bool entryMatchesKey(const Entry &entry, const KisTextureTileConversionCache::Key &key)
+{
+    return entry.srcColorSpace == key.srcColorSpace &&
+        entry.dstColorSpace == key.dstColorSpace &&
+        entry.renderingIntent == key.renderingIntent &&
+        entry.conversionFlags == key.conversionFlags &&
+        entry.srcData.size() == key.srcSize;
+}
+
+}
+
+KisTextureTileConversionCache::Key::Key(const KoColorSpace *_srcColorSpace,
+                                        const KoColorSpace *_dstColorSpace,
+                                        KoColorConversionTransformation::Intent _renderingIntent,
+                                        KoColorConversionTransformation::ConversionFlags _conversionFlags,
+                                        const quint8 *_srcData, int _srcSize)
+    : srcColorSpace(_srcColorSpace),
+      dstColorSpace(_dstColorSpace),
+      renderingIntent(_renderingIntent),
+      conversionFlags(_conversionFlags),
+      srcData(_srcData),
+      srcSize(_srcSize)
+{
+    hash = qHashBits(srcData, size_t(srcSize),
+                     qHash(quintptr(srcColorSpace)) ^
+                     qHash(quintptr(dstColorSpace)) ^
+                     qHash(int(renderingIntent) | (int(conversionFlags) << 8)));
+}
+
+struct Q_DECL_HIDDEN KisTextureTileConversionCache::Private
+{
+    QMutex mutex;
+
+    /// the cost of the entries is measured in KiB
+    QCache<uint, Entry> cache;
+
+    qint64 numLookups = 0;
+    qint64 numHits = 0;
+};
+
+KisTextureTileConversionCache::KisTextureTileConversionCache(int maxSizeKiB)
+    : m_d(new Private)
+{
+    m_d->cache.setMaxCost(maxSizeKiB);
+}
+
+KisTextureTileConversionCache::~KisTextureTileConversionCache()
+{
+}
+
+bool KisTextureTileConversionCache::fetch(const Key &key, quint8 *dstData, int dstSize)
+{
+    QByteArray cachedSrcData;
+    QByteArray cachedDstData;
+
+    {
+        QMutexLocker l(&m_d->mutex);
+
+        m_d->numLookups++;
+
+        Entry *entry = m_d->cache.object(key.hash);
+        if (!entry || !entryMatchesKey(*entry, key) || entry->dstData.size() != dstSize) {
+            return false;
+        }
+
+        cachedSrcData = entry->srcData;
+        cachedDstData = entry->dstData;
+    }
+
+    if (memcmp(cachedSrcData.constData(), key.srcData, size_t(key.srcSize)) != 0) {
+        return false;
+    }
+
+    memcpy(dstData, cachedDstData.constData(), size_t(dstSize));
+
+    QMutexLocker l(&m_d->mutex);
+    m_d->numHits++;
+
+    return true;
+}
+
+void KisTextureTileConversionCache::store(const Key &key, const quint8 *dstData, int dstSize)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(key.srcSize > 0 && dstSize > 0);
+
+    const int cost = (key.srcSize + dstSize + 1023) / 1024;
+    if (cost > maxSizeKiB()) return;
+
+    Entry *entry = new Entry();
+    entry->srcColorSpace = key.srcColorSpace;
+    entry->dstColorSpace = key.dstColorSpace;
+    entry->renderingIntent = key.renderingIntent;
+    entry->conversionFlags = key.conversionFlags;
+    entry->srcData = QByteArray(reinterpret_cast<const char*>(key.srcData), key.srcSize);
+    entry->dstData = QByteArray(reinterpret_cast<const char*>(dstData), dstSize);
+
+    QMutexLocker l(&m_d->mutex);
+    m_d->cache.insert(key.hash, entry, cost);
+}
+
+void KisTextureTileConversionCache::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->cache.clear();
+}
+
+int KisTextureTileConversionCache::maxSizeKiB() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->cache.maxCost();
+}
+
+qint64 KisTextureTileConversionCache::numLookups() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->numLookups;
+}
+
+qint64 KisTextureTileConversionCache::numHits() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->numHits;
+}
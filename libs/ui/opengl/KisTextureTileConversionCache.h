@@ -0,0 +1,84 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTEXTURETILECONVERSIONCACHE_H
+#define KISTEXTURETILECONVERSIONCACHE_H
+
+#include <QScopedPointer>
+
+#include <KoColorConversionTransformation.h>
+
+#include "kritaui_export.h"
+
+class KoColorSpace;
+
+/**
+ * A bounded LRU cache of the texture tiles converted into the display
+ * color space. The same tile content is often converted several times
+ * in a row, e.g. when undoing and redoing a fill or when toggling the
+ * visibility of a layer back and forth. With the cache, the repeated
+ * conversions become a hash lookup and a copy.
+ *
+ * The tiles are looked up by the contents of the source pixels, their
+ * color space and the display conversion settings. The hash of the
+ * contents is used for lookup only, the source pixels are always
+ * compared byte-by-byte before the cached data is returned.
+ *
+ * The class is thread-safe.
+ */
+class KRITAUI_EXPORT KisTextureTileConversionCache
+{
+public:
+    struct Key
+    {
+        Key(const KoColorSpace *srcColorSpace,
+            const KoColorSpace *dstColorSpace,
+            KoColorConversionTransformation::Intent renderingIntent,
+            KoColorConversionTransformation::ConversionFlags conversionFlags,
+            const quint8 *srcData, int srcSize);
+
+        const KoColorSpace *srcColorSpace;
+        const KoColorSpace *dstColorSpace;
+        KoColorConversionTransformation::Intent renderingIntent;
+        KoColorConversionTransformation::ConversionFlags conversionFlags;
+        const quint8 *srcData;
+        int srcSize;
+        uint hash;
+    };
+
+public:
+    /**
+     * Creates a cache that keeps at most \p maxSizeKiB kibibytes
+     * of the source and converted pixel data
+     */
+    KisTextureTileConversionCache(int maxSizeKiB = 64 * 1024);
+    ~KisTextureTileConversionCache();
+
+    /**
+     * Copies the cached result of the conversion described by \p key
+     * into \p dstData. Returns false if the conversion is not cached.
+     */
+    bool fetch(const Key &key, quint8 *dstData, int dstSize);
+
+    /**
+     * Stores the result of the conversion described by \p key
+     */
+    void store(const Key &key, const quint8 *dstData, int dstSize);
+
+    void clear();
+
+    int maxSizeKiB() const;
+
+    /// the number of fetch() calls and the number of them found in the cache
+    qint64 numLookups() const;
+    qint64 numHits() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISTEXTURETILECONVERSIONCACHE_H
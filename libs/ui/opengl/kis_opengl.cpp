@@ -175,6 +175,7 @@ void KisOpenGL::initialize()
         debugOut << "\n  Is OpenGL ES:" << openGLCheckResult->isOpenGLES();
         debugOut << "\n  supportsBufferMapping:" << openGLCheckResult->supportsBufferMapping();
         debugOut << "\n  supportsBufferInvalidation:" << openGLCheckResult->supportsBufferInvalidation();
+        debugOut << "\n  supportsBufferStorage:" << openGLCheckResult->supportsBufferStorage();
         debugOut << "\n  forceDisableTextureBuffers:" << g_forceDisableTextureBuffers;
         debugOut << "\n  Extensions:";
         {
@@ -363,6 +364,12 @@ bool KisOpenGL::supportsBufferMapping()
     return openGLCheckResult && openGLCheckResult->supportsBufferMapping();
 }
 
+bool KisOpenGL::supportsBufferStorage()
+{
+    initialize();
+    return openGLCheckResult && openGLCheckResult->supportsBufferStorage();
+}
+
 bool KisOpenGL::forceDisableTextureBuffers()
 {
     initialize();
@@ -100,6 +100,12 @@ public:
 
     static bool supportsBufferMapping();
 
+    /**
+     * @return True if OpenGL can allocate persistently mapped
+     * buffers with glBufferStorage()
+     */
+    static bool supportsBufferStorage();
+
     static bool forceDisableTextureBuffers();
     static bool shouldUseTextureBuffers(bool userPreference);
 
@@ -185,8 +185,9 @@ WrapAroundAxis KisOpenGLCanvas2::wrapAroundViewingModeAxis() const
 
 void KisOpenGLCanvas2::initializeGL()
 {
-    d->renderer->initializeGL();
+    // the image textures check for fences when allocating their upload buffer
     KisOpenGLSync::init(context());
+    d->renderer->initializeGL();
 }
 
 void KisOpenGLCanvas2::resizeGL(int width, int height)
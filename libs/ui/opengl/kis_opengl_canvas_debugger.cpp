@@ -22,6 +22,10 @@ struct KisOpenglCanvasDebugger::Private
           fpsSum(0),
           syncFlaggedCounter(0),
           syncFlaggedSum(0),
+          uploadCounter(0),
+          uploadedTilesSum(0),
+          batchedTilesSum(0),
+          batchedBytesSum(0),
           isEnabled(true) {}
 
     QElapsedTimer time;
@@ -32,6 +36,11 @@ struct KisOpenglCanvasDebugger::Private
     int syncFlaggedCounter;
     int syncFlaggedSum;
 
+    int uploadCounter;
+    int uploadedTilesSum;
+    int batchedTilesSum;
+    qint64 batchedBytesSum;
+
     bool isEnabled;
 };
 
@@ -107,3 +116,23 @@ void KisOpenglCanvasDebugger::notifySyncStatus(bool isBusy)
         m_d->syncFlaggedCounter = 0;
     }
 }
+
+void KisOpenglCanvasDebugger::notifyTextureUpload(int numTiles, int numBatchedTiles, qint64 numBatchedBytes)
+{
+    if (!m_d->isEnabled) return;
+
+    m_d->uploadedTilesSum += numTiles;
+    m_d->batchedTilesSum += numBatchedTiles;
+    m_d->batchedBytesSum += numBatchedBytes;
+    m_d->uploadCounter++;
+
+    if (m_d->uploadCounter > 100 && m_d->uploadedTilesSum > 0) {
+        qDebug() << "Texture upload: tiles per update:" << qreal(m_d->uploadedTilesSum) / m_d->uploadCounter
+                 << "batched:" << qreal(m_d->batchedTilesSum) / m_d->uploadedTilesSum
+                 << "KiB per batch:" << qreal(m_d->batchedBytesSum) / m_d->uploadCounter / 1024.0;
+        m_d->uploadCounter = 0;
+        m_d->uploadedTilesSum = 0;
+        m_d->batchedTilesSum = 0;
+        m_d->batchedBytesSum = 0;
+    }
+}
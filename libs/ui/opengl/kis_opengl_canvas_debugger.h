@@ -24,6 +24,7 @@ public:
 
     void notifyPaintRequested();
     void notifySyncStatus(bool value);
+    void notifyTextureUpload(int numTiles, int numBatchedTiles, qint64 numBatchedBytes);
     qreal accumulatedFps();
 
 private Q_SLOTS:
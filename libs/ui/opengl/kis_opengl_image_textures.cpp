@@ -32,6 +32,7 @@
 #include <QVector3D>
 #include "kis_painting_tweaks.h"
 #include "KisOpenGLBufferCreationGuard.h"
+#include "kis_opengl_canvas_debugger.h"
 
 #ifdef HAVE_OPENEXR
 #include <half.h>
@@ -167,8 +168,22 @@ void KisOpenGLImageTextures::initBufferStorage(bool useBuffer)
         const int tileSize = m_texturesInfo.width * m_texturesInfo.height * pixelSize;
 
         m_bufferStorage.allocate(numTextureBuffers, tileSize);
+
+        /**
+         * When the driver can map the buffers persistently, the tiles are
+         * uploaded in batches through a single mapped ring buffer. The
+         * circular storage is still used when the ring buffer is full.
+         */
+        const int numUploadBufferTiles = 32;
+
+        if (!KisOpenGL::supportsBufferStorage() ||
+            !m_uploadBuffer.allocate(numUploadBufferTiles * tileSize)) {
+
+            m_uploadBuffer.reset();
+        }
     } else {
         m_bufferStorage.reset();
+        m_uploadBuffer.reset();
     }
 }
 
@@ -336,10 +351,29 @@ void KisOpenGLImageTextures::recalculateCache(KisUpdateInfoSP info, bool blockMi
     QScopedPointer<KisOpenGLSync> sync;
     int numProcessedTiles = 0;
 
+    const bool useUploadBuffer = m_uploadBuffer.isValid();
+    int numBatchedTiles = 0;
+    qint64 numBatchedBytes = 0;
+
+    if (useUploadBuffer) {
+        m_uploadBuffer.beginBatch();
+    }
+
     KisTextureTileUpdateInfoSP tileInfo;
     Q_FOREACH (tileInfo, glInfo->tileList) {
         KisTextureTile *tile = getTextureTileCR(tileInfo->tileCol(), tileInfo->tileRow());
-        KIS_ASSERT_RECOVER_RETURN(tile);
+        KIS_ASSERT_RECOVER_BREAK(tile);
+
+        if (useUploadBuffer) {
+            const int uploadSize = KisTextureTile::uploadSize(*tileInfo);
+
+            if (m_uploadBuffer.reserve(uploadSize)) {
+                tile->update(*tileInfo, blockMipmapRegeneration, &m_uploadBuffer);
+                numBatchedTiles++;
+                numBatchedBytes += uploadSize;
+                continue;
+            }
+        }
 
         if (m_bufferStorage.isValid() && numProcessedTiles > m_bufferStorage.size() &&
             sync && !sync->isSignaled()) {
@@ -368,6 +402,14 @@ void KisOpenGLImageTextures::recalculateCache(KisUpdateInfoSP info, bool blockMi
             numProcessedTiles++;
         }
     }
+
+    if (useUploadBuffer) {
+        m_uploadBuffer.endBatch();
+    }
+
+    KisOpenglCanvasDebugger::instance()->notifyTextureUpload(glInfo->tileList.size(),
+                                                             numBatchedTiles,
+                                                             numBatchedBytes);
 }
 
 void KisOpenGLImageTextures::generateCheckerTexture(const QImage &checkImage)
@@ -18,6 +18,7 @@
 #include "opengl/kis_texture_tile.h"
 #include "KisOpenGLUpdateInfoBuilder.h"
 #include "KisOpenGLBufferCircularStorage.h"
+#include "KisOpenGLPersistentUploadBuffer.h"
 
 class KisOpenGLImageTextures;
 typedef KisSharedPtr<KisOpenGLImageTextures> KisOpenGLImageTexturesSP;
@@ -208,6 +209,7 @@ private:
 
     // buffers are used by texture tiles, so they must come first
     KisOpenGLBufferCircularStorage m_bufferStorage;
+    KisOpenGLPersistentUploadBuffer m_uploadBuffer;
     QVector<KisTextureTile*> m_textureTiles;
     QOpenGLBuffer m_tileVertexBuffer;
     QOpenGLBuffer m_tileTexCoordBuffer;
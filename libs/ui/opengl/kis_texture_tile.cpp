@@ -8,6 +8,7 @@
 #include "kis_texture_tile.h"
 #include "kis_texture_tile_update_info.h"
 #include "KisOpenGLBufferCircularStorage.h"
+#include "KisOpenGLPersistentUploadBuffer.h"
 
 #include <kis_debug.h>
 #if !defined(QT_OPENGL_ES)
@@ -144,13 +145,43 @@ void KisTextureTile::setPreparedLodPlane(int lod)
     m_needsMipmapRegeneration = false;
 }
 
-void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blockMipmapRegeneration)
+void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blockMipmapRegeneration,
+                            KisOpenGLPersistentUploadBuffer *uploadBuffer)
 {
     f->initializeOpenGLFunctions();
     f->glBindTexture(GL_TEXTURE_2D, m_textureId);
 
     setTextureParameters();
 
+    /**
+     * When an upload buffer is passed, it stays bound for the whole
+     * update and the tile's own buffer storage is not used
+     */
+    KisOpenGLBufferCircularStorage *bufferStorage = uploadBuffer ? nullptr : m_bufferStorage;
+
+    if (uploadBuffer) {
+        uploadBuffer->bind();
+    }
+
+    /**
+     * Copies the data into the upload buffer and replaces the data pointer
+     * with its offset in the buffer. The space is reserved in advance, so
+     * it should never fail, but if it does, the rest of the tile is
+     * uploaded from the client memory.
+     */
+    auto appendToUploadBuffer = [&uploadBuffer] (const GLvoid **fd, int size) {
+        if (!uploadBuffer) return;
+
+        const std::optional<const void*> offset = uploadBuffer->append(*fd, size);
+
+        if (offset) {
+            *fd = *offset;
+        } else {
+            uploadBuffer->release();
+            uploadBuffer = nullptr;
+        }
+    };
+
     const int patchLevelOfDetail = updateInfo.patchLevelOfDetail();
     const QSize patchSize = updateInfo.realPatchSize();
     const QPoint patchOffset = updateInfo.realPatchOffset();
@@ -189,7 +220,8 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
 
     if (updateInfo.isEntireTileUpdated()) {
         KisOpenGLBufferCircularStorage::BufferBinder b(
-            m_bufferStorage, &fd, updateInfo.patchPixelsLength());
+            bufferStorage, &fd, updateInfo.patchPixelsLength());
+        appendToUploadBuffer(&fd, updateInfo.patchPixelsLength());
 
         f->glTexImage2D(GL_TEXTURE_2D, patchLevelOfDetail,
                      m_texturesInfo->internalFormat,
@@ -202,7 +234,8 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
     else {
         const int size = patchSize.width() * patchSize.height() * updateInfo.pixelSize();
         KisOpenGLBufferCircularStorage::BufferBinder b(
-            m_bufferStorage, &fd, size);
+            bufferStorage, &fd, size);
+        appendToUploadBuffer(&fd, size);
 
         f->glTexSubImage2D(GL_TEXTURE_2D, patchLevelOfDetail,
                         patchOffset.x(), patchOffset.y(),
@@ -234,7 +267,8 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
         const GLvoid *fd = updateInfo.data();
         const int size = patchSize.width() * pixelSize;
         KisOpenGLBufferCircularStorage::BufferBinder g(
-            m_bufferStorage, &fd, size);
+            bufferStorage, &fd, size);
+        appendToUploadBuffer(&fd, size);
 
         for (int i = start; i <= end; i++) {
             f->glTexSubImage2D(GL_TEXTURE_2D, patchLevelOfDetail,
@@ -256,7 +290,8 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
         const GLvoid *fd = updateInfo.data() + shift;
         const int size = patchSize.width() * pixelSize;
         KisOpenGLBufferCircularStorage::BufferBinder g(
-            m_bufferStorage, &fd, size);
+            bufferStorage, &fd, size);
+        appendToUploadBuffer(&fd, size);
 
         for (int i = start; i < end; i++) {
             f->glTexSubImage2D(GL_TEXTURE_2D, patchLevelOfDetail,
@@ -287,7 +322,8 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
         const GLvoid *fd = columnBuffer.constData();
         const int size = columnBuffer.size();
         KisOpenGLBufferCircularStorage::BufferBinder g(
-            m_bufferStorage, &fd, size);
+            bufferStorage, &fd, size);
+        appendToUploadBuffer(&fd, size);
 
         for (int i = start; i <= end; i++) {
             f->glTexSubImage2D(GL_TEXTURE_2D, patchLevelOfDetail,
@@ -318,7 +354,8 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
         const GLvoid *fd = columnBuffer.constData();
         const int size = columnBuffer.size();
         KisOpenGLBufferCircularStorage::BufferBinder g(
-            m_bufferStorage, &fd, size);
+            bufferStorage, &fd, size);
+        appendToUploadBuffer(&fd, size);
 
         for (int i = start; i <= end; i++) {
             f->glTexSubImage2D(GL_TEXTURE_2D, patchLevelOfDetail,
@@ -339,6 +376,10 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
     //     qDebug() << "    " << ppVar(patchLevelOfDetail);
     // }
 
+    if (uploadBuffer) {
+        uploadBuffer->release();
+    }
+
     restoreTextureParameters();
 
     if (!patchLevelOfDetail) {
@@ -348,6 +389,34 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
     }
 }
 
+int KisTextureTile::uploadSize(const KisTextureTileUpdateInfo &updateInfo)
+{
+    const QSize patchSize = updateInfo.realPatchSize();
+    const int pixelSize = updateInfo.pixelSize();
+
+    int size = updateInfo.isEntireTileUpdated() ?
+        int(updateInfo.patchPixelsLength()) :
+        patchSize.width() * patchSize.height() * pixelSize;
+
+    if (updateInfo.isTopmost()) {
+        size += patchSize.width() * pixelSize;
+    }
+
+    if (updateInfo.isBottommost()) {
+        size += patchSize.width() * pixelSize;
+    }
+
+    if (updateInfo.isLeftmost()) {
+        size += patchSize.height() * pixelSize;
+    }
+
+    if (updateInfo.isRightmost()) {
+        size += patchSize.height() * pixelSize;
+    }
+
+    return size;
+}
+
 QRectF KisTextureTile::imageRectInTexturePixels(const QRect &imageRect) const
 {
     return relativeRect(m_textureRectInImagePixels,
@@ -15,6 +15,7 @@
 
 
 class KisOpenGLBufferCircularStorage;
+class KisOpenGLPersistentUploadBuffer;
 class KisTextureTileUpdateInfo;
 class QOpenGLBuffer;
 
@@ -53,7 +54,20 @@ public:
         m_numMipmapLevels = num;
     }
 
-    void update(const KisTextureTileUpdateInfo &updateInfo, bool blockMipmapRegeneration);
+    /**
+     * Uploads the patch of \p updateInfo into the texture. When \p uploadBuffer
+     * is non-null, the data is passed to the GPU through it, and the caller
+     * should have reserved uploadSize() bytes in the buffer beforehand.
+     * Otherwise, the tile's own buffer storage is used.
+     */
+    void update(const KisTextureTileUpdateInfo &updateInfo, bool blockMipmapRegeneration,
+                KisOpenGLPersistentUploadBuffer *uploadBuffer = nullptr);
+
+    /**
+     * The number of bytes update() passes to the GPU for \p updateInfo,
+     * including the replicated border pixels
+     */
+    static int uploadSize(const KisTextureTileUpdateInfo &updateInfo);
 
     inline QRect tileRectInImagePixels() {
         return m_tileRectInImagePixels;
@@ -14,6 +14,8 @@
 #include "kis_image.h"
 #include "kis_paint_device.h"
 #include "kis_texture_tile_info_pool.h"
+#include "KisTextureTileConversionCache.h"
+#include "canvas/KisDisplayConversionFastPath.h"
 #include <KoChannelInfo.h>
 #include <KoColorConversionTransformation.h>
 #include <KoColorModelStandardIds.h>
@@ -175,9 +177,15 @@ public:
 
     }
 
+    /**
+     * Converts the patch into \p dstCS. When \p cache is non-null, the
+     * result of the conversion is looked up in it and stored in it.
+     */
     void convertTo(const KoColorSpace* dstCS,
                    KoColorConversionTransformation::Intent renderingIntent,
-                   KoColorConversionTransformation::ConversionFlags conversionFlags)
+                   KoColorConversionTransformation::ConversionFlags conversionFlags,
+                   KisTextureTileConversionCache *cache = nullptr,
+                   KisDisplayConversionFastPath *fastPath = nullptr)
     {
         // we use two-stage check of the color space equivalence:
         // first check pointers, and if not, check the spaces themselves
@@ -191,7 +199,20 @@ public:
             const qint32 numPixels = m_patchRect.width() * m_patchRect.height();
             DataBuffer conversionCache(dstCS->pixelSize(), m_pool);
 
-            m_patchColorSpace->convertPixelsTo(m_patchPixels.data(), conversionCache.data(), dstCS, numPixels, renderingIntent, conversionFlags);
+            if (cache) {
+                const KisTextureTileConversionCache::Key key(m_patchColorSpace, dstCS,
+                                                             renderingIntent, conversionFlags,
+                                                             m_patchPixels.data(),
+                                                             numPixels * m_patchColorSpace->pixelSize());
+                const int dstSize = numPixels * dstCS->pixelSize();
+
+                if (!cache->fetch(key, conversionCache.data(), dstSize)) {
+                    convertPixels(conversionCache.data(), dstCS, numPixels, renderingIntent, conversionFlags, fastPath);
+                    cache->store(key, conversionCache.data(), dstSize);
+                }
+            } else {
+                convertPixels(conversionCache.data(), dstCS, numPixels, renderingIntent, conversionFlags, fastPath);
+            }
 
             m_patchColorSpace = dstCS;
             conversionCache.swap(m_patchPixels);
@@ -304,6 +325,20 @@ public:
         m_patchColorSpace = colorSpace;
     }
 
+private:
+    void convertPixels(quint8 *dst, const KoColorSpace *dstCS, qint32 numPixels,
+                       KoColorConversionTransformation::Intent renderingIntent,
+                       KoColorConversionTransformation::ConversionFlags conversionFlags,
+                       KisDisplayConversionFastPath *fastPath)
+    {
+        if (!fastPath ||
+            !fastPath->convert(m_patchColorSpace, m_patchPixels.data(), dst, dstCS,
+                               numPixels, renderingIntent, conversionFlags)) {
+
+            m_patchColorSpace->convertPixelsTo(m_patchPixels.data(), dst, dstCS, numPixels, renderingIntent, conversionFlags);
+        }
+    }
+
 private:
     Q_DISABLE_COPY(KisTextureTileUpdateInfo)
 
@@ -0,0 +1,161 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisAnimationPrefetchSchedulerTest.h"
+
+#include <simpletest.h>
+
+#include <QSet>
+
+#include "KisAnimationPrefetchScheduler.h"
+#include "KisFrameCacheStatistics.h"
+#include "kis_time_span.h"
+
+namespace {
+
+/**
+ * Marks every frame returned by the scheduler as cached and
+ * returns the order in which the frames have been requested
+ */
+QVector<int> prefetchAll(const KisAnimationPrefetchScheduler &scheduler,
+                         const KisTimeSpan &range,
+                         QSet<int> cachedFrames,
+                         const KisFrameCacheStatistics &stats = KisFrameCacheStatistics())
+{
+    QVector<int> frames;
+
+    auto isCached = [&cachedFrames] (int frame) {
+        return cachedFrames.contains(frame);
+    };
+
+    int frame = -1;
+    while ((frame = scheduler.nextFrame(range, stats, isCached)) >= 0) {
+        // the scheduler should never return the same frame twice
+        if (frames.contains(frame)) break;
+
+        frames.append(frame);
+        cachedFrames.insert(frame);
+    }
+
+    return frames;
+}
+
+}
+
+void KisAnimationPrefetchSchedulerTest::testForwardOrder()
+{
+    KisAnimationPrefetchScheduler scheduler;
+    scheduler.setLimits(5, 0);
+
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(10, 19);
+
+    QVERIFY(!scheduler.hasRequest());
+    QCOMPARE(prefetchAll(scheduler, range, {}), QVector<int>());
+
+    // the playback wraps around the end of the range,
+    // the cached frames are skipped
+    scheduler.setRequest(17, 1);
+    QVERIFY(scheduler.hasRequest());
+    QCOMPARE(prefetchAll(scheduler, range, {18}), QVector<int>({17, 19, 10, 11}));
+
+    scheduler.resetRequest();
+    QVERIFY(!scheduler.hasRequest());
+    QCOMPARE(prefetchAll(scheduler, range, {}), QVector<int>());
+}
+
+void KisAnimationPrefetchSchedulerTest::testBackwardOrder()
+{
+    KisAnimationPrefetchScheduler scheduler;
+    scheduler.setLimits(4, 0);
+
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(10, 19);
+
+    // scrubbing backwards wraps around the start of the range
+    scheduler.setRequest(11, -1);
+    QCOMPARE(prefetchAll(scheduler, range, {11}), QVector<int>({10, 19, 18}));
+}
+
+void KisAnimationPrefetchSchedulerTest::testFramesLimit()
+{
+    KisAnimationPrefetchScheduler scheduler;
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(0, 9);
+
+    // the frames behind the limit are not prefetched even
+    // if the ones inside it are already cached
+    scheduler.setLimits(3, 0);
+    scheduler.setRequest(2, 1);
+    QCOMPARE(prefetchAll(scheduler, range, {2, 3, 4}), QVector<int>());
+
+    // the limit larger than the range visits every frame once
+    scheduler.setLimits(100, 0);
+    QCOMPARE(prefetchAll(scheduler, range, {}), QVector<int>({2, 3, 4, 5, 6, 7, 8, 9, 0, 1}));
+
+    // zero limit disables prefetching
+    scheduler.setLimits(0, 0);
+    QCOMPARE(scheduler.framesLimit(), 0);
+    QCOMPARE(prefetchAll(scheduler, range, {}), QVector<int>());
+}
+
+void KisAnimationPrefetchSchedulerTest::testMemoryLimit()
+{
+    KisAnimationPrefetchScheduler scheduler;
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(0, 9);
+    scheduler.setRequest(0, 1);
+
+    KisFrameCacheStatistics stats;
+    stats.numFrames = 4;
+    stats.storedBytes = 4000;
+
+    // the budget is estimated from the average frame size
+    scheduler.setLimits(24, 6500);
+    QCOMPARE(prefetchAll(scheduler, range, {}, stats), QVector<int>({0, 1}));
+
+    // at least one frame is prefetched while the budget is not exhausted
+    scheduler.setLimits(24, 4500);
+    QCOMPARE(prefetchAll(scheduler, range, {}, stats), QVector<int>({0}));
+
+    // nothing is prefetched when the cache is over the budget
+    scheduler.setLimits(24, 4000);
+    QCOMPARE(prefetchAll(scheduler, range, {}, stats), QVector<int>());
+
+    // an empty cache has no frame size estimation yet
+    scheduler.setLimits(3, 100);
+    QCOMPARE(prefetchAll(scheduler, range, {}), QVector<int>({0, 1, 2}));
+}
+
+void KisAnimationPrefetchSchedulerTest::testLatestRequestWins()
+{
+    KisAnimationPrefetchScheduler scheduler;
+    scheduler.setLimits(3, 0);
+
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(0, 9);
+
+    scheduler.setRequest(2, 1);
+    scheduler.setRequest(6, -1);
+    QCOMPARE(prefetchAll(scheduler, range, {}), QVector<int>({6, 5, 4}));
+}
+
+void KisAnimationPrefetchSchedulerTest::testStaleRegeneration()
+{
+    KisAnimationPrefetchScheduler scheduler;
+
+    QCOMPARE(scheduler.regeneratedFrame(), -1);
+    QVERIFY(!scheduler.isRegenerationStale(KisTimeSpan::infinite(0)));
+
+    scheduler.startRegeneration(5);
+    QCOMPARE(scheduler.regeneratedFrame(), 5);
+
+    // only the changes of the frame being regenerated cancel it
+    QVERIFY(!scheduler.isRegenerationStale(KisTimeSpan::fromTimeToTime(0, 4)));
+    QVERIFY(!scheduler.isRegenerationStale(KisTimeSpan::fromTimeToTime(6, 10)));
+    QVERIFY(scheduler.isRegenerationStale(KisTimeSpan::fromTimeToTime(3, 7)));
+    QVERIFY(scheduler.isRegenerationStale(KisTimeSpan::infinite(2)));
+
+    scheduler.finishRegeneration();
+    QCOMPARE(scheduler.regeneratedFrame(), -1);
+    QVERIFY(!scheduler.isRegenerationStale(KisTimeSpan::fromTimeToTime(3, 7)));
+}
+
+SIMPLE_TEST_MAIN(KisAnimationPrefetchSchedulerTest)
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISANIMATIONPREFETCHSCHEDULERTEST_H
+#define KISANIMATIONPREFETCHSCHEDULERTEST_H
+
+#include <QObject>
+
+class KisAnimationPrefetchSchedulerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testForwardOrder();
+    void testBackwardOrder();
+    void testFramesLimit();
+    void testMemoryLimit();
+    void testLatestRequestWins();
+    void testStaleRegeneration();
+};
+
+#endif // KISANIMATIONPREFETCHSCHEDULERTEST_H
@@ -67,14 +67,11 @@ bool verifyTestFrame(int frameSeed, const KisFrameDataSerializer::Frame &frame)
 
 
 
-void KisFrameSerializerTest::testFrameDataSerialization()
+void testFrameDataSerializationImpl(KisFrameDataSerializer &serializer)
 {
     KisTextureTileInfoPoolRegistry poolRegistry;
     KisTextureTileInfoPoolSP pool = poolRegistry.getPool(maxTileSize, maxTileSize);
 
-
-    KisFrameDataSerializer serializer;
-
     KisFrameDataSerializer::Frame testFrame1 = generateTestFrame(2, pool);
     KisFrameDataSerializer::Frame testFrame2 = generateTestFrame(3, pool);
     KisFrameDataSerializer::Frame testFrame3 = generateTestFrame(503, pool);
@@ -117,6 +114,64 @@ void KisFrameSerializerTest::testFrameDataSerialization()
     QCOMPARE(serializer.hasFrame(testFrameId1), false);
     QCOMPARE(serializer.hasFrame(testFrameId2), false);
     QCOMPARE(serializer.hasFrame(testFrameId3), false);
+
+    QCOMPARE(serializer.statistics().numFrames, 0);
+    QCOMPARE(serializer.statistics().rawBytes, qint64(0));
+    QCOMPARE(serializer.statistics().storedBytes, qint64(0));
+}
+
+void KisFrameSerializerTest::testFrameDataSerialization()
+{
+    KisFrameDataSerializer serializer;
+    testFrameDataSerializationImpl(serializer);
+}
+
+void KisFrameSerializerTest::testInMemoryFrameDataSerialization()
+{
+    KisFrameDataSerializer serializer(KisFrameDataSerializer::StoreInMemory);
+    testFrameDataSerializationImpl(serializer);
+}
+
+void KisFrameSerializerTest::testInMemoryTileDeduplication()
+{
+    KisTextureTileInfoPoolRegistry poolRegistry;
+    KisTextureTileInfoPoolSP pool = poolRegistry.getPool(maxTileSize, maxTileSize);
+
+    KisFrameDataSerializer serializer(KisFrameDataSerializer::StoreInMemory);
+
+    KisFrameDataSerializer::Frame testFrame1 = generateTestFrame(2, pool);
+    const int numTiles = int(testFrame1.frameTiles.size());
+
+    const int testFrameId1 = serializer.saveFrame(testFrame1);
+
+    KisFrameCacheStatistics stats = serializer.statistics();
+    QCOMPARE(stats.numFrames, 1);
+    QCOMPARE(stats.numTileLookups, qint64(numTiles));
+    QVERIFY(stats.storedBytes > 0);
+    QVERIFY(stats.storedBytes <= stats.rawBytes);
+
+    const qint64 uniqueFrameBytes = stats.storedBytes;
+
+    // the identical frame should reuse all the tiles of the first one
+    KisFrameDataSerializer::Frame testFrame2 = generateTestFrame(2, pool);
+    const int testFrameId2 = serializer.saveFrame(testFrame2);
+
+    stats = serializer.statistics();
+    QCOMPARE(stats.numFrames, 2);
+    QCOMPARE(stats.numTileLookups, qint64(2 * numTiles));
+    QCOMPARE(stats.numTileHits, qint64(numTiles));
+    QCOMPARE(stats.storedBytes, uniqueFrameBytes);
+    QCOMPARE(stats.bytesPerFrame(), uniqueFrameBytes / 2);
+    QVERIFY(qFuzzyCompare(stats.tileHitRate(), 0.5));
+
+    // the shared tiles must survive removal of the first frame
+    serializer.forgetFrame(testFrameId1);
+    QCOMPARE(serializer.statistics().storedBytes, uniqueFrameBytes);
+    QVERIFY(verifyTestFrame(2, serializer.loadFrame(testFrameId2, pool)));
+
+    serializer.forgetFrame(testFrameId2);
+    QCOMPARE(serializer.statistics().numFrames, 0);
+    QCOMPARE(serializer.statistics().storedBytes, qint64(0));
 }
 
 #include "kis_random_source.h"
@@ -15,6 +15,8 @@ class KisFrameSerializerTest : public QObject
 
 private Q_SLOTS:
     void testFrameDataSerialization();
+    void testInMemoryFrameDataSerialization();
+    void testInMemoryTileDeduplication();
     void testFrameUniquenessEstimation();
     void testFrameArithmetics();
 
@@ -0,0 +1,101 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisImagePyramidTest.h"
+
+#include <QDebug>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_paint_device.h>
+#include <kis_paint_layer.h>
+
+#include "canvas/kis_image_pyramid.h"
+
+namespace {
+
+bool compareDevices(KisPaintDeviceSP dev, KisPaintDeviceSP ref, const QRect &rect, int levelOfDetail)
+{
+    KoColor actual(dev->colorSpace());
+    KoColor expected(ref->colorSpace());
+
+    for (int y = rect.top(); y <= rect.bottom(); y++) {
+        for (int x = rect.left(); x <= rect.right(); x++) {
+            dev->pixel(x, y, &actual);
+            ref->pixel(x >> levelOfDetail, y >> levelOfDetail, &expected);
+
+            if (!(actual == expected)) {
+                qWarning() << "Pixels differ at" << x << y << "lod" << levelOfDetail;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+void KisImagePyramidTest::testLodUpscaleAndReread()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect imageRect(0, 0, 128, 128);
+
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "pyramid test");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "layer", OPACITY_OPAQUE_U8);
+    image->addNode(layer);
+
+    // every pixel is different, so a wrong source pixel is noticed
+    for (int y = imageRect.top(); y <= imageRect.bottom(); y++) {
+        for (int x = imageRect.left(); x <= imageRect.right(); x++) {
+            layer->paintDevice()->setPixel(x, y, QColor(x * 2, y * 2, (x + y) % 256));
+        }
+    }
+
+    image->refreshGraphAsync();
+    image->waitForDone();
+
+    KisImagePyramid pyramid(1);
+    pyramid.setMonitorProfile(cs->profile(),
+                              KoColorConversionTransformation::internalRenderingIntent(),
+                              KoColorConversionTransformation::internalConversionFlags());
+    pyramid.setImage(image);
+
+    KisPaintDeviceSP basePlane = pyramid.m_pyramid.first();
+    KisPaintDeviceSP fullResolution = new KisPaintDevice(*basePlane);
+
+    QVERIFY(compareDevices(basePlane, fullResolution, imageRect, 0));
+
+    /**
+     * The image is not in the level of detail mode, so the pyramid reads
+     * the full resolution projection as if it were the Lod plane. That is,
+     * the pixel (x, y) of the preview should be a copy of the pixel
+     * (x >> lod, y >> lod) of the projection.
+     */
+    const int lod = 1;
+    const QRect previewRect(10, 21, 50, 40);
+
+    QCOMPARE(pyramid.updateCache(previewRect, lod), previewRect);
+    QVERIFY(compareDevices(basePlane, fullResolution, previewRect, lod));
+
+    // the rest of the base plane is untouched
+    QVERIFY(compareDevices(basePlane, fullResolution, QRect(64, 64, 64, 64), 0));
+
+    // the first Lod0 update rereads the previewed area as well
+    const QRect lod0Rect(100, 100, 8, 8);
+    const QRect updatedRect = pyramid.updateCache(lod0Rect, 0);
+
+    QVERIFY(updatedRect.contains(previewRect));
+    QVERIFY(updatedRect.contains(lod0Rect));
+    QVERIFY(compareDevices(basePlane, fullResolution, imageRect, 0));
+
+    // and only the first one
+    QCOMPARE(pyramid.updateCache(lod0Rect, 0), lod0Rect);
+}
+
+SIMPLE_TEST_MAIN(KisImagePyramidTest)
@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISIMAGEPYRAMIDTEST_H
+#define KISIMAGEPYRAMIDTEST_H
+
+#include <simpletest.h>
+
+class KisImagePyramidTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testLodUpscaleAndReread();
+};
+
+#endif // KISIMAGEPYRAMIDTEST_H
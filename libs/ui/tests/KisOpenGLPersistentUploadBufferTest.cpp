@@ -0,0 +1,137 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisOpenGLPersistentUploadBufferTest.h"
+
+#include <simpletest.h>
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLFramebufferObject>
+
+#include "opengl/KisOpenGLPersistentUploadBuffer.h"
+#include "opengl/KisOpenGLSync.h"
+#include "opengl/kis_opengl.h"
+
+void KisOpenGLPersistentUploadBufferTest::initTestCase()
+{
+    // probing may switch the current context, so do it beforehand
+    if (!KisOpenGL::supportsFenceSync()) {
+        QSKIP("OpenGL fences are not supported");
+    }
+
+    QSurfaceFormat format;
+    format.setVersion(4, 5);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+
+    m_context.reset(new QOpenGLContext());
+    m_context->setFormat(format);
+
+    if (!m_context->create()) {
+        QSKIP("Cannot create an OpenGL context");
+    }
+
+    m_surface.reset(new QOffscreenSurface());
+    m_surface->setFormat(m_context->format());
+    m_surface->create();
+
+    if (!m_context->makeCurrent(m_surface.data())) {
+        QSKIP("Cannot make the OpenGL context current");
+    }
+
+    KisOpenGLSync::init(m_context.data());
+    if (!KisOpenGLSync::isAvailable()) {
+        QSKIP("OpenGL fences are not available");
+    }
+
+    KisOpenGLPersistentUploadBuffer buffer;
+    if (!buffer.allocate(4096)) {
+        QSKIP("Persistently mapped buffers are not supported");
+    }
+}
+
+void KisOpenGLPersistentUploadBufferTest::cleanupTestCase()
+{
+    if (m_context) {
+        m_context->doneCurrent();
+    }
+}
+
+void KisOpenGLPersistentUploadBufferTest::testUpload()
+{
+    const int size = 32;
+    const int numBytes = size * size * 4;
+
+    QVector<quint8> srcData(numBytes);
+    for (int i = 0; i < numBytes; i++) {
+        srcData[i] = quint8(i * 7 + i / 13);
+    }
+
+    QOpenGLExtraFunctions *f = m_context->extraFunctions();
+
+    QOpenGLFramebufferObject fbo(size, size, QOpenGLFramebufferObject::NoAttachment,
+                                 GL_TEXTURE_2D, GL_RGBA8);
+    QVERIFY(fbo.isValid());
+
+    KisOpenGLPersistentUploadBuffer buffer;
+    QVERIFY(buffer.allocate(4 * numBytes));
+
+    // shift the upload so that it does not start at the beginning of the buffer
+    buffer.beginBatch();
+    QVERIFY(buffer.reserve(100));
+    buffer.endBatch();
+
+    buffer.beginBatch();
+    QVERIFY(buffer.reserve(numBytes));
+
+    f->glBindTexture(GL_TEXTURE_2D, fbo.texture());
+    f->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    buffer.bind();
+    const std::optional<const void*> fd = buffer.append(srcData.constData(), numBytes);
+    QVERIFY(fd.has_value());
+    f->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, *fd);
+    buffer.release();
+
+    buffer.endBatch();
+
+    QVector<quint8> dstData(numBytes);
+
+    QVERIFY(fbo.bind());
+    f->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    f->glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, dstData.data());
+    fbo.release();
+
+    QCOMPARE(dstData, srcData);
+}
+
+void KisOpenGLPersistentUploadBufferTest::testRingReuse()
+{
+    QOpenGLExtraFunctions *f = m_context->extraFunctions();
+
+    KisOpenGLPersistentUploadBuffer buffer;
+    QVERIFY(buffer.allocate(4096));
+
+    // the space of the current batch is never reused
+    buffer.beginBatch();
+    QVERIFY(buffer.reserve(2048));
+    QVERIFY(buffer.reserve(2048));
+    QVERIFY(!buffer.reserve(64));
+    QVERIFY(!buffer.reserve(8192));
+    buffer.endBatch();
+
+    // ...but the space of the finished batches is
+    for (int i = 0; i < 64; i++) {
+        f->glFinish();
+
+        buffer.beginBatch();
+        QVERIFY(buffer.reserve(1000));
+        QVERIFY(buffer.reserve(1000));
+        buffer.endBatch();
+    }
+}
+
+SIMPLE_TEST_MAIN(KisOpenGLPersistentUploadBufferTest)
@@ -0,0 +1,30 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISOPENGLPERSISTENTUPLOADBUFFERTEST_H
+#define KISOPENGLPERSISTENTUPLOADBUFFERTEST_H
+
+#include <QObject>
+#include <QScopedPointer>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+
+class KisOpenGLPersistentUploadBufferTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testUpload();
+    void testRingReuse();
+
+private:
+    QScopedPointer<QOffscreenSurface> m_surface;
+    QScopedPointer<QOpenGLContext> m_context;
+};
+
+#endif // KISOPENGLPERSISTENTUPLOADBUFFERTEST_H
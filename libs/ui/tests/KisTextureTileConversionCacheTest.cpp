@@ -0,0 +1,159 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisTextureTileConversionCacheTest.h"
+
+#include <simpletest.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_paint_device.h"
+#include "opengl/KisTextureTileConversionCache.h"
+#include "opengl/kis_texture_tile_update_info.h"
+
+namespace {
+
+QVector<quint8> randomPixels(int numBytes, int seed)
+{
+    QVector<quint8> data(numBytes);
+    std::srand(uint(seed));
+    for (int i = 0; i < numBytes; i++) {
+        data[i] = quint8(std::rand());
+    }
+    return data;
+}
+
+}
+
+void KisTextureTileConversionCacheTest::testFetchStore()
+{
+    const KoColorSpace *srcCS = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCS = KoColorSpaceRegistry::instance()->rgb16();
+    const KoColorSpace *otherCS = KoColorSpaceRegistry::instance()->lab16();
+
+    const auto intent = KoColorConversionTransformation::IntentPerceptual;
+    const auto flags = KoColorConversionTransformation::BlackpointCompensation;
+
+    const int numPixels = 64 * 64;
+    QVector<quint8> src = randomPixels(numPixels * srcCS->pixelSize(), 1);
+    QVector<quint8> dst(numPixels * dstCS->pixelSize());
+    srcCS->convertPixelsTo(src.constData(), dst.data(), dstCS, numPixels, intent, flags);
+
+    KisTextureTileConversionCache cache;
+    QVector<quint8> result(dst.size());
+
+    KisTextureTileConversionCache::Key key(srcCS, dstCS, intent, flags, src.constData(), src.size());
+    QVERIFY(!cache.fetch(key, result.data(), result.size()));
+
+    cache.store(key, dst.constData(), dst.size());
+    QVERIFY(cache.fetch(key, result.data(), result.size()));
+    QCOMPARE(result, dst);
+
+    // the same content in a different buffer is still a hit
+    QVector<quint8> srcCopy = src;
+    srcCopy.detach();
+    KisTextureTileConversionCache::Key copyKey(srcCS, dstCS, intent, flags, srcCopy.constData(), srcCopy.size());
+    QVERIFY(cache.fetch(copyKey, result.data(), result.size()));
+
+    // different content
+    srcCopy[100] ^= 0xff;
+    KisTextureTileConversionCache::Key changedKey(srcCS, dstCS, intent, flags, srcCopy.constData(), srcCopy.size());
+    QVERIFY(!cache.fetch(changedKey, result.data(), result.size()));
+
+    // different display settings
+    KisTextureTileConversionCache::Key otherSpaceKey(srcCS, otherCS, intent, flags, src.constData(), src.size());
+    QVERIFY(!cache.fetch(otherSpaceKey, result.data(), result.size()));
+
+    KisTextureTileConversionCache::Key otherIntentKey(srcCS, dstCS, KoColorConversionTransformation::IntentSaturation, flags, src.constData(), src.size());
+    QVERIFY(!cache.fetch(otherIntentKey, result.data(), result.size()));
+
+    KisTextureTileConversionCache::Key otherFlagsKey(srcCS, dstCS, intent, KoColorConversionTransformation::Empty, src.constData(), src.size());
+    QVERIFY(!cache.fetch(otherFlagsKey, result.data(), result.size()));
+
+    QCOMPARE(cache.numLookups(), qint64(7));
+    QCOMPARE(cache.numHits(), qint64(2));
+
+    cache.clear();
+    QVERIFY(!cache.fetch(key, result.data(), result.size()));
+}
+
+void KisTextureTileConversionCacheTest::testEviction()
+{
+    const KoColorSpace *srcCS = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCS = KoColorSpaceRegistry::instance()->rgb16();
+
+    const auto intent = KoColorConversionTransformation::IntentPerceptual;
+    const auto flags = KoColorConversionTransformation::Empty;
+
+    // every entry takes 16 + 32 KiB
+    const int numPixels = 64 * 64;
+    KisTextureTileConversionCache cache(4 * 48);
+
+    QVector<QVector<quint8>> sources;
+    QVector<quint8> dst(numPixels * dstCS->pixelSize(), 0);
+
+    for (int i = 0; i < 6; i++) {
+        sources << randomPixels(numPixels * srcCS->pixelSize(), i + 10);
+        KisTextureTileConversionCache::Key key(srcCS, dstCS, intent, flags, sources.last().constData(), sources.last().size());
+        cache.store(key, dst.constData(), dst.size());
+    }
+
+    QVector<quint8> result(dst.size());
+
+    // only the last four entries fit into the cache
+    for (int i = 0; i < 6; i++) {
+        KisTextureTileConversionCache::Key key(srcCS, dstCS, intent, flags, sources[i].constData(), sources[i].size());
+        QCOMPARE(cache.fetch(key, result.data(), result.size()), i >= 2);
+    }
+
+    // too big entries are never stored
+    KisTextureTileConversionCache smallCache(16);
+    KisTextureTileConversionCache::Key key(srcCS, dstCS, intent, flags, sources[0].constData(), sources[0].size());
+    smallCache.store(key, dst.constData(), dst.size());
+    QVERIFY(!smallCache.fetch(key, result.data(), result.size()));
+}
+
+void KisTextureTileConversionCacheTest::testConvertTile()
+{
+    const KoColorSpace *srcCS = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCS = KoColorSpaceRegistry::instance()->lab16();
+
+    const auto intent = KoColorConversionTransformation::IntentPerceptual;
+    const auto flags = KoColorConversionTransformation::BlackpointCompensation;
+
+    KisPaintDeviceSP dev = new KisPaintDevice(srcCS);
+    dev->fill(QRect(0, 0, 64, 64), KoColor(Qt::red, srcCS));
+    dev->fill(QRect(16, 16, 32, 32), KoColor(Qt::blue, srcCS));
+
+    KisTextureTileInfoPoolSP pool(new KisTextureTileInfoPool(64, 64));
+    KisTextureTileConversionCache cache;
+
+    const QRect rc(0, 0, 64, 64);
+
+    KisTextureTileUpdateInfo reference(0, 0, rc, rc, rc, 0, pool);
+    reference.retrieveData(dev, QBitArray(), false, -1);
+    reference.convertTo(dstCS, intent, flags);
+
+    const int numBytes = rc.width() * rc.height() * dstCS->pixelSize();
+
+    for (int i = 0; i < 2; i++) {
+        KisTextureTileUpdateInfo info(0, 0, rc, rc, rc, 0, pool);
+        info.retrieveData(dev, QBitArray(), false, -1);
+        info.convertTo(dstCS, intent, flags, &cache);
+
+        QCOMPARE(info.patchColorSpace(), dstCS);
+        QVERIFY(memcmp(info.data(), reference.data(), size_t(numBytes)) == 0);
+    }
+
+    QCOMPARE(cache.numLookups(), qint64(2));
+    QCOMPARE(cache.numHits(), qint64(1));
+}
+
+SIMPLE_TEST_MAIN(KisTextureTileConversionCacheTest)
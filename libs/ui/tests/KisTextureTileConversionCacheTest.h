@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISTEXTURETILECONVERSIONCACHETEST_H
+#define KISTEXTURETILECONVERSIONCACHETEST_H
+
+#include <QObject>
+
+class KisTextureTileConversionCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testFetchStore();
+    void testEviction();
+    void testConvertTile();
+};
+
+#endif // KISTEXTURETILECONVERSIONCACHETEST_H
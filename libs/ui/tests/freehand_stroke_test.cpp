@@ -16,7 +16,9 @@
 #include "kis_resources_snapshot.h"
 #include "kis_image.h"
 #include "kis_painter.h"
+#include "kis_group_layer.h"
 #include <brushengine/kis_paint_information.h>
+#include <qimage_test_util.h>
 
 #include "testui.h"
 
@@ -140,6 +142,68 @@ void FreehandStrokeTest::testColorSmudgeStroke()
     tester.test();
 }
 
+static QImage paintStrokeWithThreads(const QString &presetFileName, int numThreads)
+{
+    KisImageSP image = utils::createImage(0, QSize(500, 500));
+    image->setWorkingThreadsLimit(numThreads);
+
+    KisNodeSP node = image->rootLayer()->firstChild();
+    node->paintDevice()->fill(QRect(150, 100, 200, 300), KoColor(Qt::red, image->colorSpace()));
+
+    QScopedPointer<KoCanvasResourceProvider> manager(
+        utils::createResourceManager(image, node, presetFileName));
+
+    KisResourcesSnapshotSP resources =
+        new KisResourcesSnapshot(image, node, manager.data());
+
+    KisStrokeId strokeId =
+        image->startStroke(new FreehandStrokeStrategy(resources,
+                                                      new KisFreehandStrokeInfo(),
+                                                      kundo2_noi18n("Freehand Stroke")));
+
+    for (int i = 0; i < 8; i++) {
+        KisPaintInformation pi1(QPointF(100 + 40 * i, 150 + 25 * (i % 2)));
+        KisPaintInformation pi2(QPointF(140 + 40 * i, 150 + 25 * ((i + 1) % 2)));
+
+        image->addJob(strokeId, new FreehandStrokeStrategy::Data(0, pi1, pi2));
+        image->addJob(strokeId, new KisAsynchronousStrokeUpdateHelper::UpdateData(false));
+    }
+
+    image->addJob(strokeId, new KisAsynchronousStrokeUpdateHelper::UpdateData(true));
+    image->endStroke(strokeId);
+    image->waitForDone();
+
+    return node->paintDevice()->convertToQImage(0, image->bounds());
+}
+
+void FreehandStrokeTest::testColorSmudgeStrokeMultithreaded()
+{
+    /**
+     * Every smudge dab reads the canvas written by the previous one,
+     * so rendering the dabs on several threads must not change the
+     * result of the stroke
+     */
+    const QImage singleThreaded = paintStrokeWithThreads("colorsmudge_predefined.kpp", 1);
+    const QImage multiThreaded = paintStrokeWithThreads("colorsmudge_predefined.kpp", 8);
+
+    QPoint errorPoint;
+    QVERIFY(TestUtil::compareQImages(errorPoint, singleThreaded, multiThreaded));
+}
+
+void FreehandStrokeTest::testSketchStrokeMultithreaded()
+{
+    /**
+     * Every sketch segment connects to the points of the segments
+     * painted before it, so rendering the brush masks on several
+     * threads must not change the result of the stroke
+     */
+    const QImage singleThreaded = paintStrokeWithThreads("sketchbrush.kpp", 1);
+    const QImage multiThreaded = paintStrokeWithThreads("sketchbrush.kpp", 8);
+
+    QPoint errorPoint;
+    QVERIFY(TestUtil::compareQImages(errorPoint, singleThreaded, multiThreaded));
+}
+
 void FreehandStrokeTest::testAutoTextured17()
 {
     FreehandStrokeTester tester("auto_textured_17.kpp");
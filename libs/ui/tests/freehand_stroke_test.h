@@ -18,6 +18,8 @@ private Q_SLOTS:
     void testAutoBrushStroke();
     void testHatchingStroke();
     void testColorSmudgeStroke();
+    void testColorSmudgeStrokeMultithreaded();
+    void testSketchStrokeMultithreaded();
     void testAutoTextured17();
     void testAutoTextured38();
     void testMixDullCompositing();
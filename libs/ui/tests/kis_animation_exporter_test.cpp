@@ -7,6 +7,10 @@
 #include "kis_animation_exporter_test.h"
 
 #include "dialogs/KisAsyncAnimationFramesSaveDialog.h"
+#include "dialogs/KisAsyncAnimationFramesStreamDialog.h"
+#include "KisAnimationRawFrameStream.h"
+#include "animation/KisAnimationRenderingOptions.h"
+#include "animation/KisVideoSaver.h"
 
 #include <simpletest.h>
 #include <testutil.h>
@@ -20,6 +24,9 @@
 #include "kis_keyframe_channel.h"
 #include <testui.h>
 
+#include <QFile>
+#include <QTemporaryDir>
+
 void KisAnimationExporterTest::testAnimationExport()
 {
     KisDocument *document = KisPart::instance()->createDocument();
@@ -87,4 +94,251 @@ void KisAnimationExporterTest::testAnimationExport()
     }
 }
 
+void KisAnimationExporterTest::testRawFrameStreamOrder()
+{
+    QList<QByteArray> writtenFrames;
+
+    // a stand-in for the encoder process
+    KisAnimationRawFrameStream stream(KisTimeSpan::fromTimeToTime(0, 5),
+                                      [&writtenFrames] (const QByteArray &data) {
+                                          writtenFrames.append(data);
+                                          return true;
+                                      });
+
+    // the frames come in random order, frame 3 is held for two frames
+    stream.addFrame(3, "3", 2);
+    stream.addFrame(1, "1");
+    QVERIFY(writtenFrames.isEmpty());
+
+    // the next frame in order is written right away, along with the queued ones
+    stream.addFrame(0, "0");
+    QCOMPARE(writtenFrames, QList<QByteArray>({"0", "1"}));
+
+    stream.addFrame(5, "5");
+    QVERIFY(!stream.isComplete());
+
+    stream.addFrame(2, "2");
+    QCOMPARE(writtenFrames, QList<QByteArray>({"0", "1", "2", "3", "3", "5"}));
+    QVERIFY(stream.isComplete());
+    QVERIFY(!stream.hasFailed());
+}
+
+void KisAnimationExporterTest::testRawFrameStreamCancel()
+{
+    QList<QByteArray> writtenFrames;
+
+    KisAnimationRawFrameStream stream(KisTimeSpan::fromTimeToTime(0, 2),
+                                      [&writtenFrames] (const QByteArray &data) {
+                                          writtenFrames.append(data);
+                                          return true;
+                                      });
+
+    stream.addFrame(1, "1");
+    stream.cancel();
+
+    // the queued frame is dropped and the new ones are ignored
+    stream.addFrame(0, "0");
+    stream.addFrame(2, "2");
+
+    QVERIFY(writtenFrames.isEmpty());
+    QVERIFY(!stream.isComplete());
+    QVERIFY(!stream.hasFailed());
+}
+
+namespace {
+
+struct AnimatedImage
+{
+    AnimatedImage(const QRect &rect, int numFrames)
+        : document(KisPart::instance()->createDocument()),
+          p(rect)
+    {
+        document->setCurrentImage(p.image);
+        const KoColorSpace *cs = p.image->colorSpace();
+
+        KUndo2Command parentCommand;
+
+        p.layer->enableAnimation();
+        KisKeyframeChannel *rasterChannel = p.layer->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+
+        for (int i = 1; i < numFrames; i++) {
+            rasterChannel->addKeyframe(i, &parentCommand);
+        }
+        p.image->animationInterface()->setDocumentRange(KisTimeSpan::fromTimeToTime(0, numFrames - 1));
+
+        KisPaintDeviceSP dev = p.layer->paintDevice();
+
+        for (int i = 0; i < numFrames; i++) {
+            p.image->animationInterface()->switchCurrentTimeAsync(i);
+            p.image->waitForDone();
+
+            dev->fill(QRect(10 * i, 0, rect.width() - 10 * i, rect.height()),
+                      KoColor(QColor::fromHsv(i * 360 / numFrames, 255, 255), cs));
+            frames.append(KisAnimationRawFrameStream::rawFrameData(dev, rect));
+        }
+    }
+
+    QScopedPointer<KisDocument> document;
+    TestUtil::MaskParent p;
+    QList<QByteArray> frames;
+};
+
+}
+
+void KisAnimationExporterTest::testAnimationStreamExport()
+{
+    const QRect rect(0, 0, 512, 512);
+    AnimatedImage image(rect, 3);
+
+    // frame 3 is held from frame 2
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(0, 3);
+    QList<QByteArray> writtenFrames;
+
+    KisAnimationRawFrameStream stream(range,
+                                      [&writtenFrames] (const QByteArray &data) {
+                                          writtenFrames.append(data);
+                                          return true;
+                                      });
+
+    KisAsyncAnimationFramesStreamDialog exporter(image.document->image(), range, &stream);
+    exporter.setBatchMode(true);
+    QCOMPARE(exporter.regenerateRange(0), KisAsyncAnimationRenderDialogBase::RenderComplete);
+
+    QVERIFY(stream.isComplete());
+    QCOMPARE(writtenFrames.size(), 4);
+    QCOMPARE(writtenFrames[0], image.frames[0]);
+    QCOMPARE(writtenFrames[1], image.frames[1]);
+    QCOMPARE(writtenFrames[2], image.frames[2]);
+    QCOMPARE(writtenFrames[3], image.frames[2]);
+}
+
+void KisAnimationExporterTest::testStreamEncoderProcess()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("The stand-in encoder is a shell script");
+#else
+    const QRect rect(0, 0, 64, 48);
+    AnimatedImage image(rect, 3);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // a stand-in for ffmpeg that saves its arguments and its standard
+    // input next to the output file, which is always the last argument
+    const QString encoderPath = dir.filePath("fake-ffmpeg.sh");
+    {
+        QFile script(encoderPath);
+        QVERIFY(script.open(QIODevice::WriteOnly));
+        script.write("#!/bin/sh\n"
+                     "for output; do :; done\n"
+                     "printf '%s\\n' \"$@\" > \"$output.args\"\n"
+                     "cat > \"$output\"\n");
+        script.close();
+        script.setPermissions(script.permissions() | QFileDevice::ExeOwner);
+    }
+
+    KisAnimationRenderingOptions options;
+    options.ffmpegPath = encoderPath;
+    options.videoFileName = dir.filePath("result.mkv");
+    options.firstFrame = 0;
+    options.lastFrame = 3;
+    options.frameRate = 24;
+    options.width = rect.width();
+    options.height = rect.height();
+    options.customFFMpegOptions = "-c:v libx264";
+
+    KisAnimationVideoSaver encoder(image.document.data(), true);
+    QVERIFY(encoder.startStreamEncoding(options, rect.size()).isOk());
+
+    // frame 3 is held from frame 2
+    for (int i = 0; i <= options.lastFrame; i++) {
+        QVERIFY(encoder.writeStreamFrame(image.frames[qMin(i, 2)]));
+    }
+
+    QVERIFY(encoder.finishStreamEncoding().isOk());
+
+    QFile result(options.videoFileName);
+    QVERIFY(result.open(QIODevice::ReadOnly));
+    QCOMPARE(result.size(), 4 * qint64(image.frames[0].size()));
+    QCOMPARE(result.read(image.frames[0].size()), image.frames[0]);
+
+    QFile argsFile(options.videoFileName + ".args");
+    QVERIFY(argsFile.open(QIODevice::ReadOnly));
+    const QStringList args = QString::fromUtf8(argsFile.readAll()).trimmed().split('\n');
+
+    const QStringList inputArgs = {"-f", "rawvideo", "-pix_fmt", "bgra", "-s", "64x48", "-i", "-"};
+    const int inputIndex = args.indexOf("rawvideo") - 1;
+    QVERIFY(inputIndex >= 0);
+    QCOMPARE(args.mid(inputIndex, inputArgs.size()), inputArgs);
+
+    // the frame rate goes before the input, the encoder options after it
+    QVERIFY(args.indexOf("-r") < inputIndex);
+    QCOMPARE(args[args.indexOf("-r") + 1], QString("24"));
+    QVERIFY(args.indexOf("libx264") > inputIndex);
+    QCOMPARE(args.last(), options.videoFileName);
+
+    // a failing encoder is reported when the stream is closed
+    {
+        QFile script(encoderPath);
+        QVERIFY(script.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        script.write("#!/bin/sh\n"
+                     "cat > /dev/null\n"
+                     "exit 1\n");
+    }
+
+    KisAnimationVideoSaver failingEncoder(image.document.data(), true);
+    QVERIFY(failingEncoder.startStreamEncoding(options, rect.size()).isOk());
+    QVERIFY(failingEncoder.writeStreamFrame(image.frames[0]));
+    QVERIFY(!failingEncoder.finishStreamEncoding().isOk());
+
+    // an encoder that cannot be started is reported right away
+    {
+        QFile script(encoderPath);
+        script.setPermissions(script.permissions() & ~(QFileDevice::ExeOwner | QFileDevice::ExeUser));
+    }
+
+    image.document->setErrorMessage(QString());
+
+    KisAnimationVideoSaver brokenEncoder(image.document.data(), true);
+    QVERIFY(!brokenEncoder.startStreamEncoding(options, rect.size()).isOk());
+    QVERIFY(!image.document->errorMessage().isEmpty());
+#endif
+}
+
+void KisAnimationExporterTest::benchmarkSequenceExport()
+{
+    const QRect rect(0, 0, 2048, 2048);
+    AnimatedImage image(rect, 10);
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(0, 9);
+
+    QBENCHMARK_ONCE {
+        KisAsyncAnimationFramesSaveDialog exporter(image.document->image(),
+                                                   range,
+                                                   "export-benchmark.png",
+                                                   0,
+                                                   false,
+                                                   0);
+        exporter.setBatchMode(true);
+        exporter.regenerateRange(0);
+    }
+
+    for (int i = 0; i <= range.end(); i++) {
+        QFile::remove(QString("export-benchmark%1.png").arg(i, 4, 10, QChar('0')));
+    }
+}
+
+void KisAnimationExporterTest::benchmarkStreamExport()
+{
+    const QRect rect(0, 0, 2048, 2048);
+    AnimatedImage image(rect, 10);
+    const KisTimeSpan range = KisTimeSpan::fromTimeToTime(0, 9);
+
+    QBENCHMARK_ONCE {
+        KisAnimationRawFrameStream stream(range, [] (const QByteArray &) { return true; });
+        KisAsyncAnimationFramesStreamDialog exporter(image.document->image(), range, &stream);
+        exporter.setBatchMode(true);
+        exporter.regenerateRange(0);
+    }
+}
+
 KISTEST_MAIN(KisAnimationExporterTest)
@@ -15,6 +15,13 @@ class KisAnimationExporterTest : public QObject
 
 private Q_SLOTS:
     void testAnimationExport();
+    void testRawFrameStreamOrder();
+    void testRawFrameStreamCancel();
+    void testStreamEncoderProcess();
+    void testAnimationStreamExport();
+
+    void benchmarkSequenceExport();
+    void benchmarkStreamExport();
 
 };
 #endif
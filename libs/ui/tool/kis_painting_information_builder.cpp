@@ -126,6 +126,7 @@ KisPaintInformation KisPaintingInformationBuilder::createPaintingInformation(KoP
     pi.setCanvasRotation(canvasRotation());
     pi.setCanvasMirroredH(canvasMirroredX());
     pi.setCanvasMirroredV(canvasMirroredY());
+    pi.setInputTimestamp(event->receivedTimestamp());
 
     return pi;
 }
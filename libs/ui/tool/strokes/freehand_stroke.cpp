@@ -17,6 +17,7 @@
 #include "kis_paintop.h"
 
 #include "kis_update_time_monitor.h"
+#include "KisInputLatencyTracker.h"
 
 #include <brushengine/kis_stroke_random_source.h>
 #include <KisRunnableStrokeJobsInterface.h>
@@ -212,6 +213,9 @@ void FreehandStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
             break;
         };
 
+        KisInputLatencyTracker::instance()->notifyDabPainted(
+            qMax(d->pi1.inputTimestamp(), d->pi2.inputTimestamp()));
+
         tryDoUpdate();
     } else {
         KisPainterBasedStrokeStrategy::doStrokeCallback(data);
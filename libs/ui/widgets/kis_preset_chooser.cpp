@@ -85,31 +85,24 @@ void KisPresetDelegate::paint(QPainter * painter, const QStyleOptionViewItem & o
 
     bool dirty = index.data(Qt::UserRole + KisAbstractResourceModel::Dirty).toBool();
 
-    QImage preview = KisResourceThumbnailCache::instance()->getImage(index);
-
-    if (preview.isNull()) {
-        preview = QImage(512, 512, QImage::Format_RGB32);
-        preview.fill(Qt::red);
-    }
-
     qreal devicePixelRatioF = painter->device()->devicePixelRatioF();
 
     QRect paintRect = option.rect.adjusted(1, 1, -1, -1);
     if (!m_showText) {
         QImage previewHighDpi =
-            KisResourceThumbnailCache::instance()->getImage(index,
-                                                             paintRect.size() * devicePixelRatioF,
-                                                             Qt::IgnoreAspectRatio,
-                                                             Qt::SmoothTransformation);
+            KisResourceThumbnailCache::instance()->getImageLazily(index,
+                                                                   paintRect.size() * devicePixelRatioF,
+                                                                   Qt::IgnoreAspectRatio,
+                                                                   Qt::SmoothTransformation);
         previewHighDpi.setDevicePixelRatio(devicePixelRatioF);
         painter->drawImage(paintRect.x(), paintRect.y(), previewHighDpi);
     }
     else {
         QSize pixSize(paintRect.height(), paintRect.height());
-        QImage previewHighDpi = KisResourceThumbnailCache::instance()->getImage(index,
-                                                                                 pixSize * devicePixelRatioF,
-                                                                                 Qt::KeepAspectRatio,
-                                                                                 Qt::SmoothTransformation);
+        QImage previewHighDpi = KisResourceThumbnailCache::instance()->getImageLazily(index,
+                                                                                       pixSize * devicePixelRatioF,
+                                                                                       Qt::KeepAspectRatio,
+                                                                                       Qt::SmoothTransformation);
         previewHighDpi.setDevicePixelRatio(devicePixelRatioF);
         painter->drawImage(paintRect.x(), paintRect.y(), previewHighDpi);
 
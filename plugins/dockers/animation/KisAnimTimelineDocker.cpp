@@ -16,6 +16,7 @@
 #include "QToolButton"
 #include "QMenu"
 #include "QWidgetAction"
+#include <KFormat>
 
 #include "krita_utils.h"
 #include "kis_canvas2.h"
@@ -500,6 +501,10 @@ void KisAnimTimelineDocker::updatePlaybackStatistics()
     qreal effectiveFps = 0.0;
     qreal realFps = 0.0;
     qreal framesDropped = 0.0;
+    qreal cacheHitRate = 0.0;
+    qint64 cacheBytesPerFrame = 0;
+    qreal cacheCompressionRatio = 1.0;
+    qreal regenerationLatency = 0.0;
     bool isPlaying = false;
 
     {
@@ -507,6 +512,10 @@ void KisAnimTimelineDocker::updatePlaybackStatistics()
         effectiveFps = stats.expectedFps;
         realFps = stats.realFps;
         framesDropped = stats.droppedFramesPortion;
+        cacheHitRate = stats.cacheHitRate;
+        cacheBytesPerFrame = stats.cacheBytesPerFrame;
+        cacheCompressionRatio = stats.cacheCompressionRatio;
+        regenerationLatency = stats.regenerationLatency;
         isPlaying = effectiveFps > 0.0;
     }
 
@@ -528,12 +537,20 @@ void KisAnimTimelineDocker::updatePlaybackStatistics()
         actionText = QString("%1 (%2)\n"
                        "%3\n"
                        "%4\n"
-                       "%5")
+                       "%5\n"
+                       "%6\n"
+                       "%7\n"
+                       "%8\n"
+                       "%9")
             .arg(KisAnimUtils::dropFramesActionName)
             .arg(KritaUtils::toLocalizedOnOff(shouldDropFrames))
                          .arg(i18n("Effective FPS:\t%1", QString::number(effectiveFps, 'f', 1)))
             .arg(i18n("Real FPS:\t%1", QString::number(realFps, 'f', 1)))
-            .arg(i18n("Frames dropped:\t%1\%", QString::number(framesDropped * 100, 'f', 1)));
+            .arg(i18n("Frames dropped:\t%1\%", QString::number(framesDropped * 100, 'f', 1)))
+            .arg(i18n("Cache hits:\t%1\%", QString::number(cacheHitRate * 100, 'f', 1)))
+            .arg(i18n("Cache per frame:\t%1", KFormat().formatByteSize(cacheBytesPerFrame)))
+            .arg(i18n("Cache compression:\t%1x", QString::number(cacheCompressionRatio, 'f', 1)))
+            .arg(i18n("Frame regeneration:\t%1 ms", QString::number(regenerationLatency, 'f', 0)));
     }
 
     /**
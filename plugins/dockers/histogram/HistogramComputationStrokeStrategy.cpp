@@ -9,7 +9,9 @@
 #include "KoColorSpace.h"
 
 #include "krita_utils.h"
+#include "kis_datamanager.h"
 #include "kis_image.h"
+#include "kis_paint_device.h"
 #include "kis_sequential_iterator.h"
 
 struct HistogramComputationStrokeStrategy::Private
@@ -28,35 +30,128 @@ struct HistogramComputationStrokeStrategy::Private
         int jobId; // id in the list of results
     };
 
+    struct PatchUpdate
+    {
+        int patchIndex;
+        quint64 maxTileRevision;
+        int numTiles;
+    };
+
     KisImageSP image;
+    HistogramCacheSP cache;
+
+    /// the patches of the cache being recalculated and their new histograms
+    QVector<PatchUpdate> updates;
     std::vector<HistVector> results;
 };
 
 
-HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image)
+HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image, HistogramCacheSP cache)
     : KisIdleTaskStrokeStrategy(QLatin1String("ComputeHistogram"), kundo2_i18n("Update histogram"))
     , m_d(new Private)
 {
     m_d->image = image;
+    m_d->cache = cache;
 }
 
 HistogramComputationStrokeStrategy::~HistogramComputationStrokeStrategy()
 {
 }
 
+void HistogramComputationStrokeStrategy::resetCache(KisPaintDeviceSP device)
+{
+    HistogramCache &cache = *m_d->cache;
+
+    cache.colorSpace = device->colorSpace();
+    cache.defaultPixel = device->defaultPixel();
+    cache.bounds = m_d->image->bounds();
+    cache.deviceOffset = QPoint(device->x(), device->y());
+    cache.patchSize = KritaUtils::optimalPatchSize();
+    cache.numColumns = (cache.bounds.width() + cache.patchSize.width() - 1) / cache.patchSize.width();
+
+    const int numRows = (cache.bounds.height() + cache.patchSize.height() - 1) / cache.patchSize.height();
+
+    cache.patches.clear();
+    cache.patches.resize(cache.numColumns * numRows);
+
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < cache.numColumns; col++) {
+            const QRect rect(cache.bounds.x() + col * cache.patchSize.width(),
+                             cache.bounds.y() + row * cache.patchSize.height(),
+                             cache.patchSize.width(), cache.patchSize.height());
+
+            cache.patches[row * cache.numColumns + col].rect = rect & cache.bounds;
+        }
+    }
+
+    initiateVector(cache.bins, cache.colorSpace);
+}
+
 void HistogramComputationStrokeStrategy::initStrokeCallback()
 {
     KisIdleTaskStrokeStrategy::initStrokeCallback();
 
+    KisPaintDeviceSP dev = m_d->image->projection();
+    HistogramCache &cache = *m_d->cache;
+
+    if (cache.colorSpace != dev->colorSpace() ||
+        cache.defaultPixel != dev->defaultPixel() ||
+        cache.bounds != m_d->image->bounds() ||
+        cache.deviceOffset != QPoint(dev->x(), dev->y()) ||
+        cache.patchSize != KritaUtils::optimalPatchSize()) {
+
+        resetCache(dev);
+    }
+
+    /**
+     * Collect the signatures of the patches. The signature is taken
+     * before the pixels are read, so if the image changes while the
+     * histogram is being calculated, the patch will just be
+     * recalculated the next time.
+     */
+    QVector<quint64> maxTileRevisions(cache.patches.size(), 0);
+    QVector<int> numTiles(cache.patches.size(), 0);
+
+    const int tileSize = KisTileData::WIDTH;
+    const QVector<KisTiledDataManager::TileRevision> revisions = dev->dataManager()->tileRevisions();
+
+    Q_FOREACH (const KisTiledDataManager::TileRevision &tile, revisions) {
+        const QRect tileRect =
+            QRect(tile.col * tileSize + dev->x(), tile.row * tileSize + dev->y(), tileSize, tileSize) &
+            cache.bounds;
+
+        if (tileRect.isEmpty()) continue;
+
+        const QPoint topLeft = tileRect.topLeft() - cache.bounds.topLeft();
+        const QPoint bottomRight = tileRect.bottomRight() - cache.bounds.topLeft();
+
+        for (int row = topLeft.y() / cache.patchSize.height(); row <= bottomRight.y() / cache.patchSize.height(); row++) {
+            for (int col = topLeft.x() / cache.patchSize.width(); col <= bottomRight.x() / cache.patchSize.width(); col++) {
+                const int index = row * cache.numColumns + col;
+                maxTileRevisions[index] = qMax(maxTileRevisions[index], tile.revision);
+                numTiles[index]++;
+            }
+        }
+    }
+
     QVector<KisStrokeJobData*> jobsData;
-    int i = 0;
-    QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(m_d->image->bounds(), KritaUtils::optimalPatchSize());
-    m_d->results.resize(tileRects.size());
 
-    Q_FOREACH (const QRect &tileRectangle, tileRects) {
-        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileRectangle, i);
-        i++;
+    for (int i = 0; i < cache.patches.size(); i++) {
+        const HistogramCache::Patch &patch = cache.patches[i];
+
+        if (patch.isValid &&
+            patch.maxTileRevision == maxTileRevisions[i] &&
+            patch.numTiles == numTiles[i]) {
+
+            continue;
+        }
+
+        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(patch.rect, m_d->updates.size());
+        m_d->updates.append({i, maxTileRevisions[i], numTiles[i]});
     }
+
+    cache.numUpdatedPatches = m_d->updates.size();
+    m_d->results.resize(m_d->updates.size());
     addMutatedJobs(jobsData);
 }
 
@@ -81,12 +176,19 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
     int imageSize = imageBounds.width() * imageBounds.height();
     int nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
 
+    HistVector &result = m_d->results[d_pd->jobId];
+    initiateVector(result, cs);
+
     if (calculate.isEmpty())
         return;
 
-    initiateVector(m_d->results[d_pd->jobId], cs);
+    std::vector<quint32*> bins(channelCount);
+    for (quint32 chan = 0; chan < channelCount; ++chan) {
+        bins[chan] = result[chan].data();
+    }
 
-    quint32 toSkip = nSkip;
+    // the position of the next sampled pixel, counting from 1
+    int toSkip = nSkip;
 
     KisSequentialConstIterator it(m_dev, calculate);
 
@@ -94,47 +196,56 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
     while (it.nextPixels(numConseqPixels)) {
 
         numConseqPixels = it.nConseqPixels();
-        const quint8* pixel = it.rawDataConst();
-        for (int k = 0; k < numConseqPixels; ++k) {
-            if (--toSkip == 0) {
-                for (int chan = 0; chan < (int)channelCount; ++chan) {
-                    m_d->results[d_pd->jobId][chan][cs->scaleToU8(pixel, chan)]++;
-                }
-                toSkip = nSkip;
-            }
-            pixel += pixelSize;
+
+        if (toSkip > numConseqPixels) {
+            toSkip -= numConseqPixels;
+            continue;
         }
+
+        const int first = toSkip - 1;
+        const int numSampled = (numConseqPixels - first + nSkip - 1) / nSkip;
+
+        cs->addPixelsToHistogramU8(it.rawDataConst() + first * pixelSize,
+                                   numConseqPixels - first, nSkip, bins.data());
+
+        toSkip = first + numSampled * nSkip - numConseqPixels + 1;
     }
 }
 
 void HistogramComputationStrokeStrategy::finishStrokeCallback()
 {
-    HistogramData hisData;
-    hisData.colorSpace = m_d->image->projection()->colorSpace();
+    HistogramCache &cache = *m_d->cache;
+    const int channelCount = cache.colorSpace->channelCount();
 
-    if (m_d->results.size() == 1) {
-        hisData.bins = m_d->results[0];
-        emit computationResultReady(hisData);
-    } else {
+    for (int i = 0; i < m_d->updates.size(); i++) {
+        const Private::PatchUpdate &update = m_d->updates[i];
+        HistogramCache::Patch &patch = cache.patches[update.patchIndex];
+        const HistVector &newBins = m_d->results[i];
 
-        quint32 channelCount = m_d->image->projection()->channelCount();
-
-        initiateVector(hisData.bins, hisData.colorSpace);
-
-        for (int chan = 0; chan < (int)channelCount; chan++) {
-            int bsize = hisData.bins[chan].size();
+        for (int chan = 0; chan < channelCount; chan++) {
+            std::vector<quint32> &totalBins = cache.bins[chan];
+            const int bsize = totalBins.size();
 
             for (int bi = 0; bi < bsize; bi++) {
-                hisData.bins[chan][bi] = 0;
-                for (int i = 0; i < (int)m_d->results.size(); i++) {
-                    hisData.bins[chan][bi] += m_d->results[i][chan][bi];
+                if (patch.isValid) {
+                    totalBins[bi] -= patch.bins[chan][bi];
                 }
+                totalBins[bi] += newBins[chan][bi];
             }
         }
 
-        emit computationResultReady(hisData);
+        patch.bins = newBins;
+        patch.isValid = true;
+        patch.maxTileRevision = update.maxTileRevision;
+        patch.numTiles = update.numTiles;
     }
 
+    HistogramData hisData;
+    hisData.colorSpace = cache.colorSpace;
+    hisData.bins = cache.bins;
+
+    emit computationResultReady(hisData);
+
     KisIdleTaskStrokeStrategy::finishStrokeCallback();
 }
 
@@ -142,6 +253,6 @@ void HistogramComputationStrokeStrategy::initiateVector(HistVector &vec, const K
 {
     vec.resize(colorSpace->channelCount());
     for (auto &bin : vec) {
-        bin.resize(std::numeric_limits<quint8>::max() + 1);
+        bin.assign(std::numeric_limits<quint8>::max() + 1, 0);
     }
 }
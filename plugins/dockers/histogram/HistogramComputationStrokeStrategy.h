@@ -10,6 +10,12 @@
 #include <KisIdleTaskStrokeStrategy.h>
 #include <vector>
 
+#include <QRect>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <KoColor.h>
+
 class KoColorSpace;
 
 
@@ -22,12 +28,52 @@ struct HistogramData
 };
 Q_DECLARE_METATYPE(HistogramData)
 
+/**
+ * The histograms of the patches of the image kept between the strokes.
+ * A patch is recalculated only when some of its tiles have been changed,
+ * added or removed since the previous stroke, then its old histogram is
+ * subtracted from the total and the new one is added.
+ */
+struct HistogramCache
+{
+    struct Patch
+    {
+        QRect rect;
+        HistVector bins;
+
+        /// the tiles of the patch are unchanged if neither the number
+        /// of tiles nor their newest revision has changed, because
+        /// the 64-bit revisions of the tiles only grow
+        bool isValid {false};
+        quint64 maxTileRevision {0};
+        int numTiles {0};
+    };
+
+    const KoColorSpace *colorSpace {0};
+    KoColor defaultPixel;
+    QRect bounds;
+    QPoint deviceOffset;
+    QSize patchSize;
+    int numColumns {0};
+
+    QVector<Patch> patches;
+
+    /// the sum of the histograms of all the valid patches
+    HistVector bins;
+
+    /// the number of patches recalculated by the last stroke,
+    /// used in unittests
+    int numUpdatedPatches {0};
+};
+
+using HistogramCacheSP = QSharedPointer<HistogramCache>;
+
 
 class HistogramComputationStrokeStrategy : public KisIdleTaskStrokeStrategy
 {
     Q_OBJECT
 public:
-    HistogramComputationStrokeStrategy(KisImageSP image);
+    HistogramComputationStrokeStrategy(KisImageSP image, HistogramCacheSP cache);
     ~HistogramComputationStrokeStrategy() override;
 
 private:
@@ -36,6 +82,7 @@ private:
     void finishStrokeCallback() override;
 
     void initiateVector(HistVector &vec, const KoColorSpace* colorSpace);
+    void resetCache(KisPaintDeviceSP device);
 
 Q_SIGNALS:
     //Emitted when thumbnail is updated and overviewImage is fully generated.
@@ -35,6 +35,7 @@ private:
 
 private:
     HistVector m_histogramData;
+    HistogramCacheSP m_histogramCache;
     const KoColorSpace* m_colorSpace {0};
     bool m_smoothHistogram {false};
 };
@@ -0,0 +1,147 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "HistogramComputationStrokeStrategyTest.h"
+
+#include <simpletest.h>
+
+#include <KoColor.h>
+#include <KoColorConversionTransformation.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_paint_device.h>
+#include <kis_paint_layer.h>
+#include <kis_sequential_iterator.h>
+
+#include "HistogramComputationStrokeStrategy.h"
+
+namespace {
+
+/// the image is smaller than 1M pixels, so every pixel is sampled
+const QRect imageRect(0, 0, 1000, 1000);
+
+HistogramData computeHistogram(KisImageSP image, HistogramCacheSP cache)
+{
+    HistogramComputationStrokeStrategy *strategy = new HistogramComputationStrokeStrategy(image, cache);
+
+    HistogramData result;
+    QObject::connect(strategy, &HistogramComputationStrokeStrategy::computationResultReady,
+                     [&result] (HistogramData data) { result = data; });
+
+    KisStrokeId id = image->startStroke(strategy);
+    image->endStroke(id);
+    image->waitForDone();
+
+    return result;
+}
+
+HistVector referenceHistogram(KisPaintDeviceSP dev, const QRect &rect)
+{
+    const KoColorSpace *cs = dev->colorSpace();
+    HistVector bins(cs->channelCount(), std::vector<quint32>(256, 0));
+
+    KisSequentialConstIterator it(dev, rect);
+    while (it.nextPixel()) {
+        for (quint32 c = 0; c < cs->channelCount(); c++) {
+            bins[c][cs->scaleToU8(it.rawDataConst(), c)]++;
+        }
+    }
+
+    return bins;
+}
+
+KisImageSP createImage(KisPaintLayerSP *layer)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "histogram test");
+
+    *layer = new KisPaintLayer(image, "layer", OPACITY_OPAQUE_U8);
+    image->addNode(*layer);
+
+    (*layer)->paintDevice()->fill(QRect(100, 100, 600, 300), KoColor(Qt::red, cs));
+    image->refreshGraphAsync();
+    image->waitForDone();
+
+    return image;
+}
+
+}
+
+void HistogramComputationStrokeStrategyTest::testIncrementalUpdate()
+{
+    KisPaintLayerSP layer;
+    KisImageSP image = createImage(&layer);
+
+    HistogramCacheSP cache(new HistogramCache());
+
+    HistogramData data = computeHistogram(image, cache);
+    const int numPatches = cache->patches.size();
+    QVERIFY(numPatches > 1);
+    QCOMPARE(cache->numUpdatedPatches, numPatches);
+    QCOMPARE(data.colorSpace, image->projection()->colorSpace());
+    QVERIFY(data.bins == referenceHistogram(image->projection(), imageRect));
+
+    // nothing has changed, so nothing is recalculated
+    data = computeHistogram(image, cache);
+    QCOMPARE(cache->numUpdatedPatches, 0);
+    QVERIFY(data.bins == referenceHistogram(image->projection(), imageRect));
+
+    // the change is inside a single patch: its old histogram should be
+    // subtracted from the total and the new one added
+    layer->paintDevice()->fill(QRect(10, 10, 20, 20), KoColor(Qt::green, layer->colorSpace()));
+    layer->setDirty(QRect(10, 10, 20, 20));
+    image->waitForDone();
+
+    data = computeHistogram(image, cache);
+    QCOMPARE(cache->numUpdatedPatches, 1);
+    QVERIFY(data.bins == referenceHistogram(image->projection(), imageRect));
+
+    // clearing removes the tiles of the projection, which is detected too
+    layer->paintDevice()->clear(QRect(100, 100, 600, 300));
+    layer->setDirty(QRect(100, 100, 600, 300));
+    image->waitForDone();
+
+    data = computeHistogram(image, cache);
+    QVERIFY(cache->numUpdatedPatches > 0);
+    QVERIFY(cache->numUpdatedPatches < numPatches);
+    QVERIFY(data.bins == referenceHistogram(image->projection(), imageRect));
+}
+
+void HistogramComputationStrokeStrategyTest::testCacheReset()
+{
+    KisPaintLayerSP layer;
+    KisImageSP image = createImage(&layer);
+
+    HistogramCacheSP cache(new HistogramCache());
+
+    computeHistogram(image, cache);
+    const int numPatches = cache->patches.size();
+
+    // the histograms of another color space cannot be reused
+    const KoColorSpace *rgb16 = KoColorSpaceRegistry::instance()->rgb16();
+    image->convertImageColorSpace(rgb16,
+                                  KoColorConversionTransformation::internalRenderingIntent(),
+                                  KoColorConversionTransformation::internalConversionFlags());
+    image->waitForDone();
+
+    HistogramData data = computeHistogram(image, cache);
+    QCOMPARE(data.colorSpace, rgb16);
+    QCOMPARE(cache->numUpdatedPatches, numPatches);
+    QVERIFY(data.bins == referenceHistogram(image->projection(), imageRect));
+
+    // the bounds of the image have changed
+    const QRect newImageRect(0, 0, 700, 500);
+    image->resizeImage(newImageRect);
+    image->waitForDone();
+
+    data = computeHistogram(image, cache);
+    QCOMPARE(cache->numUpdatedPatches, cache->patches.size());
+    QVERIFY(data.bins == referenceHistogram(image->projection(), newImageRect));
+}
+
+SIMPLE_TEST_MAIN(HistogramComputationStrokeStrategyTest)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef HISTOGRAMCOMPUTATIONSTROKESTRATEGYTEST_H
+#define HISTOGRAMCOMPUTATIONSTROKESTRATEGYTEST_H
+
+#include <QObject>
+
+class HistogramComputationStrokeStrategyTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testIncrementalUpdate();
+    void testCacheReset();
+};
+
+#endif // HISTOGRAMCOMPUTATIONSTROKESTRATEGYTEST_H
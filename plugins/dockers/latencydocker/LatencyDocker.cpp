@@ -0,0 +1,60 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "LatencyDocker.h"
+
+#include <kpluginfactory.h>
+#include <klocalizedstring.h>
+
+#include <KoDockFactoryBase.h>
+#include <KoDockRegistry.h>
+
+#include "LatencyDockerDock.h"
+
+K_PLUGIN_FACTORY_WITH_JSON(LatencyDockerPluginFactory,
+                           "krita_latencydocker.json",
+                           registerPlugin<LatencyDockerPlugin>();)
+
+class LatencyDockerDockFactory : public KoDockFactoryBase {
+public:
+    LatencyDockerDockFactory()
+    {
+    }
+
+    QString id() const override
+    {
+        return QString( "LatencyDocker" );
+    }
+
+    virtual Qt::DockWidgetArea defaultDockWidgetArea() const
+    {
+        return Qt::RightDockWidgetArea;
+    }
+
+    QDockWidget* createDockWidget() override
+    {
+        LatencyDockerDock *dockWidget = new LatencyDockerDock();
+        dockWidget->setObjectName(id());
+        return dockWidget;
+    }
+
+    DockPosition defaultDockPosition() const override
+    {
+        return DockMinimized;
+    }
+};
+
+
+LatencyDockerPlugin::LatencyDockerPlugin(QObject *parent, const QVariantList &)
+    : QObject(parent)
+{
+    KoDockRegistry::instance()->add(new LatencyDockerDockFactory());
+}
+
+LatencyDockerPlugin::~LatencyDockerPlugin()
+{
+}
+
+#include "LatencyDocker.moc"
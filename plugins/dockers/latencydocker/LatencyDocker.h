@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef _LATENCY_DOCKER_H_
+#define _LATENCY_DOCKER_H_
+
+#include <QObject>
+#include <QVariant>
+
+class LatencyDockerPlugin : public QObject
+{
+    Q_OBJECT
+public:
+    LatencyDockerPlugin(QObject *parent, const QVariantList &);
+    ~LatencyDockerPlugin() override;
+};
+
+#endif
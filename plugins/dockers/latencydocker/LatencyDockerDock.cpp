@@ -0,0 +1,171 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "LatencyDockerDock.h"
+
+#include <QCheckBox>
+#include <QDateTime>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QStandardPaths>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <klocalizedstring.h>
+
+#include <KoFileDialog.h>
+#include <KisInputLatencyTracker.h>
+
+namespace {
+
+QString stageTitle(KisInputLatencyTracker::Stage stage)
+{
+    switch (stage) {
+    case KisInputLatencyTracker::DabPainted:
+        return i18nc("input latency stage", "Input to dab");
+    case KisInputLatencyTracker::ProjectionMerged:
+        return i18nc("input latency stage", "Dab to merge");
+    case KisInputLatencyTracker::TexturesUpdated:
+        return i18nc("input latency stage", "Merge to upload");
+    case KisInputLatencyTracker::FramePresented:
+        return i18nc("input latency stage", "Upload to paint");
+    case KisInputLatencyTracker::EndToEnd:
+        return i18nc("input latency stage", "Input to paint");
+    case KisInputLatencyTracker::TransformPreviewRendered:
+        return i18nc("input latency stage", "Transform drag to preview");
+    case KisInputLatencyTracker::TransformEndToEnd:
+        return i18nc("input latency stage", "Transform drag to paint");
+    case KisInputLatencyTracker::NumStages:
+        break;
+    }
+
+    return QString();
+}
+
+QString formatMs(qreal value)
+{
+    return QString::number(value, 'f', 1);
+}
+
+}
+
+LatencyDockerDock::LatencyDockerDock()
+    : QDockWidget(i18n("Input Latency"))
+{
+    QWidget *page = new QWidget(this);
+    QVBoxLayout *layout = new QVBoxLayout(page);
+
+    m_chkEnabled = new QCheckBox(i18n("Measure input latency"), page);
+    m_chkEnabled->setChecked(KisInputLatencyTracker::instance()->isEnabled());
+    connect(m_chkEnabled, SIGNAL(toggled(bool)), SLOT(slotToggleTracking(bool)));
+    layout->addWidget(m_chkEnabled);
+
+    m_stagesView = new QTreeWidget(page);
+    m_stagesView->setRootIsDecorated(false);
+    m_stagesView->setHeaderLabels(QStringList()
+                                  << i18nc("input latency table header", "Stage")
+                                  << i18nc("input latency table header", "Samples")
+                                  << i18nc("input latency table header, milliseconds", "Mean")
+                                  << i18nc("input latency table header, milliseconds", "50%")
+                                  << i18nc("input latency table header, milliseconds", "95%")
+                                  << i18nc("input latency table header, milliseconds", "99%")
+                                  << i18nc("input latency table header, milliseconds", "Max"));
+    m_stagesView->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    for (int i = 0; i < KisInputLatencyTracker::NumStages; i++) {
+        QTreeWidgetItem *item = new QTreeWidgetItem(m_stagesView);
+        item->setText(0, stageTitle(static_cast<KisInputLatencyTracker::Stage>(i)));
+        for (int column = 1; column < m_stagesView->columnCount(); column++) {
+            item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+
+    layout->addWidget(m_stagesView);
+
+    QHBoxLayout *buttonsLayout = new QHBoxLayout();
+    buttonsLayout->addStretch();
+
+    QPushButton *bnReset = new QPushButton(i18n("Reset"), page);
+    connect(bnReset, SIGNAL(clicked()), SLOT(slotReset()));
+    buttonsLayout->addWidget(bnReset);
+
+    QPushButton *bnExport = new QPushButton(i18n("Export..."), page);
+    connect(bnExport, SIGNAL(clicked()), SLOT(slotExport()));
+    buttonsLayout->addWidget(bnExport);
+
+    layout->addLayout(buttonsLayout);
+
+    setWidget(page);
+
+    m_refreshTimer.setInterval(500);
+    connect(&m_refreshTimer, SIGNAL(timeout()), SLOT(slotRefresh()));
+
+    if (m_chkEnabled->isChecked()) {
+        m_refreshTimer.start();
+    }
+
+    slotRefresh();
+}
+
+LatencyDockerDock::~LatencyDockerDock()
+{
+}
+
+void LatencyDockerDock::setCanvas(KoCanvasBase *)
+{
+    setEnabled(true);
+}
+
+void LatencyDockerDock::slotToggleTracking(bool value)
+{
+    KisInputLatencyTracker::instance()->setEnabled(value);
+
+    if (value) {
+        m_refreshTimer.start();
+    } else {
+        m_refreshTimer.stop();
+    }
+}
+
+void LatencyDockerDock::slotReset()
+{
+    KisInputLatencyTracker::instance()->reset();
+    slotRefresh();
+}
+
+void LatencyDockerDock::slotExport()
+{
+    KoFileDialog fileDialog(this, KoFileDialog::SaveFile, "inputlatencyreport");
+    fileDialog.setDefaultDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation) + "/" +
+                             QString("krita_latency_%1.json").arg(QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm")));
+    fileDialog.setMimeTypeFilters(QStringList() << "application/json", "application/json");
+
+    const QString fileName = fileDialog.filename();
+    if (!fileName.isEmpty()) {
+        KisInputLatencyTracker::instance()->exportToFile(fileName);
+    }
+}
+
+void LatencyDockerDock::slotRefresh()
+{
+    if (!isVisible()) return;
+
+    KisInputLatencyTracker *tracker = KisInputLatencyTracker::instance();
+
+    for (int i = 0; i < KisInputLatencyTracker::NumStages; i++) {
+        const KisInputLatencyTracker::Histogram h =
+            tracker->histogram(static_cast<KisInputLatencyTracker::Stage>(i));
+
+        QTreeWidgetItem *item = m_stagesView->topLevelItem(i);
+        item->setText(1, QString::number(h.count));
+        item->setText(2, formatMs(h.meanMs()));
+        item->setText(3, formatMs(h.percentileMs(50)));
+        item->setText(4, formatMs(h.percentileMs(95)));
+        item->setText(5, formatMs(h.percentileMs(99)));
+        item->setText(6, formatMs(h.maxMs()));
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef _LATENCYDOCKER_DOCK_H_
+#define _LATENCYDOCKER_DOCK_H_
+
+#include <QDockWidget>
+#include <QTimer>
+
+#include <KoCanvasObserverBase.h>
+
+class QCheckBox;
+class QTreeWidget;
+
+/**
+ * Shows the per-stage histograms of KisInputLatencyTracker
+ */
+class LatencyDockerDock : public QDockWidget, public KoCanvasObserverBase {
+    Q_OBJECT
+public:
+    LatencyDockerDock();
+    ~LatencyDockerDock() override;
+
+    QString observerName() override { return "LatencyDockerDock"; }
+    void setCanvas(KoCanvasBase *canvas) override;
+    void unsetCanvas() override {}
+
+private Q_SLOTS:
+    void slotToggleTracking(bool value);
+    void slotReset();
+    void slotExport();
+    void slotRefresh();
+
+private:
+    QCheckBox *m_chkEnabled {nullptr};
+    QTreeWidget *m_stagesView {nullptr};
+    QTimer m_refreshTimer;
+};
+
+#endif
@@ -118,6 +118,7 @@ void ExrPaintLayerInfo::updateImageType(ImageType channelType)
 struct ExrPaintLayerSaveInfo {
     QString name; ///< name of the layer with a "." at the end (ie "group1.group2.layer1.")
     KisPaintDeviceSP layerDevice;
+    const KoColorSpace *colorSpace {nullptr}; ///< the color space the layer is encoded in, converted on the fly
     KisPaintLayerSP layer;
     QList<QString> channels;
     Imf::PixelType pixelType;
@@ -954,12 +955,19 @@ struct ExrPixel_ {
     _T_ data[size];
 };
 
+/**
+ * The layers are encoded in strips of this height, so the memory
+ * footprint of the export does not depend on the image height. It
+ * matches the height of the tiles of the paint device.
+ */
+static const int exrStripHeight = 64;
+
 class Encoder
 {
 public:
     virtual ~Encoder() {}
     virtual void prepareFrameBuffer(Imf::FrameBuffer*, int line) = 0;
-    virtual void encodeData(int line) = 0;
+    virtual void encodeData(int line, int numLines) = 0;
 
 };
 
@@ -967,15 +975,16 @@ template<typename _T_, int size, int alphaPos>
 class EncoderImpl : public Encoder
 {
 public:
-    EncoderImpl(Imf::OutputFile* _file, const ExrPaintLayerSaveInfo* _info, int width) : file(_file), info(_info), pixels(width), m_width(width) {}
+    EncoderImpl(Imf::OutputFile* _file, const ExrPaintLayerSaveInfo* _info, int width) : file(_file), info(_info), pixels(width * exrStripHeight), m_width(width) {}
     ~EncoderImpl() override {}
     void prepareFrameBuffer(Imf::FrameBuffer*, int line) override;
-    void encodeData(int line) override;
+    void encodeData(int line, int numLines) override;
 private:
     typedef ExrPixel_<_T_, size> ExrPixel;
     Imf::OutputFile* file;
     const ExrPaintLayerSaveInfo* info;
     QVector<ExrPixel> pixels;
+    QVector<quint8> m_conversionBuffer;
     int m_width;
 };
 
@@ -994,54 +1003,64 @@ void EncoderImpl<_T_, size, alphaPos>::prepareFrameBuffer(Imf::FrameBuffer* fram
 }
 
 template<typename _T_, int size, int alphaPos>
-void EncoderImpl<_T_, size, alphaPos>::encodeData(int line)
+void EncoderImpl<_T_, size, alphaPos>::encodeData(int line, int numLines)
 {
+    KIS_SAFE_ASSERT_RECOVER_RETURN(numLines <= exrStripHeight);
+
+    const int numPixels = m_width * numLines;
     ExrPixel *rgba = pixels.data();
-    KisHLineConstIteratorSP it = info->layerDevice->createHLineConstIteratorNG(0, line, m_width);
-    do {
-        const _T_* dst = reinterpret_cast < const _T_* >(it->oldRawData());
 
-        for (int i = 0; i < size; ++i) {
-            rgba->data[i] = dst[i];
-        }
+    const KoColorSpace *srcColorSpace = info->layerDevice->colorSpace();
+
+    if (*srcColorSpace == *info->colorSpace) {
+        info->layerDevice->readBytes(reinterpret_cast<quint8*>(rgba), 0, line, m_width, numLines);
+    } else {
+        // convert only the current strip instead of the whole device
+        m_conversionBuffer.resize(numPixels * static_cast<int>(srcColorSpace->pixelSize()));
+        info->layerDevice->readBytes(m_conversionBuffer.data(), 0, line, m_width, numLines);
+        srcColorSpace->convertPixelsTo(m_conversionBuffer.constData(), reinterpret_cast<quint8*>(rgba),
+                                       info->colorSpace, static_cast<quint32>(numPixels),
+                                       KoColorConversionTransformation::internalRenderingIntent(),
+                                       KoColorConversionTransformation::internalConversionFlags());
+    }
 
-        if (alphaPos != -1) {
+    if (alphaPos != -1) {
+        for (int i = 0; i < numPixels; ++i) {
             multiplyAlpha<_T_, ExrPixel, size, alphaPos>(rgba);
+            ++rgba;
         }
-
-        ++rgba;
-    } while (it->nextPixel());
+    }
 }
 
 Encoder* encoder(Imf::OutputFile& file, const ExrPaintLayerSaveInfo& info, int width)
 {
-    dbgFile << "Create encoder for" << info.name << info.channels << info.layerDevice->colorSpace()->channelCount();
-    switch (info.layerDevice->colorSpace()->channelCount()) {
+    dbgFile << "Create encoder for" << info.name << info.channels << info.colorSpace->channelCount();
+    switch (info.colorSpace->channelCount()) {
     case 1: {
-        if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
+        if (info.colorSpace->colorDepthId() == Float16BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::HALF);
             return new EncoderImpl < half, 1, -1 > (&file, &info, width);
-        } else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
+        } else if (info.colorSpace->colorDepthId() == Float32BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::FLOAT);
             return new EncoderImpl < float, 1, -1 > (&file, &info, width);
         }
         break;
     }
     case 2: {
-        if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
+        if (info.colorSpace->colorDepthId() == Float16BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::HALF);
             return new EncoderImpl<half, 2, 1>(&file, &info, width);
-        } else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
+        } else if (info.colorSpace->colorDepthId() == Float32BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::FLOAT);
             return new EncoderImpl<float, 2, 1>(&file, &info, width);
         }
         break;
     }
     case 4: {
-        if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
+        if (info.colorSpace->colorDepthId() == Float16BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::HALF);
             return new EncoderImpl<half, 4, 3>(&file, &info, width);
-        } else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
+        } else if (info.colorSpace->colorDepthId() == Float32BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::FLOAT);
             return new EncoderImpl<float, 4, 3>(&file, &info, width);
         }
@@ -1060,24 +1079,24 @@ void encodeData(Imf::OutputFile& file, const QList<ExrPaintLayerSaveInfo>& infor
         encoders.push_back(encoder(file, info, width));
     }
 
-    for (int y = 0; y < height; ++y) {
+    for (int y = 0; y < height; y += exrStripHeight) {
+        const int numLines = qMin(exrStripHeight, height - y);
+
         Imf::FrameBuffer frameBuffer;
         Q_FOREACH (Encoder* encoder, encoders) {
             encoder->prepareFrameBuffer(&frameBuffer, y);
         }
         file.setFrameBuffer(frameBuffer);
         Q_FOREACH (Encoder* encoder, encoders) {
-            encoder->encodeData(y);
+            encoder->encodeData(y, numLines);
         }
-        file.writePixels(1);
+        file.writePixels(numLines);
     }
     qDeleteAll(encoders);
 }
 
-KisPaintDeviceSP wrapLayerDevice(KisPaintDeviceSP device)
+const KoColorSpace *exportColorSpace(const KoColorSpace *cs)
 {
-    const KoColorSpace *cs = device->colorSpace();
-
     if (cs->colorDepthId() != Float16BitsColorDepthID && cs->colorDepthId() != Float32BitsColorDepthID) {
         cs = KoColorSpaceRegistry::instance()->colorSpace(
             cs->colorModelId() == GrayAColorModelID ?
@@ -1090,12 +1109,7 @@ KisPaintDeviceSP wrapLayerDevice(KisPaintDeviceSP device)
             cs->colorDepthId().id());
     }
 
-    if (*cs != *device->colorSpace()) {
-        device = new KisPaintDevice(*device);
-        device->convertTo(cs);
-    }
-
-    return device;
+    return cs;
 }
 
 KisImportExportErrorCode EXRConverter::buildFile(const QString &filename, KisPaintLayerSP layer)
@@ -1113,18 +1127,19 @@ KisImportExportErrorCode EXRConverter::buildFile(const QString &filename, KisPai
 
     ExrPaintLayerSaveInfo info;
     info.layer = layer;
-    info.layerDevice = wrapLayerDevice(layer->paintDevice());
+    info.layerDevice = layer->paintDevice();
+    info.colorSpace = exportColorSpace(info.layerDevice->colorSpace());
     Imf::PixelType pixelType = Imf::NUM_PIXELTYPES;
-    if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
+    if (info.colorSpace->colorDepthId() == Float16BitsColorDepthID) {
         pixelType = Imf::HALF;
     }
-    else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
+    else if (info.colorSpace->colorDepthId() == Float32BitsColorDepthID) {
         pixelType = Imf::FLOAT;
     }
 
     info.pixelType = pixelType;
 
-    if (info.layerDevice->colorSpace()->colorModelId() == RGBAColorModelID) {
+    if (info.colorSpace->colorModelId() == RGBAColorModelID) {
         header.channels().insert("R", Imf::Channel(pixelType));
         header.channels().insert("G", Imf::Channel(pixelType));
         header.channels().insert("B", Imf::Channel(pixelType));
@@ -1134,13 +1149,13 @@ KisImportExportErrorCode EXRConverter::buildFile(const QString &filename, KisPai
         info.channels.push_back("G");
         info.channels.push_back("B");
         info.channels.push_back("A");
-    } else if (info.layerDevice->colorSpace()->colorModelId() == GrayAColorModelID) {
+    } else if (info.colorSpace->colorModelId() == GrayAColorModelID) {
         header.channels().insert("Y", Imf::Channel(pixelType));
         header.channels().insert("A", Imf::Channel(pixelType));
 
         info.channels.push_back("Y");
         info.channels.push_back("A");
-    } else if (info.layerDevice->colorSpace()->colorModelId() == XYZAColorModelID) {
+    } else if (info.colorSpace->colorModelId() == XYZAColorModelID) {
         header.channels().insert("X", Imf::Channel(pixelType));
         header.channels().insert("Y", Imf::Channel(pixelType));
         header.channels().insert("Z", Imf::Channel(pixelType));
@@ -1249,7 +1264,8 @@ void EXRConverter::Private::recBuildPaintLayerSaveInfo(QList<ExrPaintLayerSaveIn
             ExrPaintLayerSaveInfo info;
             info.name = name + paintLayer->name() + '.';
             info.layer = paintLayer;
-            info.layerDevice = wrapLayerDevice(paintLayer->paintDevice());
+            info.layerDevice = paintLayer->paintDevice();
+            info.colorSpace = exportColorSpace(info.layerDevice->colorSpace());
 
             if (info.name == QString(HDR_LAYER) + ".") {
                 info.channels.push_back("R");
@@ -1259,16 +1275,16 @@ void EXRConverter::Private::recBuildPaintLayerSaveInfo(QList<ExrPaintLayerSaveIn
             }
             else {
 
-                if (info.layerDevice->colorSpace()->colorModelId() == RGBAColorModelID) {
+                if (info.colorSpace->colorModelId() == RGBAColorModelID) {
                     info.channels.push_back(info.name + remap(current2original, "R"));
                     info.channels.push_back(info.name + remap(current2original, "G"));
                     info.channels.push_back(info.name + remap(current2original, "B"));
                     info.channels.push_back(info.name + remap(current2original, "A"));
                 }
-                else if (info.layerDevice->colorSpace()->colorModelId() == GrayAColorModelID) {
+                else if (info.colorSpace->colorModelId() == GrayAColorModelID) {
                     info.channels.push_back(info.name + remap(current2original, "Y"));
                     info.channels.push_back(info.name + remap(current2original, "A"));
-                } else if (info.layerDevice->colorSpace()->colorModelId() == XYZAColorModelID) {
+                } else if (info.colorSpace->colorModelId() == XYZAColorModelID) {
                     info.channels.push_back(info.name + remap(current2original, "X"));
                     info.channels.push_back(info.name + remap(current2original, "Y"));
                     info.channels.push_back(info.name + remap(current2original, "Z"));
@@ -1276,10 +1292,10 @@ void EXRConverter::Private::recBuildPaintLayerSaveInfo(QList<ExrPaintLayerSaveIn
                 }
             }
 
-            if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
+            if (info.colorSpace->colorDepthId() == Float16BitsColorDepthID) {
                 info.pixelType = Imf::HALF;
             }
-            else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
+            else if (info.colorSpace->colorDepthId() == Float32BitsColorDepthID) {
                 info.pixelType = Imf::FLOAT;
             }
             else {
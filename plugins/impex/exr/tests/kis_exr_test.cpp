@@ -13,6 +13,10 @@
 
 #include <half.h>
 #include <KisMimeDatabase.h>
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <QTemporaryFile>
+#include <kis_paint_layer.h>
 #include "filestest.h"
 
 #ifndef FILES_DATA_DIR
@@ -93,6 +97,62 @@ void KisExrTest::testRoundTrip()
 
 }
 
+/**
+ * Creates an image that is taller than one strip of the writer (64 rows)
+ * and whose height is not a multiple of the strip height. Every row has
+ * its own color, so a misplaced strip would be noticed.
+ */
+static KisImageSP createTallImage(const KoColorSpace *cs)
+{
+    KisImageSP image = new KisImage(0, 97, 64 * 3 + 13, cs, "tall image");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "layer1", OPACITY_OPAQUE_U8);
+
+    for (int y = 0; y < image->height(); y++) {
+        const QColor color(y % 256, (3 * y) % 256, 255 - y % 256);
+        layer->paintDevice()->fill(QRect(0, y, image->width(), 1), KoColor(color, cs));
+    }
+
+    image->addNode(layer, image->root());
+    image->initialRefreshGraph();
+
+    return image;
+}
+
+void KisExrTest::testRoundTripTallImage()
+{
+    /**
+     * Integer layers are converted into F16 by the writer strip by
+     * strip, so use an integer color space here
+     */
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16();
+    KisImageSP image = createTallImage(cs);
+
+    QScopedPointer<KisDocument> doc(KisPart::instance()->createDocument());
+    doc->setFileBatchMode(true);
+    doc->setCurrentImage(image);
+
+    QTemporaryFile savedFile(QDir::tempPath() + QLatin1String("/krita_XXXXXX") + QLatin1String(".exr"));
+    savedFile.setAutoRemove(true);
+    QVERIFY(savedFile.open());
+
+    QVERIFY(doc->exportDocumentSync(savedFile.fileName(), ExrMimetype.toLatin1()));
+
+    QScopedPointer<KisDocument> doc2(KisPart::instance()->createDocument());
+    doc2->setFileBatchMode(true);
+    QVERIFY(doc2->importDocument(savedFile.fileName()));
+    QVERIFY(doc2->image());
+    doc2->image()->waitForDone();
+
+    QCOMPARE(doc2->image()->bounds(), image->bounds());
+
+    const QImage srcImage = image->projection()->convertToQImage(0, image->bounds());
+    const QImage dstImage = doc2->image()->projection()->convertToQImage(0, image->bounds());
+
+    // F16 cannot represent all the 8-bit values exactly
+    QPoint errorPoint;
+    QVERIFY(TestUtil::compareQImages(errorPoint, srcImage, dstImage, 2, 2));
+}
+
 KISTEST_MAIN(KisExrTest)
 
 
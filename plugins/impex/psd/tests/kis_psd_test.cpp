@@ -26,6 +26,9 @@
 #include <kis_generator_layer.h>
 #include <kis_filter_configuration.h>
 #include <KisGlobalResourcesInterface.h>
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <kis_paint_layer.h>
 
 
 
@@ -508,6 +511,86 @@ void KisPSDTest::testSavingAllFormats()
 
 
 
+/**
+ * Creates a document with a few layers that span many rows of tiles and
+ * have offsets that are not aligned to the tile grid
+ */
+QSharedPointer<KisDocument> createLargeDocument(const QSize &size)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, size.width(), size.height(), cs, "large psd");
+
+    for (int i = 0; i < 3; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer%1").arg(i), OPACITY_OPAQUE_U8);
+        KisPaintDeviceSP dev = layer->paintDevice();
+
+        const QRect rc = image->bounds().adjusted(17 * i + 3, 29 * i + 5, -11 * i, -7 * i);
+
+        dev->fill(rc, KoColor(QColor(60 * i, 255 - 60 * i, 128), cs));
+
+        // some content that does not compress into uniform rows
+        for (int y = rc.top(); y <= rc.bottom(); y += 37) {
+            dev->fill(QRect(rc.left() + (y * 13) % rc.width() / 2, y, rc.width() / 3, 5),
+                      KoColor(QColor(y % 255, 40 * i, 255 - y % 255, 200), cs));
+        }
+
+        image->addNode(layer, image->root());
+    }
+
+    image->initialRefreshGraph();
+
+    QSharedPointer<KisDocument> doc(qobject_cast<KisDocument*>(KisPart::instance()->createDocument()));
+    doc->setFileBatchMode(true);
+    doc->setCurrentImage(image);
+
+    return doc;
+}
+
+void KisPSDTest::testLargeFileRoundTrip()
+{
+    QSharedPointer<KisDocument> doc = createLargeDocument(QSize(700, 1000));
+
+    QFileInfo dstFileInfo(QDir::currentPath() + '/' + "test_large_roundtrip.psd");
+    QVERIFY(doc->exportDocumentSync(dstFileInfo.absoluteFilePath(), PSDMimetype));
+
+    QSharedPointer<KisDocument> resultDoc = openPsdDocument(dstFileInfo);
+    QVERIFY(resultDoc->image());
+    resultDoc->image()->waitForDone();
+
+    KisNodeSP srcNode = doc->image()->root()->firstChild();
+    KisNodeSP dstNode = resultDoc->image()->root()->firstChild();
+
+    while (srcNode && dstNode) {
+        const QRect rc = doc->image()->bounds();
+
+        const QImage srcImage = srcNode->paintDevice()->convertToQImage(0, rc);
+        const QImage dstImage = dstNode->paintDevice()->convertToQImage(0, rc);
+
+        QCOMPARE(dstImage, srcImage);
+
+        srcNode = srcNode->nextSibling();
+        dstNode = dstNode->nextSibling();
+    }
+
+    QVERIFY(!srcNode);
+    QVERIFY(!dstNode);
+}
+
+void KisPSDTest::benchmarkOpeningLargeFile()
+{
+    QSharedPointer<KisDocument> doc = createLargeDocument(QSize(6000, 4000));
+
+    QFileInfo dstFileInfo(QDir::currentPath() + '/' + "test_large_benchmark.psd");
+    QVERIFY(doc->exportDocumentSync(dstFileInfo.absoluteFilePath(), PSDMimetype));
+
+    doc.clear();
+
+    QBENCHMARK_ONCE {
+        QSharedPointer<KisDocument> resultDoc = openPsdDocument(dstFileInfo);
+        QVERIFY(resultDoc->image());
+    }
+}
+
 void KisPSDTest::testImportFromWriteonly()
 {
     TestUtil::testImportFromWriteonly(PSDMimetype);
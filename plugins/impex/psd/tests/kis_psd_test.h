@@ -31,6 +31,9 @@ private Q_SLOTS:
     void testOpeningAllFormats();
     void testSavingAllFormats();
 
+    void testLargeFileRoundTrip();
+    void benchmarkOpeningLargeFile();
+
 
     void testImportFromWriteonly();
     void testExportToReadonly();
@@ -6,6 +6,7 @@
  */
 
 #include <QBuffer>
+#include <QVector>
 
 #include <memory>
 
@@ -114,7 +115,9 @@ KisTIFFWriterVisitor::KisTIFFWriterVisitor(TIFF*image, KisTIFFOptions* options)
 
 KisTIFFWriterVisitor::~KisTIFFWriterVisitor() = default;
 
-bool KisTIFFWriterVisitor::copyDataToStrips(KisHLineConstIteratorSP it,
+bool KisTIFFWriterVisitor::copyDataToStrips(const quint8 *src,
+                                            int numPixels,
+                                            int pixelSize,
                                             tdata_t buff,
                                             uint32_t depth,
                                             uint16_t sample_format,
@@ -124,57 +127,54 @@ bool KisTIFFWriterVisitor::copyDataToStrips(KisHLineConstIteratorSP it,
     if (depth == 32) {
         Q_ASSERT(sample_format == SAMPLEFORMAT_IEEEFP);
         float *dst = reinterpret_cast<float *>(buff);
-        do {
-            const float *d = reinterpret_cast<const float *>(it->oldRawData());
+        for (int x = 0; x < numPixels; x++, src += pixelSize) {
+            const float *d = reinterpret_cast<const float *>(src);
             for (uint8_t i = 0; i < nbcolorssamples; i++) {
                 *(dst++) = d[poses.at(i)];
             }
             if (m_options->alpha)
                 *(dst++) = d[poses.at(nbcolorssamples)];
-        } while (it->nextPixel());
+        }
         return true;
     }
     else if (depth == 16 ) {
         if (sample_format == SAMPLEFORMAT_IEEEFP) {
 #ifdef HAVE_OPENEXR
             half *dst = reinterpret_cast<half *>(buff);
-            do {
-                const half *d = reinterpret_cast<const half *>(it->oldRawData());
+            for (int x = 0; x < numPixels; x++, src += pixelSize) {
+                const half *d = reinterpret_cast<const half *>(src);
                 for (uint8_t i = 0; i < nbcolorssamples; i++) {
                     *(dst++) = d[poses.at(i)];
                 }
                 if (m_options->alpha)
                     *(dst++) = d[poses.at(nbcolorssamples)];
-            } while (it->nextPixel());
+            }
             return true;
 #endif
         }
         else {
             quint16 *dst = reinterpret_cast<quint16 *>(buff);
-            do {
-                const quint16 *d =
-                    reinterpret_cast<const quint16 *>(it->oldRawData());
+            for (int x = 0; x < numPixels; x++, src += pixelSize) {
+                const quint16 *d = reinterpret_cast<const quint16 *>(src);
                 for (uint8_t i = 0; i < nbcolorssamples; i++) {
                     *(dst++) = d[poses.at(i)];
                 }
                 if (m_options->alpha)
                     *(dst++) = d[poses.at(nbcolorssamples)];
-
-            } while (it->nextPixel());
+            }
             return true;
         }
     }
     else if (depth == 8) {
         quint8 *dst = reinterpret_cast<quint8 *>(buff);
-        do {
-            const quint8 *d = it->oldRawData();
+        for (int x = 0; x < numPixels; x++, src += pixelSize) {
+            const quint8 *d = src;
             for (uint8_t i = 0; i < nbcolorssamples; i++) {
                 *(dst++) = d[poses.at(i)];
             }
             if (m_options->alpha)
                 *(dst++) = d[poses.at(nbcolorssamples)];
-
-        } while (it->nextPixel());
+        }
         return true;
     }
     return false;
@@ -193,10 +193,12 @@ bool KisTIFFWriterVisitor::saveLayerProjection(KisLayer *layer)
         if (!destColorSpace) {
             return false;
         }
-        pd.attach(new KisPaintDevice(*pd));
-        pd->convertTo(destColorSpace);
+        // the device is converted strip by strip while writing
     }
 
+    const KoColorSpace *srcColorSpace = pd->colorSpace();
+    const KoColorSpace *dstColorSpace = destColorSpace ? destColorSpace : srcColorSpace;
+
     {
         // WORKAROUND: block any attempts to use YCbCr with alpha channels.
         // This should not happen because alpha is disabled by default
@@ -211,7 +213,7 @@ bool KisTIFFWriterVisitor::saveLayerProjection(KisLayer *layer)
     }
 
     // Save depth
-    uint32_t depth = 8 * pd->pixelSize() / pd->channelCount();
+    uint32_t depth = 8 * dstColorSpace->pixelSize() / dstColorSpace->channelCount();
     TIFFSetField(image(), TIFFTAG_BITSPERSAMPLE, depth);
 
     {
@@ -226,11 +228,11 @@ bool KisTIFFWriterVisitor::saveLayerProjection(KisLayer *layer)
 
     // Save number of samples
     if (m_options->alpha) {
-        TIFFSetField(image(), TIFFTAG_SAMPLESPERPIXEL, pd->channelCount());
+        TIFFSetField(image(), TIFFTAG_SAMPLESPERPIXEL, dstColorSpace->channelCount());
         const std::array<uint16_t, 1> sampleinfo = {EXTRASAMPLE_UNASSALPHA};
         TIFFSetField(image(), TIFFTAG_EXTRASAMPLES, 1, sampleinfo.data());
     } else {
-        TIFFSetField(image(), TIFFTAG_SAMPLESPERPIXEL, pd->channelCount() - 1);
+        TIFFSetField(image(), TIFFTAG_SAMPLESPERPIXEL, dstColorSpace->channelCount() - 1);
         TIFFSetField(image(), TIFFTAG_EXTRASAMPLES, 0);
     }
 
@@ -274,7 +276,7 @@ bool KisTIFFWriterVisitor::saveLayerProjection(KisLayer *layer)
 
     // Save profile
     if (m_options->saveProfile) {
-        const KoColorProfile* profile = pd->colorSpace()->profile();
+        const KoColorProfile* profile = dstColorSpace->profile();
         if (profile && profile->type() == "icc" && !profile->rawData().isEmpty()) {
             QByteArray ba = profile->rawData();
             TIFFSetField(image(), TIFFTAG_ICCPROFILE, ba.size(), ba.constData());
@@ -322,62 +324,102 @@ bool KisTIFFWriterVisitor::saveLayerProjection(KisLayer *layer)
         false);
     qint32 height = layer->image()->height();
     qint32 width = layer->image()->width();
+
+    // Read the device in strips of the tile height, so that neither
+    // the whole image nor its color-converted copy is ever allocated
+    const int stripHeight = 64;
+    const int srcPixelSize = static_cast<int>(srcColorSpace->pixelSize());
+    const int dstPixelSize = static_cast<int>(dstColorSpace->pixelSize());
+
+    QVector<quint8> stripBuffer(width * stripHeight * srcPixelSize);
+    QVector<quint8> convertedBuffer;
+    if (destColorSpace) {
+        convertedBuffer.resize(width * stripHeight * dstPixelSize);
+    }
+
     bool r = true;
-    for (int y = 0; y < height; y++) {
-        KisHLineConstIteratorSP it = pd->createHLineConstIteratorNG(0, y, width);
-        switch (color_type) {
-        case PHOTOMETRIC_MINISBLACK: {
-            const std::array<quint8, 5> poses = {0, 1};
-            r = copyDataToStrips(it,
-                                 buff.get(),
-                                 depth,
-                                 sample_format,
-                                 1,
-                                 poses);
-            }
-            break;
-        case PHOTOMETRIC_RGB: {
-            const auto poses = [&]() -> std::array<quint8, 5> {
-                if (sample_format == SAMPLEFORMAT_IEEEFP) {
-                    return {0, 1, 2, 3};
-                } else {
-                    return {2, 1, 0, 3};
+    for (int stripY = 0; stripY < height; stripY += stripHeight) {
+        const int numRows = qMin(stripHeight, height - stripY);
+
+        pd->readBytes(stripBuffer.data(), 0, stripY, width, numRows);
+
+        const quint8 *stripData = stripBuffer.constData();
+        if (destColorSpace) {
+            srcColorSpace->convertPixelsTo(stripBuffer.constData(),
+                                           convertedBuffer.data(),
+                                           destColorSpace,
+                                           static_cast<quint32>(width * numRows),
+                                           KoColorConversionTransformation::internalRenderingIntent(),
+                                           KoColorConversionTransformation::internalConversionFlags());
+            stripData = convertedBuffer.constData();
+        }
+
+        for (int row = 0; row < numRows; row++) {
+            const int y = stripY + row;
+            const quint8 *src = stripData + row * width * dstPixelSize;
+
+            switch (color_type) {
+            case PHOTOMETRIC_MINISBLACK: {
+                const std::array<quint8, 5> poses = {0, 1};
+                r = copyDataToStrips(src,
+                                     width,
+                                     dstPixelSize,
+                                     buff.get(),
+                                     depth,
+                                     sample_format,
+                                     1,
+                                     poses);
                 }
-            }();
-            r = copyDataToStrips(it,
-                                 buff.get(),
-                                 depth,
-                                 sample_format,
-                                 3,
-                                 poses);
-            }
-            break;
-        case PHOTOMETRIC_SEPARATED: {
-            const std::array<quint8, 5> poses = {0, 1, 2, 3, 4};
-            r = copyDataToStrips(it,
-                                 buff.get(),
-                                 depth,
-                                 sample_format,
-                                 4,
-                                 poses);
-            }
-            break;
-            case PHOTOMETRIC_ICCLAB:
-            case PHOTOMETRIC_YCBCR: {
-                const std::array<quint8, 5> poses = {0, 1, 2, 3};
-                r = copyDataToStrips(it,
+                break;
+            case PHOTOMETRIC_RGB: {
+                const auto poses = [&]() -> std::array<quint8, 5> {
+                    if (sample_format == SAMPLEFORMAT_IEEEFP) {
+                        return {0, 1, 2, 3};
+                    } else {
+                        return {2, 1, 0, 3};
+                    }
+                }();
+                r = copyDataToStrips(src,
+                                     width,
+                                     dstPixelSize,
                                      buff.get(),
                                      depth,
                                      sample_format,
                                      3,
                                      poses);
-            } break;
+                }
+                break;
+            case PHOTOMETRIC_SEPARATED: {
+                const std::array<quint8, 5> poses = {0, 1, 2, 3, 4};
+                r = copyDataToStrips(src,
+                                     width,
+                                     dstPixelSize,
+                                     buff.get(),
+                                     depth,
+                                     sample_format,
+                                     4,
+                                     poses);
+                }
+                break;
+                case PHOTOMETRIC_ICCLAB:
+                case PHOTOMETRIC_YCBCR: {
+                    const std::array<quint8, 5> poses = {0, 1, 2, 3};
+                    r = copyDataToStrips(src,
+                                         width,
+                                         dstPixelSize,
+                                         buff.get(),
+                                         depth,
+                                         sample_format,
+                                         3,
+                                         poses);
+                } break;
+            }
+            if (!r) return false;
+            TIFFWriteScanline(image(),
+                              buff.get(),
+                              static_cast<uint32_t>(y),
+                              (tsample_t)-1);
         }
-        if (!r) return false;
-        TIFFWriteScanline(image(),
-                          buff.get(),
-                          static_cast<uint32_t>(y),
-                          (tsample_t)-1);
     }
     buff.reset();
 
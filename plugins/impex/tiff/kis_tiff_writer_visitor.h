@@ -96,7 +96,9 @@ private:
     inline TIFF* image() {
         return m_image;
     }
-    bool copyDataToStrips(KisHLineConstIteratorSP it,
+    bool copyDataToStrips(const quint8 *src,
+                          int numPixels,
+                          int pixelSize,
                           tdata_t buff,
                           uint32_t depth,
                           uint16_t sample_format,
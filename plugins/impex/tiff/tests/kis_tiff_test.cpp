@@ -14,6 +14,9 @@
 
 #include <KoColorModelStandardIds.h>
 #include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <QTemporaryFile>
+#include <kis_paint_layer.h>
 
 #include <KoColorModelStandardIdsUtils.h>
 #include <kis_meta_data_backend_registry.h>
@@ -120,6 +123,57 @@ void KisTiffTest::testSaveTiffYCbCrAColorSpace()
                            profile);
 }
 
+/**
+ * Creates an image that is taller than one strip of the writer (64 rows)
+ * and whose height is not a multiple of the strip height. Every row has
+ * its own color, so a misplaced strip would be noticed.
+ */
+static KisImageSP createTallImage(const KoColorSpace *cs)
+{
+    KisImageSP image = new KisImage(0, 97, 64 * 3 + 13, cs, "tall image");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "layer1", OPACITY_OPAQUE_U8);
+
+    for (int y = 0; y < image->height(); y++) {
+        const QColor color(y % 256, (3 * y) % 256, 255 - y % 256);
+        layer->paintDevice()->fill(QRect(0, y, image->width(), 1), KoColor(color, cs));
+    }
+
+    image->addNode(layer, image->root());
+    image->initialRefreshGraph();
+
+    return image;
+}
+
+void KisTiffTest::testRoundTripTallImage()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = createTallImage(cs);
+
+    QScopedPointer<KisDocument> doc(KisPart::instance()->createDocument());
+    doc->setFileBatchMode(true);
+    doc->setCurrentImage(image);
+
+    QTemporaryFile savedFile(QDir::tempPath() + QLatin1String("/krita_XXXXXX") + QLatin1String(".tif"));
+    savedFile.setAutoRemove(true);
+    QVERIFY(savedFile.open());
+
+    QVERIFY(doc->exportDocumentSync(savedFile.fileName(), TiffMimetype.toLatin1()));
+
+    QScopedPointer<KisDocument> doc2(KisPart::instance()->createDocument());
+    doc2->setFileBatchMode(true);
+    QVERIFY(doc2->importDocument(savedFile.fileName()));
+    QVERIFY(doc2->image());
+    doc2->image()->waitForDone();
+
+    QCOMPARE(doc2->image()->bounds(), image->bounds());
+
+    const QImage srcImage = image->projection()->convertToQImage(0, image->bounds());
+    const QImage dstImage = doc2->image()->projection()->convertToQImage(0, image->bounds());
+
+    QPoint errorPoint;
+    QVERIFY(TestUtil::compareQImages(errorPoint, srcImage, dstImage));
+}
+
 void KisTiffTest::testImportFromWriteonly()
 {
     TestUtil::testImportFromWriteonly(TiffMimetype);
@@ -22,6 +22,8 @@ private Q_SLOTS:
     void testSaveTiffLabColorSpace();
     void testSaveTiffYCbCrAColorSpace();
 
+    void testRoundTripTallImage();
+
     void testImportFromWriteonly();
     void testExportToReadonly();
     void testImportIncorrectFormat();
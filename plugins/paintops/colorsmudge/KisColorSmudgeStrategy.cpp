@@ -10,3 +10,8 @@ KisColorSmudgeStrategy::KisColorSmudgeStrategy()
         : m_memoryAllocator(new KisOptimizedByteArray::PooledMemoryAllocator())
 {
 }
+
+bool KisColorSmudgeStrategy::needsNormalizedImageDab() const
+{
+    return false;
+}
@@ -7,8 +7,13 @@
 #ifndef KRITA_KISCOLORSMUDGESTRATEGY_H
 #define KRITA_KISCOLORSMUDGESTRATEGY_H
 
+#include <QRect>
+#include <QVector>
+
+#include <KoColor.h>
 #include <KisOptimizedByteArray.h>
-#include <kis_dab_cache.h>
+#include <kis_fixed_paint_device.h>
+#include <kis_types.h>
 
 class KisColorSmudgeStrategy
 {
@@ -19,12 +24,24 @@ public:
 
     virtual void initializePainting() = 0;
 
-    virtual void updateMask(KisDabCache *dabCache,
-                            const KisPaintInformation& info,
-                            const KisDabShape &shape,
-                            const QPointF &cursorPoint,
-                            QRect *dstDabRect,
-                            qreal lightnessStrength) = 0;
+    /**
+     * The color space the dab rendering queue should render
+     * the brush tip in
+     */
+    virtual const KoColorSpace* dabColorSpace() const = 0;
+
+    /**
+     * Whether the brush tip should be rendered as a normalized RGBA
+     * image stamp, \see KisDabCache::fetchNormalizedImageDab()
+     */
+    virtual bool needsNormalizedImageDab() const;
+
+    /**
+     * Sets the brush tip for the next paintDab() call. The dab comes from
+     * the dab rendering queue and may be shared with the other dabs of the
+     * queue, so the strategy should never modify it in place.
+     */
+    virtual void updateMask(KisFixedPaintDeviceSP dab, qreal paintThickness) = 0;
 
     virtual QVector<QRect> paintDab(const QRect &srcRect, const QRect &dstRect,
                                     const KoColor &currentPaintColor,
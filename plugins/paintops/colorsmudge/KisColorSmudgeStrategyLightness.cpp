@@ -87,18 +87,20 @@ KisColorSmudgeStrategyBase::DabColoringStrategy &KisColorSmudgeStrategyLightness
     return m_coloringStrategy;
 }
 
-void KisColorSmudgeStrategyLightness::updateMask(KisDabCache *dabCache, const KisPaintInformation &info,
-                                                 const KisDabShape &shape, const QPointF &cursorPoint,
-                                                 QRect *dstDabRect, qreal paintThickness)
+const KoColorSpace *KisColorSmudgeStrategyLightness::dabColorSpace() const
 {
-    m_origDab = dabCache->fetchNormalizedImageDab(m_origDab->colorSpace(),
-                                                  cursorPoint,
-                                                  shape,
-                                                  info,
-                                                  1.0,
-                                                  dstDabRect);
-
-    m_shouldPreserveOriginalDab = !dabCache->needSeparateOriginal();
+    return m_origDab->colorSpace();
+}
+
+bool KisColorSmudgeStrategyLightness::needsNormalizedImageDab() const
+{
+    return true;
+}
+
+void KisColorSmudgeStrategyLightness::updateMask(KisFixedPaintDeviceSP dab, qreal paintThickness)
+{
+    m_origDab = dab;
+    m_shouldPreserveOriginalDab = true;
 
     const int numPixels = m_origDab->bounds().width() * m_origDab->bounds().height();
 
@@ -24,11 +24,11 @@ public:
 
     DabColoringStrategy &coloringStrategy() override;
 
-    void updateMask(KisDabCache *dabCache,
-                    const KisPaintInformation& info,
-                    const KisDabShape &shape,
-                    const QPointF &cursorPoint,
-                    QRect *dstDabRect, qreal lightnessStrength) override;
+    const KoColorSpace* dabColorSpace() const override;
+
+    bool needsNormalizedImageDab() const override;
+
+    void updateMask(KisFixedPaintDeviceSP dab, qreal paintThickness) override;
 
     QVector<QRect> paintDab(const QRect &srcRect, const QRect &dstRect, const KoColor &currentPaintColor, qreal opacity,
                             qreal colorRateValue, qreal smudgeRateValue, qreal maxPossibleSmudgeRateValue,
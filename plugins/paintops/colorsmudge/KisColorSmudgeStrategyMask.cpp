@@ -20,20 +20,15 @@ KisColorSmudgeStrategyBase::DabColoringStrategy &KisColorSmudgeStrategyMask::col
     return m_coloringStrategy;
 }
 
-void KisColorSmudgeStrategyMask::updateMask(KisDabCache *dabCache, const KisPaintInformation &info, const KisDabShape &shape,
-                                       const QPointF &cursorPoint, QRect *dstDabRect, qreal lightnessStrength)
+const KoColorSpace *KisColorSmudgeStrategyMask::dabColorSpace() const
 {
-    static const KoColorSpace* cs = KoColorSpaceRegistry::instance()->alpha8();
-    static KoColor color(Qt::black, cs);
+    return KoColorSpaceRegistry::instance()->alpha8();
+}
 
-    m_maskDab = dabCache->fetchDab(cs,
-                                   color,
-                                   cursorPoint,
-                                   shape,
-                                   info,
-                                   1.0,
-                                   dstDabRect,
-                                   lightnessStrength);
+void KisColorSmudgeStrategyMask::updateMask(KisFixedPaintDeviceSP dab, qreal paintThickness)
+{
+    Q_UNUSED(paintThickness);
 
-    m_shouldPreserveMaskDab = !dabCache->needSeparateOriginal();
+    m_maskDab = dab;
+    m_shouldPreserveMaskDab = true;
 }
@@ -20,12 +20,9 @@ public:
 
     DabColoringStrategy &coloringStrategy() override;
 
-    void updateMask(KisDabCache *dabCache,
-                    const KisPaintInformation& info,
-                    const KisDabShape &shape,
-                    const QPointF &cursorPoint,
-                    QRect *dstDabRect, 
-                    qreal lightnessStrength) override;
+    const KoColorSpace* dabColorSpace() const override;
+
+    void updateMask(KisFixedPaintDeviceSP dab, qreal paintThickness) override;
 
 private:
     DabColoringStrategyMask m_coloringStrategy;
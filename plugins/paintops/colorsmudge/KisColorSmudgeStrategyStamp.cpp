@@ -23,20 +23,16 @@ KisColorSmudgeStrategyBase::DabColoringStrategy &KisColorSmudgeStrategyStamp::co
     return m_coloringStrategy;
 }
 
-void KisColorSmudgeStrategyStamp::updateMask(KisDabCache *dabCache, const KisPaintInformation &info,
-                                             const KisDabShape &shape, const QPointF &cursorPoint, QRect *dstDabRect, qreal lightnessStrength)
+const KoColorSpace *KisColorSmudgeStrategyStamp::dabColorSpace() const
 {
+    return m_origDab->colorSpace();
+}
 
-    static KoColor color(Qt::black, m_origDab->colorSpace());
+void KisColorSmudgeStrategyStamp::updateMask(KisFixedPaintDeviceSP dab, qreal paintThickness)
+{
+    Q_UNUSED(paintThickness);
 
-    m_origDab = dabCache->fetchDab(m_origDab->colorSpace(),
-                                   color,
-                                   cursorPoint,
-                                   shape,
-                                   info,
-                                   1.0,
-                                   dstDabRect,
-                                   lightnessStrength);
+    m_origDab = dab;
 
     m_coloringStrategy.setStampDab(m_origDab);
 
@@ -19,12 +19,9 @@ struct KisColorSmudgeStrategyStamp : public KisColorSmudgeStrategyWithOverlay
 
     DabColoringStrategy &coloringStrategy() override;
 
-    void updateMask(KisDabCache *dabCache,
-                    const KisPaintInformation& info,
-                    const KisDabShape &shape,
-                    const QPointF &cursorPoint,
-                    QRect *dstDabRect,
-                    qreal lightnessStrength) override;
+    const KoColorSpace* dabColorSpace() const override;
+
+    void updateMask(KisFixedPaintDeviceSP dab, qreal paintThickness) override;
 
 private:
     KisFixedPaintDeviceSP m_origDab;
@@ -17,6 +17,14 @@
 #include <kis_lod_transform.h>
 #include <kis_spacing_information.h>
 #include "kis_paintop_plugin_utils.h"
+#include "kis_texture_option.h"
+
+#include <KisDabCacheUtils.h>
+#include <KisDabRenderingExecutor.h>
+#include <KisRenderedDab.h>
+#include <kis_pointer_utils.h>
+#include <KisRunnableStrokeJobData.h>
+#include <KisRunnableStrokeJobUtils.h>
 
 #include "KisInterstrokeData.h"
 #include "KisInterstrokeDataFactory.h"
@@ -124,6 +132,50 @@ KisColorSmudgeOp::KisColorSmudgeOp(const KisPaintOpSettingsSP settings, KisPaint
             m_hsvTransform = m_paintColor.colorSpace()->createColorTransformation("hsv_adjustment", QHash<QString, QVariant>());
         }
     }
+
+    m_dabColor = KoColor(Qt::black, m_strategy->dabColorSpace());
+
+    m_brush->notifyBrushIsGoingToBeClonedForStroke();
+
+    KisBrushSP baseBrush = m_brush;
+    const bool useNormalizedImageDab = m_strategy->needsNormalizedImageDab();
+    auto resourcesFactory =
+        [baseBrush, settings, painter, useNormalizedImageDab] () {
+            KisDabCacheUtils::DabRenderingResources *resources =
+                new KisDabCacheUtils::DabRenderingResources();
+            resources->brush = baseBrush->clone().dynamicCast<KisBrush>();
+            resources->textureOption.reset(
+                new KisTextureOption(settings.data(),
+                                     settings->resourcesInterface(),
+                                     settings->canvasResourcesInterface(),
+                                     painter->device()->defaultBounds()->currentLevelOfDetail(),
+                                     None));
+            resources->forceNormalizedRGBAImageStamp = useNormalizedImageDab;
+
+            return resources;
+        };
+
+    m_dabExecutor.reset(
+        new KisDabRenderingExecutor(
+                    m_strategy->dabColorSpace(),
+                    resourcesFactory,
+                    painter->runnableStrokeJobsInterface(),
+                    &m_mirrorOption,
+                    &m_precisionOption));
+
+    if (m_smudgeRateOption.mode() == KisSmudgeLengthOptionData::SMEARING_MODE) {
+        /**
+        * Disable handling of the subpixel precision. In the smudge op we
+        * should read from the aligned areas of the image, so having
+        * additional internal offsets, created by the subpixel precision,
+        * will worsen the quality (at least because
+        * QRectF(dstDabRect).center() will not point to the real center
+        * of the brush anymore).
+        * Of course, this only really matters with smearing_mode (bug:327235),
+        * and you only notice the lack of subpixel precision in the dulling methods.
+        */
+        m_dabExecutor->disableSubpixelPrecision();
+    }
 }
 
 KisColorSmudgeOp::~KisColorSmudgeOp()
@@ -140,19 +192,6 @@ KisSpacingInformation KisColorSmudgeOp::paintAt(const KisPaintInformation& info)
     if (!painter()->device() || !brush || !brush->canPaintFor(info)) {
         return KisSpacingInformation(1.0);
     }
-    if (m_smudgeRateOption.mode() == KisSmudgeLengthOptionData::SMEARING_MODE) {
-        /**
-        * Disable handling of the subpixel precision. In the smudge op we
-        * should read from the aligned areas of the image, so having
-        * additional internal offsets, created by the subpixel precision,
-        * will worsen the quality (at least because
-        * QRectF(m_dstDabRect).center() will not point to the real center
-        * of the brush anymore).
-        * Of course, this only really matters with smearing_mode (bug:327235),
-        * and you only notice the lack of subpixel precision in the dulling methods.
-        */
-        m_dabCache->disableSubpixelPrecision();
-    }
 
     // get the scaling factor calculated by the size option
     qreal scale = m_sizeOption.apply(info);
@@ -169,19 +208,60 @@ KisSpacingInformation KisColorSmudgeOp::paintAt(const KisPaintInformation& info)
                               brush->maskWidth(shape, 0, 0, info),
                               brush->maskHeight(shape, 0, 0, info));
 
-    const qreal smudgeRadiusPortion = m_smudgeRadiusOption.isChecked() ? m_smudgeRadiusOption.computeSizeLikeValue(info) : 0.0;
-
     KisSpacingInformation spacingInfo =
             effectiveSpacing(scale, rotation,
                              &m_airbrushData, &m_spacingOption, info);
 
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_strategy, spacingInfo);
 
+    DabParameters params;
+    params.paintThickness = m_paintThicknessOption.apply(info);
+    params.smudgeRadiusPortion = m_smudgeRadiusOption.isChecked() ? m_smudgeRadiusOption.computeSizeLikeValue(info) : 0.0;
+    params.colorRate = m_colorRateOption.isChecked() ? m_colorRateOption.computeSizeLikeValue(info) : 0.0;
+    params.smudgeRate = m_smudgeRateOption.isChecked() ? m_smudgeRateOption.computeSizeLikeValue(info) : 1.0;
+    params.maxSmudgeRate = m_smudgeRateOption.strengthValue();
+    params.opacity = m_opacityOption.apply(info);
 
-    const qreal paintThickness = m_paintThicknessOption.apply(info);
-    m_strategy->updateMask(m_dabCache, info, shape, scatteredPos, &m_dstDabRect, paintThickness);
+    params.paintColor = m_paintColor;
+
+    m_gradientOption.apply(params.paintColor, m_gradient, info);
+    if (m_hsvTransform) {
+        Q_FOREACH (KisHSVOption *option, m_hsvOptions) {
+            option->apply(m_hsvTransform, info);
+        }
+        m_hsvTransform->transform(params.paintColor.data(), params.paintColor.data(), 1);
+    }
+
+    /**
+     * The parameters should be queued **before** the dab is passed to
+     * the executor, because doAsynchronousUpdate() may fetch the dab
+     * from a different thread right after addDab() returns.
+     */
+    {
+        QMutexLocker l(&m_pendingDabsMutex);
+        m_pendingDabs.enqueue(params);
+    }
+
+    const qreal lightnessStrength =
+        m_strategy->needsNormalizedImageDab() ? 1.0 : params.paintThickness;
+
+    KisDabCacheUtils::DabRequestInfo request(m_dabColor,
+                                             scatteredPos,
+                                             shape,
+                                             info,
+                                             1.0,
+                                             lightnessStrength);
+
+    m_dabExecutor->addDab(request, params.opacity, 1.0);
+
+    return spacingInfo;
+}
+
+void KisColorSmudgeOp::paintRenderedDab(const KisRenderedDab &dab, const DabParameters &params)
+{
+    const QRect dstDabRect = dab.realBounds();
+    const QPointF newCenterPos = QRectF(dstDabRect).center();
 
-    QPointF newCenterPos = QRectF(m_dstDabRect).center();
     /**
      * Save the center of the current dab to know where to read the
      * data during the next pass. We do not save scatteredPos here,
@@ -189,42 +269,90 @@ KisSpacingInformation KisColorSmudgeOp::paintAt(const KisPaintInformation& info)
      * brush (due to rounding effects), which will result in a
      * really weird quality.
      */
-    QRect srcDabRect = m_dstDabRect.translated((m_lastPaintPos - newCenterPos).toPoint());
+    const QRect srcDabRect = dstDabRect.translated((m_lastPaintPos - newCenterPos).toPoint());
 
     m_lastPaintPos = newCenterPos;
 
     if (m_firstRun) {
         m_firstRun = false;
-        return spacingInfo;
+        return;
     }
 
-    const qreal colorRate = m_colorRateOption.isChecked() ? m_colorRateOption.computeSizeLikeValue(info) : 0.0;
-    const qreal smudgeRate = m_smudgeRateOption.isChecked() ? m_smudgeRateOption.computeSizeLikeValue(info) : 1.0;
-    const qreal maxSmudgeRate = m_smudgeRateOption.strengthValue();
-    const qreal fpOpacity = m_opacityOption.apply(info);
-
-    KoColor paintColor = m_paintColor;
-
-    m_gradientOption.apply(paintColor, m_gradient, info);
-    if (m_hsvTransform) {
-        Q_FOREACH (KisHSVOption *option, m_hsvOptions) {
-            option->apply(m_hsvTransform, info);
-        }
-        m_hsvTransform->transform(paintColor.data(), paintColor.data(), 1);
-    }
+    m_strategy->updateMask(dab.device, params.paintThickness);
 
     const QVector<QRect> dirtyRects =
-            m_strategy->paintDab(srcDabRect, m_dstDabRect,
-                                 paintColor,
-                                 fpOpacity, colorRate,
-                                 smudgeRate,
-                                 maxSmudgeRate,
-                                 paintThickness,
-                                 smudgeRadiusPortion);
+            m_strategy->paintDab(srcDabRect, dstDabRect,
+                                 params.paintColor,
+                                 params.opacity, params.colorRate,
+                                 params.smudgeRate,
+                                 params.maxSmudgeRate,
+                                 params.paintThickness,
+                                 params.smudgeRadiusPortion);
 
     painter()->addDirtyRects(dirtyRects);
+}
 
-    return spacingInfo;
+struct KisColorSmudgeOp::UpdateSharedState
+{
+    QList<KisRenderedDab> dabsQueue;
+    QVector<DabParameters> dabParams;
+};
+
+std::pair<int, bool> KisColorSmudgeOp::doAsynchronousUpdate(QVector<KisRunnableStrokeJobData*> &jobs)
+{
+    bool someDabsAreStillInQueue = false;
+    const bool hasPreparedDabsAtStart = m_dabExecutor->hasPreparedDabs();
+
+    if (!m_updateSharedState && hasPreparedDabsAtStart) {
+
+        m_updateSharedState = toQShared(new UpdateSharedState());
+        UpdateSharedStateSP state = m_updateSharedState;
+
+        state->dabsQueue = m_dabExecutor->takeReadyDabs(false, -1, &someDabsAreStillInQueue);
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!state->dabsQueue.isEmpty(),
+                                             std::make_pair(m_currentUpdatePeriod, false));
+
+        {
+            QMutexLocker l(&m_pendingDabsMutex);
+
+            KIS_SAFE_ASSERT_RECOVER_NOOP(m_pendingDabs.size() >= state->dabsQueue.size());
+
+            const int numDabs = qMin(m_pendingDabs.size(), state->dabsQueue.size());
+            state->dabParams.reserve(numDabs);
+            for (int i = 0; i < numDabs; i++) {
+                state->dabParams.append(m_pendingDabs.dequeue());
+            }
+        }
+
+        /**
+         * The dab masks are rendered concurrently by the executor, but
+         * every smudge dab reads the canvas area written by the previous
+         * dab, so the dabs must be blended strictly one after another, in
+         * the order they were painted.
+         */
+        KritaUtils::addJobSequential(jobs,
+            [state, this, someDabsAreStillInQueue] () {
+                const int numDabs = qMin(state->dabsQueue.size(), state->dabParams.size());
+                for (int i = 0; i < numDabs; i++) {
+                    paintRenderedDab(state->dabsQueue[i], state->dabParams[i]);
+                }
+
+                m_currentUpdatePeriod =
+                    someDabsAreStillInQueue ? m_minUpdatePeriod :
+                    qMax(m_minUpdatePeriod, qRound(1.5 * m_dabExecutor->averageDabRenderingTime()));
+
+                // release all the dab devices
+                state->dabsQueue.clear();
+
+                m_updateSharedState.clear();
+            }
+        );
+    } else if (m_updateSharedState && hasPreparedDabsAtStart) {
+        someDabsAreStillInQueue = true;
+    }
+
+    return std::make_pair(m_currentUpdatePeriod, someDabsAreStillInQueue);
 }
 
 KisSpacingInformation KisColorSmudgeOp::updateSpacingImpl(const KisPaintInformation &info) const
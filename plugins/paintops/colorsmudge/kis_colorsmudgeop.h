@@ -7,8 +7,12 @@
 #ifndef _KIS_COLORSMUDGEOP_H_
 #define _KIS_COLORSMUDGEOP_H_
 
+#include <QMutex>
+#include <QQueue>
 #include <QRect>
+#include <QSharedPointer>
 
+#include <KoColor.h>
 #include "KoColorTransformation.h"
 #include <KoAbstractGradient.h>
 
@@ -37,6 +41,9 @@ class KoColorSpace;
 class KisInterstrokeDataFactory;
 
 class KisColorSmudgeStrategy;
+class KisDabRenderingExecutor;
+struct KisRenderedDab;
+class KisRunnableStrokeJobData;
 
 class KisColorSmudgeOp: public KisBrushBasedPaintOp
 {
@@ -46,12 +53,34 @@ public:
 
     static KisInterstrokeDataFactory* createInterstrokeDataFactory(const KisPaintOpSettingsSP settings, KisResourcesInterfaceSP resourcesInterface);
 
+    std::pair<int, bool> doAsynchronousUpdate(QVector<KisRunnableStrokeJobData *> &jobs) override;
+
 protected:
     KisSpacingInformation paintAt(const KisPaintInformation& info) override;
 
     KisSpacingInformation updateSpacingImpl(const KisPaintInformation &info) const override;
     KisTimingInformation updateTimingImpl(const KisPaintInformation &info) const override;
 
+private:
+    /**
+     * The parameters of a dab that has been passed to the dab
+     * rendering queue, but has not been painted yet
+     */
+    struct DabParameters {
+        KoColor paintColor;
+        qreal opacity = 1.0;
+        qreal colorRate = 0.0;
+        qreal smudgeRate = 1.0;
+        qreal maxSmudgeRate = 1.0;
+        qreal paintThickness = 1.0;
+        qreal smudgeRadiusPortion = 0.0;
+    };
+
+    struct UpdateSharedState;
+    typedef QSharedPointer<UpdateSharedState> UpdateSharedStateSP;
+
+    void paintRenderedDab(const KisRenderedDab &dab, const DabParameters &params);
+
 private:
     bool                      m_firstRun;
 
@@ -74,11 +103,20 @@ private:
     KisAirbrushOptionData m_airbrushData;
     KisSmudgeOverlayModeOptionData m_overlayModeData;
 
-    QRect                     m_dstDabRect;
     QPointF                   m_lastPaintPos;
 
     KoColorTransformation *m_hsvTransform {0};
     QScopedPointer<KisColorSmudgeStrategy> m_strategy;
+
+    KoColor m_dabColor;
+    QScopedPointer<KisDabRenderingExecutor> m_dabExecutor;
+
+    QMutex m_pendingDabsMutex;
+    QQueue<DabParameters> m_pendingDabs;
+
+    UpdateSharedStateSP m_updateSharedState;
+    int m_currentUpdatePeriod = 20;
+    const int m_minUpdatePeriod = 10;
 };
 
 #endif // _KIS_COLORSMUDGEOP_H_
@@ -19,6 +19,8 @@ public:
 
     QList<KisUniformPaintOpPropertySP> uniformProperties(KisPaintOpSettingsSP settings, QPointer<KisPaintOpPresetUpdateProxy> updateProxy) override;
 
+    bool needsAsynchronousUpdates() const override;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -15,6 +15,9 @@
 #include <brushengine/kis_paintop_preset.h>
 #include <brushengine/kis_paintop_settings.h>
 #include <KoCanvasResourcesIds.h>
+#include <brushengine/kis_paintop.h>
+#include <KisRunnableStrokeJobData.h>
+#include <KisRunnableStrokeJobsInterface.h>
 
 class TestColorsmudgeOp : public TestUtil::QImageBasedTest
 {
@@ -106,6 +109,22 @@ public:
 
             yOffset += 60;
         }
+
+        flushAsynchronousUpdates(gc);
+    }
+
+    void flushAsynchronousUpdates(KisPainter &gc) {
+        /**
+         * The colorsmudge op blends its dabs in asynchronous update
+         * jobs, which are never issued for a bare painter, so we
+         * should run them explicitly
+         */
+        bool someDabsAreStillInQueue = true;
+        while (someDabsAreStillInQueue) {
+            QVector<KisRunnableStrokeJobData*> jobs;
+            someDabsAreStillInQueue = gc.paintOp()->doAsynchronousUpdate(jobs).second;
+            gc.runnableStrokeJobsInterface()->addRunnableJobs(jobs);
+        }
     }
 
     QString m_presetFileName;
@@ -46,6 +46,13 @@ struct PAINTOP_EXPORT DabRenderingResources
 
     KisPaintDeviceSP colorSourceDevice;
 
+    /**
+     * Render the brush tip as a normalized RGBA image stamp, even
+     * when the brush is not an image stamp, \see
+     * KisDabCache::fetchNormalizedImageDab()
+     */
+    bool forceNormalizedRGBAImageStamp = false;
+
 private:
     DabRenderingResources(const DabRenderingResources &rhs) = delete;
 };
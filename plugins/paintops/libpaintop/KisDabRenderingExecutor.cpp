@@ -17,6 +17,7 @@
 struct KisDabRenderingExecutor::Private
 {
     QScopedPointer<KisDabRenderingQueue> renderingQueue;
+    KisDabRenderingQueueCache *cache = 0;
     KisRunnableStrokeJobsInterface *runnableJobsInterface;
 };
 
@@ -37,6 +38,7 @@ KisDabRenderingExecutor::KisDabRenderingExecutor(const KoColorSpace *cs,
     cache->setPrecisionOption(precisionOption);
 
     m_d->renderingQueue->setCacheInterface(cache);
+    m_d->cache = cache;
 }
 
 KisDabRenderingExecutor::~KisDabRenderingExecutor()
@@ -67,6 +69,11 @@ bool KisDabRenderingExecutor::hasPreparedDabs() const
     return m_d->renderingQueue->hasPreparedDabs();
 }
 
+void KisDabRenderingExecutor::disableSubpixelPrecision()
+{
+    m_d->cache->disableSubpixelPrecision();
+}
+
 qreal KisDabRenderingExecutor::averageDabRenderingTime() const
 {
     return m_d->renderingQueue->averageExecutionTime();
@@ -95,7 +95,8 @@ int KisDabRenderingJobRunner::executeOneJob(KisDabRenderingJob *job,
         // TODO: thing about better interface for the reverse queue link
         job->originalDevice = parentQueue->fetchCachedPaintDevice();
 
-        generateDab(job->generationInfo, resources, &job->originalDevice);
+        generateDab(job->generationInfo, resources, &job->originalDevice,
+                    resources->forceNormalizedRGBAImageStamp);
     }
 
     // by now the original device should be already prepared
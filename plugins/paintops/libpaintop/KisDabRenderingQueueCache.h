@@ -10,9 +10,9 @@
 #include "KisDabRenderingQueue.h"
 #include "kis_dab_cache_base.h"
 
-#include "kritadefaultpaintops_export.h"
+#include "kritapaintop_export.h"
 
-class KRITADEFAULTPAINTOPS_EXPORT KisDabRenderingQueueCache : public KisDabRenderingQueue::CacheInterface, public KisDabCacheBase
+class PAINTOP_EXPORT KisDabRenderingQueueCache : public KisDabRenderingQueue::CacheInterface, public KisDabCacheBase
 {
 public:
 
@@ -19,6 +19,8 @@
 
 #include <kundo2command.h>
 
+#include <cmath>
+
 struct PrecisionValues {
     qreal angle;
     qreal sizeFrac;
@@ -83,6 +85,8 @@ struct KisDabCacheBase::Private {
     SavedDabParameters lastSavedDabParameters;
 
     static qreal positiveFraction(qreal x);
+    static qreal snapSubPixel(qreal subPixel, qreal grid, qint32 *coordinate);
+    static KisDabShape snapShape(const KisDabShape &shape, const PrecisionValues &prec);
 };
 
 
@@ -168,6 +172,41 @@ qreal KisDabCacheBase::Private::positiveFraction(qreal x) {
     return fraction;
 }
 
+qreal KisDabCacheBase::Private::snapSubPixel(qreal subPixel, qreal grid, qint32 *coordinate)
+{
+    qreal result = qRound(subPixel / grid) * grid;
+
+    if (result >= 1.0) {
+        (*coordinate)++;
+        result -= 1.0;
+    }
+
+    return result;
+}
+
+KisDabShape KisDabCacheBase::Private::snapShape(const KisDabShape &shape, const PrecisionValues &prec)
+{
+    qreal scale = shape.scale();
+    qreal ratio = shape.ratio();
+    qreal rotation = shape.rotation();
+
+    if (prec.sizeFrac > 0.0 && scale > 0.0) {
+        // the size tolerance is relative, so the grid is logarithmic
+        const qreal step = std::log(1.0 + prec.sizeFrac);
+        scale = std::exp(qRound(std::log(scale) / step) * step);
+    }
+
+    if (prec.ratio > eps) {
+        ratio = qMax(prec.ratio, qRound(ratio / prec.ratio) * prec.ratio);
+    }
+
+    if (prec.angle > eps && !qIsNaN(rotation)) {
+        rotation = qRound(rotation / prec.angle) * prec.angle;
+    }
+
+    return KisDabShape(scale, ratio, rotation);
+}
+
 inline
 KisDabCacheBase::DabPosition
 KisDabCacheBase::calculateDabRect(KisBrushSP brush,
@@ -175,7 +214,8 @@ KisDabCacheBase::calculateDabRect(KisBrushSP brush,
                                   KisDabShape shape,
                                   const KisPaintInformation& info,
                                   const MirrorProperties &mirrorProperties,
-                                  KisSharpnessOption *sharpnessOption)
+                                  KisSharpnessOption *sharpnessOption,
+                                  qreal subPixelGrid)
 {
     qint32 x = 0, y = 0;
     qreal subPixelX = 0.0, subPixelY = 0.0;
@@ -195,6 +235,11 @@ KisDabCacheBase::calculateDabRect(KisBrushSP brush,
         KisPaintOp::splitCoordinate(pt.y(), &y, &subPixelY);
     }
 
+    if (subPixelGrid > 0.0 && !qIsNaN(subPixelX) && !qIsNaN(subPixelY)) {
+        subPixelX = Private::snapSubPixel(subPixelX, subPixelGrid, &x);
+        subPixelY = Private::snapSubPixel(subPixelY, subPixelGrid, &y);
+    }
+
     if (m_d->subPixelPrecisionDisabled) {
         subPixelX = 0;
         subPixelY = 0;
@@ -228,6 +273,19 @@ KisDabCacheBase::calculateDabRect(KisBrushSP brush,
                        shape.rotation());
 }
 
+int KisDabCacheBase::effectivePrecisionLevel(KisBrushSP brush,
+                                             const KisDabShape &shape,
+                                             const KisPaintInformation &info) const
+{
+    if (!m_d->precisionOption) return 4;
+
+    const int effectiveDabSize =
+        qMin(brush->maskWidth(shape, 0, 0, info),
+             brush->maskHeight(shape, 0, 0, info));
+
+    return m_d->precisionOption->effectivePrecisionLevel(effectiveDabSize) - 1;
+}
+
 void KisDabCacheBase::fetchDabGenerationInfo(bool hasDabInCache,
                                              KisDabCacheUtils::DabRenderingResources *resources,
                                              const KisDabCacheUtils::DabRequestInfo &request,
@@ -242,16 +300,6 @@ void KisDabCacheBase::fetchDabGenerationInfo(bool hasDabInCache,
         di->mirrorProperties = m_d->mirrorOption->apply(request.info);
     }
 
-    DabPosition position = calculateDabRect(resources->brush,
-                                            request.cursorPoint,
-                                            request.shape,
-                                            request.info,
-                                            di->mirrorProperties,
-                                            resources->sharpnessOption.data());
-    di->shape = KisDabShape(request.shape.scale(), request.shape.ratio(), position.realAngle);
-    di->dstDabRect = position.rect;
-    di->subPixel = position.subPixel;
-
     const bool supportsCaching = resources->brush->supportsCaching();
 
     const KisUniformColorSource *uniformColorSource =
@@ -261,6 +309,64 @@ void KisDabCacheBase::fetchDabGenerationInfo(bool hasDabInCache,
     di->paintColor = uniformColorSource ?
         uniformColorSource->uniformColor() : request.color;
 
+    di->needsPostprocessing = needSeparateOriginal(resources->textureOption.data(), resources->sharpnessOption.data());
+
+    int precisionLevel = effectivePrecisionLevel(resources->brush, request.shape, request.info);
+
+    /**
+     * On the reduced precision levels the dab shape is snapped onto
+     * a grid defined by the tolerances of the level. It lets the dabs
+     * of a pressure-sensitive stroke reuse the tips rendered earlier
+     * (see KisQImagePyramid) instead of resampling the brush for every
+     * dab. The snapping is done only when the dab can actually be
+     * reused, otherwise it would just lose precision for nothing.
+     */
+    KisDabShape requestShape = request.shape;
+    qreal subPixelGrid = 0.0;
+
+    const bool canSnapDab =
+        supportsCaching && di->solidColorFill && !di->needsPostprocessing;
+
+    if (canSnapDab && precisionLevel < 4) {
+        requestShape = Private::snapShape(request.shape, precisionLevels[precisionLevel]);
+
+        /**
+         * Snapping may change the size of the dab enough to select a
+         * different precision level, so the level is recalculated for
+         * the snapped shape. If the snapped dab needs higher precision,
+         * we snap the original shape once again with a finer grid.
+         */
+        const int snappedPrecisionLevel =
+            effectivePrecisionLevel(resources->brush, requestShape, request.info);
+
+        if (snappedPrecisionLevel > precisionLevel) {
+            precisionLevel = snappedPrecisionLevel;
+            requestShape = precisionLevel < 4 ?
+                Private::snapShape(request.shape, precisionLevels[precisionLevel]) :
+                request.shape;
+        }
+
+        /**
+         * The levels that do not sacrifice subpixel precision in the
+         * cache comparison (i.e. have the grid of a whole pixel) should
+         * not quantize the position of the dab either.
+         */
+        if (precisionLevel < 4 && precisionLevels[precisionLevel].subPixel < 1.0) {
+            subPixelGrid = precisionLevels[precisionLevel].subPixel;
+        }
+    }
+
+    DabPosition position = calculateDabRect(resources->brush,
+                                            request.cursorPoint,
+                                            requestShape,
+                                            request.info,
+                                            di->mirrorProperties,
+                                            resources->sharpnessOption.data(),
+                                            subPixelGrid);
+    di->shape = KisDabShape(requestShape.scale(), requestShape.ratio(), position.realAngle);
+    di->dstDabRect = position.rect;
+    di->subPixel = position.subPixel;
+
     SavedDabParameters newParams = getDabParameters(resources->brush,
                                                     di->paintColor,
                                                     di->shape,
@@ -271,18 +377,11 @@ void KisDabCacheBase::fetchDabGenerationInfo(bool hasDabInCache,
                                                     di->lightnessStrength,
                                                     di->mirrorProperties);
 
-    int precisionLevel = 4;
-    if (m_d->precisionOption) {
-        const int effectiveDabSize = qMin(newParams.width, newParams.height);
-        precisionLevel = m_d->precisionOption->effectivePrecisionLevel(effectiveDabSize) - 1;
-    }
     *shouldUseCache = hasDabInCache && supportsCaching && di->solidColorFill &&
             newParams.compare(m_d->lastSavedDabParameters, precisionLevel);
 
     if (!*shouldUseCache) {
         m_d->lastSavedDabParameters = newParams;
     }
-
-    di->needsPostprocessing = needSeparateOriginal(resources->textureOption.data(), resources->sharpnessOption.data());
 }
 
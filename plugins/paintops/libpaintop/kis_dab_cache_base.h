@@ -102,7 +102,12 @@ private:
     calculateDabRect(KisBrushSP brush, const QPointF &cursorPoint,
                      KisDabShape,
                      const KisPaintInformation& info,
-                     const MirrorProperties &mirrorProperties, KisSharpnessOption *sharpnessOption);
+                     const MirrorProperties &mirrorProperties, KisSharpnessOption *sharpnessOption,
+                     qreal subPixelGrid);
+
+    int effectivePrecisionLevel(KisBrushSP brush,
+                                const KisDabShape &shape,
+                                const KisPaintInformation &info) const;
 
 private:
     struct Private;
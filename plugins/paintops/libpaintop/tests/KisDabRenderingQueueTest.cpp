@@ -10,9 +10,9 @@
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
 
-#include <../KisDabRenderingQueue.h>
-#include <../KisRenderedDab.h>
-#include <../KisDabRenderingJob.h>
+#include <KisDabRenderingQueue.h>
+#include <KisRenderedDab.h>
+#include <KisDabRenderingJob.h>
 
 struct SurrogateCacheInterface : public KisDabRenderingQueue::CacheInterface
 {
@@ -431,7 +431,7 @@ void KisDabRenderingQueueTest::testPostprocessedDabs()
 
 }
 
-#include <../KisDabRenderingQueueCache.h>
+#include <KisDabRenderingQueueCache.h>
 
 void KisDabRenderingQueueTest::testRunningJobs()
 {
@@ -486,7 +486,7 @@ void KisDabRenderingQueueTest::testRunningJobs()
     QCOMPARE(renderedDabs[1].offset, QPoint(15,15));
 }
 
-#include "../KisDabRenderingExecutor.h"
+#include <KisDabRenderingExecutor.h>
 #include "KisFakeRunnableStrokeJobsExecutor.h"
 
 void KisDabRenderingQueueTest::testExecutor()
@@ -526,4 +526,87 @@ void KisDabRenderingQueueTest::testExecutor()
 
 }
 
+#include <KisDabRenderingQueueCache.h>
+#include <kis_precision_option.h>
+#include <kis_properties_configuration.h>
+
+KisDabCacheUtils::DabGenerationInfo fetchGenerationInfo(int precisionLevel,
+                                                        const QPointF &pos,
+                                                        const KisDabShape &shape)
+{
+    QScopedPointer<KisDabCacheUtils::DabRenderingResources> resources(testResourcesFactory());
+
+    KisPropertiesConfiguration config;
+    KisPrecisionOption precisionOption(&config);
+    precisionOption.setPrecisionLevel(precisionLevel);
+
+    KisDabRenderingQueueCache cache;
+    if (precisionLevel > 0) {
+        cache.setPrecisionOption(&precisionOption);
+    }
+
+    KoColor color(Qt::black, KoColorSpaceRegistry::instance()->rgb8());
+    KisPaintInformation pi(pos);
+    KisDabCacheUtils::DabRequestInfo request(color, pos, shape, pi, 1.0);
+
+    KisDabCacheUtils::DabGenerationInfo di;
+    bool shouldUseCache = false;
+    cache.getDabType(false, resources.data(), request, &di, &shouldUseCache);
+
+    return di;
+}
+
+void KisDabRenderingQueueTest::testPrecisionSnapping()
+{
+    const QPointF pos(10.3, 20.7);
+
+    {
+        // the highest precision level should not change the dab at all
+        const KisDabShape shape(0.73, 0.9, 0.3);
+
+        const KisDabCacheUtils::DabGenerationInfo reference = fetchGenerationInfo(0, pos, shape);
+        const KisDabCacheUtils::DabGenerationInfo di = fetchGenerationInfo(5, pos, shape);
+
+        QCOMPARE(di.dstDabRect, reference.dstDabRect);
+        QCOMPARE(di.subPixel, reference.subPixel);
+        QCOMPARE(di.shape.scale(), reference.shape.scale());
+        QCOMPARE(di.shape.ratio(), reference.shape.ratio());
+        QCOMPARE(di.shape.rotation(), reference.shape.rotation());
+    }
+
+    {
+        // the low precision levels snap the size, but keep the subpixel position
+        const KisDabShape shape(1.0, 1.0, 0.0);
+        const KisDabCacheUtils::DabGenerationInfo reference = fetchGenerationInfo(0, pos, shape);
+
+        QVERIFY(!qFuzzyIsNull(reference.subPixel.x()));
+        QVERIFY(!qFuzzyIsNull(reference.subPixel.y()));
+
+        for (int level = 1; level <= 3; level++) {
+            const KisDabCacheUtils::DabGenerationInfo di = fetchGenerationInfo(level, pos, shape);
+
+            QCOMPARE(di.dstDabRect, reference.dstDabRect);
+            QCOMPARE(di.subPixel, reference.subPixel);
+        }
+    }
+
+    {
+        // the size is snapped onto a logarithmic grid of 5% steps
+        const KisDabShape shape(0.73, 1.0, 0.0);
+        const KisDabCacheUtils::DabGenerationInfo di = fetchGenerationInfo(1, pos, shape);
+
+        QVERIFY(di.shape.scale() != 0.73);
+        QVERIFY(qAbs(di.shape.scale() - 0.73) < 0.05 * 0.73);
+    }
+
+    {
+        // precision level 4 quantizes the subpixel position to a half of a pixel
+        const KisDabShape shape(1.0, 1.0, 0.0);
+        const KisDabCacheUtils::DabGenerationInfo di = fetchGenerationInfo(4, pos, shape);
+
+        QVERIFY(qFuzzyIsNull(di.subPixel.x()) || qFuzzyCompare(di.subPixel.x(), 0.5));
+        QVERIFY(qFuzzyIsNull(di.subPixel.y()) || qFuzzyCompare(di.subPixel.y(), 0.5));
+    }
+}
+
 SIMPLE_TEST_MAIN(KisDabRenderingQueueTest)
@@ -18,6 +18,8 @@ private Q_SLOTS:
     void testRunningJobs();
 
     void testExecutor();
+
+    void testPrecisionSnapping();
 };
 
 #endif // KISDABRENDERINGQUEUETEST_H
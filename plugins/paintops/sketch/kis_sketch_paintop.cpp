@@ -9,6 +9,7 @@
 #include "kis_sketch_paintop_settings.h"
 
 #include <cmath>
+#include <limits>
 #include <QRect>
 
 #include <KoColor.h>
@@ -26,10 +27,17 @@
 #include <brushengine/kis_paint_information.h>
 #include <kis_fixed_paint_device.h>
 
-#include <kis_dab_cache.h>
 #include "kis_lod_transform.h"
 #include <KoResourceLoadResult.h>
 
+#include <kis_random_source.h>
+#include <KisDabCacheUtils.h>
+#include <KisDabRenderingExecutor.h>
+#include <KisRenderedDab.h>
+#include <kis_pointer_utils.h>
+#include <KisRunnableStrokeJobData.h>
+#include <KisRunnableStrokeJobUtils.h>
+
 
 #include <QtGlobal>
 
@@ -69,16 +77,38 @@ KisSketchPaintOp::KisSketchPaintOp(const KisPaintOpSettingsSP settings, KisPaint
     m_brushOption.readOptionSetting(settings, settings->resourcesInterface(), settings->canvasResourcesInterface());
 
     m_brush = m_brushOption.brush();
-    m_dabCache = new KisDabCache(m_brush);
 
     m_painter = 0;
     m_count = 0;
+
+    /**
+     * The simple mode uses a circle of the size of the brush for hit
+     * testing, so only the mask mode needs the brush tip to be rendered.
+     */
+    if (m_brush && !m_sketchProperties.simpleMode) {
+        m_brush->notifyBrushIsGoingToBeClonedForStroke();
+
+        KisBrushSP baseBrush = m_brush;
+        auto resourcesFactory =
+            [baseBrush] () {
+                KisDabCacheUtils::DabRenderingResources *resources =
+                    new KisDabCacheUtils::DabRenderingResources();
+                resources->brush = baseBrush->clone().dynamicCast<KisBrush>();
+
+                return resources;
+            };
+
+        m_dabExecutor.reset(
+            new KisDabRenderingExecutor(
+                        painter->device()->compositionSourceColorSpace(),
+                        resourcesFactory,
+                        painter->runnableStrokeJobsInterface()));
+    }
 }
 
 KisSketchPaintOp::~KisSketchPaintOp()
 {
     delete m_painter;
-    delete m_dabCache;
 }
 
 QList<KoResourceLoadResult> KisSketchPaintOp::prepareLinkedResources(const KisPaintOpSettingsSP settings, KisResourcesInterfaceSP resourcesInterface)
@@ -108,21 +138,6 @@ void KisSketchPaintOp::drawConnection(const QPointF& start, const QPointF& end,
     }
 }
 
-void KisSketchPaintOp::updateBrushMask(const KisPaintInformation& info, qreal scale, qreal rotation)
-{
-    QRect dstRect;
-    m_maskDab = m_dabCache->fetchDab(m_dab->colorSpace(),
-                                     painter()->paintColor(),
-                                     info.pos(),
-                                     KisDabShape(scale, 1.0, rotation),
-                                     info, 1.0,
-                                     &dstRect);
-
-    m_brushBoundingBox = dstRect;
-    m_hotSpot = QPointF(0.5 * m_brushBoundingBox.width(),
-                        0.5 * m_brushBoundingBox.height());
-}
-
 void KisSketchPaintOp::paintLine(const KisPaintInformation &pi1, const KisPaintInformation &pi2,
                                  KisDistanceInformation *currentDistance)
 {
@@ -139,6 +154,69 @@ void KisSketchPaintOp::doPaintLine(const KisPaintInformation &pi1, const KisPain
 {
     if (!m_brush || !painter()) return;
 
+    const qreal lodAdditionalScale = KisLodTransform::lodToScale(painter()->device());
+    const qreal scale = lodAdditionalScale * m_sizeOption.apply(pi2);
+    if ((scale * m_brush->width()) <= 0.01 || (scale * m_brush->height()) <= 0.01) {
+        // the point is still connected to by the following segments
+        m_skippedPoints.append(pi2.pos());
+        return;
+    }
+
+    SegmentParameters params;
+    params.info = pi2;
+    params.skippedPoints.swap(m_skippedPoints);
+    params.prevPos = pi1.pos();
+    params.scale = scale;
+    params.lineWidth = qMax(0.9, lodAdditionalScale * m_lineWidthOption.apply(pi2) * m_sketchProperties.lineWidth);
+    params.offsetScale = m_offsetScaleOption.apply(pi2) * m_sketchProperties.offset * 0.01;
+    params.probability = m_densityOption.apply(pi2) * m_sketchProperties.probability;
+
+    if (m_sketchProperties.simpleMode) {
+        // determine the radius
+        if (m_count == 0) {
+            m_radius = 0.5 * qMax(m_brush->width(), m_brush->height());
+        }
+
+        paintSegment(params, 0, QRect());
+        return;
+    }
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_dabExecutor);
+
+    /**
+     * The segment is painted later, in doAsynchronousUpdate(), and the
+     * options of the following segments may consume the random source
+     * of the stroke in the meantime. Give the segment a random source
+     * of its own to keep the stroke reproducible.
+     */
+    params.info.setRandomSource(
+        new KisRandomSource(pi2.randomSource()->generate(0, std::numeric_limits<int>::max())));
+
+    /**
+     * The parameters should be queued **before** the mask is passed to
+     * the executor, because doAsynchronousUpdate() may fetch the mask
+     * from a different thread right after addDab() returns.
+     */
+    {
+        QMutexLocker l(&m_pendingSegmentsMutex);
+        m_pendingSegments.enqueue(params);
+    }
+
+    const KoColor color = painter()->paintColor();
+    const QPointF cursorPoint = pi2.pos();
+    const double rotation = m_rotationOption.apply(pi2);
+
+    KisDabCacheUtils::DabRequestInfo request(color,
+                                             cursorPoint,
+                                             KisDabShape(scale, 1.0, rotation),
+                                             pi2,
+                                             1.0);
+
+    m_dabExecutor->addDab(request, 1.0, 1.0);
+}
+
+void KisSketchPaintOp::paintSegment(const SegmentParameters &params, KisFixedPaintDeviceSP maskDab, const QRect &maskRect)
+{
     if (!m_dab) {
         m_dab = source()->createCompositionSourceDevice();
         m_painter = new KisPainter(m_dab);
@@ -148,20 +226,16 @@ void KisSketchPaintOp::doPaintLine(const KisPaintInformation &pi1, const KisPain
         m_dab->clear();
     }
 
-    QPointF prevMouse = pi1.pos();
+    const KisPaintInformation &pi2 = params.info;
+
+    QPointF prevMouse = params.prevPos;
     QPointF mousePosition = pi2.pos();
+    m_points.append(params.skippedPoints);
     m_points.append(mousePosition);
 
-
-    const qreal lodAdditionalScale = KisLodTransform::lodToScale(painter()->device());
-    const qreal scale = lodAdditionalScale * m_sizeOption.apply(pi2);
-    if ((scale * m_brush->width()) <= 0.01 || (scale * m_brush->height()) <= 0.01) return;
-
-    const qreal currentLineWidth = qMax(0.9, lodAdditionalScale * m_lineWidthOption.apply(pi2) * m_sketchProperties.lineWidth);
-
-    const qreal currentOffsetScale = m_offsetScaleOption.apply(pi2) * m_sketchProperties.offset * 0.01;
-    const double rotation = m_rotationOption.apply(pi2);
-    const double currentProbability = m_densityOption.apply(pi2) * m_sketchProperties.probability;
+    const qreal currentLineWidth = params.lineWidth;
+    const qreal currentOffsetScale = params.offsetScale;
+    const double currentProbability = params.probability;
 
     // shaded: does not draw this line, chrome does, fur does
     if (m_sketchProperties.makeConnection) {
@@ -171,23 +245,21 @@ void KisSketchPaintOp::doPaintLine(const KisPaintInformation &pi1, const KisPain
 
     qreal thresholdDistance = 0.0;
 
-    // update the mask for simple mode only once
-    // determine the radius
-    if (m_count == 0 && m_sketchProperties.simpleMode) {
-        updateBrushMask(pi2, 1.0, 0.0);
-        //m_radius = qMax(m_maskDab->bounds().width(),m_maskDab->bounds().height()) * 0.5;
-        m_radius = 0.5 * qMax(m_brush->width(), m_brush->height());
-    }
+    // mask detection area
+    const QRectF brushBoundingBox = maskRect;
+    const QPointF hotSpot(0.5 * brushBoundingBox.width(),
+                          0.5 * brushBoundingBox.height());
 
     if (!m_sketchProperties.simpleMode) {
-        updateBrushMask(pi2, scale, rotation);
-        m_radius = qMax(m_maskDab->bounds().width(), m_maskDab->bounds().height()) * 0.5;
+        KIS_SAFE_ASSERT_RECOVER_RETURN(maskDab);
+
+        m_radius = qMax(maskDab->bounds().width(), maskDab->bounds().height()) * 0.5;
         thresholdDistance = pow(m_radius, 2);
     }
 
     if (m_sketchProperties.simpleMode) {
         // update the radius according scale in simple mode
-        thresholdDistance = pow(m_radius * scale, 2);
+        thresholdDistance = pow(m_radius * params.scale, 2);
     }
 
     // determine density
@@ -200,7 +272,7 @@ void KisSketchPaintOp::doPaintLine(const KisPaintInformation &pi1, const KisPain
     QColor randomColor;
     KoColor color(m_dab->colorSpace());
 
-    int w = m_maskDab->bounds().width();
+    int w = maskDab ? maskDab->bounds().width() : 0;
     quint8 opacityU8 = 0;
     quint8 * pixel;
     qreal distance;
@@ -222,12 +294,12 @@ void KisSketchPaintOp::doPaintLine(const KisPaintInformation &pi1, const KisPain
             // mask test
         }
         else {
-            if (m_brushBoundingBox.contains(m_points.at(i))) {
-                positionInMask = (diff + m_hotSpot).toPoint();
-                uint pos = ((positionInMask.y() * w + positionInMask.x()) * m_maskDab->pixelSize());
-                if (pos < m_maskDab->allocatedPixels() * m_maskDab->pixelSize()) {
-                    pixel = m_maskDab->data() + pos;
-                    opacityU8 = m_maskDab->colorSpace()->opacityU8(pixel);
+            if (brushBoundingBox.contains(m_points.at(i))) {
+                positionInMask = (diff + hotSpot).toPoint();
+                uint pos = ((positionInMask.y() * w + positionInMask.x()) * maskDab->pixelSize());
+                if (pos < maskDab->allocatedPixels() * maskDab->pixelSize()) {
+                    pixel = maskDab->data() + pos;
+                    opacityU8 = maskDab->colorSpace()->opacityU8(pixel);
                     if (opacityU8 != 0) {
                         makeConnection = true;
                     }
@@ -312,6 +384,74 @@ KisSpacingInformation KisSketchPaintOp::paintAt(const KisPaintInformation& info)
     return updateSpacingImpl(info);
 }
 
+struct KisSketchPaintOp::UpdateSharedState
+{
+    QList<KisRenderedDab> dabsQueue;
+    QVector<SegmentParameters> segmentParams;
+};
+
+std::pair<int, bool> KisSketchPaintOp::doAsynchronousUpdate(QVector<KisRunnableStrokeJobData*> &jobs)
+{
+    if (!m_dabExecutor) {
+        return KisPaintOp::doAsynchronousUpdate(jobs);
+    }
+
+    bool someDabsAreStillInQueue = false;
+    const bool hasPreparedDabsAtStart = m_dabExecutor->hasPreparedDabs();
+
+    if (!m_updateSharedState && hasPreparedDabsAtStart) {
+
+        m_updateSharedState = toQShared(new UpdateSharedState());
+        UpdateSharedStateSP state = m_updateSharedState;
+
+        state->dabsQueue = m_dabExecutor->takeReadyDabs(false, -1, &someDabsAreStillInQueue);
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!state->dabsQueue.isEmpty(),
+                                             std::make_pair(m_currentUpdatePeriod, false));
+
+        {
+            QMutexLocker l(&m_pendingSegmentsMutex);
+
+            KIS_SAFE_ASSERT_RECOVER_NOOP(m_pendingSegments.size() >= state->dabsQueue.size());
+
+            const int numSegments = qMin(m_pendingSegments.size(), state->dabsQueue.size());
+            state->segmentParams.reserve(numSegments);
+            for (int i = 0; i < numSegments; i++) {
+                state->segmentParams.append(m_pendingSegments.dequeue());
+            }
+        }
+
+        /**
+         * The brush masks are rendered concurrently by the executor, but
+         * every segment connects to all the points painted before it and
+         * consumes the random source of the stroke, so the segments must
+         * be painted strictly one after another, in stroke order.
+         */
+        KritaUtils::addJobSequential(jobs,
+            [state, this, someDabsAreStillInQueue] () {
+                const int numSegments = qMin(state->dabsQueue.size(), state->segmentParams.size());
+                for (int i = 0; i < numSegments; i++) {
+                    const KisRenderedDab &dab = state->dabsQueue[i];
+                    paintSegment(state->segmentParams[i], dab.device, dab.realBounds());
+                }
+
+                m_currentUpdatePeriod =
+                    someDabsAreStillInQueue ? m_minUpdatePeriod :
+                    qMax(m_minUpdatePeriod, qRound(1.5 * m_dabExecutor->averageDabRenderingTime()));
+
+                // release all the dab devices
+                state->dabsQueue.clear();
+
+                m_updateSharedState.clear();
+            }
+        );
+    } else if (m_updateSharedState && hasPreparedDabsAtStart) {
+        someDabsAreStillInQueue = true;
+    }
+
+    return std::make_pair(m_currentUpdatePeriod, someDabsAreStillInQueue);
+}
+
 KisSpacingInformation KisSketchPaintOp::updateSpacingImpl(const KisPaintInformation &info) const
 {
     return KisPaintOpPluginUtils::effectiveSpacing(0.0, 0.0, true, 0.0, false, 0.0, false, 0.0,
@@ -7,7 +7,13 @@
 #ifndef KIS_SKETCH_PAINTOP_H_
 #define KIS_SKETCH_PAINTOP_H_
 
+#include <QMutex>
+#include <QQueue>
+#include <QScopedPointer>
+#include <QSharedPointer>
+
 #include <brushengine/kis_paintop.h>
+#include <brushengine/kis_paint_information.h>
 #include <kis_types.h>
 
 #include "KisSketchStandardOptions.h"
@@ -21,7 +27,8 @@
 #include "KisOpacityOption.h"
 #include "KisAirbrushOptionData.h"
 
-class KisDabCache;
+class KisDabRenderingExecutor;
+class KisRunnableStrokeJobData;
 
 
 class KisSketchPaintOp : public KisPaintOp
@@ -36,6 +43,8 @@ public:
 
     static QList<KoResourceLoadResult> prepareLinkedResources(const KisPaintOpSettingsSP settings, KisResourcesInterfaceSP resourcesInterface);
 
+    std::pair<int, bool> doAsynchronousUpdate(QVector<KisRunnableStrokeJobData *> &jobs) override;
+
 protected:
     KisSpacingInformation paintAt(const KisPaintInformation& info) override;
 
@@ -43,15 +52,28 @@ protected:
 
     KisTimingInformation updateTimingImpl(const KisPaintInformation &info) const override;
 
+private:
+    /**
+     * The parameters of a stroke segment whose brush mask has been
+     * passed to the dab rendering queue, but has not been painted yet
+     */
+    struct SegmentParameters {
+        KisPaintInformation info;
+        QPointF prevPos;
+        QVector<QPointF> skippedPoints;
+        qreal scale = 1.0;
+        qreal lineWidth = 1.0;
+        qreal offsetScale = 0.0;
+        qreal probability = 0.0;
+    };
+
+    struct UpdateSharedState;
+    typedef QSharedPointer<UpdateSharedState> UpdateSharedStateSP;
+
 private:
     // pixel buffer
     KisPaintDeviceSP m_dab;
 
-    // mask detection area
-    KisFixedPaintDeviceSP m_maskDab;
-    QRectF m_brushBoundingBox;
-    QPointF m_hotSpot;
-
     // simple mode
     qreal m_radius {1.0};
 
@@ -68,15 +90,24 @@ private:
     KisSketchOpOptionData m_sketchProperties;
 
     QVector<QPointF> m_points;
+    QVector<QPointF> m_skippedPoints;
     int m_count {0};
     KisPainter * m_painter {nullptr};
     KisBrushSP m_brush;
-    KisDabCache *m_dabCache {nullptr};
+
+    QScopedPointer<KisDabRenderingExecutor> m_dabExecutor;
+
+    QMutex m_pendingSegmentsMutex;
+    QQueue<SegmentParameters> m_pendingSegments;
+
+    UpdateSharedStateSP m_updateSharedState;
+    int m_currentUpdatePeriod = 20;
+    const int m_minUpdatePeriod = 10;
 
 private:
     void drawConnection(const QPointF &start, const QPointF &end, double lineWidth);
-    void updateBrushMask(const KisPaintInformation& info, qreal scale, qreal rotation);
     void doPaintLine(const KisPaintInformation &pi1, const KisPaintInformation &pi2);
+    void paintSegment(const SegmentParameters &params, KisFixedPaintDeviceSP maskDab, const QRect &maskRect);
 };
 
 #endif // KIS_SKETCH_PAINTOP_H_
@@ -320,6 +320,7 @@ void KisToolTransform::beginActionImpl(KoPointerEvent *event, bool usePrimaryAct
     }
 
     m_actuallyMoveWhileSelected = false;
+    m_pendingInputTimestamp = 0;
 
     outlineChanged();
 }
@@ -331,6 +332,15 @@ void KisToolTransform::continueActionImpl(KoPointerEvent *event, bool usePrimary
 
     m_actuallyMoveWhileSelected = true;
 
+    /**
+     * Some strategies request the recalculation right away, others
+     * pass it through their signal compressors, so the timestamp is
+     * kept until the recalculation is actually requested.
+     */
+    if (!m_pendingInputTimestamp) {
+        m_pendingInputTimestamp = event->receivedTimestamp();
+    }
+
     if (usePrimaryAction) {
         currentStrategy()->continuePrimaryAction(event);
     } else {
@@ -823,8 +833,11 @@ void KisToolTransform::requestImageRecalculation()
             m_strokeId,
             new InplaceTransformStrokeStrategy::UpdateTransformData(
                 m_currentArgs,
-                InplaceTransformStrokeStrategy::UpdateTransformData::PAINT_DEVICE));
+                InplaceTransformStrokeStrategy::UpdateTransformData::PAINT_DEVICE,
+                m_pendingInputTimestamp));
     }
+
+    m_pendingInputTimestamp = 0;
 }
 
 void KisToolTransform::startStroke(ToolTransformArgs::TransformMode mode, bool forceReset)
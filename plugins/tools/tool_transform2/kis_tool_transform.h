@@ -261,6 +261,10 @@ private:
 
     bool m_actuallyMoveWhileSelected {false}; // true <=> selection has been moved while clicked
 
+    /// the moment the oldest pointer event of the drag that has not been
+    /// passed to the stroke yet has been received, or zero if there is none
+    qint64 m_pendingInputTimestamp {0};
+
     KisPaintDeviceSP m_selectedPortionCache;
     KisStrokeId m_strokeId;
     void *m_strokeStrategyCookie {0};
@@ -27,6 +27,7 @@
 #include "kis_projection_leaf.h"
 #include "commands_new/KisSimpleModifyTransformMaskCommand.h"
 #include "KisAnimAutoKey.h"
+#include "KisInputLatencyTracker.h"
 
 #include "kis_sequential_iterator.h"
 #include "kis_selection_mask.h"
@@ -112,6 +113,7 @@ struct InplaceTransformStrokeStrategy::Private
 
     // data for asynchronous updates
     boost::optional<ToolTransformArgs> pendingUpdateArgs;
+    qint64 pendingUpdateInputTimestamp = 0;
     QElapsedTimer updateTimer;
     const int updateInterval = 30;
 
@@ -179,6 +181,12 @@ void InplaceTransformStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
     if (UpdateTransformData *upd = dynamic_cast<UpdateTransformData*>(data)) {
         if (upd->destination == UpdateTransformData::PAINT_DEVICE) {
             m_d->pendingUpdateArgs = upd->args;
+
+            // the preview will be ready for all the pending events at once,
+            // so measure the one that has been waiting the longest
+            if (!m_d->pendingUpdateInputTimestamp) {
+                m_d->pendingUpdateInputTimestamp = upd->inputTimestamp;
+            }
             tryPostUpdateJob(false);
         } else if (m_d->selection) {
             // NOTE: selection is hidden during the transformation, so we
@@ -238,11 +246,19 @@ void InplaceTransformStrokeStrategy::doCanvasUpdate(bool forceUpdate)
     ToolTransformArgs args = *m_d->pendingUpdateArgs;
     m_d->pendingUpdateArgs = boost::none;
 
+    const qint64 inputTimestamp = m_d->pendingUpdateInputTimestamp;
+    m_d->pendingUpdateInputTimestamp = 0;
+
     reapplyTransform(args, jobs, m_d->previewLevelOfDetail, false);
 
-    KritaUtils::addJobBarrier(jobs, [this, args]() {
+    KritaUtils::addJobBarrier(jobs, [this, args, inputTimestamp]() {
         m_d->currentTransformArgs = args;
         m_d->updateTimer.restart();
+
+        if (inputTimestamp) {
+            KisInputLatencyTracker::instance()->notifyTransformPreviewRendered(inputTimestamp);
+        }
+
         // sanity check that no job has been squeezed in between
         KIS_SAFE_ASSERT_RECOVER_RETURN(!m_d->pendingUpdateArgs);
     });
@@ -250,10 +266,21 @@ void InplaceTransformStrokeStrategy::doCanvasUpdate(bool forceUpdate)
     addMutatedJobs(jobs);
 }
 
+int InplaceTransformStrokeStrategy::previewLevelOfDetail() const
+{
+    return m_d->previewLevelOfDetail;
+}
+
 int InplaceTransformStrokeStrategy::calculatePreferredLevelOfDetail(const QRect &srcRect)
 {
     KisLodPreferences lodPreferences = this->currentLodPreferences();
-    if (!lodPreferences.lodSupported() ||
+
+    /// QPainter canvas supports only the short-living LoD previews,
+    /// which is exactly what the transform tool uses
+    const bool lodSupported =
+        lodPreferences.lodSupported() || lodPreferences.lodPreviewSupported();
+
+    if (!lodSupported ||
         !(lodPreferences.lodPreferred() || m_d->forceLodMode)) return -1;
 
     const int maxSize = 2000;
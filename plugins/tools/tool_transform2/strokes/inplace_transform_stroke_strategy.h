@@ -39,10 +39,11 @@ public:
         };
 
     public:
-        UpdateTransformData(ToolTransformArgs _args, Destination _dest)
+        UpdateTransformData(ToolTransformArgs _args, Destination _dest, qint64 _inputTimestamp = 0)
             : KisStrokeJobData(SEQUENTIAL, NORMAL),
               args(_args),
-              destination(_dest)
+              destination(_dest),
+              inputTimestamp(_inputTimestamp)
         {}
 
         KisStrokeJobData* createLodClone(int levelOfDetail) override {
@@ -53,7 +54,8 @@ public:
         UpdateTransformData(const UpdateTransformData &rhs, int levelOfDetail)
             : KisStrokeJobData(rhs),
               args(rhs.args),
-              destination(rhs.destination)
+              destination(rhs.destination),
+              inputTimestamp(rhs.inputTimestamp)
         {
             Q_UNUSED(levelOfDetail);
         }
@@ -61,6 +63,11 @@ public:
     public:
         ToolTransformArgs args;
         Destination destination;
+
+        /// the moment the tool has received the oldest pointer event that
+        /// has caused the update, used for measuring the latency of the
+        /// handle drags, zero if the update is not caused by a drag
+        qint64 inputTimestamp;
     };
 
 private:
@@ -133,6 +140,13 @@ public:
     void cancelStrokeCallback() override;
     void doStrokeCallback(KisStrokeJobData *data) override;
 
+    /**
+     * The level of detail the preview is rendered on, or a non-positive
+     * value if the preview is rendered on the image itself. It is known
+     * when sigTransactionGenerated() is emitted.
+     */
+    int previewLevelOfDetail() const;
+
 Q_SIGNALS:
     void sigTransactionGenerated(TransformTransactionProperties transaction, ToolTransformArgs args, void *cookie);
 
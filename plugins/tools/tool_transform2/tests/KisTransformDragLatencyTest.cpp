@@ -0,0 +1,113 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTransformDragLatencyTest.h"
+
+#include <QAtomicInt>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kistest.h"
+#include <KisAsynchronousStrokeUpdateHelper.h>
+#include <KisInputLatencyTracker.h>
+#include <KisLodPreferences.h>
+#include <kis_image.h>
+#include <kis_paint_device.h>
+#include <kis_paint_layer.h>
+
+#include "strokes/inplace_transform_stroke_strategy.h"
+#include "tool_transform_args.h"
+
+void KisTransformDragLatencyTest::testDragLatency8K()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect imageRect(0, 0, 7680, 4320);
+
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "8K drag latency");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "layer", OPACITY_OPAQUE_U8);
+    image->addNode(layer);
+
+    layer->paintDevice()->fill(imageRect.adjusted(100, 100, -100, -100), KoColor(Qt::red, cs));
+    image->refreshGraphAsync();
+    image->waitForDone();
+
+    // like on the QPainter canvas: only the strokes asking for the
+    // preview explicitly may use the level of detail
+    image->setLodPreferences(KisLodPreferences(KisLodPreferences::LodPreviewSupported, 0));
+
+    KisInputLatencyTracker *tracker = KisInputLatencyTracker::instance();
+    tracker->reset();
+    tracker->setEnabled(true);
+
+    InplaceTransformStrokeStrategy *strategy =
+        new InplaceTransformStrokeStrategy(ToolTransformArgs::FREE_TRANSFORM, "Bicubic", false,
+                                           KisNodeList() << layer,
+                                           KisSelectionSP(), KisPaintDeviceSP(),
+                                           image.data(), image.data(), image->root(), true);
+
+    ToolTransformArgs initialArgs;
+    QAtomicInt transactionGenerated(0);
+    QAtomicInt previewLevelOfDetail(-1);
+
+    connect(strategy, &InplaceTransformStrokeStrategy::sigTransactionGenerated,
+            [&] (TransformTransactionProperties, ToolTransformArgs args, void *) {
+                initialArgs = args;
+                previewLevelOfDetail.storeRelease(strategy->previewLevelOfDetail());
+                transactionGenerated.storeRelease(1);
+            });
+
+    KisStrokeId id = image->startStroke(strategy);
+    QTRY_VERIFY_WITH_TIMEOUT(transactionGenerated.loadAcquire(), 60000);
+
+    // the preview of an 8K image must go to the LoD plane, even though
+    // the preferences support LoD for the previews only
+    QVERIFY(previewLevelOfDetail.loadAcquire() > 0);
+
+    const int numDragEvents = 20;
+
+    for (int i = 1; i <= numDragEvents; i++) {
+        ToolTransformArgs args = initialArgs;
+        args.setTransformedCenter(initialArgs.transformedCenter() + QPointF(10 * i, 5 * i));
+        args.setAZ(0.01 * i);
+
+        image->addJob(id,
+            new InplaceTransformStrokeStrategy::UpdateTransformData(
+                args,
+                InplaceTransformStrokeStrategy::UpdateTransformData::PAINT_DEVICE,
+                KisInputLatencyTracker::now()));
+
+        // force the update the way KisAsynchronousStrokeUpdateHelper
+        // does at the end of the stream, so that every drag gets its
+        // own preview, and wait for that preview before the next drag
+        image->addJob(id, new KisAsynchronousStrokeUpdateHelper::UpdateData(true));
+
+        QTRY_COMPARE_WITH_TIMEOUT(tracker->histogram(KisInputLatencyTracker::TransformPreviewRendered).count,
+                                  qint64(i), 60000);
+    }
+
+    image->cancelStroke(id);
+    image->waitForDone();
+
+    const KisInputLatencyTracker::Histogram preview =
+        tracker->histogram(KisInputLatencyTracker::TransformPreviewRendered);
+
+    const int numDabs = tracker->histogram(KisInputLatencyTracker::DabPainted).count;
+
+    tracker->setEnabled(false);
+    tracker->reset();
+
+    // every drag has been measured in the transform stage, not as a dab
+    QCOMPARE(preview.count, qint64(numDragEvents));
+    QCOMPARE(numDabs, 0);
+
+    qDebug() << "8K transform drag:" << preview.count << "previews,"
+             << "p50" << preview.percentileMs(50) << "ms,"
+             << "p95" << preview.percentileMs(95) << "ms,"
+             << "max" << preview.maxMs() << "ms";
+}
+
+KISTEST_MAIN(KisTransformDragLatencyTest)
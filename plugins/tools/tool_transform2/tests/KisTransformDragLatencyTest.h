@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTRANSFORMDRAGLATENCYTEST_H
+#define KISTRANSFORMDRAGLATENCYTEST_H
+
+#include <simpletest.h>
+
+class KisTransformDragLatencyTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testDragLatency8K();
+};
+
+#endif // KISTRANSFORMDRAGLATENCYTEST_H